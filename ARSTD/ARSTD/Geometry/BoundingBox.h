@@ -24,8 +24,7 @@ namespace ARSTD
       template<class Type2>
       explicit BoundingBox(const BoundingBox<Type2>& other)
       : m_matCoordSys(static_cast< Matrix44<Type> >(other.getCoordSystem())),
-        m_Size(static_cast< Size3<Type> >(other.getSize())),
-        m_vecScalingCenter(static_cast<Vector3<Type>>(other.getScalingCenter()))
+        m_Size(static_cast< Size3<Type> >(other.getSize()))
       {
         validate();
       }
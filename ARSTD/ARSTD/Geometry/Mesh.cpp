@@ -2,8 +2,6 @@
 // Released under the MIT license. (see license.txt)
 
 #include "arstd/Geometry/Mesh.h"
-#include "windows.h"
-#include "gl/gl.h"
 #include <fstream>
 
 #undef min
@@ -232,6 +230,11 @@ namespace ARSTD
   }
 
 
+  Mesh::~Mesh()
+  {
+  }
+
+
   Mesh::PtrType Mesh::transformed(const Matrix44D& mat)
   {
     if (m_Vertices.size() != m_Normals.size())
@@ -246,40 +249,6 @@ namespace ARSTD
   }
 
 
-  void Mesh::render(int nNumerator, int nDenominator) const
-  {
-    assert(nNumerator > 0 && nDenominator > 0 && nNumerator <= nDenominator);
-
-    glPushAttrib(GL_ENABLE_BIT | GL_POLYGON_BIT | GL_LIGHTING_BIT);
-
-    glEnableClientState(GL_NORMAL_ARRAY);
-    glEnableClientState(GL_VERTEX_ARRAY);
-
-    glNormalPointer(GL_FLOAT, 0, &m_Normals.front());
-    glVertexPointer(3, GL_FLOAT, 0, &m_Vertices.front());
-
-    int nTrisToDrawAtOnce = static_cast<int>(m_Triangles.size())/nDenominator;
-    glDrawElements(GL_TRIANGLES, nTrisToDrawAtOnce*3, GL_UNSIGNED_INT, &m_Triangles.front() + (nNumerator - 1)*nTrisToDrawAtOnce);
-    
-    glDisableClientState(GL_NORMAL_ARRAY);
-    glDisableClientState(GL_VERTEX_ARRAY);
-    
-////draw normals    
-//glColor3d(0, 1, 1);
-//glBegin(GL_LINES);
-//  VectorContainer::const_iterator itVert = m_Vertices.begin();
-//  VectorContainer::const_iterator itNormal = m_Normals.begin();
-//  for (; itVert != m_Vertices.end() && itNormal != m_Normals.end(); ++itVert, ++itNormal)
-//  {
-//    glVertex3dv(itVert->pData);
-//    glVertex3dv((*itVert + *itNormal*3.0).pData);
-//  }
-//glEnd();
-
-    glPopAttrib();
-  }
-
-
   Mesh::VectorConstIterator Mesh::getVerticesBegin() const
   { 
     return m_Vertices.begin(); 
@@ -330,6 +299,7 @@ namespace ARSTD
 
     generateNormals();
     updateAxisAlignedBoundingBox();
+    m_pRenderData.reset();
   }
 
 
@@ -7,6 +7,7 @@
 
 #include <vector>
 #include <map>
+#include <memory>
 #include "arstd/Geometry/AxisAlignedBoundingBox.h"
 
 
@@ -29,10 +30,19 @@ namespace ARSTD
         uint indices[3];
       };
 
+      //transform (rotation, scaling and translation) relative to the current model view matrix and color of one
+      //drawn copy of the mesh
+      struct Instance
+      {
+        Matrix44F matTransform;
+        Vector4F vecColor;
+      };
+
       typedef std::shared_ptr<Mesh> PtrType;
       typedef std::vector<Vector3F> VectorContainer;
       typedef VectorContainer::const_iterator VectorConstIterator;
       typedef std::vector<Triangle> TriangleContainer;
+      typedef std::vector<Instance> InstanceContainer;
 
       static PtrType create(const VectorContainer& vertices, const TriangleContainer& triangles, const VectorContainer& normals = VectorContainer());
 
@@ -48,9 +58,9 @@ namespace ARSTD
 
       static PtrType copy(const PtrType pMesh);
 
-      PtrType transformed(const Matrix44D& mat);
+      ~Mesh();
 
-      void render(int nNumerator = 1, int nDenominator = 1) const;
+      PtrType transformed(const Matrix44D& mat);
 
       VectorConstIterator getVerticesBegin() const;
       VectorConstIterator getVerticesEnd() const;
@@ -71,6 +81,7 @@ namespace ARSTD
       void generateNormals();
       void updateAxisAlignedBoundingBox();
 
+
       static void mergeVertices(Mesh::VectorContainer& vertices,
                                 VertexIndexMap& vertexIndexMap,
                                 Mesh::TriangleContainer& triangles,
@@ -80,6 +91,12 @@ namespace ARSTD
       TriangleContainer m_Triangles;
       VectorContainer m_Normals;
       AxisAlignedBoundingBoxD m_AxisAlignedBoundingBox;
+
+      //whatever a renderer keeps for the mesh (see MeshRenderer), created with the first draw call and released
+      //with the mesh or when it changes
+      mutable std::shared_ptr<void> m_pRenderData;
+
+      friend class MeshRenderer;
   };
 
 
@@ -6,6 +6,7 @@
 #include <cassert>
 #include "arstd/Math/Math.h"
 #include "arstd/Geometry/Segment3.h"
+#include "arstd/Geometry/Plane.h"
 
 
 namespace ARSTD
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <utility>
+#include <algorithm>
 #include <limits>
 #include <cmath>
 #include <cassert>
@@ -16,6 +17,16 @@
 #include "Constants.h"
 
 
+namespace ARSTD
+{
+
+  //declared ahead of the vector and matrix templates which use them
+  double getInDegree(double fRad);
+  double getInRad(double fDegree);
+
+}
+
+
 #include "Vector3.h"
 #include "Vector4.h"
 #include "Quaternion.h"
@@ -30,9 +41,6 @@ namespace ARSTD
   double log2(double);
   double log10(double);
 
-  double getInDegree(double fRad);
-  double getInRad(double fDegree);
-
   template <typename Type>
   Type minimum(const Type& lhs, const Type& rhs)
   {
@@ -52,7 +60,7 @@ namespace ARSTD
             typename std::iterator_traits<ForwardIterator>::value_type>
   getMinMax(ForwardIterator itBegin, ForwardIterator itEnd)
   {
-    typedef std::iterator_traits<ForwardIterator>::value_type ValueType;
+    typedef typename std::iterator_traits<ForwardIterator>::value_type ValueType;
     if (itBegin == itEnd)
       return std::make_pair(ValueType(), ValueType());
 
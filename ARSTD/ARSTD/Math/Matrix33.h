@@ -93,11 +93,15 @@ namespace ARSTD
   };
 
 
-  template <class Matrix>
-  struct boost::qvm::mat_traits;
+} //namespace ARSTD
+
+
+//the traits must be specialized in the namespace of boost::qvm
+namespace boost { namespace qvm
+{
 
   template <class Type>
-  struct boost::qvm::mat_traits<ARSTD::Matrix33<Type>>
+  struct mat_traits<ARSTD::Matrix33<Type>>
   {
     typedef Type scalar_type;
     static int const rows = 3;
@@ -126,6 +130,12 @@ namespace ARSTD
     }
   };
 
+} }
+
+
+namespace ARSTD
+{
+
 
   typedef Matrix33<float> Matrix33F;
   typedef Matrix33<double> Matrix33D;
@@ -260,11 +260,15 @@ namespace ARSTD
   };
 
 
-  template <class Matrix>
-  struct boost::qvm::mat_traits;
+} //namespace ARSTD
+
+
+//the traits must be specialized in the namespace of boost::qvm
+namespace boost { namespace qvm
+{
 
   template <class Type>
-  struct boost::qvm::mat_traits<ARSTD::Matrix44<Type>>
+  struct mat_traits<ARSTD::Matrix44<Type>>
   {
     typedef Type scalar_type;
     static int const rows = 4;
@@ -293,6 +297,12 @@ namespace ARSTD
     }
   };
 
+} }
+
+
+namespace ARSTD
+{
+
 
   typedef Matrix44<float> Matrix44F;
   typedef Matrix44<double> Matrix44D;
@@ -227,7 +227,7 @@ namespace ARSTD
 
 
   template <typename Type>
-  typename Type& Matrix<Type>::operator()(const uint nRow, const uint nColumn)
+  Type& Matrix<Type>::operator()(const uint nRow, const uint nColumn)
   {
     assert(nRow < m_nRows && nColumn < m_nColumns);
 
@@ -236,7 +236,7 @@ namespace ARSTD
 
 
   template <typename Type>
-  typename const Type& Matrix<Type>::operator()(const uint nRow, const uint nColumn) const
+  const Type& Matrix<Type>::operator()(const uint nRow, const uint nColumn) const
   {
     assert(nRow < m_nRows && nColumn < m_nColumns);
 
@@ -92,11 +92,15 @@ namespace ARSTD
   };
 
 
-  template <class Quaternion>
-  struct boost::qvm::quat_traits;
+} //namespace ARSTD
+
+
+//the traits must be specialized in the namespace of boost::qvm
+namespace boost { namespace qvm
+{
 
   template <class Type>
-  struct boost::qvm::quat_traits<ARSTD::Quaternion<Type>>
+  struct quat_traits<ARSTD::Quaternion<Type>>
   {
     typedef Type scalar_type;
 
@@ -113,6 +117,12 @@ namespace ARSTD
     }
   };
 
+} }
+
+
+namespace ARSTD
+{
+
 
   typedef Quaternion<double> QuaternionD;
 
@@ -125,11 +125,15 @@ namespace ARSTD
   };
 
 
-  template <class Vector>
-  struct boost::qvm::vec_traits;
+} //namespace ARSTD
+
+
+//the traits must be specialized in the namespace of boost::qvm
+namespace boost { namespace qvm
+{
 
   template <class Type>
-  struct boost::qvm::vec_traits<ARSTD::Vector3<Type>>
+  struct vec_traits<ARSTD::Vector3<Type>>
   {
     typedef Type scalar_type;
     static int const dim = 3;
@@ -158,6 +162,12 @@ namespace ARSTD
 
   };
 
+} }
+
+
+namespace ARSTD
+{
+
   typedef Vector3<float> Vector3F;
   typedef Vector3<double> Vector3D;
 
@@ -295,44 +305,49 @@ namespace ARSTD
 } // namespace ARSTD
 
 
-template<> class std::numeric_limits<ARSTD::Vector3F> : public std::_Num_float_base
-{ 
-  public:
-    typedef ARSTD::Vector3F _Ty;
+namespace std
+{
 
-    static _Ty (__cdecl min)()
-    {
-      return _Ty(-std::numeric_limits<float>::max(),
-                 -std::numeric_limits<float>::max(),
-                 -std::numeric_limits<float>::max());
-    }
+  template<> class numeric_limits<ARSTD::Vector3F> : public numeric_limits<float>
+  { 
+    public:
+      typedef ARSTD::Vector3F _Ty;
 
-    static _Ty (__cdecl max)()
-    {
-      return _Ty(std::numeric_limits<float>::max(),
-                 std::numeric_limits<float>::max(),
-                 std::numeric_limits<float>::max());
-    }
-};
+      static _Ty (min)()
+      {
+        return _Ty(-numeric_limits<float>::max(),
+                   -numeric_limits<float>::max(),
+                   -numeric_limits<float>::max());
+      }
 
-template<> class std::numeric_limits<ARSTD::Vector3D> : public std::_Num_float_base
-{
-public:
-  typedef ARSTD::Vector3D _Ty;
+      static _Ty (max)()
+      {
+        return _Ty(numeric_limits<float>::max(),
+                   numeric_limits<float>::max(),
+                   numeric_limits<float>::max());
+      }
+  };
 
-  static _Ty(__cdecl min)()
+  template<> class numeric_limits<ARSTD::Vector3D> : public numeric_limits<double>
   {
-    return ARSTD::Vector3D(-std::numeric_limits<double>::max(),
-      -std::numeric_limits<double>::max(),
-      -std::numeric_limits<double>::max());
-  }
+    public:
+      typedef ARSTD::Vector3D _Ty;
 
-  static _Ty(__cdecl max)()
-  {
-    return ARSTD::Vector3D(std::numeric_limits<double>::max(),
-      std::numeric_limits<double>::max(),
-      std::numeric_limits<double>::max());
-  }
-};
+      static _Ty (min)()
+      {
+        return _Ty(-numeric_limits<double>::max(),
+                   -numeric_limits<double>::max(),
+                   -numeric_limits<double>::max());
+      }
+
+      static _Ty (max)()
+      {
+        return _Ty(numeric_limits<double>::max(),
+                   numeric_limits<double>::max(),
+                   numeric_limits<double>::max());
+      }
+  };
+
+}
 
 #include "Vector3_Impl.h"
@@ -106,11 +106,15 @@ namespace ARSTD
       };
   };
 
-  template <class Vector>
-  struct boost::qvm::vec_traits;
+} //namespace ARSTD
+
+
+//the traits must be specialized in the namespace of boost::qvm
+namespace boost { namespace qvm
+{
 
   template <class Type>
-  struct boost::qvm::vec_traits<ARSTD::Vector4<Type>>
+  struct vec_traits<ARSTD::Vector4<Type>>
   {
     typedef Type scalar_type;
     static int const dim = 4;
@@ -138,6 +142,12 @@ namespace ARSTD
     }
   };
 
+} }
+
+
+namespace ARSTD
+{
+
 
   typedef Vector4<float> Vector4F;
   typedef Vector4<double> Vector4D;
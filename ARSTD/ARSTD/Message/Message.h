@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 namespace ARSTD
 {
@@ -39,11 +40,28 @@ namespace ARSTD
     if (nMaxTreeDepth <= 0)
       return;
 
-    ObjectType::ChildIterator it;
-    ObjectType::ChildRange range = pObject->getChildRange();
-    for (it = range.first; it != range.second; ++it)
+    //evaluating may attach or detach objects (e.g. launched weapons), so the childs are copied before. childs
+    //attached during the walk are reached by the next broadcast, childs detached before their turn are skipped.
+    //the copies of all levels share one stack, which grows only in the first walks.
+    typedef std::vector<typename ObjectType::ChildContainer::value_type> ChildStack;
+    static thread_local ChildStack childStack;
+    struct StackGuard
     {
-      std::shared_ptr<ObjectType> pChild = std::dynamic_pointer_cast<ObjectType>(*it);
+      ChildStack& stack;
+      std::size_t nSize;
+      ~StackGuard() { stack.resize(nSize); }
+    } guard = { childStack, childStack.size() };
+
+    typename ObjectType::ChildRange range = pObject->getChildRange();
+    childStack.insert(childStack.end(), range.first, range.second);
+    const std::size_t nEnd = childStack.size();
+
+    //the stack may be reallocated by deeper levels, so it is accessed by index
+    for (std::size_t nChild = guard.nSize; nChild < nEnd; ++nChild)
+    {
+      if (childStack[nChild]->getParent() != pObject.get())
+        continue;
+      std::shared_ptr<ObjectType> pChild = std::dynamic_pointer_cast<ObjectType>(childStack[nChild]);
       if (pChild)
       {
         broadcastMessage(pChild, message, nMaxTreeDepth - 1);
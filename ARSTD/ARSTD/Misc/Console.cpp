@@ -0,0 +1,37 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#ifdef _WIN32
+#include <conio.h>
+#include <io.h>
+#include <stdio.h>
+#else
+#include <sys/select.h>
+#include <unistd.h>
+#endif
+
+#include "Console.h"
+
+namespace ARSTD
+{
+
+  bool Console::isKeyPressed()
+  {
+#ifdef _WIN32
+    if (!_isatty(_fileno(stdin)))
+      return false;
+    return _kbhit() != 0;
+#else
+    if (!isatty(STDIN_FILENO))
+      return false;
+
+    fd_set readSet;
+    FD_ZERO(&readSet);
+    FD_SET(STDIN_FILENO, &readSet);
+    timeval timeout = { 0, 0 };
+    return select(STDIN_FILENO + 1, &readSet, NULL, NULL, &timeout) > 0;
+#endif
+  }
+
+} //namespace ARSTD
@@ -0,0 +1,24 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#pragma once
+
+namespace ARSTD
+{
+
+  /**
+   * Platform independent polling of the console for runners without graphical output.
+   */
+  class Console
+  {
+    public:
+      /**
+       * Returns true if a key has been pressed on the console without blocking and without consuming it. On systems 
+       * other than windows the console is line buffered, so the key has to be followed by return. Always returns 
+       * false if the standard input is not a console (e.g. redirected from a file).
+       */
+      static bool isKeyPressed();
+  };
+
+} //namespace ARSTD
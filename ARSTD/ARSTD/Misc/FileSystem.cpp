@@ -0,0 +1,125 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#include <io.h>
+#else
+#include <dirent.h>
+#include <climits>
+#endif
+
+#include "FileSystem.h"
+
+namespace ARSTD
+{
+
+  bool FileSystem::exists(const std::string& strPath)
+  {
+    struct stat info;
+    return stat(strPath.c_str(), &info) == 0;
+  }
+
+
+  bool FileSystem::isDirectory(const std::string& strPath)
+  {
+    struct stat info;
+    return stat(strPath.c_str(), &info) == 0 && (info.st_mode & S_IFDIR);
+  }
+
+
+  bool FileSystem::createDirectory(const std::string& strPath)
+  {
+    if (isDirectory(strPath))
+      return true;
+#ifdef _WIN32
+    return _mkdir(strPath.c_str()) == 0;
+#else
+    return mkdir(strPath.c_str(), 0755) == 0;
+#endif
+  }
+
+
+  std::vector<FileSystem::Entry> FileSystem::getEntries(const std::string& strPath)
+  {
+    std::vector<Entry> entries;
+#ifdef _WIN32
+    _finddata_t data;
+    intptr_t hFind = _findfirst((strPath + "/*").c_str(), &data);
+    if (hFind == -1)
+      return entries;
+    do
+    {
+      std::string strName(data.name);
+      if (strName == "." || strName == "..")
+        continue;
+      Entry e = { strName, (data.attrib & _A_SUBDIR) != 0 };
+      entries.push_back(e);
+    }
+    while (_findnext(hFind, &data) == 0);
+    _findclose(hFind);
+#else
+    DIR* pDir = opendir(strPath.c_str());
+    if (!pDir)
+      return entries;
+    while (dirent* pEntry = readdir(pDir))
+    {
+      std::string strName(pEntry->d_name);
+      if (strName == "." || strName == "..")
+        continue;
+      struct stat info;
+      if (lstat((strPath + "/" + strName).c_str(), &info) != 0 || S_ISLNK(info.st_mode))
+        continue;
+      Entry e = { strName, S_ISDIR(info.st_mode) };
+      entries.push_back(e);
+    }
+    closedir(pDir);
+#endif
+    std::sort(entries.begin(), entries.end(), 
+              [](const Entry& lhs, const Entry& rhs) { return lhs.strName < rhs.strName; });
+    return entries;
+  }
+
+
+  std::string FileSystem::getAbsolutePath(const std::string& strPath)
+  {
+#ifdef _WIN32
+    char pBuffer[_MAX_PATH];
+    if (!_fullpath(pBuffer, strPath.c_str(), _MAX_PATH))
+      return strPath;
+    std::string strResult(pBuffer);
+    std::replace(strResult.begin(), strResult.end(), '\\', '/');
+    return strResult;
+#else
+    char pBuffer[PATH_MAX];
+    if (!realpath(strPath.c_str(), pBuffer))
+      return strPath;
+    return std::string(pBuffer);
+#endif
+  }
+
+
+  std::string FileSystem::getBaseName(const std::string& strFileName)
+  {
+    std::string::size_type nStart = strFileName.find_last_of("/\\");
+    nStart = nStart == std::string::npos ? 0 : nStart + 1;
+    std::string::size_type nEnd = strFileName.find('.', nStart);
+    return strFileName.substr(nStart, nEnd == std::string::npos ? std::string::npos : nEnd - nStart);
+  }
+
+
+  std::string FileSystem::getSuffix(const std::string& strFileName)
+  {
+    std::string::size_type nStart = strFileName.find_last_of("/\\");
+    nStart = nStart == std::string::npos ? 0 : nStart + 1;
+    std::string::size_type nDot = strFileName.rfind('.');
+    if (nDot == std::string::npos || nDot < nStart)
+      return std::string();
+    return strFileName.substr(nDot + 1);
+  }
+
+} //namespace ARSTD
@@ -0,0 +1,41 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace ARSTD
+{
+
+  /**
+   * Minimal platform independent access to the file system. Only the functionality needed to 
+   * find files and to create output directories is provided.
+   */
+  class FileSystem
+  {
+    public:
+      struct Entry
+      {
+        std::string strName;
+        bool bDirectory;
+      };
+
+      static bool exists(const std::string& strPath);
+      static bool isDirectory(const std::string& strPath);
+      static bool createDirectory(const std::string& strPath);
+
+      /**
+       * Returns the files and directories of the given directory sorted by name. The entries "." and ".."
+       * and symbolic links are skipped.
+       */
+      static std::vector<Entry> getEntries(const std::string& strPath);
+
+      static std::string getAbsolutePath(const std::string& strPath);
+      static std::string getBaseName(const std::string& strFileName);
+      static std::string getSuffix(const std::string& strFileName);
+  };
+
+} //namespace ARSTD
@@ -2,123 +2,184 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include <windows.h>
-#include <mmsystem.h>
 #include <stdexcept>
+#include <mutex>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <time.h>
+#endif
 
 #include "Time.h"
 
 namespace ARSTD
 {
 
-  Time::PtrType Time::m_pInstance;
-
-
   void Time::setTimeRatio(double fRatio)
   {
-    initialize();
+    Time& time = getInstance();
+    std::lock_guard<std::mutex> lck(time.m_mtxChange);
 
-    if (m_pInstance->m_Mode == MANUAL)
+    if (time.m_Mode == MANUAL)
       return;
 
-    LARGE_INTEGER currentCount;
-    QueryPerformanceCounter(&currentCount);
-    m_pInstance->m_fElapsedTimeBeforeChangeTimeRatio += (currentCount.QuadPart - m_pInstance->m_StartCount.QuadPart)*m_pInstance->m_fCurrentTimeRatio/
-                                                        m_pInstance->m_PerformanceFrequency.QuadPart;
-    m_pInstance->m_StartCount = currentCount;
-    m_pInstance->m_fCurrentTimeRatio = fRatio;
+    double fRealSeconds = time.getRealSeconds();
+    time.setTimeBase(time.calcTime(fRealSeconds) - fRealSeconds*fRatio, fRatio);
+    time.m_fCurrentTimeRatio.store(fRatio);
   }
 
 
   double Time::getTimeRatio()
   {
-    initialize();
-    return m_pInstance->m_fCurrentTimeRatio;
+    return getInstance().m_fCurrentTimeRatio.load();
   }
 
   
   double Time::getTime()
   {
-    initialize();
-
-    if (m_pInstance->m_Mode == MANUAL)
-      return m_pInstance->m_fManualTime;
-
-    LARGE_INTEGER currentCount;
-    QueryPerformanceCounter(&currentCount);
-    return m_pInstance->m_fElapsedTimeBeforeChangeTimeRatio + (currentCount.QuadPart - m_pInstance->m_StartCount.QuadPart)*m_pInstance->m_fCurrentTimeRatio/
-           m_pInstance->m_PerformanceFrequency.QuadPart;
+    Time& time = getInstance();
+    return time.calcTime(time.getRealSeconds());
   }
 
 
   double Time::getRealTime()
   {
-    initialize();
+    return getInstance().getRealSeconds();
+  }
+
 
-    LARGE_INTEGER currentCount;
-    QueryPerformanceCounter(&currentCount);
-    return static_cast<double>(currentCount.QuadPart - m_pInstance->m_RealStartCount.QuadPart)/m_pInstance->m_PerformanceFrequency.QuadPart;
+  double Time::getThreadTime()
+  {
+#ifdef _WIN32
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime))
+      return 0;
+
+    //both are given in 100ns units
+    ULARGE_INTEGER kernel, user;
+    kernel.LowPart = kernelTime.dwLowDateTime;
+    kernel.HighPart = kernelTime.dwHighDateTime;
+    user.LowPart = userTime.dwLowDateTime;
+    user.HighPart = userTime.dwHighDateTime;
+    return (kernel.QuadPart + user.QuadPart)*1e-7;
+#else
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+      return 0;
+    return ts.tv_sec + ts.tv_nsec*1e-9;
+#endif
   }
 
   
   void Time::step(double fDeltaTime)
   {
-    initialize();
+    Time& time = getInstance();
+    std::lock_guard<std::mutex> lck(time.m_mtxChange);
 
-    if (m_pInstance->m_Mode != MANUAL)
+    if (time.m_Mode != MANUAL)
       return;
 
-    m_pInstance->m_fManualTime += fDeltaTime;
+    time.setTimeBase(time.m_fOffset.load(std::memory_order_relaxed) + fDeltaTime, 0);
   }
 
 
   void Time::setTime(double fTime)
   {
-    initialize();
+    Time& time = getInstance();
+    std::lock_guard<std::mutex> lck(time.m_mtxChange);
 
-    if (m_pInstance->m_Mode == MANUAL)
+    if (time.m_Mode == MANUAL)
       return;
 
-    m_pInstance->m_fElapsedTimeBeforeChangeTimeRatio = fTime;
+    double fScale = time.m_fScale.load(std::memory_order_relaxed);
+    time.setTimeBase(fTime - time.getRealSeconds()*fScale, fScale);
   }
 
 
   void Time::reset(Mode mode, double fTime)
   {
-    initialize();
+    Time& time = getInstance();
+    std::lock_guard<std::mutex> lck(time.m_mtxChange);
     
-    m_pInstance->resetLocal(mode, fTime);
+    time.resetLocal(mode, fTime);
   }
 
 
   Time::Time(double fRatio) 
-  : m_fTimeRatio(fRatio),
+  : m_RealStartCount(Clock::now()),
+    m_fTimeRatio(fRatio),
+    m_nVersion(0),
+    m_fOffset(0),
+    m_fScale(0),
+    m_fCurrentTimeRatio(0),
     m_Mode(AUTOMATIC)
   {
-    bool bResult = static_cast<bool>(QueryPerformanceCounter(&m_RealStartCount));
-    bResult &= static_cast<bool>(QueryPerformanceFrequency(&m_PerformanceFrequency));
-    if (!bResult)
-      throw std::runtime_error("High performance counter in not supported!");
+    if (!Clock::is_steady)
+      throw std::runtime_error("Monotonic clock is not supported!");
 
     resetLocal(AUTOMATIC, 0);
   }
 
 
-  void Time::initialize()
+  Time& Time::getInstance()
   {
-    if (!m_pInstance)
-      m_pInstance = Time::PtrType(new Time());
+    //the initialization of a local static is thread safe
+    static Time instance;
+    return instance;
   }
 
 
   void Time::resetLocal(Mode mode, double fTime)
   {
     m_Mode = mode;
-    m_fManualTime = 0;
-    m_fCurrentTimeRatio = m_fTimeRatio;
-    m_fElapsedTimeBeforeChangeTimeRatio = fTime;
+    m_fCurrentTimeRatio.store(m_fTimeRatio);
+    if (mode == MANUAL)
+      setTimeBase(fTime, 0);
+    else
+      setTimeBase(fTime - getRealSeconds()*m_fTimeRatio, m_fTimeRatio);
+  }
+
+
+  double Time::getSeconds(const Clock::duration& duration)
+  {
+    return std::chrono::duration_cast<std::chrono::duration<double> >(duration).count();
+  }
+
+
+  double Time::getRealSeconds() const
+  {
+    return getSeconds(Clock::now() - m_RealStartCount);
+  }
 
-    QueryPerformanceCounter(&m_StartCount);
+
+  double Time::calcTime(double fRealSeconds) const
+  {
+    unsigned int nVersion;
+    double fOffset;
+    double fScale;
+    do
+    {
+      nVersion = m_nVersion.load(std::memory_order_acquire);
+      fOffset = m_fOffset.load(std::memory_order_relaxed);
+      fScale = m_fScale.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    while ((nVersion & 1) || nVersion != m_nVersion.load(std::memory_order_relaxed));
+
+    return fOffset + fRealSeconds*fScale;
+  }
+
+
+  void Time::setTimeBase(double fOffset, double fScale)
+  {
+    //an odd version marks the change in progress
+    m_nVersion.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_fOffset.store(fOffset, std::memory_order_relaxed);
+    m_fScale.store(fScale, std::memory_order_relaxed);
+    m_nVersion.fetch_add(1, std::memory_order_release);
   }
 
 
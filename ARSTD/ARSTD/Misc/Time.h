@@ -4,12 +4,17 @@
 
 #pragma once
 
-#include <windows.h>
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
 
 namespace ARSTD
 {
 
+  /**
+   * Simulation and real time. All methods may be called from different threads, reading the time does not lock.
+   */
   class Time
   {
     public:
@@ -27,6 +32,12 @@ namespace ARSTD
       static double getTime();
       static double getRealTime();
 
+      /**
+       * Returns the processor time in seconds consumed by the calling thread so far. Unlike getRealTime() it does not
+       * advance while the thread is waiting or preempted. On windows the resolution is the scheduler tick.
+       */
+      static double getThreadTime();
+
       static void setTime(double fTime);
 
       static void step(double fDeltaTime);
@@ -36,19 +47,30 @@ namespace ARSTD
     protected:
       Time(double fRatio = 1.0);
 
-      static void initialize();
+      static Time& getInstance();
       void resetLocal(Mode mode, double fTime);
 
-      static PtrType m_pInstance;
-      LARGE_INTEGER m_StartCount;
-      LARGE_INTEGER m_RealStartCount;
-      LARGE_INTEGER m_PerformanceFrequency;
-      
+      //steady_clock is monotonic on every platform and is not affected by changes of the system time
+      typedef std::chrono::steady_clock Clock;
+
+      static double getSeconds(const Clock::duration& duration);
+
+      double getRealSeconds() const;
+
+      //the time is m_fOffset + getRealSeconds()*m_fScale, the scale is 0 in manual mode
+      double calcTime(double fRealSeconds) const;
+      void setTimeBase(double fOffset, double fScale);
+
+      const Clock::time_point m_RealStartCount;
+      const double m_fTimeRatio;
+
+      //serializes the changes, reading the time only retries while a change is in progress (seqlock)
+      std::mutex m_mtxChange;
+      std::atomic<unsigned int> m_nVersion;
+      std::atomic<double> m_fOffset;
+      std::atomic<double> m_fScale;
+      std::atomic<double> m_fCurrentTimeRatio;
       Mode m_Mode;
-      double m_fManualTime;
-      double m_fTimeRatio;
-      double m_fCurrentTimeRatio;
-      double m_fElapsedTimeBeforeChangeTimeRatio;
   };
 
 } //namespace ARSTD
\ No newline at end of file
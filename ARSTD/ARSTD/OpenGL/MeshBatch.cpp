@@ -0,0 +1,84 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+#include "OpenGLExtensions.h"
+#include "arstd/Math/Math.h"
+#include "MeshBatch.h"
+#include "MeshRenderer.h"
+
+namespace ARSTD
+{
+
+
+  MeshBatch::PtrType MeshBatch::create()
+  {
+    return PtrType(new MeshBatch());
+  }
+
+
+  MeshBatch::~MeshBatch()
+  {
+  }
+
+
+  void MeshBatch::add(const Mesh::PtrType pMesh, const Vector4F& vecColor)
+  {
+    Matrix44F matModelView;
+    glGetFloatv(GL_MODELVIEW_MATRIX, matModelView.pData);
+    add(pMesh, matModelView, vecColor);
+  }
+
+
+  void MeshBatch::add(const Mesh::PtrType pMesh, const Matrix44F& matTransform, const Vector4F& vecColor)
+  {
+    if (!pMesh)
+      return;
+
+    std::map<const Mesh*, size_t>::iterator it = m_EntryIndices.find(pMesh.get());
+    if (it == m_EntryIndices.end())
+    {
+      it = m_EntryIndices.insert(std::make_pair(pMesh.get(), m_Entries.size())).first;
+      m_Entries.push_back(Entry(pMesh, Mesh::InstanceContainer()));
+    }
+
+    Mesh::Instance instance;
+    instance.matTransform = matTransform;
+    instance.vecColor = vecColor;
+    m_Entries[it->second].second.push_back(instance);
+  }
+
+
+  void MeshBatch::render()
+  {
+    //the instance transforms already contain the model view matrix
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+      glLoadIdentity();
+      std::vector<Entry>::const_iterator it = m_Entries.begin();
+      for (; it != m_Entries.end(); ++it)
+        MeshRenderer::renderInstances(*it->first, it->second);
+    glPopMatrix();
+
+    clear();
+  }
+
+
+  void MeshBatch::clear()
+  {
+    m_Entries.clear();
+    m_EntryIndices.clear();
+  }
+
+
+  bool MeshBatch::isEmpty() const
+  {
+    return m_Entries.empty();
+  }
+
+
+  MeshBatch::MeshBatch()
+  {
+  }
+
+
+} // namespace ARSTD
\ No newline at end of file
@@ -0,0 +1,54 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+#pragma once
+
+#include <vector>
+#include <map>
+#include "arstd/Geometry/Mesh.h"
+
+namespace ARSTD
+{
+
+  /**
+   * Collects the meshes of a frame and draws all instances of the same mesh with one call of
+   * MeshRenderer::renderInstances(). A mesh is added with the current model view matrix where it would otherwise
+   * be rendered or with an explicit transform. The meshes are drawn in the order they were first added, the caller
+   * sets up the material before rendering the batch.
+   */
+  class MeshBatch
+  {
+    public:
+      typedef std::shared_ptr<MeshBatch> PtrType;
+
+      static PtrType create();
+
+      ~MeshBatch();
+
+      void add(const Mesh::PtrType pMesh, const Vector4F& vecColor);
+
+      /**
+       * Adds the mesh with the given transform instead of the current model view matrix.
+       */
+      void add(const Mesh::PtrType pMesh, const Matrix44F& matTransform, const Vector4F& vecColor);
+
+      /**
+       * Draws all added meshes and removes them from the batch.
+       */
+      void render();
+
+      void clear();
+
+      bool isEmpty() const;
+
+    protected:
+      typedef std::pair<Mesh::PtrType, Mesh::InstanceContainer> Entry;
+
+      MeshBatch();
+
+      std::vector<Entry> m_Entries;
+      std::map<const Mesh*, size_t> m_EntryIndices;
+  };
+
+
+} // namespace ARSTD
\ No newline at end of file
@@ -0,0 +1,271 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+#include "OpenGLExtensions.h"
+#include "MeshRenderer.h"
+#include <cstddef>
+
+namespace ARSTD
+{
+
+  namespace
+  {
+    //lights like the fixed function pipeline with light 0 and the color as ambient and diffuse material or uses the
+    //color unlit. the instance transform is a rotation with scaling, dividing the normal by the squared scale gives its
+    //inverse transpose
+    const char* INSTANCING_VERTEX_SHADER =
+      "#version 120\n"
+      "attribute mat4 instanceTransform;\n"
+      "attribute vec4 instanceColor;\n"
+      "uniform bool bLighting;\n"
+      "void main()\n"
+      "{\n"
+      "  vec4 vecPosition = gl_ModelViewMatrix*(instanceTransform*gl_Vertex);\n"
+      "  gl_Position = gl_ProjectionMatrix*vecPosition;\n"
+      "  if (!bLighting)\n"
+      "  {\n"
+      "    gl_FrontColor = instanceColor;\n"
+      "    return;\n"
+      "  }\n"
+      "  mat3 matRotationScale = mat3(instanceTransform);\n"
+      "  vec3 vecScale2 = vec3(dot(matRotationScale[0], matRotationScale[0]), dot(matRotationScale[1], matRotationScale[1]),\n"
+      "                        dot(matRotationScale[2], matRotationScale[2]));\n"
+      "  vec3 vecNormal = normalize(gl_NormalMatrix*(matRotationScale*(gl_Normal/vecScale2)));\n"
+      "  vec4 vecLight = gl_LightSource[0].position;\n"
+      "  vec3 vecLightDir = normalize(vecLight.w == 0.0 ? vecLight.xyz : vecLight.xyz - vecPosition.xyz);\n"
+      "  float fDiffuse = max(dot(vecNormal, vecLightDir), 0.0);\n"
+      "  vec3 vecColor = gl_FrontMaterial.emission.rgb +\n"
+      "                  instanceColor.rgb*(gl_LightModel.ambient.rgb + gl_LightSource[0].ambient.rgb +\n"
+      "                                     gl_LightSource[0].diffuse.rgb*fDiffuse);\n"
+      "  gl_FrontColor = vec4(vecColor, instanceColor.a);\n"
+      "}\n";
+
+
+    //shared by all meshes, created with the first instanced draw call
+    struct InstancingProgram
+    {
+      InstancingProgram()
+      : bInitialized(false),
+        nProgram(0),
+        nTransformLocation(-1),
+        nColorLocation(-1),
+        nLightingLocation(-1),
+        nInstanceBuffer(0)
+      {
+      }
+
+      bool isValid() const
+      {
+        return nProgram && nTransformLocation >= 0 && nColorLocation >= 0 && nLightingLocation >= 0 && nInstanceBuffer;
+      }
+
+      bool bInitialized;
+      GLuint nProgram;
+      GLint nTransformLocation;
+      GLint nColorLocation;
+      GLint nLightingLocation;
+      GLuint nInstanceBuffer;
+    };
+
+
+    const InstancingProgram& getInstancingProgram()
+    {
+      static InstancingProgram program;
+      if (program.bInitialized)
+        return program;
+      program.bInitialized = true;
+
+      GLuint nShader = OpenGLExtensions::createShader(GL_VERTEX_SHADER);
+      OpenGLExtensions::shaderSource(nShader, 1, &INSTANCING_VERTEX_SHADER, NULL);
+      OpenGLExtensions::compileShader(nShader);
+      GLint nCompiled = 0;
+      OpenGLExtensions::getShaderiv(nShader, GL_COMPILE_STATUS, &nCompiled);
+
+      GLint nLinked = 0;
+      if (nCompiled)
+      {
+        program.nProgram = OpenGLExtensions::createProgram();
+        OpenGLExtensions::attachShader(program.nProgram, nShader);
+        OpenGLExtensions::linkProgram(program.nProgram);
+        OpenGLExtensions::getProgramiv(program.nProgram, GL_LINK_STATUS, &nLinked);
+      }
+      //the program keeps the attached shader
+      OpenGLExtensions::deleteShader(nShader);
+
+      if (!nLinked)
+      {
+        if (program.nProgram)
+          OpenGLExtensions::deleteProgram(program.nProgram);
+        program.nProgram = 0;
+        return program;
+      }
+
+      program.nTransformLocation = OpenGLExtensions::getAttribLocation(program.nProgram, "instanceTransform");
+      program.nColorLocation = OpenGLExtensions::getAttribLocation(program.nProgram, "instanceColor");
+      program.nLightingLocation = OpenGLExtensions::getUniformLocation(program.nProgram, "bLighting");
+      OpenGLExtensions::genBuffers(1, &program.nInstanceBuffer);
+      return program;
+    }
+
+
+    void setInstanceAttribute(GLuint nLocation, GLint nSize, size_t nOffset, GLuint nDivisor)
+    {
+      OpenGLExtensions::enableVertexAttribArray(nLocation);
+      OpenGLExtensions::vertexAttribPointer(nLocation, nSize, GL_FLOAT, GL_FALSE, sizeof(Mesh::Instance),
+                                            reinterpret_cast<const GLvoid*>(nOffset));
+      OpenGLExtensions::vertexAttribDivisor(nLocation, nDivisor);
+    }
+
+
+    //buffer objects of one mesh, kept as its render data
+    struct MeshBuffers
+    {
+      MeshBuffers()
+      : nVertexBuffer(0),
+        nIndexBuffer(0)
+      {
+      }
+
+      ~MeshBuffers()
+      {
+        //the mesh may be changed or destroyed without a current context, so the buffers are deleted with the next upload
+        OpenGLExtensions::releaseBuffer(nVertexBuffer);
+        OpenGLExtensions::releaseBuffer(nIndexBuffer);
+      }
+
+      GLuint nVertexBuffer;
+      GLuint nIndexBuffer;
+    };
+  }
+
+
+  void MeshRenderer::render(const Mesh& mesh, int nNumerator, int nDenominator)
+  {
+    assert(nNumerator > 0 && nDenominator > 0 && nNumerator <= nDenominator);
+
+    if (mesh.m_Triangles.empty())
+      return;
+
+    glPushAttrib(GL_ENABLE_BIT | GL_POLYGON_BIT | GL_LIGHTING_BIT);
+
+    const char* pIndices = bindArrays(mesh);
+
+    int nTrisToDrawAtOnce = static_cast<int>(mesh.m_Triangles.size())/nDenominator;
+    glDrawElements(GL_TRIANGLES, nTrisToDrawAtOnce*3, GL_UNSIGNED_INT, pIndices + (nNumerator - 1)*nTrisToDrawAtOnce*sizeof(Mesh::Triangle));
+    
+    unbindArrays();
+
+    glPopAttrib();
+  }
+
+
+  void MeshRenderer::renderInstances(const Mesh& mesh, const Mesh::InstanceContainer& instances)
+  {
+    if (mesh.m_Triangles.empty() || instances.empty())
+      return;
+
+    glPushAttrib(GL_ENABLE_BIT | GL_POLYGON_BIT | GL_LIGHTING_BIT | GL_CURRENT_BIT);
+
+    const char* pIndices = bindArrays(mesh);
+    GLsizei nNumIndices = static_cast<GLsizei>(mesh.m_Triangles.size()*3);
+
+    if (OpenGLExtensions::hasInstancing() && getInstancingProgram().isValid())
+    {
+      const InstancingProgram& program = getInstancingProgram();
+      OpenGLExtensions::bindBuffer(GL_ARRAY_BUFFER, program.nInstanceBuffer);
+      OpenGLExtensions::bufferData(GL_ARRAY_BUFFER, instances.size()*sizeof(Mesh::Instance), &instances.front(), GL_STREAM_DRAW);
+
+      //a matrix attribute takes one location per column
+      for (GLuint nColumn = 0; nColumn < 4; ++nColumn)
+        setInstanceAttribute(program.nTransformLocation + nColumn, 4, offsetof(Mesh::Instance, matTransform) + nColumn*4*sizeof(float), 1);
+      setInstanceAttribute(program.nColorLocation, 4, offsetof(Mesh::Instance, vecColor), 1);
+
+      OpenGLExtensions::useProgram(program.nProgram);
+      OpenGLExtensions::uniform1i(program.nLightingLocation, glIsEnabled(GL_LIGHTING));
+      OpenGLExtensions::drawElementsInstanced(GL_TRIANGLES, nNumIndices, GL_UNSIGNED_INT, pIndices,
+                                              static_cast<GLsizei>(instances.size()));
+      OpenGLExtensions::useProgram(0);
+
+      for (GLuint nLocation = program.nTransformLocation; nLocation < program.nTransformLocation + 4u; ++nLocation)
+      {
+        OpenGLExtensions::vertexAttribDivisor(nLocation, 0);
+        OpenGLExtensions::disableVertexAttribArray(nLocation);
+      }
+      OpenGLExtensions::vertexAttribDivisor(program.nColorLocation, 0);
+      OpenGLExtensions::disableVertexAttribArray(program.nColorLocation);
+    }
+    else
+    {
+      glEnable(GL_NORMALIZE);
+      Mesh::InstanceContainer::const_iterator it = instances.begin();
+      for (; it != instances.end(); ++it)
+      {
+        glPushMatrix();
+          glMultMatrixf(it->matTransform.pData);
+          glColor4fv(it->vecColor.pData);
+          glDrawElements(GL_TRIANGLES, nNumIndices, GL_UNSIGNED_INT, pIndices);
+        glPopMatrix();
+      }
+    }
+
+    unbindArrays();
+
+    glPopAttrib();
+  }
+
+
+  const char* MeshRenderer::bindArrays(const Mesh& mesh)
+  {
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glEnableClientState(GL_VERTEX_ARRAY);
+
+    if (!OpenGLExtensions::hasBufferObjects())
+    {
+      glNormalPointer(GL_FLOAT, 0, &mesh.m_Normals.front());
+      glVertexPointer(3, GL_FLOAT, 0, &mesh.m_Vertices.front());
+      return reinterpret_cast<const char*>(&mesh.m_Triangles.front());
+    }
+
+    GLsizeiptr nVerticesSize = mesh.m_Vertices.size()*sizeof(Vector3F);
+    std::shared_ptr<MeshBuffers> pBuffers = std::static_pointer_cast<MeshBuffers>(mesh.m_pRenderData);
+    if (!pBuffers)
+    {
+      OpenGLExtensions::deleteReleasedBuffers();
+      pBuffers = std::make_shared<MeshBuffers>();
+      mesh.m_pRenderData = pBuffers;
+
+      //vertices and normals one after another in one buffer
+      OpenGLExtensions::genBuffers(1, &pBuffers->nVertexBuffer);
+      OpenGLExtensions::bindBuffer(GL_ARRAY_BUFFER, pBuffers->nVertexBuffer);
+      OpenGLExtensions::bufferData(GL_ARRAY_BUFFER, nVerticesSize*2, NULL, GL_STATIC_DRAW);
+      OpenGLExtensions::bufferSubData(GL_ARRAY_BUFFER, 0, nVerticesSize, &mesh.m_Vertices.front());
+      OpenGLExtensions::bufferSubData(GL_ARRAY_BUFFER, nVerticesSize, nVerticesSize, &mesh.m_Normals.front());
+
+      OpenGLExtensions::genBuffers(1, &pBuffers->nIndexBuffer);
+      OpenGLExtensions::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, pBuffers->nIndexBuffer);
+      OpenGLExtensions::bufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.m_Triangles.size()*sizeof(Mesh::Triangle), &mesh.m_Triangles.front(), 
+                                   GL_STATIC_DRAW);
+    }
+
+    OpenGLExtensions::bindBuffer(GL_ARRAY_BUFFER, pBuffers->nVertexBuffer);
+    OpenGLExtensions::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, pBuffers->nIndexBuffer);
+    glNormalPointer(GL_FLOAT, 0, reinterpret_cast<const GLvoid*>(nVerticesSize));
+    glVertexPointer(3, GL_FLOAT, 0, NULL);
+    //the indices start at the beginning of the bound buffer
+    return NULL;
+  }
+
+
+  void MeshRenderer::unbindArrays()
+  {
+    if (OpenGLExtensions::hasBufferObjects())
+    {
+      OpenGLExtensions::bindBuffer(GL_ARRAY_BUFFER, 0);
+      OpenGLExtensions::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+  }
+
+}
\ No newline at end of file
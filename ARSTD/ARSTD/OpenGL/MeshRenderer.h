@@ -0,0 +1,37 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+#pragma once
+
+#include "arstd/Geometry/Mesh.h"
+
+namespace ARSTD
+{
+
+  /**
+   * Draws meshes with opengl. The meshes themselves only hold the geometry, the buffer objects are kept as render
+   * data of the mesh and released with it.
+   */
+  class MeshRenderer
+  {
+    public:
+      /**
+       * Draws the mesh with the current color. The vertices are uploaded into buffer objects with the first call, so
+       * drawing again only submits the draw call. Without buffer objects client side arrays are used.
+       */
+      static void render(const Mesh& mesh, int nNumerator = 1, int nDenominator = 1);
+
+      /**
+       * Draws the mesh once for each instance with its transform and color. All instances are drawn with a single
+       * instanced draw call if the context supports it, otherwise with one draw call each.
+       */
+      static void renderInstances(const Mesh& mesh, const Mesh::InstanceContainer& instances);
+
+    protected:
+      //binds vertices and normals and returns the pointer or offset of the indices
+      static const char* bindArrays(const Mesh& mesh);
+      static void unbindArrays();
+  };
+
+
+} // namespace ARSTD
\ No newline at end of file
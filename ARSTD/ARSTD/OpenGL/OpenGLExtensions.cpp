@@ -0,0 +1,211 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+#include "OpenGLExtensions.h"
+
+#ifndef _WIN32
+#include <GL/glx.h>
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace ARSTD
+{
+
+  namespace
+  {
+    template <typename Function>
+    void resolve(Function& function, const char* pName)
+    {
+#ifdef _WIN32
+      function = reinterpret_cast<Function>(wglGetProcAddress(pName));
+#else
+      function = reinterpret_cast<Function>(glXGetProcAddress(reinterpret_cast<const GLubyte*>(pName)));
+#endif
+    }
+
+
+    const void* getCurrentContext()
+    {
+#ifdef _WIN32
+      return wglGetCurrentContext();
+#else
+      return glXGetCurrentContext();
+#endif
+    }
+
+
+    bool isVersionAtLeast(int nMajor, int nMinor)
+    {
+      const char* pVersion = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+      int nCurrentMajor = 0;
+      int nCurrentMinor = 0;
+      if (!pVersion || sscanf(pVersion, "%d.%d", &nCurrentMajor, &nCurrentMinor) != 2)
+        return false;
+      return nCurrentMajor > nMajor || (nCurrentMajor == nMajor && nCurrentMinor >= nMinor);
+    }
+
+
+    std::mutex& getReleasedBuffersMutex()
+    {
+      static std::mutex mtx;
+      return mtx;
+    }
+
+
+    std::vector<GLuint>& getReleasedBuffers()
+    {
+      static std::vector<GLuint> buffers;
+      return buffers;
+    }
+  }
+
+
+  OpenGLExtensions::GenBuffersFunction OpenGLExtensions::genBuffers = NULL;
+  OpenGLExtensions::DeleteBuffersFunction OpenGLExtensions::deleteBuffers = NULL;
+  OpenGLExtensions::BindBufferFunction OpenGLExtensions::bindBuffer = NULL;
+  OpenGLExtensions::BufferDataFunction OpenGLExtensions::bufferData = NULL;
+  OpenGLExtensions::BufferSubDataFunction OpenGLExtensions::bufferSubData = NULL;
+  OpenGLExtensions::IsBufferFunction OpenGLExtensions::isBuffer = NULL;
+
+  OpenGLExtensions::CreateShaderFunction OpenGLExtensions::createShader = NULL;
+  OpenGLExtensions::DeleteShaderFunction OpenGLExtensions::deleteShader = NULL;
+  OpenGLExtensions::ShaderSourceFunction OpenGLExtensions::shaderSource = NULL;
+  OpenGLExtensions::CompileShaderFunction OpenGLExtensions::compileShader = NULL;
+  OpenGLExtensions::GetShaderivFunction OpenGLExtensions::getShaderiv = NULL;
+  OpenGLExtensions::CreateProgramFunction OpenGLExtensions::createProgram = NULL;
+  OpenGLExtensions::DeleteProgramFunction OpenGLExtensions::deleteProgram = NULL;
+  OpenGLExtensions::AttachShaderFunction OpenGLExtensions::attachShader = NULL;
+  OpenGLExtensions::LinkProgramFunction OpenGLExtensions::linkProgram = NULL;
+  OpenGLExtensions::GetProgramivFunction OpenGLExtensions::getProgramiv = NULL;
+  OpenGLExtensions::UseProgramFunction OpenGLExtensions::useProgram = NULL;
+  OpenGLExtensions::GetAttribLocationFunction OpenGLExtensions::getAttribLocation = NULL;
+  OpenGLExtensions::GetUniformLocationFunction OpenGLExtensions::getUniformLocation = NULL;
+  OpenGLExtensions::Uniform1iFunction OpenGLExtensions::uniform1i = NULL;
+  OpenGLExtensions::EnableVertexAttribArrayFunction OpenGLExtensions::enableVertexAttribArray = NULL;
+  OpenGLExtensions::DisableVertexAttribArrayFunction OpenGLExtensions::disableVertexAttribArray = NULL;
+  OpenGLExtensions::VertexAttribPointerFunction OpenGLExtensions::vertexAttribPointer = NULL;
+
+  OpenGLExtensions::DrawElementsInstancedFunction OpenGLExtensions::drawElementsInstanced = NULL;
+  OpenGLExtensions::VertexAttribDivisorFunction OpenGLExtensions::vertexAttribDivisor = NULL;
+
+  bool OpenGLExtensions::m_bInitialized = false;
+  bool OpenGLExtensions::m_bBufferObjects = false;
+  bool OpenGLExtensions::m_bInstancing = false;
+  GLuint OpenGLExtensions::m_nProbeBuffer = 0;
+  const void* OpenGLExtensions::m_pLastContext = NULL;
+  std::vector<const void*> OpenGLExtensions::m_SharingContexts;
+
+
+  bool OpenGLExtensions::hasBufferObjects()
+  {
+    initialize();
+    checkContext();
+    return m_bBufferObjects;
+  }
+
+
+  bool OpenGLExtensions::hasInstancing()
+  {
+    initialize();
+    checkContext();
+    return m_bInstancing;
+  }
+
+
+  void OpenGLExtensions::releaseBuffer(GLuint nBuffer)
+  {
+    if (!nBuffer)
+      return;
+
+    std::lock_guard<std::mutex> lck(getReleasedBuffersMutex());
+    getReleasedBuffers().push_back(nBuffer);
+  }
+
+
+  void OpenGLExtensions::deleteReleasedBuffers()
+  {
+    std::vector<GLuint> buffers;
+    {
+      std::lock_guard<std::mutex> lck(getReleasedBuffersMutex());
+      buffers.swap(getReleasedBuffers());
+    }
+    if (!buffers.empty() && deleteBuffers)
+      deleteBuffers(static_cast<GLsizei>(buffers.size()), &buffers.front());
+  }
+
+
+  void OpenGLExtensions::initialize()
+  {
+    if (m_bInitialized)
+      return;
+    m_bInitialized = true;
+
+    resolve(genBuffers, "glGenBuffers");
+    resolve(deleteBuffers, "glDeleteBuffers");
+    resolve(bindBuffer, "glBindBuffer");
+    resolve(bufferData, "glBufferData");
+    resolve(bufferSubData, "glBufferSubData");
+    resolve(isBuffer, "glIsBuffer");
+    m_bBufferObjects = isVersionAtLeast(1, 5) && genBuffers && deleteBuffers && bindBuffer && bufferData && bufferSubData && isBuffer;
+
+    resolve(createShader, "glCreateShader");
+    resolve(deleteShader, "glDeleteShader");
+    resolve(shaderSource, "glShaderSource");
+    resolve(compileShader, "glCompileShader");
+    resolve(getShaderiv, "glGetShaderiv");
+    resolve(createProgram, "glCreateProgram");
+    resolve(deleteProgram, "glDeleteProgram");
+    resolve(attachShader, "glAttachShader");
+    resolve(linkProgram, "glLinkProgram");
+    resolve(getProgramiv, "glGetProgramiv");
+    resolve(useProgram, "glUseProgram");
+    resolve(getAttribLocation, "glGetAttribLocation");
+    resolve(getUniformLocation, "glGetUniformLocation");
+    resolve(uniform1i, "glUniform1i");
+    resolve(enableVertexAttribArray, "glEnableVertexAttribArray");
+    resolve(disableVertexAttribArray, "glDisableVertexAttribArray");
+    resolve(vertexAttribPointer, "glVertexAttribPointer");
+    resolve(drawElementsInstanced, "glDrawElementsInstanced");
+    resolve(vertexAttribDivisor, "glVertexAttribDivisor");
+    m_bInstancing = m_bBufferObjects && isVersionAtLeast(3, 3) &&
+                    createShader && deleteShader && shaderSource && compileShader && getShaderiv &&
+                    createProgram && deleteProgram && attachShader && linkProgram && getProgramiv && useProgram &&
+                    getAttribLocation && getUniformLocation && uniform1i && enableVertexAttribArray && disableVertexAttribArray && vertexAttribPointer &&
+                    drawElementsInstanced && vertexAttribDivisor;
+
+    m_pLastContext = getCurrentContext();
+    m_SharingContexts.push_back(m_pLastContext);
+    if (m_bBufferObjects)
+    {
+      //a buffer name is only known by other contexts after it has been bound once
+      GLint nBoundBuffer = 0;
+      glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &nBoundBuffer);
+      genBuffers(1, &m_nProbeBuffer);
+      bindBuffer(GL_ARRAY_BUFFER, m_nProbeBuffer);
+      bindBuffer(GL_ARRAY_BUFFER, nBoundBuffer);
+    }
+  }
+
+
+  void OpenGLExtensions::checkContext()
+  {
+    const void* pContext = getCurrentContext();
+    if (pContext == m_pLastContext)
+      return;
+
+    if (std::find(m_SharingContexts.begin(), m_SharingContexts.end(), pContext) == m_SharingContexts.end())
+    {
+      if (m_nProbeBuffer && !isBuffer(m_nProbeBuffer))
+        throw std::runtime_error("opengl context does not share its objects with the first context");
+      m_SharingContexts.push_back(pContext);
+    }
+    m_pLastContext = pContext;
+  }
+
+
+} // namespace ARSTD
\ No newline at end of file
@@ -0,0 +1,143 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+#pragma once
+
+#ifdef _WIN32
+#include "windows.h"
+#include "gl/gl.h"
+#else
+#include <GL/gl.h>
+#endif
+
+#include <cstddef>
+#include <vector>
+
+
+//the headers of windows only declare opengl 1.1
+#ifndef GL_VERSION_1_5
+typedef ptrdiff_t GLsizeiptr;
+typedef ptrdiff_t GLintptr;
+#define GL_ARRAY_BUFFER                   0x8892
+#define GL_ELEMENT_ARRAY_BUFFER           0x8893
+#define GL_ARRAY_BUFFER_BINDING           0x8894
+#define GL_STREAM_DRAW                    0x88E0
+#define GL_STATIC_DRAW                    0x88E4
+#endif
+
+#ifndef GL_VERSION_2_0
+typedef char GLchar;
+#define GL_VERTEX_SHADER                  0x8B31
+#define GL_COMPILE_STATUS                 0x8B81
+#define GL_LINK_STATUS                    0x8B82
+#endif
+
+
+namespace ARSTD
+{
+
+  /**
+   * Resolves the opengl functions beyond version 1.1 that are needed for buffer objects and instanced drawing. They
+   * are looked up once with the first current context. The functions and the objects created with them (buffers of
+   * meshes, shaders) are only valid in contexts that share their objects with the first one. Therefore every other
+   * context is checked once for a probe buffer of the first context, and hasBufferObjects() and hasInstancing()
+   * throw a std::runtime_error in a context that does not share.
+   */
+  class OpenGLExtensions
+  {
+    public:
+      typedef void (APIENTRY *GenBuffersFunction)(GLsizei n, GLuint* pBuffers);
+      typedef void (APIENTRY *DeleteBuffersFunction)(GLsizei n, const GLuint* pBuffers);
+      typedef void (APIENTRY *BindBufferFunction)(GLenum target, GLuint nBuffer);
+      typedef void (APIENTRY *BufferDataFunction)(GLenum target, GLsizeiptr nSize, const GLvoid* pData, GLenum usage);
+      typedef void (APIENTRY *BufferSubDataFunction)(GLenum target, GLintptr nOffset, GLsizeiptr nSize, const GLvoid* pData);
+      typedef GLboolean (APIENTRY *IsBufferFunction)(GLuint nBuffer);
+
+      typedef GLuint (APIENTRY *CreateShaderFunction)(GLenum type);
+      typedef void (APIENTRY *DeleteShaderFunction)(GLuint nShader);
+      typedef void (APIENTRY *ShaderSourceFunction)(GLuint nShader, GLsizei nCount, const GLchar* const* pStrings, const GLint* pLengths);
+      typedef void (APIENTRY *CompileShaderFunction)(GLuint nShader);
+      typedef void (APIENTRY *GetShaderivFunction)(GLuint nShader, GLenum name, GLint* pParam);
+      typedef GLuint (APIENTRY *CreateProgramFunction)();
+      typedef void (APIENTRY *DeleteProgramFunction)(GLuint nProgram);
+      typedef void (APIENTRY *AttachShaderFunction)(GLuint nProgram, GLuint nShader);
+      typedef void (APIENTRY *LinkProgramFunction)(GLuint nProgram);
+      typedef void (APIENTRY *GetProgramivFunction)(GLuint nProgram, GLenum name, GLint* pParam);
+      typedef void (APIENTRY *UseProgramFunction)(GLuint nProgram);
+      typedef GLint (APIENTRY *GetAttribLocationFunction)(GLuint nProgram, const GLchar* pName);
+      typedef GLint (APIENTRY *GetUniformLocationFunction)(GLuint nProgram, const GLchar* pName);
+      typedef void (APIENTRY *Uniform1iFunction)(GLint nLocation, GLint nValue);
+      typedef void (APIENTRY *EnableVertexAttribArrayFunction)(GLuint nIndex);
+      typedef void (APIENTRY *DisableVertexAttribArrayFunction)(GLuint nIndex);
+      typedef void (APIENTRY *VertexAttribPointerFunction)(GLuint nIndex, GLint nSize, GLenum type, GLboolean bNormalized,
+                                                          GLsizei nStride, const GLvoid* pPointer);
+
+      typedef void (APIENTRY *DrawElementsInstancedFunction)(GLenum mode, GLsizei nCount, GLenum type, const GLvoid* pIndices,
+                                                            GLsizei nInstances);
+      typedef void (APIENTRY *VertexAttribDivisorFunction)(GLuint nIndex, GLuint nDivisor);
+
+      /**
+       * @return True if the context supports buffer objects (opengl 1.5). Must be called with a current context.
+       */
+      static bool hasBufferObjects();
+
+      /**
+       * @return True if the context supports shaders and instanced vertex attributes (opengl 3.3). Must be called with
+       *         a current context.
+       */
+      static bool hasInstancing();
+
+      /**
+       * Deletes the buffer with the next call of deleteReleasedBuffers(). May be called from any thread, for example
+       * by the destructor of a mesh that is destroyed without a current context.
+       */
+      static void releaseBuffer(GLuint nBuffer);
+
+      /**
+       * Deletes the buffers given to releaseBuffer(). Must be called with a current context.
+       */
+      static void deleteReleasedBuffers();
+
+      static GenBuffersFunction genBuffers;
+      static DeleteBuffersFunction deleteBuffers;
+      static BindBufferFunction bindBuffer;
+      static BufferDataFunction bufferData;
+      static BufferSubDataFunction bufferSubData;
+      static IsBufferFunction isBuffer;
+
+      static CreateShaderFunction createShader;
+      static DeleteShaderFunction deleteShader;
+      static ShaderSourceFunction shaderSource;
+      static CompileShaderFunction compileShader;
+      static GetShaderivFunction getShaderiv;
+      static CreateProgramFunction createProgram;
+      static DeleteProgramFunction deleteProgram;
+      static AttachShaderFunction attachShader;
+      static LinkProgramFunction linkProgram;
+      static GetProgramivFunction getProgramiv;
+      static UseProgramFunction useProgram;
+      static GetAttribLocationFunction getAttribLocation;
+      static GetUniformLocationFunction getUniformLocation;
+      static Uniform1iFunction uniform1i;
+      static EnableVertexAttribArrayFunction enableVertexAttribArray;
+      static DisableVertexAttribArrayFunction disableVertexAttribArray;
+      static VertexAttribPointerFunction vertexAttribPointer;
+
+      static DrawElementsInstancedFunction drawElementsInstanced;
+      static VertexAttribDivisorFunction vertexAttribDivisor;
+
+    protected:
+      static void initialize();
+      static void checkContext();
+
+      static bool m_bInitialized;
+      static bool m_bBufferObjects;
+      static bool m_bInstancing;
+      //bound once in the first context, so it is known by the contexts sharing with it
+      static GLuint m_nProbeBuffer;
+      static const void* m_pLastContext;
+      static std::vector<const void*> m_SharingContexts;
+  };
+
+
+} // namespace ARSTD
\ No newline at end of file
@@ -1,8 +1,12 @@
 // Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
 // Released under the MIT license. (see license.txt)
 
+#ifdef _WIN32
 #include "windows.h"
 #include "gl/gl.h"
+#else
+#include <GL/gl.h>
+#endif
 #include "arstd/Math/Math.h"
 #include "arstd/Common/Size3.h"
 #include "OpenGLTools.h"
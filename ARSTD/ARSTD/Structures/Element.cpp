@@ -13,7 +13,8 @@ namespace ARSTD
 
   Element::Element(const std::string& strName)
   : m_strName(strName),
-    m_pParent(NULL)
+    m_pParent(NULL),
+    m_nChildIndex(-1)
   {
   }
 
@@ -69,6 +70,7 @@ namespace ARSTD
   void Element::resetParent()
   {
     m_pParent = NULL;
+    m_nChildIndex = -1;
   }
 
 
@@ -8,6 +8,8 @@
 namespace ARSTD 
 {
 
+  class Node;
+
   class Element
   {
     public:
@@ -28,10 +30,14 @@ namespace ARSTD
       static PtrType findElement(PtrType pElement, const std::string& strName);
 
     protected:
+      friend class Node;
+
       Element(const std::string& strName = "noname");
 
       std::string m_strName;
       Element* m_pParent;
+      //position in the child container of the parent, -1 if the element is not attached
+      int m_nChildIndex;
   };
 
 } //namespace ARSTD
\ No newline at end of file
@@ -3,14 +3,22 @@
 
 
 #include <cassert>
+#include <atomic>
 #include "Node.h"
-#include <iostream>
 
 namespace ARSTD 
 {
 
+  namespace
+  {
+    std::atomic<unsigned long long> nLastVersion(0);
+  }
+
+
   Node::Node(const std::string& strName)
-  : Element(strName)
+  : Element(strName),
+    m_nModifications(Nothing),
+    m_nVersion(0)
   {
   }
 
@@ -25,14 +33,16 @@ namespace ARSTD
     if (!pElement)
       return false;
 
-    bool bResult = m_ChildContainer.insert(pElement).second;
+    //an element can only be a child of one node
+    bool bResult = !pElement->getParent();
     if (bResult)
     {
       pElement->setParent(this);
+      pElement->m_nChildIndex = static_cast<int>(m_ChildContainer.size());
+      m_ChildContainer.push_back(pElement);
       m_nModifications |= ChildAdded;
+      updateVersion();
     }
-    else std::cerr << "Node::attach(): could not attach element " << pElement->getName() << " onto element " << getName() << "\n";
-
     return bResult;
   }
 
@@ -48,17 +58,20 @@ namespace ARSTD
     {
       Node* pNode = dynamic_cast<Node*>(pParent);
       assert(pNode && "the parent of this element must be a node");
-      bResult = pNode->m_ChildContainer.erase(pElement) != 0;
+      int nIndex = pElement->m_nChildIndex;
+      bResult = nIndex >= 0 && nIndex < static_cast<int>(pNode->m_ChildContainer.size()) &&
+                pNode->m_ChildContainer[nIndex] == pElement;
       if (bResult)
       {
+        //the following childs keep their order
+        pNode->m_ChildContainer.erase(pNode->m_ChildContainer.begin() + nIndex);
+        for (int nChild = nIndex; nChild < static_cast<int>(pNode->m_ChildContainer.size()); ++nChild)
+          pNode->m_ChildContainer[nChild]->m_nChildIndex = nChild;
         pElement->resetParent();
         m_nModifications |= ChildRemoved;
+        pNode->updateVersion();
       }
     }
-    
-    if (!bResult)
-      std::cerr << "Node::detach(): could not detach element " << pElement->getName() << " from element " << getName() << "\n";
-
     return bResult;
   }
 
@@ -75,6 +88,13 @@ namespace ARSTD
   }
 
 
+  Element::PtrType Node::getChild(int nIndex) const
+  {
+    assert(nIndex >= 0 && nIndex < static_cast<int>(m_ChildContainer.size()));
+    return m_ChildContainer[nIndex];
+  }
+
+
   void Node::rename(const std::string& strOldName, const std::string& strNewName, bool bReplaceSubstrings)
   {
     if (strOldName == strNewName)
@@ -116,6 +136,20 @@ namespace ARSTD
   }
 
 
+  unsigned long long Node::getVersion() const
+  {
+    return m_nVersion;
+  }
+
+
+  void Node::updateVersion()
+  {
+    unsigned long long nVersion = ++nLastVersion;
+    for (Node* pNode = this; pNode; pNode = dynamic_cast<Node*>(pNode->getParent()))
+      pNode->m_nVersion = nVersion;
+  }
+
+
   Node::ChildRange Node::getChildRange()
   {
     return std::make_pair(m_ChildContainer.begin(), m_ChildContainer.end());
@@ -6,7 +6,7 @@
 #pragma warning (disable : 4786)
 
 #include <string>
-#include <set>
+#include <vector>
 
 #include <memory>
 
@@ -17,14 +17,16 @@ namespace ARSTD
 {
 
   /**
-   * This class is a specialized object in a tree that can have childs.
+   * This class is a specialized object in a tree that can have childs. The childs are stored contiguously in the order
+   * they were attached, detaching a child keeps the order of the others. Attaching and detaching invalidate the
+   * iterators of the child range, so loops that may change the childs must iterate over a copy of them.
    */
   class Node : public Element
   {
     public:
       typedef std::shared_ptr<Node> PtrType;
 
-      typedef std::set<Element::PtrType> ChildContainer;
+      typedef std::vector<Element::PtrType> ChildContainer;
       typedef ChildContainer::iterator ChildIterator;
       typedef ChildContainer::const_iterator ChildConstIterator;
       typedef std::pair<ChildIterator, ChildIterator> ChildRange;
@@ -39,7 +41,17 @@ namespace ARSTD
 
       virtual ~Node();
 
+      /**
+       * Appends the element to the childs of this node.
+       * @return False if the element is null or already attached to a node (also this one). An element must be
+       *         detached from its parent before it can be attached to another node.
+       */
       bool attach(Element::PtrType pElement);
+
+      /**
+       * Removes the element from the childs of its parent, which need not be this node.
+       * @return False if the element is null or not attached.
+       */
       bool detach(Element::PtrType pElement);
 
       bool hasChilds() const;
@@ -47,21 +59,32 @@ namespace ARSTD
       template <class Type>
       int getChildNumber() const;
       int getTotalChildNumber() const;
+      Element::PtrType getChild(int nIndex) const;
       
       virtual void rename(const std::string& strOldName, const std::string& strNewName, bool bReplaceSubstrings = true);
 
       int getModifications(bool bResetModification = true);
       void resetModification();
 
+      /**
+       * @return A number that changes whenever a child is attached to or detached from the subtree of this node. The
+       *         numbers are unique over all nodes, so they can be compared without resetting anything.
+       */
+      unsigned long long getVersion() const;
+
       ChildRange getChildRange();
       ChildConstRange getChildRange() const;
 
     protected:
       Node(const std::string& strName = "noname");
 
+      //assigns a new version to this node and all its parents
+      void updateVersion();
+
       ChildContainer m_ChildContainer;
 
       int m_nModifications;
+      unsigned long long m_nVersion;
   };
 
 
@@ -0,0 +1,107 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#pragma once
+
+#include <atomic>
+
+namespace ARSTD
+{
+
+  /**
+   * Hands values from one writing thread to one reading thread without locking. The writer fills the back
+   * buffer and publishes it, the reader fetches the most recently published value into its front buffer.
+   * Values the reader did not fetch in time are overwritten, so neither side ever waits for the other.
+   */
+  template <typename Type>
+  class TripleBuffer
+  {
+    public:
+      TripleBuffer();
+
+      //writer side
+      Type& getBackBuffer();
+      void publish();
+
+      //reader side
+
+      /**
+       * Makes the most recently published value the front buffer.
+       * @return Returns true if a value was published since the last call.
+       */
+      bool fetch();
+      const Type& getFrontBuffer() const;
+
+      /**
+       * Assigns the value to all three buffers. Must only be called by the writer while the reader is known
+       * not to access its front buffer.
+       */
+      void reset(const Type& value);
+
+    protected:
+      TripleBuffer(const TripleBuffer& other);
+      TripleBuffer& operator=(const TripleBuffer& other);
+
+      //the middle index is combined with this flag as long as it was not fetched
+      static const int FRESH = 4;
+      static const int INDEX_MASK = 3;
+
+      Type m_Buffers[3];
+      int m_nBack;
+      std::atomic<int> m_nMiddle;
+      int m_nFront;
+  };
+
+
+
+  template <typename Type>
+  TripleBuffer<Type>::TripleBuffer()
+  : m_nBack(0),
+    m_nMiddle(1),
+    m_nFront(2)
+  {
+  }
+
+
+  template <typename Type>
+  Type& TripleBuffer<Type>::getBackBuffer()
+  {
+    return m_Buffers[m_nBack];
+  }
+
+
+  template <typename Type>
+  void TripleBuffer<Type>::publish()
+  {
+    m_nBack = m_nMiddle.exchange(m_nBack | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+  }
+
+
+  template <typename Type>
+  bool TripleBuffer<Type>::fetch()
+  {
+    if (!(m_nMiddle.load(std::memory_order_relaxed) & FRESH))
+      return false;
+
+    m_nFront = m_nMiddle.exchange(m_nFront, std::memory_order_acq_rel) & INDEX_MASK;
+    return true;
+  }
+
+
+  template <typename Type>
+  const Type& TripleBuffer<Type>::getFrontBuffer() const
+  {
+    return m_Buffers[m_nFront];
+  }
+
+
+  template <typename Type>
+  void TripleBuffer<Type>::reset(const Type& value)
+  {
+    for (int i = 0; i < 3; ++i)
+      m_Buffers[i] = value;
+    m_nMiddle.fetch_and(INDEX_MASK, std::memory_order_acq_rel);
+  }
+
+} //namespace ARSTD
\ No newline at end of file
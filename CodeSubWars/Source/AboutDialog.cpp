@@ -38,7 +38,7 @@ namespace CodeSubWars
         pInformationLayout->addLayout(pDetailsLayout);
       
           QLabel* pVersion = new QLabel(QString("CodeSubWars") + " v" + Constants::getVersion().getAsString().c_str() + " beta\n"
-                                        "Copyright (c) 2005-2022 " + Constants::AUTHOR + ". All rights reserved.\n" +
+                                        "Copyright (c) 2005-2022 " + Constants::AUTHOR.c_str() + ". All rights reserved.\n" +
                                         "Released under the MIT license. (see license.txt)", this);
           pVersion->setAlignment(Qt::AlignLeft | Qt::AlignTop);
           pDetailsLayout->addWidget(pVersion);
@@ -46,8 +46,8 @@ namespace CodeSubWars
           QLabel* pText = new QLabel(QString() +
             "A physics based three dimensional programming game.\n" +
             "\n" +
-            Constants::WEBSITE + "\n" +
-            Constants::EMAIL + "\n" +
+            Constants::WEBSITE.c_str() + "\n" +
+            Constants::EMAIL.c_str() + "\n" +
             "\n" +
             "based on (alphabetical order):\n" + 
             "    Boost 1.79.0 for python bindings and transforms (http://www.boost.org/)\n" +
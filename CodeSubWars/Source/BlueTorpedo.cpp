@@ -2,8 +2,9 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "BlueTorpedo.h"
+#include "CSWObjectPool.h"
 #include "CSWEngine.h"
 
 
@@ -12,7 +13,7 @@ namespace CodeSubWars
 
   BlueTorpedo::PtrType BlueTorpedo::create(const std::string& strName, const Matrix44D& matBaseTObject, double fLength)
   {
-    return PtrType(new BlueTorpedo(strName, matBaseTObject, fLength));
+    return CSWObjectPool::create<BlueTorpedo>([&](void* pBlock) { return new (pBlock) BlueTorpedo(strName, matBaseTObject, fLength); });
   }
 
 
@@ -2,7 +2,7 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "Border.h"
 
 
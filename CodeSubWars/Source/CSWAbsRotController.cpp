@@ -1,7 +1,7 @@
 // Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
 // Released under the MIT license. (see license.txt)
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWUtilities.h"
 #include "CSWAbsRotController.h"
 #include "CSWControlCenter.h"
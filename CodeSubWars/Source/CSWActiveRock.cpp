@@ -2,7 +2,7 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWWorld.h"
 #include "CSWSettings.h"
 #include "CSWActiveRock.h"
@@ -79,11 +79,11 @@ namespace CodeSubWars
   }
 
 
-  void CSWActiveRock::draw()
+  void CSWActiveRock::collectRenderData(CSWRenderFrame& frame, CSWRenderFrame::Entry& entry)
   {
-    CSWDamDynSolCol::draw();
+    CSWDamDynSolCol::collectRenderData(frame, entry);
     if (CSWWorld::getInstance()->getSettings()->getSelectedObject() == getSharedThis())
-      getPassiveSonar()->draw();
+      getPassiveSonar()->collectRenderData(frame);
   }
 
 
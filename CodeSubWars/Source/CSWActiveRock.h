@@ -31,7 +31,7 @@ namespace CodeSubWars
       virtual void update();
   
       //for debugging stuff
-      virtual void draw();
+      virtual void collectRenderData(CSWRenderFrame& frame, CSWRenderFrame::Entry& entry);
     
     protected:
       CSWActiveRock(const std::string& strName, const Matrix44D& matBaseTObject, const Size3D& size);
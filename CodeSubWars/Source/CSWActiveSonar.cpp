@@ -2,9 +2,9 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWActiveSonar.h"
-#include "CSWActiveSonarVisualizer.h"
+#include "CSWObjectPool.h"
 #include "CSWMap.h"
 #include "CSWWorld.h"
 #include "CSWSettings.h"
@@ -15,35 +15,46 @@
 #include "CSWSubmarine.h"
 #include "CSWWeapon.h"
 #include "CSWScanRay.h"
+#include "CSWCollisionFilter.h"
 
 namespace CodeSubWars
 {
 
   //maximum visible range is 3 km
   const double CSWActiveSonar::MAX_DISTANCE = 3000;
+  const double CSWActiveSonar::MIN_DISTANCE = 60;
 
   //vertical angle is 30 degree
   const double CSWActiveSonar::VERTICAL_SCANNING_ANGLE = getInRad(15);
   //vertical rotation velocity is 1125 degree per second or scanning the whole vertical range with 37.5 Hz
   const double CSWActiveSonar::VERTICAL_ANGULAR_VELOCITY = getInRad(1125);
 
+  //a beam costs as much as one step of the scanning sonar
+  const double CSWActiveSonar::BEAM_TIME = 0.01;
+  const size_t CSWActiveSonar::MAX_BEAMS = 1000;
 
-  CSWActiveSonar::PtrType CSWActiveSonar::create(const std::string& strName, const Matrix44D& matBaseTObject)
+
+  bool operator == (const CSWSonarEcho& lhs, const CSWSonarEcho& rhs)
   {
-    return PtrType(new CSWActiveSonar(strName, matBaseTObject));
+    return lhs.vecWorldTDirection == rhs.vecWorldTDirection &&
+           fabs(lhs.fDistance - rhs.fDistance) < EPSILON &&
+           lhs.vecTargetPosition == rhs.vecTargetPosition &&
+           lhs.bTargetDetected == rhs.bTargetDetected &&
+           lhs.bTargetDynamic == rhs.bTargetDynamic &&
+           lhs.bTargetBorder == rhs.bTargetBorder &&
+           lhs.bTargetSubmarine == rhs.bTargetSubmarine &&
+           lhs.bTargetWeapon == rhs.bTargetWeapon;
   }
 
 
-  CSWActiveSonar::~CSWActiveSonar()
+  CSWActiveSonar::PtrType CSWActiveSonar::create(const std::string& strName, const Matrix44D& matBaseTObject)
   {
+    return CSWObjectPool::create<CSWActiveSonar>([&](void* pBlock) { return new (pBlock) CSWActiveSonar(strName, matBaseTObject); });
   }
 
 
-  QWidget* CSWActiveSonar::getInformationWidget(QWidget* pParent)
+  CSWActiveSonar::~CSWActiveSonar()
   {
-    if (!m_pVisualizer)
-      m_pVisualizer = new CSWActiveSonarVisualizer(pParent, std::dynamic_pointer_cast<CSWActiveSonar>(getSharedThis()));
-    return m_pVisualizer;
   }
 
 
@@ -56,14 +67,7 @@ namespace CodeSubWars
     CSWMap::PtrType pMap = getMap();
     if (pMap && hasTargetDetected() && !isTargetBorder())
     {
-      CSWMap::DangerLevel level = CSWMap::UNKNOWN;
-      if (isTargetDynamic())
-        level = CSWMap::LOW;
-      if (isTargetSubmarine())
-        level = CSWMap::MEDIUM;
-      if (isTargetWeapon())
-        level = CSWMap::HIGH;
-      pMap->insertElement(getTargetPosition(), level);
+      pMap->insertElement(getTargetPosition(), determineDangerLevel(isTargetDynamic(), isTargetSubmarine(), isTargetWeapon()));
     }
   }
 
@@ -80,74 +84,54 @@ namespace CodeSubWars
   }
 
 
-  void CSWActiveSonar::draw()
+  void CSWActiveSonar::collectRenderData(CSWRenderFrame& frame) const
   {
-    m_pScanRay->draw();
+    m_pScanRay->collectRenderData(frame);
     
     if (CSWWorld::getInstance()->getSettings()->getVariousProperties() & CSWSettings::DISPLAY_ACTIVE_SONAR_SCAN)
     {  
       //for debugging only
-      glPushAttrib(GL_ALL_ATTRIB_BITS);
-        glPushMatrix();
-        glLoadIdentity();
-      
-        glDisable(GL_LIGHTING);
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-        glDisable(GL_CULL_FACE);
-
-        glShadeModel(GL_SMOOTH);
-
-        glDepthMask(false);
-        glEnable(GL_DEPTH_TEST);
-      
-        if (m_LastScans.size() > 1)
+      if (m_LastScans.size() > 1)
+      {
+        CSWRenderFrame::Geometry scans(CSWRenderFrame::Geometry::TRIANGLES);
+        int nNumValues = 0;
+        int nMaxIterations = 10;
+        boost::circular_buffer<ScanLine>::const_iterator it = m_LastScans.begin();
+        double fCurrentBlend = 0.2;
+        int nTmp = std::min(nMaxIterations, static_cast<int>(m_LastScans.size()));
+        double fBlendDelta = fCurrentBlend;
+        if (nTmp)
+          fBlendDelta = fCurrentBlend/nTmp;
+        Vector4D col1;
+        Vector4D col2;
+        for (; nNumValues < nMaxIterations && it != boost::prior(m_LastScans.end()); ++it, ++nNumValues)
         {
-          glBegin(GL_TRIANGLES);
-            int nNumValues = 0;
-            int nMaxIterations = 10;
-            boost::circular_buffer<ScanLine>::const_iterator it = m_LastScans.begin();
-            double fCurrentBlend = 0.2;
-            int nTmp = std::min(nMaxIterations, static_cast<int>(m_LastScans.size()));
-            double fBlendDelta = fCurrentBlend;
-            if (nTmp)
-              fBlendDelta = fCurrentBlend/nTmp;
-            Vector3D vecP1;
-            Vector3D vecP2;
-            Vector3D vecP3;
-            Vector3D vecP4;
-            Vector4D col1;
-            Vector4D col2;
-            for (; nNumValues < nMaxIterations && it != boost::prior(m_LastScans.end()); ++it, ++nNumValues)
-            {
-              vecP1 = it->segment.getPoint1();
-              vecP2 = it->segment.getPoint2();
-              vecP3 = boost::next(it)->segment.getPoint1();
-              vecP4 = boost::next(it)->segment.getPoint2();
-              col1 = it->vecColor;
-              col1.a += fCurrentBlend;
-              col2 = boost::next(it)->vecColor;
-              col2.a += fCurrentBlend;
-            
-              glColor4dv(col1.pData);
-              glVertex3dv(vecP1.pData);
-              glVertex3dv(vecP2.pData);
-              glColor4dv(col2.pData);
-              glVertex3dv(vecP3.pData);
-
-              glVertex3dv(vecP4.pData);
-              glVertex3dv(vecP3.pData);
-              glColor4dv(col1.pData);
-              glVertex3dv(vecP2.pData);
-              fCurrentBlend -= fBlendDelta;
-            }
-          glEnd();
+          const Vector3D& vecP1 = it->segment.getPoint1();
+          const Vector3D& vecP2 = it->segment.getPoint2();
+          const Vector3D& vecP3 = boost::next(it)->segment.getPoint1();
+          const Vector3D& vecP4 = boost::next(it)->segment.getPoint2();
+          col1 = it->vecColor;
+          col1.a += fCurrentBlend;
+          col2 = boost::next(it)->vecColor;
+          col2.a += fCurrentBlend;
+
+          scans.vertices.push_back(vecP1);
+          scans.vertices.push_back(vecP2);
+          scans.vertices.push_back(vecP3);
+          scans.colors.push_back(col1);
+          scans.colors.push_back(col1);
+          scans.colors.push_back(col2);
+
+          scans.vertices.push_back(vecP4);
+          scans.vertices.push_back(vecP3);
+          scans.vertices.push_back(vecP2);
+          scans.colors.push_back(col2);
+          scans.colors.push_back(col2);
+          scans.colors.push_back(col1);
+          fCurrentBlend -= fBlendDelta;
         }
-        glPopMatrix();
-        glDepthMask(true);
-      glPopAttrib();
+        frame.addGeometry(scans);
+      }
     }
   }
 
@@ -262,15 +246,139 @@ namespace CodeSubWars
   }
 
 
+  CSWActiveSonar::EchoContainer CSWActiveSonar::scan(const std::vector<Vector3D>& directions)
+  {
+    EchoContainer echoes;
+    if (!isScanReady() || directions.empty())
+      return echoes;
+
+    size_t nNumberBeams = std::min(directions.size(), MAX_BEAMS);
+    m_fNextScanTime = ARSTD::Time::getTime() + nNumberBeams*BEAM_TIME;
+
+    //the directions are relative to the carrying object because the sonar itself turns with its scan direction
+    CSWObject::PtrType pCarrier = findFirstParent<CSWISolid>();
+    const Matrix44D& matWorldTCarrier = pCarrier ? pCarrier->getWorldTransform() : getWorldTransform();
+    Vector3D vecWorldTSource = getWorldTransform().getTranslation();
+
+    std::vector<Vector3D> worldTDirections;
+    std::vector<Vector3D> worldTTargets;
+    worldTDirections.reserve(nNumberBeams);
+    worldTTargets.reserve(nNumberBeams);
+    for (size_t nCntBeam = 0; nCntBeam < nNumberBeams; ++nCntBeam)
+    {
+      const Vector3D& vecDirection = directions[nCntBeam];
+      Vector3D vecWorldTDirection = matWorldTCarrier.getXAxis()*vecDirection.x + 
+                                    matWorldTCarrier.getYAxis()*vecDirection.y + 
+                                    matWorldTCarrier.getZAxis()*vecDirection.z;
+      if (vecWorldTDirection == Vector3D::ZERO)
+        vecWorldTDirection = matWorldTCarrier.getZAxis();
+      else
+        vecWorldTDirection.normalize();
+      worldTDirections.push_back(vecWorldTDirection);
+      worldTTargets.push_back(vecWorldTSource + vecWorldTDirection*MAX_DISTANCE);
+    }
+
+    std::vector<CSWCollisionFilter::RayHit> hits;
+    //like by the scan ray objects closer than 60m are not detected, the beams start behind them
+    CSWWorld::getInstance()->getCollisionFilter()->castRays(pCarrier.get(), vecWorldTSource, worldTTargets, MIN_DISTANCE, hits);
+    assert(hits.size() == nNumberBeams);
+
+    CSWMap::PtrType pMap = getMap();
+    echoes.reserve(nNumberBeams);
+    for (size_t nCntBeam = 0; nCntBeam < nNumberBeams; ++nCntBeam)
+    {
+      CSWSonarEcho echo;
+      echo.vecWorldTDirection = worldTDirections[nCntBeam];
+      double fDetectedDistance = hits[nCntBeam].fParam*MAX_DISTANCE;
+      CSWObject* pDetectedObject = hits[nCntBeam].pObject;
+      echo.bTargetDetected = pDetectedObject && fDetectedDistance < MAX_DISTANCE;
+      echo.bTargetDynamic = echo.bTargetDetected && dynamic_cast<CSWIDynamic*>(pDetectedObject) != nullptr;
+      echo.bTargetBorder = echo.bTargetDetected && dynamic_cast<CSWBorder*>(pDetectedObject) != nullptr;
+      echo.bTargetSubmarine = echo.bTargetDetected && dynamic_cast<CSWSubmarine*>(pDetectedObject) != nullptr;
+      echo.bTargetWeapon = echo.bTargetDetected && dynamic_cast<CSWWeapon*>(pDetectedObject) != nullptr;
+      if (!echo.bTargetDetected)
+      {
+        echo.fDistance = MAX_DISTANCE;
+        echo.vecTargetPosition = Vector3D(0, 0, 0);
+      }
+      else if (echo.bTargetBorder)
+      {
+        echo.fDistance = fDetectedDistance;
+        echo.vecTargetPosition = vecWorldTSource + echo.vecWorldTDirection*fDetectedDistance;
+      }
+      else
+      {
+        //for simplification: on object detection return allways the position of the detected object
+        echo.vecTargetPosition = pDetectedObject->getWorldTransform().getTranslation();
+        echo.fDistance = (vecWorldTSource - echo.vecTargetPosition).getLength();
+        if (pMap)
+          pMap->insertElement(echo.vecTargetPosition, determineDangerLevel(echo.bTargetDynamic, echo.bTargetSubmarine, echo.bTargetWeapon));
+      }
+      echoes.push_back(echo);
+    }
+    return echoes;
+  }
+
+
+  bool CSWActiveSonar::isScanReady() const
+  {
+    return m_fNextScanTime <= ARSTD::Time::getTime();
+  }
+
+
+  std::vector<Vector3D> CSWActiveSonar::createFanDirections(const double& fAngle, int nNumberBeams)
+  {
+    std::vector<Vector3D> directions;
+    if (nNumberBeams <= 0)
+      return directions;
+
+    double fAngleInRad = getInRad(std::max(0.0, std::min(360.0, fAngle)));
+    //a full circle must not contain the backward direction twice
+    int nNumberGaps = fAngle >= 360 ? nNumberBeams : nNumberBeams - 1;
+    for (int nCntBeam = 0; nCntBeam < nNumberBeams; ++nCntBeam)
+    {
+      double fCurrentAngle = nNumberGaps ? fAngleInRad*(static_cast<double>(nCntBeam)/nNumberGaps - 0.5) : 0;
+      directions.push_back(Vector3D(sin(fCurrentAngle), 0, cos(fCurrentAngle)));
+    }
+    return directions;
+  }
+
+
+  std::vector<Vector3D> CSWActiveSonar::createConeDirections(const double& fAngle, int nNumberBeams)
+  {
+    std::vector<Vector3D> directions;
+    if (nNumberBeams <= 0)
+      return directions;
+    if (nNumberBeams == 1)
+    {
+      directions.push_back(Vector3D(0, 0, 1));
+      return directions;
+    }
+
+    //spiral over the spherical cap with equal area per beam, the golden angle between successive beams avoids 
+    //clustering
+    double fCosAngle = cos(getInRad(std::max(0.0, std::min(180.0, fAngle))));
+    double fGoldenAngle = PI*(3 - sqrt(5.0));
+    for (int nCntBeam = 0; nCntBeam < nNumberBeams; ++nCntBeam)
+    {
+      double fCosPolar = 1 - (1 - fCosAngle)*(nCntBeam + 0.5)/nNumberBeams;
+      double fSinPolar = sqrt(std::max(0.0, 1 - fCosPolar*fCosPolar));
+      double fAzimuth = fGoldenAngle*nCntBeam;
+      directions.push_back(Vector3D(fSinPolar*sin(fAzimuth), fSinPolar*cos(fAzimuth), fCosPolar));
+    }
+    return directions;
+  }
+
+
   CSWActiveSonar::CSWActiveSonar(const std::string& strName, const Matrix44D& matBaseTObject)
   : CSWSonar(strName, matBaseTObject),
     m_fAngleOfBeam(45),
     m_fDistance(MAX_DISTANCE),
     m_bTargetDetected(false),
     m_vecTargetPosition(0, 0, 0),
+    m_fNextScanTime(0),
     m_LastScans(50),
-    m_pVisualizer(NULL),
-    m_pScanRay(CSWScanRay::create(strName + ".ScanRay", Matrix44D(Vector3D(0, 0, 60)), MAX_DISTANCE - 60))
+    m_pScanRay(CSWScanRay::create(strName + ".ScanRay", Matrix44D(Vector3D(0, 0, MIN_DISTANCE)), MAX_DISTANCE - MIN_DISTANCE))
   {
     attach(m_pScanRay);
   }
@@ -280,7 +388,7 @@ namespace CodeSubWars
   {
     double fVisualizingDistance;  
   
-    double fDetectedDistance = m_pScanRay->getDetectedDistance() + 60;
+    double fDetectedDistance = m_pScanRay->getDetectedDistance() + MIN_DISTANCE;
     CSWObject::PtrType pDetectedObject = m_pScanRay->getIntersectingObject();    
     m_bTargetDetected = fDetectedDistance < MAX_DISTANCE && pDetectedObject;
     if (m_bTargetDetected)
@@ -313,4 +421,17 @@ namespace CodeSubWars
                                     m_bTargetDetected && !isTargetBorder() ? Vector4D(1, 1, 0, 0.2) : Vector4D(0, 0, 0.6, 0)));
   }
 
+
+  CSWMap::DangerLevel CSWActiveSonar::determineDangerLevel(bool bTargetDynamic, bool bTargetSubmarine, bool bTargetWeapon)
+  {
+    CSWMap::DangerLevel level = CSWMap::UNKNOWN;
+    if (bTargetDynamic)
+      level = CSWMap::LOW;
+    if (bTargetSubmarine)
+      level = CSWMap::MEDIUM;
+    if (bTargetWeapon)
+      level = CSWMap::HIGH;
+    return level;
+  }
+
 }
\ No newline at end of file
@@ -5,13 +5,40 @@
 #pragma once
 
 #include "CSWSonar.h"
+#include "CSWMap.h"
 
 namespace CodeSubWars
 {
 
   class CSWScanRay;
-  class CSWActiveSonar3DView;
-  class CSWActiveSonarVisualizer;
+  class CSWInformationSnapshot;
+
+  /**
+   * The echo of one beam of a multi beam scan (see CSWActiveSonar::scan()).
+   */
+  struct CSWSonarEcho
+  {
+    Vector3D vecWorldTDirection;    ///< The normalized direction of the beam in world coordinate system.
+                                    ///<
+    double fDistance;               ///< The distance to the detected object or the maximal distance if nothing has been 
+                                    ///< detected.
+    Vector3D vecTargetPosition;     ///< The position of the detection in world coordinates or Vector3(0, 0, 0).
+                                    ///<
+    bool bTargetDetected;           ///< True if an object has been detected.
+                                    ///<
+    bool bTargetDynamic;            ///< True if a dynamic object has been detected.
+                                    ///<
+    bool bTargetBorder;             ///< True if a world border has been detected.
+                                    ///<
+    bool bTargetSubmarine;          ///< True if a submarine has been detected.
+                                    ///<
+    bool bTargetWeapon;             ///< True if a weapon has been detected.
+                                    ///<
+  };
+
+
+  bool operator == (const CSWSonarEcho& lhs, const CSWSonarEcho& rhs);
+
 
   /**
    * This class specializes a sonar to an active sonar. The time difference between sent and received sonic waves gives
@@ -41,19 +68,17 @@ namespace CodeSubWars
   {
     public:
       typedef std::shared_ptr<CSWActiveSonar> PtrType;
+      typedef std::vector<CSWSonarEcho> EchoContainer;
     
       static PtrType create(const std::string& strName, const Matrix44D& matBaseTObject);
 
       virtual ~CSWActiveSonar();
 
-      //defined methods from CSWEquipment
-      virtual QWidget* getInformationWidget(QWidget* pParent);
-    
       //defined methods from IUpdateable
       virtual void update();
 
       //defined methods from CSWSonar
-      virtual void draw();
+      virtual void collectRenderData(CSWRenderFrame& frame) const;
       virtual Vector3D getAdditionalDirection(const Vector3D& vecCurrentDir, const Vector3D& vecUp) const;
 
       /**
@@ -115,7 +140,41 @@ namespace CodeSubWars
        */
       const Vector3D& getTargetPosition() const;
 
-      friend CSWActiveSonar3DView;
+      /**
+       * Sends beams into all given directions at once and returns their echoes immediately, independently of the 
+       * current scan direction. Detected objects are reported to the map. Each beam occupies the sonar for 0.01 
+       * seconds (the time the scanning sonar needs for one direction), so after a scan with n beams the next one can 
+       * be done after n*0.01 seconds. At most 1000 beams are sent per scan, further directions are ignored.
+       * @param directions The directions of the beams relative to the object that carries the sonar (z forward, 
+       *                   y up, x left). They do not need to be normalized.
+       * @return The echoes in order of the directions or an empty container if the sonar is not ready.
+       * @warning Objects closer than 60m are not detected.
+       */
+      EchoContainer scan(const std::vector<Vector3D>& directions);
+
+      /**
+       * Returns true if a multi beam scan can be done.
+       * @returns True if a multi beam scan can be done.
+       */
+      bool isScanReady() const;
+
+      /**
+       * Creates horizontal directions with equal angles in between for scan().
+       * @param fAngle The angle in degree between the outer beams that is centered around the forward direction. 
+       *               This is clamped to [0, 360].
+       * @param nNumberBeams The number of beams.
+       */
+      static std::vector<Vector3D> createFanDirections(const double& fAngle, int nNumberBeams);
+
+      /**
+       * Creates evenly distributed directions within a cone around the forward direction for scan(). An angle of 180
+       * degree gives directions over the whole sphere.
+       * @param fAngle The half opening angle of the cone in degree. This is clamped to [0, 180].
+       * @param nNumberBeams The number of beams.
+       */
+      static std::vector<Vector3D> createConeDirections(const double& fAngle, int nNumberBeams);
+
+      friend CSWInformationSnapshot;
     protected:
       struct ScanLine
       {
@@ -135,22 +194,27 @@ namespace CodeSubWars
 
       void validate();
 
+      static CSWMap::DangerLevel determineDangerLevel(bool bTargetDynamic, bool bTargetSubmarine, bool bTargetWeapon);
+
 
       static const double VERTICAL_SCANNING_ANGLE; //the angle that is scanned verticaly
       static const double VERTICAL_ANGULAR_VELOCITY; //in rad per second;
   
       static const double MAX_DISTANCE;
+      static const double MIN_DISTANCE; //objects closer than this are not detected
+
+      static const double BEAM_TIME; //time in seconds the sonar is occupied per beam of a multi beam scan
+      static const size_t MAX_BEAMS;
 
       double m_fAngleOfBeam;
       double m_fDistance;
       bool m_bTargetDetected;
       Vector3D m_vecTargetPosition;
       std::weak_ptr<CSWObject> m_pDetectedObject;
+      double m_fNextScanTime;
     
       boost::circular_buffer<ScanLine> m_LastScans;
     
-      CSWActiveSonarVisualizer* m_pVisualizer;
-    
       std::shared_ptr<CSWScanRay> m_pScanRay;
   };    
 
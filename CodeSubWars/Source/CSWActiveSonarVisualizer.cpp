@@ -4,20 +4,16 @@
 
 #include "PrecompiledHeader.h"
 #include "CSWActiveSonarVisualizer.h"
-#include "CSWActiveSonar.h"
 #include "CSWCamera.h"
-#include "CSWISolid.h"
 #include "CSWUtilities.h"
 #include "glut.h"
 
 namespace CodeSubWars
 {
 
-  CSWActiveSonar3DView::CSWActiveSonar3DView(QWidget* pParent, CSWActiveSonar::PtrType pActiveSonar)
+  CSWActiveSonar3DView::CSWActiveSonar3DView(QWidget* pParent)
   : OpenGLView(pParent),
     m_pMainCamera(CSWCamera::create("ActiveSonar", Matrix44D())),
-    m_pActiveSonar(pActiveSonar),
-    m_pSolidParent(pActiveSonar->findFirstParent<CSWISolid>()),
     m_matActiveSonarTCamera(Vector3D(1, 0, 0),
                             Vector3D(0, 0, 1),
                             Vector3D(0, -1, 0),
@@ -27,15 +23,20 @@ namespace CodeSubWars
   }
 
 
+  void CSWActiveSonar3DView::setInformation(const CSWInformationSnapshot::PtrType& pInformation)
+  {
+    m_pInformation = pInformation;
+  }
+
+
   void CSWActiveSonar3DView::draw()
   {
-    CSWActiveSonar::PtrType pActiveSonar = m_pActiveSonar.lock();
-    CSWObject::PtrType pSolidParent = m_pSolidParent.lock();
     CSWCamera::PtrType pCam = m_pCamera.lock();
-    if (!pActiveSonar || !pSolidParent || !pCam)
+    if (!m_pInformation || !(m_pInformation->nProperties & CSWInformationSnapshot::ACTIVE_SONAR) || !pCam)
       return;
+    const CSWInformationSnapshot& info = *m_pInformation;
   
-    pCam->setTransform(pSolidParent->getWorldTransform()*m_matActiveSonarTCamera);
+    pCam->setTransform(info.matSolidParentTransform*m_matActiveSonarTCamera);
     pCam->calcWorldTransforms();
 
     glPushAttrib(GL_ALL_ATTRIB_BITS);
@@ -47,7 +48,7 @@ namespace CodeSubWars
       //draw scan area
       glPushMatrix();
         Matrix44D mat2(pCam->getWorldTransform());
-        mat2.getTranslation() = pActiveSonar->getWorldTransform().getTranslation();
+        mat2.getTranslation() = info.matWorldTransform.getTranslation();
         glLoadMatrixd(mat2.pData);
       
         glDisable(GL_BLEND);
@@ -90,8 +91,8 @@ namespace CodeSubWars
       glColor3d(0.3, 0.3, 0.6);
       glLineWidth(4);
       glBegin(GL_LINES);
-        glVertex3dv(pActiveSonar->getWorldTransform().getTranslation().pData);
-        glVertex3dv((pActiveSonar->getWorldTransform().getTranslation() + pActiveSonar->getDirection()*pActiveSonar->getMaximalDistance()).pData);
+        glVertex3dv(info.matWorldTransform.getTranslation().pData);
+        glVertex3dv((info.matWorldTransform.getTranslation() + info.vecScanDirection*info.fMaximalDistance).pData);
       glEnd();
 
       glDisable(GL_DEPTH_TEST);
@@ -99,15 +100,15 @@ namespace CodeSubWars
       //draw detected points
       glLineWidth(2);
       glBegin(GL_LINE_STRIP);
-        boost::circular_buffer<CSWActiveSonar::ScanLine>::const_iterator it = pActiveSonar->m_LastScans.begin();
-        for (; it != pActiveSonar->m_LastScans.end(); ++it)
+        std::vector<std::pair<Vector3D, double> >::const_iterator it = info.activeSonarScans.begin();
+        for (; it != info.activeSonarScans.end(); ++it)
         {
-          glColor3dv(CSWUtilities::calcColorR2G2B(it->segment.getLength()/pActiveSonar->getMaximalDistance()).pData);      
-          glVertex3dv(it->segment.getPoint2().pData);
+          glColor3dv(CSWUtilities::calcColorR2G2B(it->second/info.fMaximalDistance).pData);      
+          glVertex3dv(it->first.pData);
         }
       glEnd();
 
-      ARSTD::OpenGLTools::paintTripod(pSolidParent->getWorldTransform(), 100);
+      ARSTD::OpenGLTools::paintTripod(info.matSolidParentTransform, 100);
   
       //draw world coord tripod in lower left corner
       drawWorldTripod();
@@ -155,18 +156,19 @@ namespace CodeSubWars
 
 
 
-  CSWActiveSonarVisualizer::CSWActiveSonarVisualizer(QWidget* pParent, CSWActiveSonar::PtrType pActiveSonar)
+  CSWActiveSonarVisualizer::CSWActiveSonarVisualizer(QWidget* pParent)
   : QWidget(pParent, NULL)
   {
     QHBoxLayout* pLayout = new QHBoxLayout(this); 
     pLayout->setMargin(1);
-    m_pView = new CSWActiveSonar3DView(this, pActiveSonar);
+    m_pView = new CSWActiveSonar3DView(this);
     pLayout->addWidget(m_pView);
   }
 
 
-  void CSWActiveSonarVisualizer::updateContent()
+  void CSWActiveSonarVisualizer::updateContent(const CSWInformationSnapshot::PtrType& pInformation)
   {
+    m_pView->setInformation(pInformation);
     update();
   }
 
@@ -2,7 +2,7 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWAxialInclRotateCommand.h"
 #include "CSWAxialInclRotationController.h"
 #include "CSWControlCommand.h"
@@ -2,14 +2,14 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWLog.h"
-#include "CSWWorld.h"
 #include "CSWBattleStatistics.h"
 #include "CSWObject.h"
 #include "CSWSubmarine.h"
 #include "CSWWeapon.h"
-#include "CSWMessageCollectObjects.h"
+#include "CSWTournamentResults.h"
+#include "CSWUtilities.h"
 
 
 namespace CodeSubWars
@@ -26,10 +26,91 @@ namespace CodeSubWars
   }
 
 
-  void CSWBattleStatistics::initialize()
+  void CSWBattleStatistics::initialize(const std::string& strWorld, const std::string& strBattleType)
   {
     m_SubmarineTable.clear();
     m_KillTable.clear();
+    m_strWorld = strWorld;
+
+    if (m_EventStream.is_open())
+      m_EventStream.close();
+    m_EventStream.clear();
+    m_strBattleID.clear();
+    try
+    {
+      ARSTD::FileSystem::createDirectory(m_strStatisticsPath);
+      m_strBattleID = CSWUtilities::getUniqueFilename(m_strStatisticsPath);
+    }
+    catch (std::runtime_error&)
+    {
+      CSWLog::getInstance()->log("could not create battle statistics in " + m_strStatisticsPath);
+      return;
+    }
+
+    //events are written in large blocks
+    m_EventStream.rdbuf()->pubsetbuf(&m_EventBuffer.front(), m_EventBuffer.size());
+    m_EventStream.open((m_strStatisticsPath + "/" + m_strBattleID + ".jsonl").c_str());
+    m_EventStream.precision(3);
+    m_EventStream.setf(std::ios::fixed);
+
+    beginEvent("battle") << ",\"id\":" << getQuoted(m_strBattleID) << ",\"world\":" << getQuoted(m_strWorld)
+                         << ",\"type\":" << getQuoted(strBattleType);
+    endEvent();
+  }
+
+
+  void CSWBattleStatistics::setStatisticsPath(const std::string& strPath)
+  {
+    m_strStatisticsPath = strPath;
+    m_pTournamentResults.reset();
+  }
+
+
+  const std::string& CSWBattleStatistics::getStatisticsPath() const
+  {
+    return m_strStatisticsPath;
+  }
+
+
+  std::shared_ptr<CSWTournamentResults> CSWBattleStatistics::getTournamentResults()
+  {
+    if (!m_pTournamentResults)
+    {
+      m_pTournamentResults = CSWTournamentResults::create(m_strStatisticsPath + "/results.csv");
+      if (!m_pTournamentResults->load())
+        CSWLog::getInstance()->log("could not read tournament results of " + m_strStatisticsPath);
+    }
+    return m_pTournamentResults;
+  }
+
+
+  void CSWBattleStatistics::reportSubmarineAdded(CSWObject::PtrType pObject)
+  {
+    CSWSubmarine::PtrType pSubmarine = std::dynamic_pointer_cast<CSWSubmarine>(pObject);
+    if (!pSubmarine)
+      return;
+
+    const std::string& strBot = pSubmarine->getBotName();
+    m_SubmarineTable[pSubmarine->getName()].strBot = strBot;
+
+    beginEvent("added") << ",\"submarine\":" << getQuoted(pSubmarine->getName()) << ",\"bot\":" << getQuoted(strBot)
+                        << ",\"team\":" << pSubmarine->getTeamID();
+    endEvent();
+  }
+
+
+  void CSWBattleStatistics::reportSubmarineRemoved(CSWObject::PtrType pObject)
+  {
+    if (!std::dynamic_pointer_cast<CSWSubmarine>(pObject))
+      return;
+
+    SubmarineTable::iterator itFound = m_SubmarineTable.find(pObject->getName());
+    if (itFound == m_SubmarineTable.end())
+      return;
+    itFound->second.fTimeRemoved = ARSTD::Time::getTime();
+
+    beginEvent("removed") << ",\"submarine\":" << getQuoted(pObject->getName());
+    endEvent();
   }
 
 
@@ -50,6 +131,9 @@ namespace CodeSubWars
     {
       ++(itFound->second.nNumFiredWeapons);
     }
+
+    beginEvent("fired") << ",\"submarine\":" << getQuoted(pObject->getName());
+    endEvent();
   }
 
 
@@ -86,6 +170,9 @@ namespace CodeSubWars
     e.fTime = ARSTD::Time::getTime();
     e.strKilled = strKiller == pKilledObject->getName() ? "self" : pKilledObject->getName();
     m_KillTable.insert(std::make_pair(strKiller, e));
+
+    beginEvent("kill") << ",\"killer\":" << getQuoted(strKiller) << ",\"killed\":" << getQuoted(pKilledObject->getName());
+    endEvent();
   
     std::stringstream ss;
     ss.precision(2);
@@ -95,7 +182,7 @@ namespace CodeSubWars
   }
 
 
-  void CSWBattleStatistics::reportHit(CSWObject::PtrType pObject, CSWObject::PtrType pHitObject)
+  void CSWBattleStatistics::reportHit(CSWObject::PtrType pObject, CSWObject::PtrType pHitObject, double fDamage)
   {
     //count only hits to submarines
     if (!std::dynamic_pointer_cast<CSWSubmarine>(pHitObject))
@@ -116,29 +203,17 @@ namespace CodeSubWars
     if (strShooterName == pHitObject->getName())
       return;
 
-    SubmarineTable::iterator itFound = m_SubmarineTable.find(strShooterName);
-    if (itFound == m_SubmarineTable.end())
-    {
-      SubmarineEntry e;
-      e.nNumCausedHits = 1;
-      m_SubmarineTable[strShooterName] = e;
-    }
-    else
-    {
-      ++(itFound->second.nNumCausedHits);
-    }
+    SubmarineEntry& shooter = m_SubmarineTable[strShooterName];
+    ++shooter.nNumCausedHits;
+    shooter.fDamageDealt += fDamage;
 
-    itFound = m_SubmarineTable.find(pHitObject->getName());
-    if (itFound == m_SubmarineTable.end())
-    {
-      SubmarineEntry e;
-      e.nNumHits = 1;
-      m_SubmarineTable[pHitObject->getName()] = e;
-    }
-    else
-    {
-      ++(itFound->second.nNumHits);
-    }
+    SubmarineEntry& hit = m_SubmarineTable[pHitObject->getName()];
+    ++hit.nNumHits;
+    hit.fDamageTaken += fDamage;
+
+    beginEvent("hit") << ",\"shooter\":" << getQuoted(strShooterName) << ",\"target\":" << getQuoted(pHitObject->getName())
+                      << ",\"damage\":" << fDamage;
+    endEvent();
   }
 
 
@@ -173,6 +248,12 @@ namespace CodeSubWars
         ++(itFound->second.nNumCollisions);
       }
     }
+
+    if (std::dynamic_pointer_cast<CSWSubmarine>(pObjectA) || std::dynamic_pointer_cast<CSWSubmarine>(pObjectB))
+    {
+      beginEvent("collision") << ",\"a\":" << getQuoted(pObjectA->getName()) << ",\"b\":" << getQuoted(pObjectB->getName());
+      endEvent();
+    }
   }
 
 
@@ -180,48 +261,20 @@ namespace CodeSubWars
   {
     CSWLog::getInstance()->log("total ranking:");
   
-    typedef CSWMessageCollectObjects1<CSWObject, CSWSubmarine> MessageCollectSubmarines;
-    MessageCollectSubmarines collectSubmarinesMessage;
-    MessageCollectSubmarines::broadcastMessage(CSWWorld::getInstance()->getObjectTree(), collectSubmarinesMessage);
-
-    //log alive objects
-    int nCnt = 1;
-    MessageCollectSubmarines::ObjectContainer::const_iterator itAliveSubmarines = collectSubmarinesMessage.getCollectedObjects()[0].begin();
-    MessageCollectSubmarines::ObjectContainer::const_iterator itEnd = collectSubmarinesMessage.getCollectedObjects()[0].end();
-    nCnt += std::distance(itAliveSubmarines, itEnd);
-    for (; itAliveSubmarines != itEnd; ++itAliveSubmarines)
+    std::vector<std::pair<int, std::string> > ranking = determineRanking();
+    std::vector<std::pair<int, std::string> >::const_iterator itRank = ranking.begin();
+    for (; itRank != ranking.end(); ++itRank)
     {
       std::stringstream ss;
-      ss << "\t1. " << (*itAliveSubmarines)->getName();
+      ss << "\t" << itRank->first << ". " << itRank->second;
       CSWLog::getInstance()->log(ss.str());
     }
   
   
     if (!m_KillTable.empty())
     {
-      std::map<double, std::string> tmp;
-      std::multimap<std::string, KillEntry>::const_iterator itLogData = m_KillTable.begin();
-      for (; itLogData != m_KillTable.end(); ++itLogData)
-      {
-        std::string strName;
-        if (itLogData->second.strKilled == "self")
-          strName = itLogData->first;
-        else strName = itLogData->second.strKilled;
-        tmp[itLogData->second.fTime] = strName;
-      }
-    
-      std::map<double, std::string>::reverse_iterator rit = tmp.rbegin();
-      for (; rit != tmp.rend(); ++rit)
-      {
-        assert(rit->second != "self");
-        std::stringstream ss;
-        ss << "\t" << nCnt << ". " << rit->second;
-        CSWLog::getInstance()->log(ss.str());
-        ++nCnt;
-      }
+      std::multimap<std::string, KillEntry>::const_iterator itLogData;
 
-    
-    
       CSWLog::getInstance()->log("ranking by kills:");
     
       std::multimap<int, std::string> tmp2;
@@ -290,11 +343,218 @@ namespace CodeSubWars
         CSWLog::getInstance()->log(ss.str());
       }
     }
+
+    writeResults(ranking);
   }
 
 
   CSWBattleStatistics::CSWBattleStatistics()
+  : m_strStatisticsPath("statistics"),
+    m_EventBuffer(1 << 16)
   {
   }
 
+
+  std::vector<std::pair<int, std::string> > CSWBattleStatistics::determineRanking() const
+  {
+    //bots with a submarine that is still alive share the first rank
+    std::map<std::string, double> botTimesRemoved;
+    SubmarineTable::const_iterator it = m_SubmarineTable.begin();
+    for (; it != m_SubmarineTable.end(); ++it)
+    {
+      if (it->second.strBot.empty())
+        continue;
+      double fTimeRemoved = it->second.fTimeRemoved < 0 ? std::numeric_limits<double>::max() : it->second.fTimeRemoved;
+      double& fBotTimeRemoved = botTimesRemoved.insert(std::make_pair(it->second.strBot, fTimeRemoved)).first->second;
+      fBotTimeRemoved = std::max(fBotTimeRemoved, fTimeRemoved);
+    }
+
+    std::vector<std::pair<double, std::string> > timesRemoved;
+    std::map<std::string, double>::const_iterator itBot = botTimesRemoved.begin();
+    for (; itBot != botTimesRemoved.end(); ++itBot)
+      timesRemoved.push_back(std::make_pair(itBot->second, itBot->first));
+    std::stable_sort(timesRemoved.begin(), timesRemoved.end(),
+                     [](const std::pair<double, std::string>& lhs, const std::pair<double, std::string>& rhs) { return lhs.first > rhs.first; });
+
+    std::vector<std::pair<int, std::string> > ranking;
+    for (size_t i = 0; i < timesRemoved.size(); ++i)
+    {
+      int nRank = i > 0 && timesRemoved[i].first == timesRemoved[i - 1].first ? ranking.back().first : static_cast<int>(i) + 1;
+      ranking.push_back(std::make_pair(nRank, timesRemoved[i].second));
+    }
+    return ranking;
+  }
+
+
+  std::string CSWBattleStatistics::getState() const
+  {
+    std::stringstream ss;
+    ss.precision(std::numeric_limits<double>::max_digits10);
+    ss << m_SubmarineTable.size() << "\n";
+    SubmarineTable::const_iterator itSubmarine = m_SubmarineTable.begin();
+    for (; itSubmarine != m_SubmarineTable.end(); ++itSubmarine)
+    {
+      const SubmarineEntry& entry = itSubmarine->second;
+      ss << std::quoted(itSubmarine->first) << " " << std::quoted(entry.strBot) << " " 
+         << entry.fTimeKilled << " " << entry.fTimeRemoved << " " << entry.nNumFiredWeapons << " " 
+         << entry.nNumCausedHits << " " << entry.nNumHits << " " << entry.nNumCollisions << " " 
+         << entry.fDamageDealt << " " << entry.fDamageTaken << "\n";
+    }
+
+    ss << m_KillTable.size() << "\n";
+    KillTable::const_iterator itKill = m_KillTable.begin();
+    for (; itKill != m_KillTable.end(); ++itKill)
+      ss << std::quoted(itKill->first) << " " << itKill->second.fTime << " " << std::quoted(itKill->second.strKilled) << "\n";
+    return ss.str();
+  }
+
+
+  bool CSWBattleStatistics::setState(const std::string& strState)
+  {
+    std::stringstream ss(strState);
+    SubmarineTable submarineTable;
+    std::size_t nNumSubmarines = 0;
+    ss >> nNumSubmarines;
+    for (std::size_t nSubmarine = 0; ss && nSubmarine < nNumSubmarines; ++nSubmarine)
+    {
+      std::string strName;
+      SubmarineEntry entry;
+      ss >> std::quoted(strName) >> std::quoted(entry.strBot) 
+         >> entry.fTimeKilled >> entry.fTimeRemoved >> entry.nNumFiredWeapons 
+         >> entry.nNumCausedHits >> entry.nNumHits >> entry.nNumCollisions 
+         >> entry.fDamageDealt >> entry.fDamageTaken;
+      submarineTable[strName] = entry;
+    }
+
+    KillTable killTable;
+    std::size_t nNumKills = 0;
+    ss >> nNumKills;
+    for (std::size_t nKill = 0; ss && nKill < nNumKills; ++nKill)
+    {
+      std::string strKiller;
+      KillEntry entry;
+      ss >> std::quoted(strKiller) >> entry.fTime >> std::quoted(entry.strKilled);
+      killTable.insert(std::make_pair(strKiller, entry));
+    }
+    if (ss.fail())
+      return false;
+
+    m_SubmarineTable.swap(submarineTable);
+    m_KillTable.swap(killTable);
+
+    beginEvent("restored");
+    endEvent();
+    return true;
+  }
+
+
+  std::ostream& CSWBattleStatistics::beginEvent(const std::string& strEvent)
+  {
+    m_EventStream << "{\"time\":" << ARSTD::Time::getTime() << ",\"event\":\"" << strEvent << "\"";
+    return m_EventStream;
+  }
+
+
+  void CSWBattleStatistics::endEvent()
+  {
+    m_EventStream << "}\n";
+  }
+
+
+  void CSWBattleStatistics::writeResults(const std::vector<std::pair<int, std::string> >& ranking)
+  {
+    CSWTournamentResults::ParticipantContainer participants;
+    std::vector<std::pair<int, std::string> >::const_iterator itRank = ranking.begin();
+    for (; itRank != ranking.end(); ++itRank)
+    {
+      CSWTournamentResults::Participant participant;
+      participant.strBot = itRank->second;
+      participant.nRank = itRank->first;
+      participant.nNumKills = 0;
+      participant.nNumDeaths = 0;
+      participant.nNumHits = 0;
+      participant.nNumFiredWeapons = 0;
+      participant.fDamageDealt = 0;
+      participant.fDamageTaken = 0;
+      int nNumCollisions = 0;
+
+      //sum up all submarines of the bot
+      SubmarineTable::const_iterator it = m_SubmarineTable.begin();
+      for (; it != m_SubmarineTable.end(); ++it)
+      {
+        const SubmarineEntry& e = it->second;
+        if (e.strBot != participant.strBot)
+          continue;
+
+        std::pair<KillTable::const_iterator, KillTable::const_iterator> range = m_KillTable.equal_range(it->first);
+        for (KillTable::const_iterator itKill = range.first; itKill != range.second; ++itKill)
+        {
+          if (itKill->second.strKilled != "self")
+            ++participant.nNumKills;
+        }
+        participant.nNumDeaths += e.fTimeRemoved < 0 ? 0 : 1;
+        participant.nNumHits += e.nNumCausedHits;
+        participant.nNumFiredWeapons += e.nNumFiredWeapons;
+        participant.fDamageDealt += e.fDamageDealt;
+        participant.fDamageTaken += e.fDamageTaken;
+        nNumCollisions += e.nNumCollisions;
+      }
+      participants.push_back(participant);
+
+      beginEvent("result") << ",\"bot\":" << getQuoted(participant.strBot) << ",\"rank\":" << participant.nRank
+                           << ",\"kills\":" << participant.nNumKills << ",\"deaths\":" << participant.nNumDeaths
+                           << ",\"hits\":" << participant.nNumHits << ",\"fired\":" << participant.nNumFiredWeapons
+                           << ",\"damage_dealt\":" << participant.fDamageDealt << ",\"damage_taken\":" << participant.fDamageTaken
+                           << ",\"collisions\":" << nNumCollisions;
+      endEvent();
+    }
+    m_EventStream.close();
+
+    if (participants.empty() || m_strBattleID.empty())
+      return;
+
+    CSWTournamentResults::PtrType pResults = getTournamentResults();
+    if (!pResults->addBattle(m_strBattleID, m_strWorld, participants))
+    {
+      CSWLog::getInstance()->log("could not add battle to tournament results of " + m_strStatisticsPath);
+      return;
+    }
+
+    std::stringstream ss;
+    ss << "ratings after " << pResults->getNumberBattles() << " battles:";
+    CSWLog::getInstance()->log(ss.str());
+    CSWTournamentResults::ParticipantContainer::const_iterator it = participants.begin();
+    for (; it != participants.end(); ++it)
+    {
+      const CSWBotResult* pWorldResult = pResults->find(it->strBot, m_strWorld);
+      const CSWBotResult* pTotalResult = pResults->find(it->strBot);
+      if (!pWorldResult || !pTotalResult)
+        continue;
+
+      std::stringstream ss;
+      ss.precision(1);
+      ss.setf(std::ios::fixed);
+      ss << "\t" << it->strBot << " has " << pTotalResult->fRating << " (" << pWorldResult->fRating << " in " << m_strWorld << ", "
+         << pTotalResult->getWinRate()*100.0 << "% wins of " << pTotalResult->nNumBattles << " battles)";
+      CSWLog::getInstance()->log(ss.str());
+    }
+  }
+
+
+  std::string CSWBattleStatistics::getQuoted(const std::string& str)
+  {
+    std::string strQuoted("\"");
+    std::string::const_iterator it = str.begin();
+    for (; it != str.end(); ++it)
+    {
+      if (*it == '"' || *it == '\\')
+        strQuoted += '\\';
+      if (static_cast<unsigned char>(*it) < 0x20)
+        strQuoted += ' ';
+      else
+        strQuoted += *it;
+    }
+    return strQuoted + "\"";
+  }
+
 }
\ No newline at end of file
@@ -9,7 +9,14 @@ namespace CodeSubWars
 
   class CSWObject;
   class CSWWeapon;
+  class CSWTournamentResults;
 
+  /**
+   * Accounts the events of a battle per submarine. Every reported event is also streamed as one json object per line
+   * to <statistics path>/<battle id>.jsonl. At the end of the battle the ranking is logged and the results are added
+   * to the tournament results in <statistics path>/results.csv. The results are accounted per bot, so all submarines
+   * of a team are ranked together by the last surviving one.
+   */
   class CSWBattleStatistics
   {
     public:
@@ -20,12 +27,42 @@ namespace CodeSubWars
 
       ~CSWBattleStatistics();
 
-      void initialize();
+      /**
+       * Starts the statistics of a new battle in the given world setup.
+       */
+      void initialize(const std::string& strWorld, const std::string& strBattleType);
+
+      /**
+       * Sets the directory the event streams and the tournament results are written to. Default is "statistics"
+       * relative to the working directory.
+       */
+      void setStatisticsPath(const std::string& strPath);
+      const std::string& getStatisticsPath() const;
+
+      /**
+       * @return The results of all battles written to the statistics path. They are loaded on first use.
+       */
+      std::shared_ptr<CSWTournamentResults> getTournamentResults();
     
+      //the results are accounted to the bot name of the submarine
+      void reportSubmarineAdded(std::shared_ptr<CSWObject> pObject);
+      void reportSubmarineRemoved(std::shared_ptr<CSWObject> pObject);
       void reportWeaponFired(std::shared_ptr<CSWObject> pObject);
       void reportKill(std::shared_ptr<CSWObject> pKiller, std::shared_ptr<CSWObject> pKilledObject);
-      void reportHit(std::shared_ptr<CSWObject> pObject, std::shared_ptr<CSWObject> pHitObject);
+      void reportHit(std::shared_ptr<CSWObject> pObject, std::shared_ptr<CSWObject> pHitObject, double fDamage);
       void reportCollision(std::shared_ptr<CSWObject> pObjectA, std::shared_ptr<CSWObject> pObjectB);
+
+      /**
+       * Returns the accounted submarines and kills of the current battle, so they can be stored in a world snapshot.
+       */
+      std::string getState() const;
+
+      /**
+       * Replaces the accounted submarines and kills with a state returned by getState(), e.g. when a battle is 
+       * continued from a world snapshot. Submarines removed before the state was taken keep their removal time.
+       * @return False if the state could not be read, the accounts are unchanged then.
+       */
+      bool setState(const std::string& strState);
       
       void write();
     
@@ -33,11 +70,16 @@ namespace CodeSubWars
       struct SubmarineEntry
       {
         SubmarineEntry()
-        : fTimeKilled(-1), nNumFiredWeapons(0), nNumCausedHits(0), nNumHits(0), nNumCollisions(0)
+        : fTimeKilled(-1), fTimeRemoved(-1), nNumFiredWeapons(0), nNumCausedHits(0), nNumHits(0), nNumCollisions(0), 
+          fDamageDealt(0), fDamageTaken(0)
         {
         }
     
         double fTimeKilled;
+        //empty if the submarine was not added by the battle
+        std::string strBot;
+        //negative while the submarine is in the world
+        double fTimeRemoved;
         //number of fired weapons
         int nNumFiredWeapons;
         //number of hits caused by self
@@ -46,6 +88,8 @@ namespace CodeSubWars
         int nNumHits;
         //number of collision of self
         int nNumCollisions;
+        double fDamageDealt;
+        double fDamageTaken;
       };
 
       struct KillEntry
@@ -61,8 +105,24 @@ namespace CodeSubWars
     
       CSWBattleStatistics();
 
+      //determines the rank of each bot by the time its last submarine was removed
+      std::vector<std::pair<int, std::string> > determineRanking() const;
+
+      //writes the beginning of an event record, the attributes are appended by the caller
+      std::ostream& beginEvent(const std::string& strEvent);
+      void endEvent();
+      void writeResults(const std::vector<std::pair<int, std::string> >& ranking);
+      static std::string getQuoted(const std::string& str);
+
       SubmarineTable m_SubmarineTable;
       KillTable m_KillTable;
+
+      std::string m_strStatisticsPath;
+      std::string m_strBattleID;
+      std::string m_strWorld;
+      std::vector<char> m_EventBuffer;
+      std::ofstream m_EventStream;
+      std::shared_ptr<CSWTournamentResults> m_pTournamentResults;
   };
 
 }
\ No newline at end of file
@@ -0,0 +1,165 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#include "CorePrecompiledHeader.h"
+#include "CSWBearingSpectrum.h"
+
+
+namespace CodeSubWars
+{
+
+  bool operator == (const CSWBearing& lhs, const CSWBearing& rhs)
+  {
+    return lhs.vecWorldTDirection == rhs.vecWorldTDirection &&
+           fabs(lhs.fAzimuth - rhs.fAzimuth) < EPSILON &&
+           fabs(lhs.fElevation - rhs.fElevation) < EPSILON &&
+           fabs(lhs.fLevel - rhs.fLevel) < EPSILON;
+  }
+
+
+
+  CSWBearingSpectrum::PtrType CSWBearingSpectrum::create(double fResolution)
+  {
+    return PtrType(new CSWBearingSpectrum(fResolution));
+  }
+
+
+  CSWBearingSpectrum::~CSWBearingSpectrum()
+  {
+  }
+
+
+  void CSWBearingSpectrum::reset(const Matrix44D& matWorldTReceiver, const Vector3D& vecWorldTIgnoreCenter, double fIgnoreRadius)
+  {
+    std::vector<int>::const_iterator it = m_UsedBins.begin();
+    for (; it != m_UsedBins.end(); ++it)
+    {
+      m_Bins[*it].fPressure = 0;
+      m_Bins[*it].vecWorldTDirection = Vector3D::ZERO;
+    }
+    m_UsedBins.clear();
+
+    m_matWorldTReceiver = matWorldTReceiver;
+    m_vecWorldTIgnoreCenter = vecWorldTIgnoreCenter;
+    m_fIgnoreRadius = fIgnoreRadius;
+  }
+
+
+  void CSWBearingSpectrum::addSound(const Vector3D& vecWorldTPosEmitter, const double& fLevel)
+  {
+    if (fLevel <= 0 || (vecWorldTPosEmitter - m_vecWorldTIgnoreCenter).getLength() < m_fIgnoreRadius)
+      return;
+
+    Vector3D vecWorldTReceiverToEmitter = vecWorldTPosEmitter - m_matWorldTReceiver.getTranslation();
+    double fDistance = vecWorldTReceiverToEmitter.getLength();
+    if (fDistance < EPSILON)
+      return;
+    Vector3D vecWorldTDirection = vecWorldTReceiverToEmitter/fDistance;
+
+    double fLeft = vecWorldTDirection*m_matWorldTReceiver.getXAxis();
+    double fUp = vecWorldTDirection*m_matWorldTReceiver.getYAxis();
+    double fForward = vecWorldTDirection*m_matWorldTReceiver.getZAxis();
+    double fAzimuth = ARSTD::getInDegree(atan2(fLeft, fForward));
+    double fElevation = ARSTD::getInDegree(asin(std::max(-1.0, std::min(1.0, fUp))));
+
+    int nAzimuth = static_cast<int>((fAzimuth + 180)/m_fResolution) % m_nNumberAzimuthBins;
+    int nElevation = std::min(static_cast<int>((fElevation + 90)/m_fResolution), m_nNumberElevationBins - 1);
+    int nBinIndex = calcBinIndex(nAzimuth, nElevation);
+
+    if (fDistance < 1)
+      fDistance = 1;
+    double fPressure = fLevel/fDistance; //sound pressure is proportional to 1/r
+
+    Bin& bin = m_Bins[nBinIndex];
+    if (bin.fPressure == 0)
+      m_UsedBins.push_back(nBinIndex);
+    bin.fPressure += fPressure;
+    bin.vecWorldTDirection += vecWorldTDirection*fPressure;
+  }
+
+
+  CSWBearingSpectrum::BearingContainer CSWBearingSpectrum::getPeaks(const double& fMinLevel) const
+  {
+    BearingContainer bearings;
+    std::vector<int>::const_iterator it = m_UsedBins.begin();
+    for (; it != m_UsedBins.end(); ++it)
+    {
+      const Bin& bin = m_Bins[*it];
+      double fLevel = 20*ARSTD::log10(bin.fPressure);
+      if (fLevel < fMinLevel || !isPeak(*it))
+        continue;
+
+      CSWBearing bearing;
+      bearing.vecWorldTDirection = bin.vecWorldTDirection.getNormalized();
+      double fUp = bearing.vecWorldTDirection*m_matWorldTReceiver.getYAxis();
+      bearing.fAzimuth = ARSTD::getInDegree(atan2(bearing.vecWorldTDirection*m_matWorldTReceiver.getXAxis(),
+                                                  bearing.vecWorldTDirection*m_matWorldTReceiver.getZAxis()));
+      bearing.fElevation = ARSTD::getInDegree(asin(std::max(-1.0, std::min(1.0, fUp))));
+      bearing.fLevel = fLevel;
+      bearings.push_back(bearing);
+    }
+
+    std::sort(bearings.begin(), bearings.end(),
+              [](const CSWBearing& lhs, const CSWBearing& rhs) { return lhs.fLevel > rhs.fLevel; });
+    return bearings;
+  }
+
+
+  const double& CSWBearingSpectrum::getResolution() const
+  {
+    return m_fResolution;
+  }
+
+
+  CSWBearingSpectrum::CSWBearingSpectrum(double fResolution)
+  : m_fResolution(std::max(1.0, std::min(90.0, fResolution))),
+    m_nNumberAzimuthBins(static_cast<int>(ceil(360/m_fResolution))),
+    m_nNumberElevationBins(static_cast<int>(ceil(180/m_fResolution))),
+    m_fIgnoreRadius(0)
+  {
+    Bin emptyBin;
+    emptyBin.fPressure = 0;
+    emptyBin.vecWorldTDirection = Vector3D::ZERO;
+    m_Bins.resize(m_nNumberAzimuthBins*m_nNumberElevationBins, emptyBin);
+  }
+
+
+  int CSWBearingSpectrum::calcBinIndex(int nAzimuth, int nElevation) const
+  {
+    assert(nAzimuth >= 0 && nAzimuth < m_nNumberAzimuthBins);
+    assert(nElevation >= 0 && nElevation < m_nNumberElevationBins);
+    return nElevation*m_nNumberAzimuthBins + nAzimuth;
+  }
+
+
+  bool CSWBearingSpectrum::isPeak(int nBinIndex) const
+  {
+    int nAzimuth = nBinIndex % m_nNumberAzimuthBins;
+    int nElevation = nBinIndex/m_nNumberAzimuthBins;
+    double fPressure = m_Bins[nBinIndex].fPressure;
+
+    for (int nDeltaElevation = -1; nDeltaElevation <= 1; ++nDeltaElevation)
+    {
+      int nNeighborElevation = nElevation + nDeltaElevation;
+      if (nNeighborElevation < 0 || nNeighborElevation >= m_nNumberElevationBins)
+        continue;
+
+      for (int nDeltaAzimuth = -1; nDeltaAzimuth <= 1; ++nDeltaAzimuth)
+      {
+        //the azimuth wraps around behind the receiver
+        int nNeighborAzimuth = (nAzimuth + nDeltaAzimuth + m_nNumberAzimuthBins) % m_nNumberAzimuthBins;
+        int nNeighborIndex = calcBinIndex(nNeighborAzimuth, nNeighborElevation);
+        if (nNeighborIndex == nBinIndex)
+          continue;
+
+        //of equally loud neighbors only the first one is a peak
+        double fNeighborPressure = m_Bins[nNeighborIndex].fPressure;
+        if (fNeighborPressure > fPressure || (fNeighborPressure == fPressure && nNeighborIndex < nBinIndex))
+          return false;
+      }
+    }
+    return true;
+  }
+
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#pragma once
+
+
+namespace CodeSubWars
+{
+
+  /**
+   * A direction from which sound has been received.
+   */
+  struct CSWBearing
+  {
+    Vector3D vecWorldTDirection;    ///< The normalized direction to the sound source in world coordinate system.
+    double fAzimuth;                ///< The horizontal angle in degree relative to the forward direction of the receiver
+                                    ///< in range [-180, 180]. Positive angles are on the left side.
+    double fElevation;              ///< The vertical angle in degree relative to the horizontal plane of the receiver in
+                                    ///< range [-90, 90]. Positive angles are above.
+    double fLevel;                  ///< The sound pressure level (SPL) in decibel (dB) received from this direction.
+  };
+
+
+  bool operator == (const CSWBearing& lhs, const CSWBearing& rhs);
+
+
+  /**
+   * Collects all received sounds of one tick into bins of azimuth and elevation around the receiver and finds the
+   * directions of local maxima. Unlike the beam of CSWSoundReceiver every sound is accounted with its full level, so
+   * the directions of all sources are available after one tick. Sounds of the same bin are summed up as sound
+   * pressure and the direction of a bin is the pressure weighted mean of its sounds.
+   */
+  class CSWBearingSpectrum
+  {
+    public:
+      typedef std::shared_ptr<CSWBearingSpectrum> PtrType;
+      typedef std::vector<CSWBearing> BearingContainer;
+
+      /**
+       * @param fResolution The size of a bin in degree. This is clamped to [1, 90].
+       */
+      static PtrType create(double fResolution = 5);
+
+      ~CSWBearingSpectrum();
+
+      /**
+       * Removes all sounds and sets the orientation and position of the receiver for the following sounds. Sounds
+       * closer than the given radius to the given center are ignored (e.g. the own engines).
+       */
+      void reset(const Matrix44D& matWorldTReceiver, const Vector3D& vecWorldTIgnoreCenter, double fIgnoreRadius);
+
+      void addSound(const Vector3D& vecWorldTPosEmitter, const double& fLevel);
+
+      /**
+       * @return The directions with a level of at least the given level (in dB) that are louder than their
+       *         neighborhood, sorted by descending level.
+       */
+      BearingContainer getPeaks(const double& fMinLevel) const;
+
+      const double& getResolution() const;
+
+    protected:
+      struct Bin
+      {
+        double fPressure;
+        Vector3D vecWorldTDirection;  //sum of the directions weighted with their pressure
+      };
+
+      CSWBearingSpectrum(double fResolution);
+
+      int calcBinIndex(int nAzimuth, int nElevation) const;
+      bool isPeak(int nBinIndex) const;
+
+      double m_fResolution;
+      int m_nNumberAzimuthBins;
+      int m_nNumberElevationBins;
+
+      Matrix44D m_matWorldTReceiver;
+      Vector3D m_vecWorldTIgnoreCenter;
+      double m_fIgnoreRadius;
+
+      std::vector<Bin> m_Bins;
+      //the indices of the bins that received sound since the last reset
+      std::vector<int> m_UsedBins;
+  };
+
+}
\ No newline at end of file
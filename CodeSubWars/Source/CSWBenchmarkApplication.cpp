@@ -0,0 +1,552 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#include "CorePrecompiledHeader.h"
+#include "CSWBenchmarkApplication.h"
+#include "Constants.h"
+#include "CSWWorld.h"
+#include "CSWObject.h"
+#include "CSWLog.h"
+#include "CSWSettings.h"
+#include "CSWUtilities.h"
+#include "GreenMine.h"
+#include "Magnet.h"
+
+
+namespace CodeSubWars
+{
+
+  namespace
+  {
+    //phases below this cost in milliseconds per step are dominated by timer noise and never reported as regression
+    const double MIN_PHASE_COST_DIFFERENCE = 0.01;
+
+
+    //the phase names may contain characters that are not allowed in xml element names
+    std::string getPhaseKey(const std::string& strPhase)
+    {
+      std::string strKey;
+      for (std::string::const_iterator it = strPhase.begin(); it != strPhase.end(); ++it)
+      {
+        if (isalnum(static_cast<unsigned char>(*it)))
+          strKey += *it;
+      }
+      return strKey;
+    }
+  }
+
+
+  CSWBenchmarkApplication::CSWBenchmarkApplication(int argc, char** argv)
+  : m_bParametersValid(true),
+    m_strScenario("all"),
+    m_fDuration(60),
+    m_nTeamSize(0),
+    m_fTimeStep(0.01),
+    m_strBaselineFileName("Test/Benchmark/baseline.xml"),
+    m_fTolerance(0.1),
+    m_bWriteBaseline(false),
+    m_bAllowMissingBaseline(false),
+    m_strOutputFileName("log/benchmark.jsonl")
+  {
+    int nReadData = 0;
+    for (int i = 0; i < argc - 1 && m_bParametersValid; ++i)
+    {
+      std::pair<ParameterType, std::string> result = determineParameterType(argv[i + 1]);
+      switch (result.first)
+      {
+        case UNKNOWN:
+        {
+          m_bParametersValid = false;
+          break;
+        }
+        case RUNNING_MODE:
+        {
+          m_bParametersValid &= result.second == "benchmark";
+          break;
+        }
+        case SCENARIO_TYPE:
+        {
+          m_strScenario = result.second;
+          bool bFound = m_strScenario == "all";
+          std::vector<Scenario> scenarios = createScenarios();
+          for (std::vector<Scenario>::const_iterator it = scenarios.begin(); it != scenarios.end(); ++it)
+            bFound |= it->strName == m_strScenario;
+          m_bParametersValid &= bFound;
+          break;
+        }
+        case DURATION_TYPE:
+        {
+          double t = atof(result.second.c_str());
+          if (t > 0)
+            m_fDuration = t;
+          else
+            m_bParametersValid = false;
+          break;
+        }
+        case TEAMSIZE_TYPE:
+        {
+          int t = atoi(result.second.c_str());
+          if (t >= 1 && t <= 100)
+            m_nTeamSize = t;
+          else
+            m_bParametersValid = false;
+          break;
+        }
+        case TIMESTEP_TYPE:
+        {
+          double t = atof(result.second.c_str());
+          if (t >= 0.01 && t <= 0.1)
+            m_fTimeStep = t;
+          else
+            m_bParametersValid = false;
+          break;
+        }
+        case BASELINE_TYPE:
+        {
+          m_strBaselineFileName = result.second;
+          m_bParametersValid &= !m_strBaselineFileName.empty();
+          break;
+        }
+        case TOLERANCE_TYPE:
+        {
+          double t = atof(result.second.c_str());
+          if (t >= 0 && t < 1)
+            m_fTolerance = t;
+          else
+            m_bParametersValid = false;
+          break;
+        }
+        case WRITE_BASELINE_TYPE:
+        {
+          m_bWriteBaseline = true;
+          break;
+        }
+        case ALLOW_MISSING_BASELINE_TYPE:
+        {
+          m_bAllowMissingBaseline = true;
+          break;
+        }
+        case OUTPUT_TYPE:
+        {
+          m_strOutputFileName = result.second;
+          m_bParametersValid &= !m_strOutputFileName.empty();
+          break;
+        }
+      }
+      nReadData |= result.first;
+    }
+
+    //at least running mode must given
+    m_bParametersValid &= (nReadData & RUNNING_MODE) != 0;
+  }
+
+
+  CSWBenchmarkApplication::~CSWBenchmarkApplication()
+  {
+  }
+
+
+  int CSWBenchmarkApplication::run()
+  {
+    std::cout << "CodeSubWars v" << Constants::getVersion().getAsString() << " beta\n";
+    std::cout << "Copyright (c) 2005-2022 " << Constants::AUTHOR << ". All rights reserved.\n";
+    std::cout << "Released under the MIT license. (see license.txt)\n\n";
+
+    if (!m_bParametersValid)
+    {
+      showSyntax();
+      return 2;
+    }
+
+    CSWLog::getInstance()->log("starting in benchmark mode ...");
+
+    //periodic storing and automatic stopping would falsify the measurement. the original settings are
+    //restored afterwards because they are written back to the preferences on exit.
+    int nVariousProperties = CSWWorld::getInstance()->getSettings()->getVariousProperties();
+    CSWWorld::getInstance()->getSettings()->setVariousProperties(nVariousProperties &
+                                                                 ~CSWSettings::STORE_WORLD_PERIODICALLY &
+                                                                 ~CSWSettings::AUTOMATIC_BATTLE_STOP);
+
+    std::ofstream os(m_strOutputFileName.c_str(), std::ios::out | std::ios::app);
+    if (!os.is_open())
+      CSWLog::getInstance()->log("could not open " + m_strOutputFileName + " -> results are only written to console");
+
+    std::vector<Result> results;
+    std::vector<Scenario> scenarios = createScenarios();
+    std::vector<Scenario>::const_iterator it = scenarios.begin();
+    for (; it != scenarios.end(); ++it)
+    {
+      if (m_strScenario != "all" && m_strScenario != it->strName)
+        continue;
+
+      Result result = runScenario(*it);
+      results.push_back(result);
+
+      std::string strJSON = toJSON(result);
+      std::cout << strJSON << "\n";
+      if (os.is_open())
+        os << strJSON << "\n";
+    }
+    os.close();
+
+    CSWWorld::getInstance()->getSettings()->setVariousProperties(nVariousProperties);
+
+    if (m_bWriteBaseline)
+    {
+      writeBaseline(results);
+      return 0;
+    }
+    return compareWithBaseline(results) ? 0 : 1;
+  }
+
+
+  std::vector<CSWBenchmarkApplication::Scenario> CSWBenchmarkApplication::createScenarios()
+  {
+    std::vector<Scenario> scenarios;
+
+    //many submarines doing nothing but being simulated
+    Scenario s = { "idle", CSWWorld::DEFAULT_1, "Test/Benchmark/Idle", 20, 0, 0 };
+    scenarios.push_back(s);
+
+    //armed mines in a grid between the submarines, magnets drag objects through the field
+    Scenario s2 = { "minefield", CSWWorld::DEFAULT_1, "Test/Benchmark/Idle", 5, 5, 4 };
+    scenarios.push_back(s2);
+
+    //every submarine empties its weapon batteries
+    Scenario s3 = { "torpedoes", CSWWorld::DEFAULT_1, "Test/Benchmark/TorpedoSwarm", 10, 0, 0 };
+    scenarios.push_back(s3);
+
+    //the black hole drags all submarines to the center
+    Scenario s4 = { "blackhole", CSWWorld::DEFAULT_4, "Test/Benchmark/Idle", 10, 0, 0 };
+    scenarios.push_back(s4);
+
+    //all passive sonar test submarines scanning simultaneously
+    Scenario s5 = { "sonar", CSWWorld::DEFAULT_1, "Test/Sensor/PassiveSonar", 3, 0, 0 };
+    scenarios.push_back(s5);
+
+    return scenarios;
+  }
+
+
+  std::vector<std::pair<std::string, double> > CSWBenchmarkApplication::getPhaseCosts(const Result& result)
+  {
+    std::vector<std::pair<std::string, double> > phaseCosts;
+    std::vector<std::pair<std::string, double> >::const_iterator it = result.load.begin();
+    for (; it != result.load.end(); ++it)
+      phaseCosts.push_back(std::make_pair(it->first, result.nNumSteps ? it->second*1000/result.nNumSteps : 0));
+    return phaseCosts;
+  }
+
+
+  CSWBenchmarkApplication::Result CSWBenchmarkApplication::runScenario(const Scenario& scenario)
+  {
+    CSWLog::getInstance()->log("running scenario " + scenario.strName + " ...");
+
+    Result result;
+    result.strScenario = scenario.strName;
+    result.nNumSubmarines = 0;
+    result.nNumSteps = 0;
+    result.nMaxNumObjects = 0;
+    result.fSimulatedTime = 0;
+    result.fRealTime = 0;
+
+    CSWUtilities::SubmarineFileContainer submarines = CSWUtilities::determineAvailableSubmarines(scenario.strSubmarinePath);
+    if (submarines.empty())
+    {
+      CSWLog::getInstance()->log("no submarines found in " + scenario.strSubmarinePath + " -> scenario skipped");
+      return result;
+    }
+
+    int nTeamSize = m_nTeamSize ? m_nTeamSize : scenario.nTeamSize;
+    CSWWorld::getInstance()->newWorld(scenario.worldType);
+    CSWWorld::getInstance()->newBattle(submarines, CSWWorld::TEAM, nTeamSize, ARSTD::Time::MANUAL);
+    if (!CSWWorld::getInstance()->isBattleRunning())
+    {
+      CSWLog::getInstance()->log("battle could not be started -> scenario skipped");
+      CSWWorld::getInstance()->finalizeWorld();
+      return result;
+    }
+    result.nNumSubmarines = static_cast<int>(submarines.size())*nTeamSize;
+
+    setupMineField(scenario);
+
+    double fStartRealTime = ARSTD::Time::getRealTime();
+    while (!ARSTD::Console::isKeyPressed() && CSWWorld::getInstance()->isBattleRunning() && ARSTD::Time::getTime() < m_fDuration)
+    {
+      CSWWorld::getInstance()->recalculate();
+      ARSTD::Time::step(m_fTimeStep);
+      ++result.nNumSteps;
+
+      result.nMaxNumObjects = std::max(result.nMaxNumObjects,
+                                       CSWWorld::getInstance()->getObjectTree()->getTotalChildNumber());
+    }
+    result.fRealTime = ARSTD::Time::getRealTime() - fStartRealTime;
+    result.fSimulatedTime = ARSTD::Time::getTime();
+    result.load = CSWWorld::getInstance()->getAccumulatedLoad();
+
+    CSWWorld::getInstance()->finalizeBattle();
+    CSWWorld::getInstance()->finalizeWorld();
+
+    return result;
+  }
+
+
+  void CSWBenchmarkApplication::setupMineField(const Scenario& scenario)
+  {
+    const double SPACING = 300;
+    double fOffset = (scenario.nNumMinesPerAxis - 1)*SPACING*0.5;
+    for (int x = 0; x < scenario.nNumMinesPerAxis; ++x)
+    {
+      for (int y = 0; y < scenario.nNumMinesPerAxis; ++y)
+      {
+        for (int z = 0; z < scenario.nNumMinesPerAxis; ++z)
+        {
+          Matrix44D mat(Vector3D(x*SPACING - fOffset, y*SPACING - fOffset, z*SPACING - fOffset));
+          GreenMine::PtrType pMine = GreenMine::create("BenchmarkMine", Matrix44D(), 1);
+          pMine->initializeDynamic(mat, Vector3D(0, 0, 0), Vector3D(0, 0, 0));
+          pMine->setShooterName("BenchmarkMineField");
+          pMine->setShooterSubmarine(false);
+          pMine->arm(0);
+          CSWWorld::getInstance()->addObject(pMine, false);
+          pMine->launch(0);
+        }
+      }
+    }
+
+    for (int i = 0; i < scenario.nNumMagnets; ++i)
+    {
+      double fAngle = 2*PI*i/scenario.nNumMagnets;
+      Matrix44D mat(Vector3D(cos(fAngle)*fOffset, 0, sin(fAngle)*fOffset));
+      Magnet::PtrType pMagnet = Magnet::create("BenchmarkMagnet", Matrix44D(), Size3D(10, 10, 10));
+      pMagnet->initializeDynamic(mat, Vector3D(0, 0, 0), Vector3D(0, 0, 0));
+      CSWWorld::getInstance()->addObject(pMagnet);
+    }
+  }
+
+
+  std::string CSWBenchmarkApplication::toJSON(const Result& result) const
+  {
+    std::stringstream ss;
+    ss.precision(6);
+    ss << "{\"version\": \"" << Constants::getVersion().getAsString() << "\""
+       << ", \"scenario\": \"" << result.strScenario << "\""
+       << ", \"submarines\": " << result.nNumSubmarines
+       << ", \"timestep\": " << m_fTimeStep
+       << ", \"steps\": " << result.nNumSteps
+       << ", \"objects\": " << result.nMaxNumObjects
+       << ", \"simulated\": " << result.fSimulatedTime
+       << ", \"wall\": " << result.fRealTime
+       << ", \"ratio\": " << (result.fRealTime > 0 ? result.fSimulatedTime/result.fRealTime : 0)
+       << ", \"phases\": {";
+    std::vector<std::pair<std::string, double> > phaseCosts = getPhaseCosts(result);
+    std::vector<std::pair<std::string, double> >::const_iterator it = phaseCosts.begin();
+    for (; it != phaseCosts.end(); ++it)
+    {
+      if (it != phaseCosts.begin())
+        ss << ", ";
+      ss << "\"" << it->first << "\": " << it->second;
+    }
+    ss << "}}";
+    return ss.str();
+  }
+
+
+  bool CSWBenchmarkApplication::compareWithBaseline(const std::vector<Result>& results) const
+  {
+    boost::property_tree::ptree baseline;
+    try
+    {
+      read_xml(m_strBaselineFileName, baseline);
+    }
+    catch (boost::property_tree::xml_parser_error&)
+    {
+      if (m_bAllowMissingBaseline)
+      {
+        CSWLog::getInstance()->log("no baseline available in " + m_strBaselineFileName + " -> comparison skipped");
+        return true;
+      }
+      CSWLog::getInstance()->log("no baseline available in " + m_strBaselineFileName + " -> FAILED");
+      return false;
+    }
+
+    bool bResult = true;
+    std::vector<Result>::const_iterator it = results.begin();
+    for (; it != results.end(); ++it)
+    {
+      double fBaselineRatio = baseline.get("Benchmark." + it->strScenario + ".Ratio", 0.0);
+      if (fBaselineRatio <= 0)
+      {
+        CSWLog::getInstance()->log(it->strScenario + ": no baseline" + (m_bAllowMissingBaseline ? "" : " -> FAILED"));
+        bResult &= m_bAllowMissingBaseline;
+        continue;
+      }
+
+      double fRatio = it->fRealTime > 0 ? it->fSimulatedTime/it->fRealTime : 0;
+      std::stringstream ss;
+      ss.precision(2);
+      ss.setf(std::ios::fixed);
+      ss << it->strScenario << ": ratio " << fRatio << " baseline " << fBaselineRatio;
+      if (fRatio < fBaselineRatio*(1 - m_fTolerance))
+      {
+        ss << " -> REGRESSION";
+        bResult = false;
+      }
+      CSWLog::getInstance()->log(ss.str());
+
+      //a phase may become slower while another one gets faster by the same amount
+      std::vector<std::pair<std::string, double> > phaseCosts = getPhaseCosts(*it);
+      std::vector<std::pair<std::string, double> >::const_iterator itPhase = phaseCosts.begin();
+      for (; itPhase != phaseCosts.end(); ++itPhase)
+      {
+        double fBaselineCost = baseline.get("Benchmark." + it->strScenario + ".Phases." + getPhaseKey(itPhase->first), -1.0);
+        std::stringstream ssPhase;
+        ssPhase.precision(3);
+        ssPhase.setf(std::ios::fixed);
+        ssPhase << it->strScenario << ": " << itPhase->first << " " << itPhase->second << "ms";
+        if (fBaselineCost < 0)
+        {
+          ssPhase << " no baseline";
+          if (!m_bAllowMissingBaseline)
+          {
+            ssPhase << " -> FAILED";
+            bResult = false;
+          }
+        }
+        else
+        {
+          ssPhase << " baseline " << fBaselineCost << "ms";
+          if (itPhase->second > fBaselineCost*(1 + m_fTolerance) && itPhase->second - fBaselineCost > MIN_PHASE_COST_DIFFERENCE)
+          {
+            ssPhase << " -> REGRESSION";
+            bResult = false;
+          }
+        }
+        CSWLog::getInstance()->log(ssPhase.str());
+      }
+    }
+    return bResult;
+  }
+
+
+  void CSWBenchmarkApplication::writeBaseline(const std::vector<Result>& results) const
+  {
+    boost::property_tree::ptree baseline;
+    try
+    {
+      read_xml(m_strBaselineFileName, baseline);
+    }
+    catch (boost::property_tree::xml_parser_error&)
+    {
+    }
+
+    std::vector<Result>::const_iterator it = results.begin();
+    for (; it != results.end(); ++it)
+    {
+      if (it->fRealTime <= 0)
+        continue;
+      baseline.put("Benchmark." + it->strScenario + ".Ratio", it->fSimulatedTime/it->fRealTime);
+      baseline.put("Benchmark." + it->strScenario + ".Version", Constants::getVersion().getAsString());
+
+      std::vector<std::pair<std::string, double> > phaseCosts = getPhaseCosts(*it);
+      std::vector<std::pair<std::string, double> >::const_iterator itPhase = phaseCosts.begin();
+      for (; itPhase != phaseCosts.end(); ++itPhase)
+        baseline.put("Benchmark." + it->strScenario + ".Phases." + getPhaseKey(itPhase->first), itPhase->second);
+    }
+    write_xml(m_strBaselineFileName, baseline);
+    CSWLog::getInstance()->log("baseline written to " + m_strBaselineFileName);
+  }
+
+
+  std::pair<CSWBenchmarkApplication::ParameterType, std::string> CSWBenchmarkApplication::determineParameterType(const std::string& value)
+  {
+    std::pair<ParameterType, std::string> result(UNKNOWN, "");
+    if (value.size() <= 2)
+      return result;
+    if (value[0] != '-')
+      return result;
+
+    const std::string RUNNING_MODE_KEY = "benchmark";
+    const std::string WRITE_BASELINE_KEY = "writebaseline";
+    const std::string ALLOW_MISSING_BASELINE_KEY = "allowmissingbaseline";
+
+    if (value.substr(1, value.size() - 1) == RUNNING_MODE_KEY)
+    {
+      result.first = RUNNING_MODE;
+      result.second = value.substr(1, value.size() - 1);
+      return result;
+    }
+
+    if (value.substr(1, value.size() - 1) == WRITE_BASELINE_KEY)
+    {
+      result.first = WRITE_BASELINE_TYPE;
+      return result;
+    }
+
+    if (value.substr(1, value.size() - 1) == ALLOW_MISSING_BASELINE_KEY)
+    {
+      result.first = ALLOW_MISSING_BASELINE_TYPE;
+      return result;
+    }
+
+    const std::pair<std::string, ParameterType> KEYS[] =
+    {
+      std::make_pair(std::string("scenario"), SCENARIO_TYPE),
+      std::make_pair(std::string("duration"), DURATION_TYPE),
+      std::make_pair(std::string("teamsize"), TEAMSIZE_TYPE),
+      std::make_pair(std::string("timestep"), TIMESTEP_TYPE),
+      std::make_pair(std::string("baseline"), BASELINE_TYPE),
+      std::make_pair(std::string("tolerance"), TOLERANCE_TYPE),
+      std::make_pair(std::string("output"), OUTPUT_TYPE)
+    };
+
+    for (size_t i = 0; i < sizeof(KEYS)/sizeof(KEYS[0]); ++i)
+    {
+      if (value.compare(1, KEYS[i].first.size() + 1, KEYS[i].first + "=") == 0)
+      {
+        result.first = KEYS[i].second;
+        result.second = value.substr(KEYS[i].first.size() + 2);
+        return result;
+      }
+    }
+
+    return result;
+  }
+
+
+  void CSWBenchmarkApplication::showSyntax()
+  {
+    std::cout << "Measures the simulation speed of predefined scenarios without graphical output.\n";
+    std::cout << "\n";
+    std::cout << "Syntax: CodeSubWars -benchmark [-scenario=<all|idle|minefield|torpedoes|blackhole|sonar>] [-duration=x]\n";
+    std::cout << "                    [-teamsize=n] [-timestep=x] [-baseline=file] [-tolerance=x] [-writebaseline]\n";
+    std::cout << "                    [-allowmissingbaseline] [-output=file]\n";
+    std::cout << "\n";
+    std::cout << "  -benchmark      Runs the application in benchmark mode. The other parameters are only valid when this is set.\n";
+    std::cout << "\n";
+    std::cout << "  -scenario       The scenario that should be run. Default is all.\n";
+    std::cout << "\n";
+    std::cout << "  -duration       The simulated time in seconds each scenario is run. Default is 60.\n";
+    std::cout << "\n";
+    std::cout << "  -teamsize       Overrides the number of instances of each submarine of a scenario. Must be in range\n";
+    std::cout << "                  [1, 100]. Per default each scenario uses its own size.\n";
+    std::cout << "\n";
+    std::cout << "  -timestep       The time step in seconds for each simulation step. The given value must be in range\n";
+    std::cout << "                  [0.01, 0.1]. Default is 0.01.\n";
+    std::cout << "\n";
+    std::cout << "  -baseline       The file that contains the baseline ratios and phase costs. Default is\n";
+    std::cout << "                  Test/Benchmark/baseline.xml.\n";
+    std::cout << "\n";
+    std::cout << "  -tolerance      The fraction the ratio of simulated to real time may fall below and the cost of each\n";
+    std::cout << "                  simulation phase may rise above the baseline before it is reported as regression.\n";
+    std::cout << "                  Default is 0.1.\n";
+    std::cout << "\n";
+    std::cout << "  -writebaseline  Stores the measured ratios and phase costs as new baseline instead of comparing them.\n";
+    std::cout << "\n";
+    std::cout << "  -allowmissingbaseline\n";
+    std::cout << "                  Passes scenarios and phases without baseline. Per default they fail the comparison.\n";
+    std::cout << "\n";
+    std::cout << "  -output         The file the results are appended to as json lines. Default is log/benchmark.jsonl.\n";
+  }
+
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#pragma once
+
+#include "CSWWorld.h"
+
+
+namespace CodeSubWars
+{
+
+  /**
+   * Runs predefined battle scenarios without graphical output and measures how fast the world is
+   * simulated. Each scenario isolates a part of the engine (dynamics, collision, weapons, sensors).
+   * The results are written as one json object per line and can be compared against stored baselines.
+   */
+  class CSWBenchmarkApplication
+  {
+    public:
+
+      CSWBenchmarkApplication(int argc, char** argv);
+      ~CSWBenchmarkApplication();
+
+      /**
+       * Runs the selected scenarios.
+       * @return Returns 0 on success, 1 if at least one scenario or simulation phase is slower than its
+       *         baseline allows or has no baseline and 2 if the parameters are invalid.
+       */
+      int run();
+
+    protected:
+      enum ParameterType
+      {
+        UNKNOWN = 0,
+        RUNNING_MODE = 1,
+        SCENARIO_TYPE = 2,
+        DURATION_TYPE = 4,
+        TEAMSIZE_TYPE = 8,
+        TIMESTEP_TYPE = 16,
+        BASELINE_TYPE = 32,
+        TOLERANCE_TYPE = 64,
+        WRITE_BASELINE_TYPE = 128,
+        OUTPUT_TYPE = 256,
+        ALLOW_MISSING_BASELINE_TYPE = 512
+      };
+
+      struct Scenario
+      {
+        std::string strName;
+        CSWWorld::WorldType worldType;
+        std::string strSubmarinePath;
+        int nTeamSize;
+        int nNumMinesPerAxis;
+        int nNumMagnets;
+      };
+
+      struct Result
+      {
+        std::string strScenario;
+        int nNumSubmarines;
+        int nNumSteps;
+        int nMaxNumObjects;
+        double fSimulatedTime;
+        double fRealTime;
+        std::vector<std::pair<std::string, double> > load;
+      };
+
+      static std::vector<Scenario> createScenarios();
+
+      /**
+       * @return The costs of the simulation phases in milliseconds per step.
+       */
+      static std::vector<std::pair<std::string, double> > getPhaseCosts(const Result& result);
+
+      Result runScenario(const Scenario& scenario);
+      void setupMineField(const Scenario& scenario);
+
+      std::string toJSON(const Result& result) const;
+      bool compareWithBaseline(const std::vector<Result>& results) const;
+      void writeBaseline(const std::vector<Result>& results) const;
+
+      std::pair<ParameterType, std::string> determineParameterType(const std::string& value);
+
+      void showSyntax();
+
+      bool m_bParametersValid;
+      std::string m_strScenario;
+      double m_fDuration;
+      int m_nTeamSize;
+      double m_fTimeStep;
+      std::string m_strBaselineFileName;
+      double m_fTolerance;
+      bool m_bWriteBaseline;
+      bool m_bAllowMissingBaseline;
+      std::string m_strOutputFileName;
+  };
+
+}
\ No newline at end of file
@@ -2,7 +2,7 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWBlackHole.h"
 #include "CSWIDynamic.h"
 
@@ -36,7 +36,7 @@ namespace CodeSubWars
     double fDist;  
     Vector3D vecWorldTMassPoint;
     CSWIDynamic::MassPointContainerRange range = pDynamic->getMassPointRange();
-    CSWIDynamic::MassPointContainer::iterator itMassPoint = range.first;
+    CSWIDynamic::MassPointContainer::const_iterator itMassPoint = range.first;
     for (; itMassPoint != range.second; ++itMassPoint)
     {
       vecWorldTMassPoint = pObject->getWorldTransform()*itMassPoint->first;
@@ -2,13 +2,14 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWBorder.h"
 #include "CSWEvent.h"
 #include "CSWCollisionDetectedMessage.h"
 
 #include "CSWSolid.h"
 #include "CSWCollideable.h"
+#include "CSWShapeCache.h"
 
 
 namespace CodeSubWars
@@ -19,47 +20,10 @@ namespace CodeSubWars
   }
 
 
-  void CSWBorder::draw()
+  void CSWBorder::collectRenderData(CSWRenderFrame& frame, CSWRenderFrame::Entry& entry)
   {
-
-  //   glPushAttrib(GL_ALL_ATTRIB_BITS);
-  // 
-  //     glDisable(GL_CULL_FACE);
-  //     
-  //     glEnable(GL_COLOR_MATERIAL);
-  //     glColorMaterial(GL_FRONT, GL_DIFFUSE);
-  // 
-  //     glEnable(GL_BLEND);
-  //     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-  // 
-  //     glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-  // 
-  //     glShadeModel(GL_FLAT);
-  //     glEnable(GL_LIGHTING);
-  //     glEnable(GL_LIGHT0);
-  //     glColor4dv(getColor().pData);
-  // 
-  //     glEnable(GL_DEPTH_TEST);
-  //     glDepthMask(false);
-  //     
-  //     m_pSolid->getMesh()->render();
-  // 
-  //     
-  //     glDisable(GL_BLEND);
-  //     glDisable(GL_LIGHTING);
-  //     glColor3dv(getColor().pData);
-  //     glLineWidth(2);
-  //     glBegin(GL_LINES);
-  //       for (int iCnt = 0; iCnt < 12; ++iCnt) 
-  //       {
-  //         glVertex3dv(m_pSolid->getBoundingBox().getSegment(iCnt).getPoint1().pData);
-  //           glVertex3dv(m_pSolid->getBoundingBox().getSegment(iCnt).getPoint2().pData);
-  //       } 
-  //     glEnd();
-  //   glPopAttrib();
-
-    //for debugging collision
-    m_pCollideable->draw(getTransform());
+    //the border itself is invisible, only for debugging collision
+    m_pCollideable->collectRenderData(frame, entry.matWorldTransform);
   }
 
 
@@ -90,19 +54,10 @@ namespace CodeSubWars
   CSWBorder::CSWBorder(const std::string& strName, const Matrix44D& matBaseTObject, const Size3D& size)
   : CSWObject(strName, matBaseTObject)
   {
-    Matrix44D mat1(Vector3D(1, 0, 0),
-                   Vector3D(0, 1, 0),
-                   Vector3D(0, 0, 1),
-                   Vector3D(-size.getWidth()/2.0, -size.getHeight()/2.0, -size.getDepth()/2.0));
-    Mesh::PtrType pSurface = Mesh::createBox(mat1, size);
+    //surface and collision mesh are the same box
+    Mesh::PtrType pSurface = CSWShapeCache::getInstance()->getBoxMesh(Vector3D(-size.getWidth()/2.0, -size.getHeight()/2.0, -size.getDepth()/2.0), size);
     m_pSolid = CSWSolid::create(pSurface);
-
-    Matrix44D mat2(Vector3D(1, 0, 0),
-                   Vector3D(0, 1, 0),
-                   Vector3D(0, 0, 1),
-                   Vector3D(-size.getWidth()/2.0, -size.getHeight()/2.0, -size.getDepth()/2.0));
-    Mesh::PtrType pCollisionMesh = Mesh::createBox(mat2, size);
-    m_pCollideable = CSWCollideable::create(pCollisionMesh);
+    m_pCollideable = CSWCollideable::create(pSurface);
 
     setColor(Vector4D(0, 0, 1, 0.2));
   }
@@ -124,14 +79,14 @@ namespace CodeSubWars
   {
     BoundingBoxD bbox(m_pCollideable->getMesh()->getAxisAlignedBoundingBox());
     Size3D size = bbox.getSize();
-    DT_ShapeHandle hDTShape = DT_NewBox(size.getWidth(), size.getHeight(), size.getDepth());
+    CSWShapeCache::ShapePtrType pDTShape = CSWShapeCache::getInstance()->getBoxShape(size);
 
-    DT_ObjectHandle hDTObject = DT_CreateObject(this, hDTShape);
+    DT_ObjectHandle hDTObject = DT_CreateObject(this, pDTShape.get());
 
     Matrix44D matObjectTCollisionShape(Vector3D(bbox.getCenter()));
-    Mesh::PtrType pCollisionMesh = Mesh::createBox(bbox.getCoordSystem(), bbox.getSize());
+    Mesh::PtrType pCollisionMesh = CSWShapeCache::getInstance()->getBoxMesh(bbox.getCoordSystem().getTranslation(), size);
 
-    m_pCollideable->initializeEnvironment(hDTShape, hDTObject, matObjectTCollisionShape, pCollisionMesh);
+    m_pCollideable->initializeEnvironment(this, pDTShape, hDTObject, matObjectTCollisionShape, pCollisionMesh);
   }
 
 
@@ -143,7 +98,7 @@ namespace CodeSubWars
 
   void CSWBorder::setupTransform()
   {
-    m_pCollideable->setupTransform(getSharedThis());
+    m_pCollideable->setupTransform();
   }
 
 
@@ -28,11 +28,11 @@ namespace CodeSubWars
       virtual ~CSWBorder();
 
       //defined methods for solid
-      virtual void draw();
+      virtual void collectRenderData(CSWRenderFrame& frame, CSWRenderFrame::Entry& entry);
       virtual const Mesh::PtrType getSurface() const;
       virtual const BoundingBoxD& getSurfaceBoundingBox() const;
       virtual void setColor(const Vector4D& vecColor);
-      virtual const Vector4D& CSWBorder::getColor();
+      virtual const Vector4D& getColor();
 
       //defined methods for collideable
       virtual const Mesh::PtrType getCollisionMesh() const;
@@ -0,0 +1,85 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#include "CorePrecompiledHeader.h"
+#include "CSWCPUAccount.h"
+#include "CSWObjectPool.h"
+#include "CSWWorld.h"
+#include "CSWSettings.h"
+#include "CSWPyProfiler.h"
+
+
+namespace CodeSubWars
+{
+
+  const int CSWCPUAccount::NUM_CYCLES = 100;
+
+
+  CSWCPUAccount::PtrType CSWCPUAccount::create()
+  {
+    return CSWObjectPool::create<CSWCPUAccount>([&](void* pBlock) { return new (pBlock) CSWCPUAccount(); });
+  }
+
+
+  CSWCPUAccount::~CSWCPUAccount()
+  {
+  }
+
+
+  bool CSWCPUAccount::add(CallType type, double fTime)
+  {
+    m_Times[type].push_back(fTime);
+    m_TotalTimes[type] += fTime;
+    return getAverageTime(type) > CSWWorld::getInstance()->getSettings()->getCPUBudget();
+  }
+
+
+  double CSWCPUAccount::getAverageTime(CallType type) const
+  {
+    //not yet measured calls count as zero to avoid kicking on a single slow first call
+    return std::accumulate(m_Times[type].begin(), m_Times[type].end(), 0.0) / m_Times[type].capacity();
+  }
+
+
+  double CSWCPUAccount::getTotalTime(CallType type) const
+  {
+    return m_TotalTimes[type];
+  }
+
+
+  double CSWCPUAccount::getTotalTime() const
+  {
+    return std::accumulate(m_TotalTimes.begin(), m_TotalTimes.end(), 0.0);
+  }
+
+
+  std::string CSWCPUAccount::getName(CallType type)
+  {
+    switch (type)
+    {
+      case STEP:
+        return "step";
+      case UPDATE:
+        return "update";
+      case PROCESS_EVENT:
+        return "processEvent";
+      default:
+        return "unknown";
+    }
+  }
+
+
+  double CSWCPUAccount::getTime()
+  {
+    return ARSTD::Time::getThreadTime() - CSWPyProfiler::getOverheadTime();
+  }
+
+
+  CSWCPUAccount::CSWCPUAccount()
+  : m_Times(NUM_CALL_TYPES, boost::circular_buffer<double>(NUM_CYCLES)),
+    m_TotalTimes(NUM_CALL_TYPES, 0.0)
+  {
+  }
+
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#pragma once
+
+
+namespace CodeSubWars
+{
+
+  /**
+   * Accounts the processor time a submarine spends in its user code. The time is measured as cpu time of the
+   * simulating thread, so it does not grow when the host is busy with other processes or battles.
+   */
+  class CSWCPUAccount
+  {
+    public:
+      typedef std::shared_ptr<CSWCPUAccount> PtrType;
+
+      enum CallType
+      {
+        STEP = 0,
+        UPDATE = 1,
+        PROCESS_EVENT = 2,
+        NUM_CALL_TYPES = 3
+      };
+
+      static PtrType create();
+
+      ~CSWCPUAccount();
+
+      /**
+       * Adds the processor time consumed by one call.
+       * @return True if the average time of the last calls of this type exceeds the budget given in the settings.
+       */
+      bool add(CallType type, double fTime);
+
+      double getAverageTime(CallType type) const;
+      double getTotalTime(CallType type) const;
+      double getTotalTime() const;
+
+      static std::string getName(CallType type);
+
+      /**
+       * Returns the processor time of the calling thread without the time spent in attached python profilers. The
+       * time of a call is the difference of two of these values.
+       */
+      static double getTime();
+
+    protected:
+      CSWCPUAccount();
+
+      static const int NUM_CYCLES;
+
+      std::vector<boost::circular_buffer<double> > m_Times;
+      std::vector<double> m_TotalTimes;
+  };
+
+}
\ No newline at end of file
@@ -2,11 +2,14 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWCollideable.h"
+#include "CSWObjectPool.h"
 #include "CSWWorld.h"
 #include "CSWObject.h"
 #include "CSWSettings.h"
+#include "CSWCollisionFilter.h"
+#include "CSWIDynamic.h"
 
 
 namespace CodeSubWars
@@ -15,7 +18,7 @@ namespace CodeSubWars
   CSWCollideable::PtrType CSWCollideable::create(const Mesh::PtrType pCollisionMesh)
   {
     assert(pCollisionMesh);
-    return PtrType(new CSWCollideable(pCollisionMesh));
+    return CSWObjectPool::create<CSWCollideable>([&](void* pBlock) { return new (pBlock) CSWCollideable(pCollisionMesh); });
   }
 
 
@@ -24,20 +27,13 @@ namespace CodeSubWars
   }
 
 
-  void CSWCollideable::draw(const Matrix44D& mat)
+  void CSWCollideable::collectRenderData(CSWRenderFrame& frame, const Matrix44D& matWorldTransform) const
   {
     if (CSWWorld::getInstance()->getSettings()->getCollidableProperties() & CSWSettings::DISPLAY_COLLISION_MESH)
     {
       //only for debugging
-      glPushAttrib(GL_ALL_ATTRIB_BITS);
-        glShadeModel(GL_FLAT);
-        glDisable(GL_LIGHTING);
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-        glColor3fv((m_bHit ? Vector3F(0, 1, 1) : Vector3F(0, 0, 1)).pData);
-        glLineWidth(1);
-
-        m_pCollisionMesh->render();
-      glPopAttrib();
+      frame.addMeshGeometry(m_pCollisionMesh, matWorldTransform, m_bHit ? Vector4D(0, 1, 1, 1) : Vector4D(0, 0, 1, 1),
+                            CSWRenderFrame::MeshGeometry::WIREFRAME);
     }
   }
 
@@ -61,14 +57,16 @@ namespace CodeSubWars
   }
 
 
-  void CSWCollideable::initializeEnvironment(DT_ShapeHandle hDTShape, DT_ObjectHandle hDTObject,
-                                             const Matrix44D& matObjectTCollisionShape, Mesh::PtrType pCollisionMesh)
+  void CSWCollideable::initializeEnvironment(CSWObject* pObject, CSWShapeCache::ShapePtrType pDTShape, 
+                                             DT_ObjectHandle hDTObject, const Matrix44D& matObjectTCollisionShape, 
+                                             Mesh::PtrType pCollisionMesh)
   {
     if (m_bInitialized)
       return;
-    assert(!m_hDTShape);
+    assert(!m_pDTShape);
 
-    m_hDTShape = hDTShape;
+    m_pObject = pObject;
+    m_pDTShape = pDTShape;
     m_hDTObject = hDTObject;
     m_matObjectTCollisionShape = matObjectTCollisionShape;
     m_pCollisionMesh = pCollisionMesh;
@@ -97,12 +95,21 @@ namespace CodeSubWars
   //      
   //     m_hDTObject = DT_CreateObject(pObject.get(), m_hDTShape);
 
-    if (!m_hDTShape)
+    if (!m_pDTShape)
       throw std::runtime_error("CSWCollideable::initializeEnvironment(): shape was not correctly created");
 
     DT_AddObject(CSWWorld::getInstance()->getScene(), m_hDTObject);
+    CSWCollisionFilter::PtrType pCollisionFilter = CSWWorld::getInstance()->getCollisionFilter();
+    CSWCollisionFilter::ObjectKind kind = CSWCollisionFilter::determineKind(pObject);
     DT_SetResponseClass(CSWWorld::getInstance()->getResponseTable(),    
-                        m_hDTObject, CSWWorld::getInstance()->getResponseClass());
+                        m_hDTObject, pCollisionFilter->getResponseClass(kind));
+    pCollisionFilter->addObject(m_hDTObject, pObject, kind);
+    //static objects never move, their transform is only uploaded once on initialization
+    m_bResting = CSWCollisionFilter::isStatic(kind);
+    pCollisionFilter->addCollideable(this);
+    if (m_bContinuous)
+      pCollisionFilter->addContinuousObject(this);
+    m_bWorldPositionValid = false;
     m_bInitialized = true;
   }
 
@@ -113,9 +120,89 @@ namespace CodeSubWars
   }
 
 
-  void CSWCollideable::setupTransform(std::shared_ptr<CSWObject> pObject)
+  void CSWCollideable::setupTransform()
   {
-    DT_SetMatrixd(m_hDTObject, (pObject->getWorldTransform()*m_matObjectTCollisionShape).pData);
+    if (!m_bInitialized)
+      return;
+
+    Matrix44D matWorldTCollisionShape(m_pObject->getWorldTransform()*m_matObjectTCollisionShape);
+    DT_SetMatrixd(m_hDTObject, matWorldTCollisionShape.pData);
+
+    if (m_bContinuous)
+    {
+      m_vecLastWorldPosition = m_bWorldPositionValid ? m_vecWorldPosition : matWorldTCollisionShape.getTranslation();
+      m_vecWorldPosition = matWorldTCollisionShape.getTranslation();
+      m_bWorldPositionValid = true;
+    }
+  }
+
+
+  void CSWCollideable::setResting(bool bResting)
+  {
+    if (m_bResting == bResting)
+      return;
+
+    m_bResting = bResting;
+    //objects falling asleep are moved to the resting ones after their last upload (see CSWCollisionFilter::setupTransforms())
+    if (m_bInitialized && !m_bResting)
+      CSWWorld::getInstance()->getCollisionFilter()->wakeCollideable(this);
+  }
+
+
+  bool CSWCollideable::isResting() const
+  {
+    return m_bResting;
+  }
+
+
+  void CSWCollideable::enableContinuousCollision(double fRadius)
+  {
+    assert(!m_bInitialized);
+    m_bContinuous = true;
+    m_fSweepRadius = fRadius;
+  }
+
+
+  void CSWCollideable::setSweepSourceObject(const CSWObject::PtrType& pObject)
+  {
+    m_pSweepSourceObject = pObject;
+  }
+
+
+  void CSWCollideable::sweep()
+  {
+    if (!m_bInitialized || m_bResting || !m_bWorldPositionValid)
+      return;
+
+    //smaller movements can not pass anything the discrete collision test would not detect
+    Vector3D vecMovement = m_vecWorldPosition - m_vecLastWorldPosition;
+    double fDistance = vecMovement.getLength();
+    if (fDistance <= m_fSweepRadius)
+      return;
+
+    double fParam = 1;
+    CSWObject::PtrType pSourceObject = m_pSweepSourceObject.lock();
+    if (!CSWWorld::getInstance()->getCollisionFilter()->castRay(m_pObject, pSourceObject.get(), m_vecLastWorldPosition, 
+                                                                m_vecWorldPosition, fParam))
+      return;
+
+    //put the object back to the hit, it should penetrate the hit object by half its radius
+    Vector3D vecWorldTHit = m_vecLastWorldPosition + vecMovement*fParam;
+    Vector3D vecCorrection = vecWorldTHit - vecMovement*(m_fSweepRadius*0.5/fDistance) - m_vecWorldPosition;
+
+    CSWObject* pParent = dynamic_cast<CSWObject*>(m_pObject->getParent());
+    Matrix44D matWorldTParent = pParent ? pParent->getWorldTransform() : Matrix44D::IDENTITY;
+    Matrix44D matWorldTObject(m_pObject->getWorldTransform());
+    matWorldTObject.getTranslation() += vecCorrection;
+    m_pObject->setTransform(Matrix44D::inverse(matWorldTParent)*matWorldTObject);
+    m_pObject->calcWorldTransforms(matWorldTParent);
+
+    //otherwise the next step continues from the position behind the hit object
+    if (CSWIDynamic* pDynamic = dynamic_cast<CSWIDynamic*>(m_pObject))
+      pDynamic->setNewTransform(m_pObject->getWorldTransform()*Matrix44D(pDynamic->getCenterOfMass()));
+
+    m_vecWorldPosition += vecCorrection;
+    DT_SetMatrixd(m_hDTObject, (m_pObject->getWorldTransform()*m_matObjectTCollisionShape).pData);
   }
 
 
@@ -136,10 +223,14 @@ namespace CodeSubWars
     if (!m_bInitialized)
       return false;
 
+    CSWCollisionFilter::PtrType pCollisionFilter = CSWWorld::getInstance()->getCollisionFilter();
+    pCollisionFilter->removeObject(m_hDTObject);
+    pCollisionFilter->removeContinuousObject(this);
+    pCollisionFilter->removeCollideable(this);
+
     DT_RemoveObject(CSWWorld::getInstance()->getScene(), m_hDTObject);
     DT_DestroyObject(m_hDTObject);
-    DT_DeleteShape(m_hDTShape);
-    m_hDTShape = NULL;
+    m_pDTShape.reset();
         
     m_bInitialized = false;
     return true;
@@ -150,9 +241,13 @@ namespace CodeSubWars
   : m_pCollisionMesh(pCollisionMesh),
     m_BoundingBox(pCollisionMesh->getAxisAlignedBoundingBox()),
     m_bInitialized(false),
-    m_hDTShape(NULL),
     m_bHit(false),
-    m_matObjectTCollisionShape(Matrix44D::IDENTITY)
+    m_matObjectTCollisionShape(Matrix44D::IDENTITY),
+    m_pObject(NULL),
+    m_bResting(false),
+    m_bContinuous(false),
+    m_fSweepRadius(0),
+    m_bWorldPositionValid(false)
   {
     assert(m_pCollisionMesh);
   }
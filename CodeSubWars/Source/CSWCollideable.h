@@ -4,10 +4,13 @@
 
 #pragma once
 
+#include "CSWShapeCache.h"
+
 namespace CodeSubWars
 {
 
   class CSWObject;
+  struct CSWRenderFrame;
 
   class CSWCollideable
   {
@@ -17,7 +20,8 @@ namespace CodeSubWars
       static PtrType create(const Mesh::PtrType pCollisionMesh);
       ~CSWCollideable();
 
-      void draw(const Matrix44D& mat);
+      //adds the collision mesh at the given transform for debugging
+      void collectRenderData(CSWRenderFrame& frame, const Matrix44D& matWorldTransform) const;
 
       //given in locale coordsystem
       const Mesh::PtrType getMesh() const;
@@ -26,10 +30,47 @@ namespace CodeSubWars
       //given in locale coordsystem
       void setMesh(const Mesh::PtrType pCollisionMesh);
 
-      void initializeEnvironment(DT_ShapeHandle hDTShape, DT_ObjectHandle hDTObject,
-                                 const Matrix44D& matObjectTCollisionShape, Mesh::PtrType pCollisionMesh);
+      /**
+       * Takes ownership of the object and adds it to the collision scene. The shape may be shared with other objects 
+       * (see CSWShapeCache). The response class is chosen by the kind of the given object (see CSWCollisionFilter).
+       */
+      void initializeEnvironment(CSWObject* pObject, CSWShapeCache::ShapePtrType pDTShape, 
+                                 DT_ObjectHandle hDTObject, const Matrix44D& matObjectTCollisionShape, 
+                                 Mesh::PtrType pCollisionMesh);
       void prepare();
-      void setupTransform(std::shared_ptr<CSWObject> pObject);
+
+      /**
+       * Uploads the current world transform of the object to the collision scene.
+       */
+      void setupTransform();
+
+      /**
+       * Resting objects keep the transform uploaded last, they are skipped by CSWCollisionFilter::setupTransforms().
+       * Static objects (walls, borders) are resting from the beginning.
+       */
+      void setResting(bool bResting);
+      bool isResting() const;
+
+      /**
+       * Enables the sweep of the path the object moved within a step (see sweep()). Needed for fast objects that could 
+       * pass thin objects between two steps. Must be called before initializeEnvironment().
+       * @param fRadius The radius of the object around the origin of its collision shape. Only movements larger than 
+       * this are swept.
+       */
+      void enableContinuousCollision(double fRadius);
+
+      /**
+       * Sets the object the sweep starts in (e.g. the submarine that shot a weapon). It is not hit as long as the path
+       * starts within its bounding box.
+       */
+      void setSweepSourceObject(const std::shared_ptr<CSWObject>& pObject);
+
+      /**
+       * Casts the path the object moved since the last step against all solid objects. If it passed one, the object is 
+       * put back to the hit position slightly penetrating the hit object, so the following collision test detects it.
+       * The dynamic of the object continues from there.
+       */
+      void sweep();
       const Matrix44D& getObjectTCollisionShape();    
       void setHit(bool bHit);
       bool deleteEnvironment();
@@ -40,10 +81,20 @@ namespace CodeSubWars
       Mesh::PtrType m_pCollisionMesh;
       BoundingBoxD m_BoundingBox;
       bool m_bInitialized;
-      DT_ShapeHandle m_hDTShape;
+      CSWShapeCache::ShapePtrType m_pDTShape;
       DT_ObjectHandle m_hDTObject;
       bool m_bHit;
       Matrix44D m_matObjectTCollisionShape;
+
+      CSWObject* m_pObject;
+      bool m_bResting;
+
+      bool m_bContinuous;
+      double m_fSweepRadius;
+      std::weak_ptr<CSWObject> m_pSweepSourceObject;
+      bool m_bWorldPositionValid;
+      Vector3D m_vecLastWorldPosition;
+      Vector3D m_vecWorldPosition;
   };
 
 }
\ No newline at end of file
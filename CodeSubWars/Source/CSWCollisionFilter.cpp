@@ -0,0 +1,361 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#include "CorePrecompiledHeader.h"
+#include "CSWCollisionFilter.h"
+
+#include "CSWObject.h"
+#include "CSWCollideable.h"
+#include "CSWSettings.h"
+#include "CSWTrigger.h"
+#include "CSWWall.h"
+#include "CSWBorder.h"
+#include "CSWWeapon.h"
+#include "CSWSubmarine.h"
+#include "CSWWeaponSupply.h"
+
+
+namespace CodeSubWars
+{
+
+  namespace
+  {
+    //the order of the elements does not matter, so the removed one is replaced by the last
+    template <typename T>
+    bool removeFrom(std::vector<T>& container, const T& value)
+    {
+      typename std::vector<T>::iterator it = std::find(container.begin(), container.end(), value);
+      if (it == container.end())
+        return false;
+
+      *it = container.back();
+      container.pop_back();
+      return true;
+    }
+  }
+
+
+  CSWCollisionFilter::PtrType CSWCollisionFilter::create(DT_RespTableHandle hDTRespTable, DT_ResponseCallback response)
+  {
+    return PtrType(new CSWCollisionFilter(hDTRespTable, response));
+  }
+
+
+  CSWCollisionFilter::~CSWCollisionFilter()
+  {
+  }
+
+
+  CSWCollisionFilter::ObjectKind CSWCollisionFilter::determineKind(const CSWObject* pObject)
+  {
+    if (dynamic_cast<const CSWTrigger*>(pObject))
+      return TRIGGER;
+    if (dynamic_cast<const CSWWall*>(pObject))
+      return WALL;
+    if (dynamic_cast<const CSWBorder*>(pObject))
+      return BORDER;
+    if (dynamic_cast<const CSWWeapon*>(pObject))
+      return WEAPON;
+    if (dynamic_cast<const CSWSubmarine*>(pObject))
+      return SUBMARINE;
+    if (dynamic_cast<const CSWWeaponSupply*>(pObject))
+      return SUPPLY;
+    return OBSTACLE;
+  }
+
+
+  bool CSWCollisionFilter::isStatic(ObjectKind kind)
+  {
+    return kind == WALL || kind == BORDER;
+  }
+
+
+  DT_ResponseClass CSWCollisionFilter::getResponseClass(ObjectKind kind) const
+  {
+    assert(kind >= 0 && kind < NUM_OBJECT_KINDS);
+    return m_ResponseClasses[kind];
+  }
+
+
+  DT_ResponseType CSWCollisionFilter::getResponseType(ObjectKind kindA, ObjectKind kindB) const
+  {
+    return m_ResponseTypes[kindA][kindB];
+  }
+
+
+  void CSWCollisionFilter::update(int nCollidableProperties)
+  {
+    for (int nKindA = 0; nKindA < NUM_OBJECT_KINDS; ++nKindA)
+    {
+      for (int nKindB = nKindA; nKindB < NUM_OBJECT_KINDS; ++nKindB)
+      {
+        ObjectKind kindA = static_cast<ObjectKind>(nKindA);
+        ObjectKind kindB = static_cast<ObjectKind>(nKindB);
+        setResponseType(kindA, kindB, determineResponseType(kindA, kindB, nCollidableProperties));
+      }
+    }
+  }
+
+
+  void CSWCollisionFilter::clear()
+  {
+    for (int nKindA = 0; nKindA < NUM_OBJECT_KINDS; ++nKindA)
+    {
+      for (int nKindB = nKindA; nKindB < NUM_OBJECT_KINDS; ++nKindB)
+        setResponseType(static_cast<ObjectKind>(nKindA), static_cast<ObjectKind>(nKindB), DT_NO_RESPONSE);
+    }
+  }
+
+
+  void CSWCollisionFilter::addObject(DT_ObjectHandle hDTObject, CSWObject* pObject, ObjectKind kind)
+  {
+    if (kind != TRIGGER)
+      m_SolidObjects.push_back(SolidObject(hDTObject, pObject));
+  }
+
+
+  void CSWCollisionFilter::removeObject(DT_ObjectHandle hDTObject)
+  {
+    removeFrom(m_SolidObjects, SolidObject(hDTObject, NULL));
+  }
+
+
+  bool CSWCollisionFilter::castRay(const CSWObject* pIgnoredObject, const CSWObject* pSourceObject, 
+                                   const Vector3D& vecWorldTSource, const Vector3D& vecWorldTTarget, double& fParam) const
+  {
+    Vector3F vecSource(vecWorldTSource);
+    Vector3F vecTarget(vecWorldTTarget);
+    Vector3F vecMin(std::min(vecSource.x, vecTarget.x), std::min(vecSource.y, vecTarget.y), std::min(vecSource.z, vecTarget.z));
+    Vector3F vecMax(std::max(vecSource.x, vecTarget.x), std::max(vecSource.y, vecTarget.y), std::max(vecSource.z, vecTarget.z));
+
+    bool bHit = false;
+    DT_Scalar fMaxParam = 1;
+    std::vector<SolidObject>::const_iterator it = m_SolidObjects.begin();
+    for (; it != m_SolidObjects.end(); ++it)
+    {
+      if (it->pObject == pIgnoredObject)
+        continue;
+
+      //the exact ray cast is only done if the bounding boxes of the object and the ray overlap
+      Vector3F vecObjectMin;
+      Vector3F vecObjectMax;
+      DT_GetBBox(it->hDTObject, vecObjectMin.pData, vecObjectMax.pData);
+      if (vecObjectMin.x > vecMax.x || vecObjectMax.x < vecMin.x ||
+          vecObjectMin.y > vecMax.y || vecObjectMax.y < vecMin.y ||
+          vecObjectMin.z > vecMax.z || vecObjectMax.z < vecMin.z)
+        continue;
+
+      //a ray starting within the source object would hit it immediately
+      if (it->pObject == pSourceObject &&
+          vecObjectMin.x <= vecSource.x && vecSource.x <= vecObjectMax.x &&
+          vecObjectMin.y <= vecSource.y && vecSource.y <= vecObjectMax.y &&
+          vecObjectMin.z <= vecSource.z && vecSource.z <= vecObjectMax.z)
+        continue;
+
+      DT_Scalar fCurrentParam = 0;
+      Vector3F vecNormal;
+      if (DT_ObjectRayCast(it->hDTObject, vecSource.pData, vecTarget.pData, fMaxParam, &fCurrentParam, vecNormal.pData))
+      {
+        fMaxParam = fCurrentParam;
+        bHit = true;
+      }
+    }
+
+    fParam = fMaxParam;
+    return bHit;
+  }
+
+
+  void CSWCollisionFilter::castRays(const CSWObject* pIgnoredObject, const Vector3D& vecWorldTSource, 
+                                    const std::vector<Vector3D>& worldTTargets, double fMinDistance, std::vector<RayHit>& hits) const
+  {
+    hits.assign(worldTTargets.size(), RayHit());
+    if (worldTTargets.empty())
+      return;
+
+    //the rays are cast from their start to the target, the hits are given on the whole way from the source
+    std::vector<Vector3F> starts;
+    std::vector<double> minParams;
+    starts.reserve(worldTTargets.size());
+    minParams.reserve(worldTTargets.size());
+    std::vector<Vector3D>::const_iterator itWorldTTarget = worldTTargets.begin();
+    for (; itWorldTTarget != worldTTargets.end(); ++itWorldTTarget)
+    {
+      double fLength = (*itWorldTTarget - vecWorldTSource).getLength();
+      double fMinParam = fLength > EPSILON ? std::min(1.0, std::max(0.0, fMinDistance/fLength)) : 0;
+      starts.push_back(Vector3F(vecWorldTSource + (*itWorldTTarget - vecWorldTSource)*fMinParam));
+      minParams.push_back(fMinParam);
+    }
+
+    std::vector<Vector3F> targets(worldTTargets.begin(), worldTTargets.end());
+    Vector3F vecMin(starts.front());
+    Vector3F vecMax(starts.front());
+    for (size_t nCntRay = 0; nCntRay < targets.size(); ++nCntRay)
+    {
+      const Vector3F& vecStart = starts[nCntRay];
+      const Vector3F& vecTarget = targets[nCntRay];
+      vecMin = Vector3F(std::min(vecMin.x, std::min(vecStart.x, vecTarget.x)), std::min(vecMin.y, std::min(vecStart.y, vecTarget.y)),
+                        std::min(vecMin.z, std::min(vecStart.z, vecTarget.z)));
+      vecMax = Vector3F(std::max(vecMax.x, std::max(vecStart.x, vecTarget.x)), std::max(vecMax.y, std::max(vecStart.y, vecTarget.y)),
+                        std::max(vecMax.z, std::max(vecStart.z, vecTarget.z)));
+    }
+
+    std::vector<SolidObject>::const_iterator it = m_SolidObjects.begin();
+    for (; it != m_SolidObjects.end(); ++it)
+    {
+      if (it->pObject == pIgnoredObject)
+        continue;
+
+      Vector3F vecObjectMin;
+      Vector3F vecObjectMax;
+      DT_GetBBox(it->hDTObject, vecObjectMin.pData, vecObjectMax.pData);
+      if (vecObjectMin.x > vecMax.x || vecObjectMax.x < vecMin.x ||
+          vecObjectMin.y > vecMax.y || vecObjectMax.y < vecMin.y ||
+          vecObjectMin.z > vecMax.z || vecObjectMax.z < vecMin.z)
+        continue;
+
+      for (size_t nCntRay = 0; nCntRay < targets.size(); ++nCntRay)
+      {
+        if (minParams[nCntRay] >= 1)
+          continue;
+
+        //slab test of the ray up to the nearest hit so far against the bounding box of the object
+        const Vector3F& vecSource = starts[nCntRay];
+        Vector3F vecDirection = targets[nCntRay] - vecSource;
+        double fMaxParam = (hits[nCntRay].fParam - minParams[nCntRay])/(1 - minParams[nCntRay]);
+        float fEnter = 0;
+        float fLeave = static_cast<float>(fMaxParam);
+        for (int nAxis = 0; nAxis < 3 && fEnter <= fLeave; ++nAxis)
+        {
+          if (fabs(vecDirection.pData[nAxis]) < EPSILON)
+          {
+            if (vecSource.pData[nAxis] < vecObjectMin.pData[nAxis] || vecSource.pData[nAxis] > vecObjectMax.pData[nAxis])
+              fEnter = fLeave + 1;
+            continue;
+          }
+          float fParam1 = (vecObjectMin.pData[nAxis] - vecSource.pData[nAxis])/vecDirection.pData[nAxis];
+          float fParam2 = (vecObjectMax.pData[nAxis] - vecSource.pData[nAxis])/vecDirection.pData[nAxis];
+          fEnter = std::max(fEnter, std::min(fParam1, fParam2));
+          fLeave = std::min(fLeave, std::max(fParam1, fParam2));
+        }
+        if (fEnter > fLeave)
+          continue;
+
+        DT_Scalar fCurrentParam = 0;
+        Vector3F vecNormal;
+        if (DT_ObjectRayCast(it->hDTObject, vecSource.pData, targets[nCntRay].pData, static_cast<DT_Scalar>(fMaxParam), 
+                             &fCurrentParam, vecNormal.pData))
+        {
+          hits[nCntRay].fParam = minParams[nCntRay] + fCurrentParam*(1 - minParams[nCntRay]);
+          hits[nCntRay].pObject = it->pObject;
+        }
+      }
+    }
+  }
+
+
+  void CSWCollisionFilter::addContinuousObject(CSWCollideable* pCollideable)
+  {
+    m_ContinuousObjects.push_back(pCollideable);
+  }
+
+
+  void CSWCollisionFilter::removeContinuousObject(CSWCollideable* pCollideable)
+  {
+    removeFrom(m_ContinuousObjects, pCollideable);
+  }
+
+
+  void CSWCollisionFilter::sweepContinuousObjects()
+  {
+    std::vector<CSWCollideable*>::iterator it = m_ContinuousObjects.begin();
+    for (; it != m_ContinuousObjects.end(); ++it)
+      (*it)->sweep();
+  }
+
+
+  void CSWCollisionFilter::addCollideable(CSWCollideable* pCollideable)
+  {
+    m_MovingObjects.push_back(pCollideable);
+  }
+
+
+  void CSWCollisionFilter::removeCollideable(CSWCollideable* pCollideable)
+  {
+    removeFrom(m_MovingObjects, pCollideable);
+    removeFrom(m_RestingObjects, pCollideable);
+  }
+
+
+  void CSWCollisionFilter::wakeCollideable(CSWCollideable* pCollideable)
+  {
+    if (removeFrom(m_RestingObjects, pCollideable))
+      m_MovingObjects.push_back(pCollideable);
+  }
+
+
+  void CSWCollisionFilter::setupTransforms()
+  {
+    size_t nIndex = 0;
+    while (nIndex < m_MovingObjects.size())
+    {
+      CSWCollideable* pCollideable = m_MovingObjects[nIndex];
+      pCollideable->setupTransform();
+      if (pCollideable->isResting())
+      {
+        m_MovingObjects[nIndex] = m_MovingObjects.back();
+        m_MovingObjects.pop_back();
+        m_RestingObjects.push_back(pCollideable);
+      }
+      else
+      {
+        ++nIndex;
+      }
+    }
+  }
+
+
+  CSWCollisionFilter::CSWCollisionFilter(DT_RespTableHandle hDTRespTable, DT_ResponseCallback response)
+  : m_hDTRespTable(hDTRespTable),
+    m_Response(response)
+  {
+    for (int nKindA = 0; nKindA < NUM_OBJECT_KINDS; ++nKindA)
+    {
+      m_ResponseClasses[nKindA] = DT_GenResponseClass(m_hDTRespTable);
+      for (int nKindB = 0; nKindB < NUM_OBJECT_KINDS; ++nKindB)
+        m_ResponseTypes[nKindA][nKindB] = DT_NO_RESPONSE;
+    }
+  }
+
+
+  DT_ResponseType CSWCollisionFilter::determineResponseType(ObjectKind kindA, ObjectKind kindB, int nCollidableProperties)
+  {
+    if (kindA == TRIGGER && kindB == TRIGGER)
+      return nCollidableProperties & CSWSettings::DISPLAY_TRIGGER_TRIGGER_COLLISION ? DT_SIMPLE_RESPONSE : DT_NO_RESPONSE;
+
+    if (kindA == TRIGGER || kindB == TRIGGER)
+      return DT_WITNESSED_RESPONSE;
+
+    if (isStatic(kindA) && isStatic(kindB))
+      return DT_NO_RESPONSE;
+
+    return DT_DEPTH_RESPONSE;
+  }
+
+
+  void CSWCollisionFilter::setResponseType(ObjectKind kindA, ObjectKind kindB, DT_ResponseType type)
+  {
+    if (m_ResponseTypes[kindA][kindB] == type)
+      return;
+
+    if (m_ResponseTypes[kindA][kindB] != DT_NO_RESPONSE)
+      DT_RemovePairResponse(m_hDTRespTable, m_ResponseClasses[kindA], m_ResponseClasses[kindB], m_Response);
+    if (type != DT_NO_RESPONSE)
+      DT_AddPairResponse(m_hDTRespTable, m_ResponseClasses[kindA], m_ResponseClasses[kindB], m_Response, type, NULL);
+
+    m_ResponseTypes[kindA][kindB] = type;
+    m_ResponseTypes[kindB][kindA] = type;
+  }
+
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#pragma once
+
+
+namespace CodeSubWars
+{
+
+  class CSWObject;
+  class CSWCollideable;
+
+  /**
+   * Decides per pair of object kinds which collision data SOLID has to compute. Each kind gets its own response class,
+   * the collision response is only registered for the pairs that matter and with the cheapest response type that still
+   * delivers the data the response needs:
+   * - static objects (walls, borders) never collide with each other
+   * - triggers only need a common point (their hit position), no penetration depth
+   * - triggers among themselves are only tested if their collisions are displayed
+   * - all other pairs need the penetration depth to calculate the impulse
+   * Additionally it knows all solid (non trigger) collision objects, so fast objects can sweep their path against them
+   * (see castRay()), and it keeps the collideables apart that are at rest, so their transforms are not uploaded each
+   * step (see setupTransforms()).
+   */
+  class CSWCollisionFilter
+  {
+    public:
+      typedef std::shared_ptr<CSWCollisionFilter> PtrType;
+
+      enum ObjectKind
+      {
+        TRIGGER = 0,
+        WALL,
+        BORDER,
+        WEAPON,
+        SUBMARINE,
+        SUPPLY,
+        OBSTACLE,
+        NUM_OBJECT_KINDS
+      };
+
+      /**
+       * The result of one ray of castRays().
+       */
+      struct RayHit
+      {
+        RayHit() : fParam(1), pObject(NULL) {}
+
+        double fParam;        //the hit as fraction of the way from source to target, 1 if nothing was hit
+        CSWObject* pObject;   //the hit object or null
+      };
+
+      static PtrType create(DT_RespTableHandle hDTRespTable, DT_ResponseCallback response);
+
+      ~CSWCollisionFilter();
+
+      static ObjectKind determineKind(const CSWObject* pObject);
+
+      /**
+       * @return True for kinds that never move (walls, borders).
+       */
+      static bool isStatic(ObjectKind kind);
+
+      DT_ResponseClass getResponseClass(ObjectKind kind) const;
+      DT_ResponseType getResponseType(ObjectKind kindA, ObjectKind kindB) const;
+
+      /**
+       * Registers the responses for the given collidable properties (see CSWSettings). Only changed pairs are
+       * registered again, so it can be called before each collision test.
+       */
+      void update(int nCollidableProperties);
+
+      /**
+       * Removes all registered responses.
+       */
+      void clear();
+
+      void addObject(DT_ObjectHandle hDTObject, CSWObject* pObject, ObjectKind kind);
+      void removeObject(DT_ObjectHandle hDTObject);
+
+      /**
+       * Casts a ray against all solid objects. Triggers are not hit.
+       * @param pIgnoredObject Object that is not tested, usually the one that casts.
+       * @param pSourceObject Object the ray may start in (e.g. the shooter of a weapon) or null. It is only tested if
+       *        the source lies outside its bounding box.
+       * @param fParam The found hit as fraction of the way from source to target.
+       * @return True if an object was hit.
+       */
+      bool castRay(const CSWObject* pIgnoredObject, const CSWObject* pSourceObject, const Vector3D& vecWorldTSource, 
+                   const Vector3D& vecWorldTTarget, double& fParam) const;
+
+      /**
+       * Casts many rays from one source against all solid objects at once (e.g. the beams of a sonar). The bounding 
+       * box of each object is fetched only once for all rays and objects outside the bounding box of all rays are 
+       * skipped, so this is much cheaper than casting each ray alone. Triggers are not hit.
+       * @param pIgnoredObject Object that is not tested, usually the one that casts.
+       * @param fMinDistance Each ray starts this far from the source towards its target, so objects closer to the
+       *        source neither are hit nor hide the objects behind them.
+       * @param hits Receives the nearest hit of each target in the same order.
+       */
+      void castRays(const CSWObject* pIgnoredObject, const Vector3D& vecWorldTSource, 
+                    const std::vector<Vector3D>& worldTTargets, double fMinDistance, std::vector<RayHit>& hits) const;
+
+      void addContinuousObject(CSWCollideable* pCollideable);
+      void removeContinuousObject(CSWCollideable* pCollideable);
+
+      /**
+       * Sweeps all objects with continuous collision detection (see CSWCollideable::sweep()). Must be called after the
+       * transforms of all objects are set up and before the collision test.
+       */
+      void sweepContinuousObjects();
+
+      void addCollideable(CSWCollideable* pCollideable);
+      void removeCollideable(CSWCollideable* pCollideable);
+
+      /**
+       * Moves a resting collideable back to the moving ones, its transform is uploaded again from the next step on.
+       */
+      void wakeCollideable(CSWCollideable* pCollideable);
+
+      /**
+       * Uploads the transforms of all moving collideables. Collideables that came to rest are moved to the resting ones
+       * after this last upload and are not visited anymore until they are woken up.
+       */
+      void setupTransforms();
+
+    protected:
+      struct SolidObject
+      {
+        SolidObject(DT_ObjectHandle hObject, CSWObject* pObj) : hDTObject(hObject), pObject(pObj) {}
+        bool operator == (const SolidObject& other) const { return hDTObject == other.hDTObject; }
+
+        DT_ObjectHandle hDTObject;
+        CSWObject* pObject;
+      };
+
+      CSWCollisionFilter(DT_RespTableHandle hDTRespTable, DT_ResponseCallback response);
+
+      static DT_ResponseType determineResponseType(ObjectKind kindA, ObjectKind kindB, int nCollidableProperties);
+
+      void setResponseType(ObjectKind kindA, ObjectKind kindB, DT_ResponseType type);
+
+      DT_RespTableHandle m_hDTRespTable;
+      DT_ResponseCallback m_Response;
+      DT_ResponseClass m_ResponseClasses[NUM_OBJECT_KINDS];
+      DT_ResponseType m_ResponseTypes[NUM_OBJECT_KINDS][NUM_OBJECT_KINDS];
+      std::vector<SolidObject> m_SolidObjects;
+      std::vector<CSWCollideable*> m_ContinuousObjects;
+      std::vector<CSWCollideable*> m_MovingObjects;
+      std::vector<CSWCollideable*> m_RestingObjects;
+  };
+
+}
\ No newline at end of file
@@ -2,9 +2,10 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 
 #include "CSWCommandable.h"
+#include "CSWObjectPool.h"
 
 
 namespace CodeSubWars
@@ -12,7 +13,7 @@ namespace CodeSubWars
 
   CSWCommandable::PtrType CSWCommandable::create()
   {
-    return PtrType(new CSWCommandable());
+    return CSWObjectPool::create<CSWCommandable>([&](void* pBlock) { return new (pBlock) CSWCommandable(); });
   }
 
 
@@ -2,7 +2,7 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWCommands.h"
 #include "CSWSubmarine.h"
 #include "CSWWeaponBattery.h"
@@ -213,7 +213,7 @@ namespace CodeSubWars
   }
 
 
-  Command::PtrType CSWCommands::fireSalvo(CSWWeaponBattery::PtrType& pWeaponBattery, int nNumTorpedos, double fTimeBetweenLaunches)
+  Command::PtrType CSWCommands::fireSalvo(const CSWWeaponBattery::PtrType& pWeaponBattery, int nNumTorpedos, double fTimeBetweenLaunches)
   {
     MacroCommand::PtrType pCmd = ARSTD::MacroCommand::create("FireSalvo");
     for (int i = 0; i < nNumTorpedos; ++i)
@@ -181,7 +181,7 @@ namespace CodeSubWars
        * @param fTimeBetweenLaunches The time between launches that should be wait in seconds.
        * @return Returns the new constructed command.
        */
-      static ARSTD::Command::PtrType fireSalvo(std::shared_ptr<CSWWeaponBattery>& pWeaponBattery, 
+      static ARSTD::Command::PtrType fireSalvo(const std::shared_ptr<CSWWeaponBattery>& pWeaponBattery, 
                                                int nNumTorpedos, double fTimeBetweenLaunches = 0);
 
 
@@ -2,8 +2,9 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWControlCenter.h"
+#include "CSWObjectPool.h"
 
 #include "CSWTransceiver.h"
 #include "CSWMap.h"
@@ -21,7 +22,7 @@ namespace CodeSubWars
 
   CSWControlCenter::PtrType CSWControlCenter::create(const std::string& strName, const Matrix44D& matBaseTObject)
   {
-    return PtrType(new CSWControlCenter(strName, matBaseTObject));
+    return CSWObjectPool::create<CSWControlCenter>([&](void* pBlock) { return new (pBlock) CSWControlCenter(strName, matBaseTObject); });
   }
 
 
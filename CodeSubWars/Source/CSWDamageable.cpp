@@ -2,8 +2,9 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWDamageable.h"
+#include "CSWObjectPool.h"
 #include "CSWWorld.h"
 #include "CSWSettings.h"
 
@@ -13,7 +14,7 @@ namespace CodeSubWars
 
   CSWDamageable::PtrType CSWDamageable::create(bool bSetAutomaticallyToDead)
   {
-    return PtrType(new CSWDamageable(bSetAutomaticallyToDead));
+    return CSWObjectPool::create<CSWDamageable>([&](void* pBlock) { return new (pBlock) CSWDamageable(bSetAutomaticallyToDead); });
   }
 
 
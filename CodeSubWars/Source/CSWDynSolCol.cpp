@@ -2,11 +2,12 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "Constants.h"
 #include "CSWDynSolCol.h"
 #include "CSWSolid.h"
 #include "CSWCollideable.h"
+#include "CSWShapeCache.h"
 
 #include "CSWEngine.h"
 
@@ -34,6 +35,14 @@ namespace CodeSubWars
     }
 
     setTransform(m_pDynamic->updatePosition());
+    //the collision transform of a sleeping object stays as it is
+    m_pCollideable->setResting(m_pDynamic->isSleeping());
+  }
+
+
+  bool CSWDynSolCol::isSleeping() const
+  {
+    return m_pDynamic->isSleeping();
   }
 
 
@@ -61,43 +70,13 @@ namespace CodeSubWars
   }
 
 
-  void CSWDynSolCol::draw()
+  void CSWDynSolCol::collectRenderData(CSWRenderFrame& frame, CSWRenderFrame::Entry& entry)
   {
-    m_pSolid->draw(getTransform());
+    m_pSolid->collectRenderData(entry);
 
     //for debugging
-    m_pDynamic->draw();
-    m_pCollideable->draw(getTransform());
-
-  //  Vector3D v = getWorldTransform()*m_pDynamic->getCenterOfMass() + m_vecCollisionPoint;
-  //  v = getInvertWorldTransform()*v;
-  //  if (m_vecCollisionNormal.getLength() > 0.0)
-  //  {
-  //    Matrix44D mat;
-  //    mat.getXAxis() = m_vecCollisionNormal.getNormalized();
-  //    mat.getYAxis() = mat.getXAxis().getPerpendicular().getNormalized();
-  //    mat.getZAxis() = mat.getXAxis()%mat.getYAxis();
-  //    mat.getTranslation() = v - mat.getYAxis()*50.0 - mat.getZAxis()*50.0;
-  //    BoundingBoxD bbox(mat, Size3D(1, 100, 100));
-  //    glShadeModel(GL_FLAT);
-  //    glDisable(GL_LIGHTING);
-  //    glBegin(GL_LINES);
-  //      glColor3f(0.0f, 1.0f, 0.0f);
-  //      for (int iCnt = 0; iCnt < 12; ++iCnt) 
-  //      {
-  //        glVertex3dv(bbox.getSegment(iCnt).getPoint1().pData);
-  //        glVertex3dv(bbox.getSegment(iCnt).getPoint2().pData);
-  //      }
-  //    glEnd();
-  //  }
-  //
-  //  glShadeModel(GL_FLAT);
-  //  glDisable(GL_LIGHTING);
-  //  glPointSize(10);
-  //  glBegin(GL_POINTS);
-  //    glColor3f(1.0f, 0.0f, 0.0f);
-  //    glVertex3dv(v.pData);
-  //  glEnd();  
+    m_pDynamic->collectRenderData(frame, entry.matWorldTransform);
+    m_pCollideable->collectRenderData(frame, entry.matWorldTransform);
   }
 
 
@@ -225,8 +204,7 @@ namespace CodeSubWars
     m_pCollideable(CSWCollideable::create(pSurface))
   {
     Size3D sizeSurface = pSurface->getAxisAlignedBoundingBox().getSize();
-    Matrix44D mat(Vector3D(pSurface->getAxisAlignedBoundingBox().getMin()));
-    Mesh::PtrType pMassMesh = Mesh::createBox(mat, sizeSurface);
+    Mesh::PtrType pMassMesh = CSWShapeCache::getInstance()->getBoxMesh(Vector3D(pSurface->getAxisAlignedBoundingBox().getMin()), sizeSurface);
     m_pDynamic = CSWDynamic::create(matBaseTObject, pMassMesh);
   }
 
@@ -247,14 +225,14 @@ namespace CodeSubWars
   {
     BoundingBoxD bbox(m_pCollideable->getMesh()->getAxisAlignedBoundingBox());
     Size3D size = bbox.getSize();
-    DT_ShapeHandle hDTShape = DT_NewBox(size.getWidth(), size.getHeight(), size.getDepth());
+    CSWShapeCache::ShapePtrType pDTShape = CSWShapeCache::getInstance()->getBoxShape(size);
 
-    DT_ObjectHandle hDTObject = DT_CreateObject(this, hDTShape);
+    DT_ObjectHandle hDTObject = DT_CreateObject(this, pDTShape.get());
 
     Matrix44D matObjectTCollisionShape(Vector3D(bbox.getCenter()));
-    Mesh::PtrType pCollisionMesh = Mesh::createBox(bbox.getCoordSystem(), bbox.getSize());
+    Mesh::PtrType pCollisionMesh = CSWShapeCache::getInstance()->getBoxMesh(bbox.getCoordSystem().getTranslation(), size);
 
-    m_pCollideable->initializeEnvironment(hDTShape, hDTObject, matObjectTCollisionShape, pCollisionMesh);
+    m_pCollideable->initializeEnvironment(this, pDTShape, hDTObject, matObjectTCollisionShape, pCollisionMesh);
   }
 
 
@@ -266,7 +244,7 @@ namespace CodeSubWars
 
   void CSWDynSolCol::setupTransform()
   {
-    m_pCollideable->setupTransform(getSharedThis());
+    m_pCollideable->setupTransform();
   }
 
 
@@ -34,6 +34,7 @@ namespace CodeSubWars
 
       //defined methods for dynamic
       virtual void updatePosition();
+      virtual bool isSleeping() const;
       virtual void resetForce();
       virtual void addForceToCM(const Vector3D& vecWorldTForce);
       virtual void addForce(const Vector3D& vecWorldTPosition, const Vector3D& vecWorldTForce);
@@ -57,7 +58,7 @@ namespace CodeSubWars
                              const Vector3D& vecWorldTAngularMomentumCM);
 
       //defined methods for solid
-      virtual void draw();
+      virtual void collectRenderData(CSWRenderFrame& frame, CSWRenderFrame::Entry& entry);
       virtual const Mesh::PtrType getSurface() const;
       virtual const BoundingBoxD& getSurfaceBoundingBox() const;
 
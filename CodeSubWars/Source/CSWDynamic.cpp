@@ -2,11 +2,13 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 
 #include "CSWDynamic.h"
+#include "CSWObjectPool.h"
 #include "CSWWorld.h"
 #include "CSWSettings.h"
+#include "CSWShapeCache.h"
 
 namespace CodeSubWars
 {
@@ -14,11 +16,64 @@ namespace CodeSubWars
   const double CSWDynamic::OBJECT_DENSITY = 0.5; //average density of whole object in g/cm^3
   const double CSWDynamic::MAXIMAL_VELOCITY = 100; //max possible velocity in the world in m/s
   const double CSWDynamic::MAXIMAL_ANGULAR_VELOCITY = getInRad(720); //max possible angular velocity in the world in rad/s
+  const double CSWDynamic::SLEEP_VELOCITY = 0.01; //max velocity of a resting object in m/s
+  const double CSWDynamic::SLEEP_ANGULAR_VELOCITY = getInRad(0.5); //max angular velocity of a resting object in rad/s
+  const double CSWDynamic::SLEEP_ACCELERATION = 0.01; //max acceleration by forces of a resting object in m/s^2
+  const double CSWDynamic::SLEEP_ANGULAR_ACCELERATION = getInRad(0.5); //max angular acceleration by forces of a resting object in rad/s^2
+  const double CSWDynamic::SLEEP_DELAY = 1; //time an object must rest before it falls asleep in s
 
 
   CSWDynamic::PtrType CSWDynamic::create(const Matrix44D& matBaseTObject, const Mesh::PtrType pMassMesh)
   {
-    return PtrType(new CSWDynamic(matBaseTObject, pMassMesh));
+    return CSWObjectPool::create<CSWDynamic>([&](void* pBlock) { return new (pBlock) CSWDynamic(matBaseTObject, pMassMesh); });
+  }
+
+
+  CSWDynamic::MassPropertiesPtrType CSWDynamic::calcMassProperties(const Mesh::PtrType pMassMesh)
+  {
+    assert(pMassMesh);
+    std::shared_ptr<MassProperties> pProperties(new MassProperties());
+
+    pProperties->boundingBox = pMassMesh->getAxisAlignedBoundingBox();
+
+    //store mass points and regarding mass in seperate container
+    double fMassPerMassPoint = pProperties->boundingBox.getSize().getVolume()*1000.0*OBJECT_DENSITY/pMassMesh->getNumVertices();
+    Mesh::VectorConstIterator itVertex = pMassMesh->getVerticesBegin();
+    for (; itVertex != pMassMesh->getVerticesEnd(); ++itVertex)
+    {
+      pProperties->massPoints.push_back(std::make_pair(*itVertex, fMassPerMassPoint));
+    }
+
+
+    //calc center of mass and mass
+    pProperties->vecCenterOfMass = Vector3D(0, 0, 0);
+    pProperties->fMass = 0;
+    MassPointContainer::const_iterator itMassPoint = pProperties->massPoints.begin();
+    for (; itMassPoint != pProperties->massPoints.end(); ++itMassPoint)
+    {
+      pProperties->fMass += itMassPoint->second;
+      pProperties->vecCenterOfMass += itMassPoint->first*itMassPoint->second;
+    }
+    if (pProperties->fMass != 0.0)
+      pProperties->vecCenterOfMass /= pProperties->fMass;
+
+
+    //calc moment of inertia invert local
+    pProperties->matMomentOfInertia = Matrix33D(true);
+    Matrix33D tmp;
+    itMassPoint = pProperties->massPoints.begin();
+    for (; itMassPoint != pProperties->massPoints.end(); ++itMassPoint)
+    {
+      tmp = tildeOperator(itMassPoint->first);
+      pProperties->matMomentOfInertia -= tmp*tmp*itMassPoint->second;
+    }
+    MatrixD mat(pProperties->matMomentOfInertia);
+    bool bResult = mat.invert();
+    if (!bResult)
+      throw std::runtime_error("moment of inertia could not be calculated correctly!");
+    pProperties->matMomentOfInertiaInvert = Matrix33D(mat);
+
+    return pProperties;
   }
 
 
@@ -71,7 +126,7 @@ namespace CodeSubWars
 
   CSWDynamic::MassPointContainerRange CSWDynamic::getMassPointRange()
   {
-    return std::make_pair(m_MassPoints.begin(), m_MassPoints.end());
+    return std::make_pair(m_pMassProperties->massPoints.begin(), m_pMassProperties->massPoints.end());
   }
 
 
@@ -94,14 +149,17 @@ namespace CodeSubWars
 
     double fElapsedTime = getElapsedTime();
 
-    if (m_vecWorldTForceTotal == Vector3D(0, 0, 0) &&
-        m_vecWorldTTorqueTotal == Vector3D(0, 0, 0) &&
-        m_vecWorldTVelocityCM == Vector3D(0, 0, 0) &&
-        m_vecWorldTAngularVelocity == Vector3D(0, 0, 0))
+    if (m_bSleeping)
     {
-      resetForce();
-      //object is sleeping. that means no forces are applied and it does not moving or rotating.
-      return Matrix44D(m_matWorldTOrientationCM, m_vecWorldTPositionCM)*m_matCenterOfMassTObject;
+      if (isAtRest())
+      {
+        //object is sleeping. the small forces and impulses applied since the last step are dropped.
+        fallAsleep();
+        resetForce();
+        return Matrix44D(m_matWorldTOrientationCM, m_vecWorldTPositionCM)*m_matCenterOfMassTObject;
+      }
+      m_bSleeping = false;
+      m_fRestingTime = 0;
     }
 
   //   double fWToHD = m_MassMeshBoundingBox.getWidth()*m_MassMeshBoundingBox.getWidth()/(m_MassMeshBoundingBox.getHeight()*m_MassMeshBoundingBox.getDepth());
@@ -200,6 +258,13 @@ namespace CodeSubWars
 
 
 
+    //objects resting long enough fall asleep
+    m_fRestingTime = isAtRest() ? m_fRestingTime + fElapsedTime : 0;
+    if (m_fRestingTime >= SLEEP_DELAY)
+      fallAsleep();
+
+
+
     //reset forces
     resetForce();
 
@@ -207,6 +272,12 @@ namespace CodeSubWars
   }
 
 
+  bool CSWDynamic::isSleeping() const
+  {
+    return m_bSleeping;
+  }
+
+
   void CSWDynamic::resetForce()
   {
     m_vecWorldTForceCM = Vector3D(0, 0, 0);
@@ -317,110 +388,21 @@ namespace CodeSubWars
   }
 
 
-  void CSWDynamic::draw()
+  void CSWDynamic::collectRenderData(CSWRenderFrame& frame, const Matrix44D& matWorldTransform) const
   {
-    //draw force lines (only for debugging)
-    if (!(CSWWorld::getInstance()->getSettings()->getDynamicProperties() & 
-        (CSWSettings::DISPLAY_MASS_POINTS | CSWSettings::DISPLAY_DETAIL_FORCE | CSWSettings::DISPLAY_TOTAL_FORCE |
-         CSWSettings::DISPLAY_DETAIL_IMPULS | CSWSettings::DISPLAY_TOTAL_IMPULS))) return;
-
-    glPushAttrib(GL_ALL_ATTRIB_BITS);
-
-      glEnable(GL_DEPTH_TEST);
-
-      glEnable(GL_BLEND);
-      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-      glShadeModel(GL_FLAT);
-      glDisable(GL_LIGHTING);
-      glPolygonMode(GL_FRONT_AND_BACK, GL_POINT);
-      glColor4d(0, 1, 1, 0.5);
-
-      if (CSWWorld::getInstance()->getSettings()->getDynamicProperties() & CSWSettings::DISPLAY_MASS_POINTS)
-      {
-        glPointSize(4);
-        m_pMassMesh->render();
-      }
-
-      glDepthMask(false);
-    
-      glPushMatrix();
-        glLoadIdentity();
-
-        Vector3D vecTotalForcePosition(0, 0, 0);
-        Vector3D vecTotalForce(0, 0, 0);
-        double fTotalForce = 0;
-
-        glBegin(GL_LINES);
-          std::vector<std::pair<Vector3D, Vector3D> >::const_iterator itForce = m_OldAppliedForces.begin();
-          for (; itForce != m_OldAppliedForces.end(); ++itForce)
-          {
-            if (CSWWorld::getInstance()->getSettings()->getDynamicProperties() & CSWSettings::DISPLAY_DETAIL_FORCE)
-            {
-              glVertex3dv(itForce->first.pData);
-              glVertex3dv((itForce->first + itForce->second/10000.0).pData);
-            }
-          
-            double fForce = itForce->second.getLength();
-            fTotalForce += fForce;
-            vecTotalForcePosition += itForce->first*fForce;
-            vecTotalForce += itForce->second;
-          }
-        glEnd();
-
-
-        if (CSWWorld::getInstance()->getSettings()->getDynamicProperties() & CSWSettings::DISPLAY_TOTAL_FORCE)
-        {
-          if (fTotalForce > 0)
-            vecTotalForcePosition /= fTotalForce;
-          glLineWidth(4);
-          glBegin(GL_LINES);
-            glColor4d(0, 0.6, 1, 0.5);
-            glVertex3dv(vecTotalForcePosition.pData);
-            glVertex3dv((vecTotalForcePosition + vecTotalForce/10000.0).pData);
-          glEnd();
-        }
-
-
-        Vector3D vecTotalImpulsPosition(0, 0, 0);
-        Vector3D vecTotalImpuls(0, 0, 0);
-        double fTotalImpuls = 0;
-    
-        glBegin(GL_LINES);
-          std::vector<std::pair<Vector3D, Vector3D> >::const_iterator itImpuls = m_OldAppliedImpulses.begin();
-          for (; itImpuls != m_OldAppliedImpulses.end(); ++itImpuls)
-          {
-            if (CSWWorld::getInstance()->getSettings()->getDynamicProperties() & CSWSettings::DISPLAY_DETAIL_IMPULS)
-            {
-              glVertex3dv(itImpuls->first.pData);
-              glVertex3dv((itImpuls->first + itImpuls->second/10000.0).pData);
-            }
-          
-            double fImpuls = itImpuls->second.getLength();
-            fTotalImpuls += fImpuls;
-            vecTotalImpulsPosition += itImpuls->first*fImpuls;
-            vecTotalImpuls += itImpuls->second;
-          }
-        glEnd();
-
-
-        if (CSWWorld::getInstance()->getSettings()->getDynamicProperties() & CSWSettings::DISPLAY_TOTAL_IMPULS)
-        {
-          if (fTotalImpuls > 0)
-            vecTotalImpulsPosition /= fTotalImpuls;
-          glLineWidth(4);
-          glBegin(GL_LINES);
-            glColor4d(0, 0.6, 1, 0.5);
-            glVertex3dv(vecTotalImpulsPosition.pData);
-            glVertex3dv((vecTotalImpulsPosition + vecTotalImpuls/10000.0).pData);
-          glEnd();
-        }
-
-      glPopMatrix();
-
-      glDepthMask(true);
-    
-    glPopAttrib();
+    //force lines (only for debugging)
+    int nProperties = CSWWorld::getInstance()->getSettings()->getDynamicProperties();
+    if (!(nProperties & (CSWSettings::DISPLAY_MASS_POINTS | CSWSettings::DISPLAY_DETAIL_FORCE | CSWSettings::DISPLAY_TOTAL_FORCE |
+                         CSWSettings::DISPLAY_DETAIL_IMPULS | CSWSettings::DISPLAY_TOTAL_IMPULS))) return;
+
+    if (nProperties & CSWSettings::DISPLAY_MASS_POINTS)
+      frame.addMeshGeometry(m_pMassMesh, matWorldTransform, Vector4D(0, 1, 1, 0.5), CSWRenderFrame::MeshGeometry::POINTS, 4);
+
+    //the applied forces and impulses are given in world coordinates
+    addVectorLines(frame, m_OldAppliedForces, nProperties & CSWSettings::DISPLAY_DETAIL_FORCE,
+                   nProperties & CSWSettings::DISPLAY_TOTAL_FORCE);
+    addVectorLines(frame, m_OldAppliedImpulses, nProperties & CSWSettings::DISPLAY_DETAIL_IMPULS,
+                   nProperties & CSWSettings::DISPLAY_TOTAL_IMPULS);
   }
 
 
@@ -439,46 +421,13 @@ namespace CodeSubWars
   {
     assert(m_pMassMesh);
 
-    m_MassMeshBoundingBox = m_pMassMesh->getAxisAlignedBoundingBox();
-
-    //store mass points and regarding mass in seperate container
-    m_MassPoints.clear();
-    double fMassPerMassPoint = m_MassMeshBoundingBox.getSize().getVolume()*1000.0*OBJECT_DENSITY/m_pMassMesh->getNumVertices();
-    Mesh::VectorConstIterator itVertex = m_pMassMesh->getVerticesBegin();
-    for (; itVertex != m_pMassMesh->getVerticesEnd(); ++itVertex)
-    {
-      m_MassPoints.push_back(std::make_pair(*itVertex, fMassPerMassPoint));
-    }
-
-
-    //calc center of mass and mass
-    m_vecObjectTCenterOfMass = Vector3D(0, 0, 0);
-    m_fMass = 0;
-    MassPointContainer::const_iterator itMassPoint = m_MassPoints.begin();
-    for (; itMassPoint != m_MassPoints.end(); ++itMassPoint)
-    {
-      m_fMass += itMassPoint->second;
-      m_vecObjectTCenterOfMass += itMassPoint->first*itMassPoint->second;
-    }
-    if (m_fMass != 0.0)
-      m_vecObjectTCenterOfMass /= m_fMass;
+    m_pMassProperties = CSWShapeCache::getInstance()->getMassProperties(m_pMassMesh);
+    m_MassMeshBoundingBox = m_pMassProperties->boundingBox;
+    m_fMass = m_pMassProperties->fMass;
+    m_vecObjectTCenterOfMass = m_pMassProperties->vecCenterOfMass;
     m_matCenterOfMassTObject = Matrix44D::inverse(Matrix44D(m_vecObjectTCenterOfMass));
-
-
-    //calc moment of inertia invert local
-    m_matMomentOfInertiaLocalCM = Matrix33D(true);
-    Matrix33D tmp;
-    itMassPoint = m_MassPoints.begin();
-    for (; itMassPoint != m_MassPoints.end(); ++itMassPoint)
-    {
-      tmp = tildeOperator(itMassPoint->first);
-      m_matMomentOfInertiaLocalCM -= tmp*tmp*itMassPoint->second;
-    }
-    MatrixD mat(m_matMomentOfInertiaLocalCM);
-    bool bResult = mat.invert();
-    if (!bResult)
-      throw std::runtime_error("moment of inertia could not be calculated correctly!");
-    m_matMomentOfInertiaInvertLocalCM = Matrix33D(mat);
+    m_matMomentOfInertiaLocalCM = m_pMassProperties->matMomentOfInertia;
+    m_matMomentOfInertiaInvertLocalCM = m_pMassProperties->matMomentOfInertiaInvert;
 
     resetForce();
   }
@@ -516,6 +465,9 @@ namespace CodeSubWars
     }
 
     m_vecWorldTAngularAcceleration = Vector3D(0, 0, 0);
+
+    m_bSleeping = false;
+    m_fRestingTime = 0;
   }
 
 
@@ -528,6 +480,26 @@ namespace CodeSubWars
   }
 
 
+  bool CSWDynamic::isAtRest() const
+  {
+    return m_vecWorldTVelocityCM.getLength() <= SLEEP_VELOCITY &&
+           m_vecWorldTAngularVelocity.getLength() <= SLEEP_ANGULAR_VELOCITY &&
+           m_vecWorldTForceTotal.getLength() <= SLEEP_ACCELERATION*m_fMass &&
+           (m_matMomentOfInertiaInvertWorldCM*m_vecWorldTTorqueTotal).getLength() <= SLEEP_ANGULAR_ACCELERATION;
+  }
+
+
+  void CSWDynamic::fallAsleep()
+  {
+    m_vecWorldTVelocityCM = Vector3D(0, 0, 0);
+    m_vecWorldTAccelerationCM = Vector3D(0, 0, 0);
+    m_vecWorldTAngularMomentumCM = Vector3D(0, 0, 0);
+    m_vecWorldTAngularVelocity = Vector3D(0, 0, 0);
+    m_vecWorldTAngularAcceleration = Vector3D(0, 0, 0);
+    m_bSleeping = true;
+  }
+
+
   Matrix33D CSWDynamic::tildeOperator(const Vector3D& vec)
   {
     return Matrix33D(Vector3D(0,      vec.z,  -vec.y), 
@@ -535,4 +507,42 @@ namespace CodeSubWars
                      Vector3D(vec.y,  -vec.x, 0     ));
   }
 
+
+  void CSWDynamic::addVectorLines(CSWRenderFrame& frame, const std::vector<std::pair<Vector3D, Vector3D> >& vectors,
+                                  bool bDetail, bool bTotal)
+  {
+    CSWRenderFrame::Geometry detailLines;
+    detailLines.colors.push_back(Vector4D(0, 1, 1, 0.5));
+
+    Vector3D vecTotalPosition(0, 0, 0);
+    Vector3D vecTotal(0, 0, 0);
+    double fTotal = 0;
+    std::vector<std::pair<Vector3D, Vector3D> >::const_iterator it = vectors.begin();
+    for (; it != vectors.end(); ++it)
+    {
+      if (bDetail)
+      {
+        detailLines.vertices.push_back(it->first);
+        detailLines.vertices.push_back(it->first + it->second/10000.0);
+      }
+
+      double fLength = it->second.getLength();
+      fTotal += fLength;
+      vecTotalPosition += it->first*fLength;
+      vecTotal += it->second;
+    }
+    frame.addGeometry(detailLines);
+
+    if (bTotal)
+    {
+      if (fTotal > 0)
+        vecTotalPosition /= fTotal;
+      CSWRenderFrame::Geometry totalLine(CSWRenderFrame::Geometry::LINES, Matrix44D(), 4);
+      totalLine.vertices.push_back(vecTotalPosition);
+      totalLine.vertices.push_back(vecTotalPosition + vecTotal/10000.0);
+      totalLine.colors.push_back(Vector4D(0, 0.6, 1, 0.5));
+      frame.addGeometry(totalLine);
+    }
+  }
+
 }
\ No newline at end of file
@@ -7,6 +7,8 @@
 namespace CodeSubWars
 {
 
+  struct CSWRenderFrame;
+
   class CSWDynamic
   {
     public:
@@ -14,9 +16,25 @@ namespace CodeSubWars
 
       typedef std::pair<Vector3D, double> MassPoint; //Position and mass
       typedef std::vector<MassPoint> MassPointContainer; 
-      typedef std::pair<MassPointContainer::iterator, MassPointContainer::iterator> MassPointContainerRange;
+      typedef std::pair<MassPointContainer::const_iterator, MassPointContainer::const_iterator> MassPointContainerRange;
+
+      /**
+       * Everything that only depends on the mass mesh. It is immutable and shared by all objects with the same mass 
+       * mesh (see CSWShapeCache).
+       */
+      struct MassProperties
+      {
+        MassPointContainer massPoints;              //mass in local system
+        double fMass;
+        Vector3D vecCenterOfMass;
+        Matrix33D matMomentOfInertia;
+        Matrix33D matMomentOfInertiaInvert;
+        AxisAlignedBoundingBoxD boundingBox;
+      };
+      typedef std::shared_ptr<const MassProperties> MassPropertiesPtrType;
 
       static PtrType create(const Matrix44D& matBaseTObject, const Mesh::PtrType pMassMesh);
+      static MassPropertiesPtrType calcMassProperties(const Mesh::PtrType pMassMesh);
       ~CSWDynamic();
 
       void setMassMesh(const Mesh::PtrType pMassMesh);
@@ -34,6 +52,13 @@ namespace CodeSubWars
 
       Matrix44D updatePosition();
 
+      /**
+       * An object falls asleep after resting for some time without noteworthy forces. While sleeping its position is
+       * not integrated anymore and forces or impulses below the wake thresholds are dropped. Larger ones, a new
+       * transform or a new velocity wake it up again.
+       */
+      bool isSleeping() const;
+
       //in world coordsystem
       void resetForce();
 
@@ -51,11 +76,15 @@ namespace CodeSubWars
       const Vector3D& getAngularMomentum() const;
       const Matrix33D& getInvertedMomentOfIntertia() const;
   
-      void draw();
+      //adds the mass points and force lines for debugging
+      void collectRenderData(CSWRenderFrame& frame, const Matrix44D& matWorldTransform) const;
 
     protected:
       CSWDynamic(const Matrix44D& matBaseTObject, const Mesh::PtrType pMassMesh);
 
+      static void addVectorLines(CSWRenderFrame& frame, const std::vector<std::pair<Vector3D, Vector3D> >& vectors,
+                                 bool bDetail, bool bTotal);
+
       void validate();
 
       void initialize(const Vector3D& vecWorldTPositionCM, 
@@ -65,11 +94,19 @@ namespace CodeSubWars
 
       double getElapsedTime();
 
+      bool isAtRest() const;
+      void fallAsleep();
+
       static Matrix33D tildeOperator(const Vector3D& vec);
 
       static const double OBJECT_DENSITY;
       static const double MAXIMAL_VELOCITY;
       static const double MAXIMAL_ANGULAR_VELOCITY;
+      static const double SLEEP_VELOCITY;
+      static const double SLEEP_ANGULAR_VELOCITY;
+      static const double SLEEP_ACCELERATION;
+      static const double SLEEP_ANGULAR_ACCELERATION;
+      static const double SLEEP_DELAY;
     
 
 
@@ -95,7 +132,7 @@ namespace CodeSubWars
       Vector3D m_vecWorldTTorqueTotal;              //t
 
       Mesh::PtrType m_pMassMesh;                    //in local coord system
-      MassPointContainer m_MassPoints;              //mass in local system, force world coord system
+      MassPropertiesPtrType m_pMassProperties;
       Matrix44D m_matCenterOfMassTObject;
       Vector3D m_vecWorldTForceCM;
 
@@ -106,6 +143,9 @@ namespace CodeSubWars
 
       std::vector<std::pair<Vector3D, Vector3D> > m_AppliedImpulses; //in world coord system: position and impuls
       std::vector<std::pair<Vector3D, Vector3D> > m_OldAppliedImpulses; //in world coord system: position and impuls
+
+      bool m_bSleeping;
+      double m_fRestingTime;                        //in seconds
   };
 
 }
\ No newline at end of file
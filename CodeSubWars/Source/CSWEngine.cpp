@@ -2,10 +2,10 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWEngine.h"
+#include "CSWObjectPool.h"
 #include "CSWWorld.h"
-#include "CSWEngineVisualizer.h"
 #include "CSWSoundVisualizer.h"
 #include "CSWISoundReceiver.h"
 
@@ -19,7 +19,7 @@ namespace CodeSubWars
   CSWEngine::PtrType CSWEngine::create(const std::string& strName, const Matrix44D& matBaseTObject,
                                        const Size3D& size, bool bAllowDirectionChanges)
   {
-    return PtrType(new CSWEngine(strName, matBaseTObject, size, bAllowDirectionChanges));
+    return CSWObjectPool::create<CSWEngine>([&](void* pBlock) { return new (pBlock) CSWEngine(strName, matBaseTObject, size, bAllowDirectionChanges); });
   }
 
 
@@ -28,14 +28,6 @@ namespace CodeSubWars
   }
 
 
-  QWidget* CSWEngine::getInformationWidget(QWidget* pParent)
-  {
-    if (!m_pVisualizer)
-      m_pVisualizer = new CSWEngineVisualizer(pParent, std::dynamic_pointer_cast<CSWEngine>(getSharedThis()));
-    return m_pVisualizer;
-  }
-
-
   bool CSWEngine::isSoundEmitterActive() const
   {
     return fabs(m_fIntensity) > EPSILON;
@@ -113,8 +105,7 @@ namespace CodeSubWars
   : CSWActuator(strName, matBaseTObject, MAX_OAR_ANGLE, ANGLULAR_VELOCITY),
     m_fMaxForce(size.getVolume()*1e+6),
     m_fIntensity(0),
-    m_bAllowDirectionChanges(bAllowDirectionChanges),
-    m_pVisualizer(NULL)
+    m_bAllowDirectionChanges(bAllowDirectionChanges)
   {
   }
 
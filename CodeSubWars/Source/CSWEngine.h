@@ -10,7 +10,7 @@
 namespace CodeSubWars
 {
 
-  class CSWEngineVisualizer;
+  class CSWInformationSnapshot;
 
   /**
    * This class encapsulates a machine that can "emit" a force in a direction. The maximal force is depend on the size of the 
@@ -28,9 +28,6 @@ namespace CodeSubWars
 
       virtual ~CSWEngine();
 
-      //defined methods from CSWEquipment
-      virtual QWidget* getInformationWidget(QWidget* pParent);
-
       //defined methods from ISoundEmitter
       virtual bool isSoundEmitterActive() const;
       virtual void initializeSoundEmission();
@@ -78,7 +75,7 @@ namespace CodeSubWars
        */
       const double& getIntensity();
  
-      friend CSWEngineVisualizer;
+      friend CSWInformationSnapshot;
     protected:
       CSWEngine(const std::string& strName, const Matrix44D& matBaseTObject,
                 const Size3D& size, bool bAllowDirectionChanges);
@@ -89,8 +86,6 @@ namespace CodeSubWars
       double m_fMaxForce;
       double m_fIntensity;
       bool m_bAllowDirectionChanges;
-    
-      CSWEngineVisualizer* m_pVisualizer;
   };
 
 }
\ No newline at end of file
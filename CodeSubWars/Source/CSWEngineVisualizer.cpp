@@ -4,15 +4,13 @@
 
 #include "PrecompiledHeader.h"
 #include "CSWEngineVisualizer.h"
-#include "CSWEngine.h"
 
 
 namespace CodeSubWars
 {
 
-  CSWEngineVisualizer::CSWEngineVisualizer(QWidget* pParent, CSWEngine::PtrType pEngine)
-  : QWidget(pParent),
-    m_pEngine(pEngine)
+  CSWEngineVisualizer::CSWEngineVisualizer(QWidget* pParent)
+  : QWidget(pParent)
   {
     QHBoxLayout* pLayout = new QHBoxLayout(this); 
     pLayout->setSpacing(2);
@@ -23,17 +21,17 @@ namespace CodeSubWars
   }
 
 
-  void CSWEngineVisualizer::updateContent()
+  void CSWEngineVisualizer::updateContent(const CSWInformationSnapshot::PtrType& pInformation)
   {
-    if (CSWEngine::PtrType pEngine = m_pEngine.lock())
+    if (pInformation && (pInformation->nProperties & CSWInformationSnapshot::ENGINE))
     {
       std::stringstream ss;
       ss.precision(3);
       ss.setf(std::ios::fixed);
-      ss << "Maximal Force [MN]: " << pEngine->m_fMaxForce/1e+6 << "\n"
-         << "Intensity [%]: " << pEngine->m_fIntensity*100 << "\n"
-         << "Force [MN]: " << pEngine->m_fIntensity*pEngine->m_fMaxForce/1e+6 << "\n"       
-         << "Direction changes possible: " << pEngine->m_bAllowDirectionChanges << "\n";       
+      ss << "Maximal Force [MN]: " << pInformation->fMaxForce/1e+6 << "\n"
+         << "Intensity [%]: " << pInformation->fIntensity*100 << "\n"
+         << "Force [MN]: " << pInformation->fIntensity*pInformation->fMaxForce/1e+6 << "\n"       
+         << "Direction changes possible: " << pInformation->bAllowDirectionChanges << "\n";       
       m_pLabel->setText(ss.str().c_str());
       update();
     }  
@@ -11,18 +11,15 @@
 namespace CodeSubWars
 {
 
-  class CSWEngine;
-
   class CSWEngineVisualizer : public QWidget,
                               public CSWIEquipmentVisualizer
   {
     public:
-      CSWEngineVisualizer(QWidget* pParent, std::shared_ptr<CSWEngine> pEngine);
+      CSWEngineVisualizer(QWidget* pParent);
     
-      virtual void updateContent();
+      virtual void updateContent(const CSWInformationSnapshot::PtrType& pInformation);
     
     protected:
-      std::weak_ptr<CSWEngine> m_pEngine;
       QLabel* m_pLabel;
   };
 
@@ -2,7 +2,7 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 
 #include "CSWEquipment.h"
 
@@ -103,12 +103,6 @@ namespace CodeSubWars
   }
 
 
-  QWidget* CSWEquipment::getInformationWidget(QWidget* pParent)
-  {
-    return NULL;
-  }
-
-
   CSWEquipment::CSWEquipment(const std::string& strName, const Matrix44D& matBaseTObject,
                              const double& fMaxAngle, const double& fAngularVelocity)
   : CSWObject(strName, matBaseTObject),
@@ -42,8 +42,6 @@ namespace CodeSubWars
        */
       bool isMoving() const;
 
-      virtual QWidget* getInformationWidget(QWidget* pParent);
-
     protected:
       CSWEquipment(const std::string& strName, const Matrix44D& matBaseTObject,
                    const double& fMaxAngle, const double& fAngularVelocity);
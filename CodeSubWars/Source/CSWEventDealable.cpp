@@ -2,9 +2,10 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "Constants.h"
 #include "CSWEventDealable.h"
+#include "CSWObjectPool.h"
 #include "CSWEvent.h"
 #include "CSWEventManager.h"
 #include "CSWObject.h"
@@ -16,7 +17,7 @@ namespace CodeSubWars
 
   CSWEventDealable::PtrType CSWEventDealable::create()
   {
-    return PtrType(new CSWEventDealable());
+    return CSWObjectPool::create<CSWEventDealable>([&](void* pBlock) { return new (pBlock) CSWEventDealable(); });
   }
 
 
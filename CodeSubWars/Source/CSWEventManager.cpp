@@ -2,18 +2,18 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWObject.h"
 #include "CSWEvent.h"
 #include "CSWEventManager.h"
 #include "CSWIEventDealable.h"
-#include "CSWMessageReceiveEventObjects.h"
-#include "CSWWorld.h"
+#include "CSWIMessage.h"
 
 
 namespace CodeSubWars
 {
 
+
   CSWEventManager::PtrType CSWEventManager::getInstance()
   {
     static PtrType pInstance = PtrType(new CSWEventManager());
@@ -45,9 +45,27 @@ namespace CodeSubWars
         CSWObject::PtrType pObject = (*it)->getReceiver();
         if (!pObject)
         {
-          //receiver is not defined -> broadcast message to ALL objects in world tree
-          CSWMessageReceiveEventObjects<CSWObject> receiveEventMessage(*it);
-          ARSTD::Message<CSWObject>::broadcastMessage(CSWWorld::getInstance()->getObjectTree(), receiveEventMessage);          
+          //receiver is not defined -> deliver to all subscribers of the message type and of all messages in order of subscription
+          static const SubscriptionContainer NO_SUBSCRIPTIONS;
+          const SubscriptionContainer* pTypedSubscriptions = &NO_SUBSCRIPTIONS;
+          if (CSWIMessage::PtrType pMessage = (*it)->getMessage())
+          {
+            const CSWIMessage& message = *pMessage;
+            std::unordered_map<std::type_index, SubscriptionContainer>::const_iterator itFound = m_TypedSubscriptions.find(std::type_index(typeid(message)));
+            if (itFound != m_TypedSubscriptions.end())
+              pTypedSubscriptions = &itFound->second;
+          }
+
+          SubscriptionContainer::const_iterator itTyped = pTypedSubscriptions->begin();
+          SubscriptionContainer::const_iterator itGeneral = m_GeneralSubscriptions.begin();
+          while (itTyped != pTypedSubscriptions->end() || itGeneral != m_GeneralSubscriptions.end())
+          {
+            if (itGeneral == m_GeneralSubscriptions.end() || 
+                (itTyped != pTypedSubscriptions->end() && itTyped->nSequence < itGeneral->nSequence))
+              deliver(*it, *itTyped++);
+            else
+              deliver(*it, *itGeneral++);
+          }
         }
         else if (CSWIEventDealable::PtrType pEventDealable = std::dynamic_pointer_cast<CSWIEventDealable>(pObject))
         {
@@ -59,8 +77,120 @@ namespace CodeSubWars
   }
 
 
+  void CSWEventManager::subscribe(CSWObject::PtrType pObject, const std::type_info& messageType)
+  {
+    addSubscription(m_TypedSubscriptions[std::type_index(messageType)], pObject);
+  }
+
+
+  void CSWEventManager::subscribeAll(CSWObject::PtrType pObject)
+  {
+    addSubscription(m_GeneralSubscriptions, pObject);
+  }
+
+
+  void CSWEventManager::unsubscribe(CSWObject::PtrType pObject)
+  {
+    //the remaining subscriptions must keep their order
+    const CSWObject* pObjectKey = pObject.get();
+    auto removeSubscriptions = [pObjectKey](SubscriptionContainer& subscriptions)
+    {
+      subscriptions.erase(std::remove_if(subscriptions.begin(), subscriptions.end(),
+                                         [pObjectKey](const Subscription& subscription) { return subscription.pObjectKey == pObjectKey; }),
+                          subscriptions.end());
+    };
+
+    removeSubscriptions(m_GeneralSubscriptions);
+    std::unordered_map<std::type_index, SubscriptionContainer>::iterator it = m_TypedSubscriptions.begin();
+    for (; it != m_TypedSubscriptions.end(); ++it)
+      removeSubscriptions(it->second);
+  }
+
+
+  void CSWEventManager::registerObject(CSWObject::PtrType pObject)
+  {
+    if (CSWIEventDealable::PtrType pEventDealable = std::dynamic_pointer_cast<CSWIEventDealable>(pObject))
+    {
+      unsubscribe(pObject);
+      pEventDealable->subscribeEvents(getInstance());
+    }
+
+    ARSTD::Node::ChildConstRange range = pObject->getChildRange();
+    for (ARSTD::Node::ChildConstIterator it = range.first; it != range.second; ++it)
+    {
+      CSWObject::PtrType pChild = std::dynamic_pointer_cast<CSWObject>(*it);
+      if (pChild)
+        registerObject(pChild);
+    }
+  }
+
+
+  void CSWEventManager::unregisterObject(CSWObject::PtrType pObject)
+  {
+    if (std::dynamic_pointer_cast<CSWIEventDealable>(pObject))
+      unsubscribe(pObject);
+
+    ARSTD::Node::ChildConstRange range = pObject->getChildRange();
+    for (ARSTD::Node::ChildConstIterator it = range.first; it != range.second; ++it)
+    {
+      CSWObject::PtrType pChild = std::dynamic_pointer_cast<CSWObject>(*it);
+      if (pChild)
+        unregisterObject(pChild);
+    }
+  }
+
+
+  void CSWEventManager::reset(CSWObject::PtrType pObjectTree)
+  {
+    m_TypedSubscriptions.clear();
+    m_GeneralSubscriptions.clear();
+    if (pObjectTree)
+      registerObject(pObjectTree);
+  }
+
+
+  bool CSWEventManager::hasEvents() const
+  {
+    return !m_EventContainer.empty();
+  }
+
+
+  void CSWEventManager::clearEvents()
+  {
+    m_EventContainer.clear();
+  }
+
+
   CSWEventManager::CSWEventManager()
+  : m_nNextSequence(0)
+  {
+  }
+
+
+  void CSWEventManager::addSubscription(SubscriptionContainer& subscriptions, CSWObject::PtrType pObject)
   {
+    CSWIEventDealable* pEventDealable = dynamic_cast<CSWIEventDealable*>(pObject.get());
+    if (!pEventDealable)
+      return;
+
+    Subscription subscription;
+    subscription.nSequence = m_nNextSequence++;
+    subscription.pObjectKey = pObject.get();
+    subscription.pObject = pObject;
+    subscription.pEventDealable = pEventDealable;
+    subscriptions.push_back(subscription);
+  }
+
+
+  void CSWEventManager::deliver(CSWEvent::PtrType pEvent, const Subscription& subscription)
+  {
+    CSWObject::PtrType pObject = subscription.pObject.lock();
+    if (!pObject || pEvent->getSender() == pObject)
+      return;
+
+    CSWEvent::PtrType pCopiedEvent = pEvent->copy();
+    pCopiedEvent->setReceiver(pObject);
+    subscription.pEventDealable->receiveEvent(pCopiedEvent);
   }
 
 }
\ No newline at end of file
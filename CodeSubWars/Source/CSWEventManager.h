@@ -5,15 +5,21 @@
 #pragma once
 
 #include <boost/smart_ptr.hpp>
+#include <typeindex>
 
 namespace CodeSubWars
 {
 
+  class CSWObject;
   class CSWEvent;
+  class CSWIEventDealable;
 
   /**
    * This class manages sending and delivering of events. An event is repeatly delivered to the receiver until the receiver processed the event
    * successfully by returning true in the processEvent method or the time to life has expired.
+   * Events without receiver (broadcasts) are delivered to the objects that subscribed to the type of their message, in the order the objects
+   * subscribed. The world registers the event dealable objects when they are attached and unregisters them when they are detached, the objects 
+   * choose their message types in CSWIEventDealable::subscribeEvents().
    */
   class CSWEventManager
   {
@@ -31,12 +37,77 @@ namespace CodeSubWars
       //deliver all queued events
       void deliverAllEvents();
 
+      /**
+       * Delivers the events without receiver that contain a message of exactly the given type to the given object.
+       */
+      template <class MessageType>
+      void subscribe(std::shared_ptr<CSWObject> pObject);
+      void subscribe(std::shared_ptr<CSWObject> pObject, const std::type_info& messageType);
+
+      /**
+       * Delivers all events without receiver to the given object.
+       */
+      void subscribeAll(std::shared_ptr<CSWObject> pObject);
+
+      /**
+       * Removes all subscriptions of the given object.
+       */
+      void unsubscribe(std::shared_ptr<CSWObject> pObject);
+
+      /**
+       * Lets all event dealable objects of the given subtree subscribe. Must be called when the subtree is attached to the world.
+       */
+      void registerObject(std::shared_ptr<CSWObject> pObject);
+
+      /**
+       * Removes all subscriptions of the objects of the given subtree.
+       */
+      void unregisterObject(std::shared_ptr<CSWObject> pObject);
+
+      /**
+       * Replaces all subscriptions with those of the objects of the given tree.
+       */
+      void reset(std::shared_ptr<CSWObject> pObjectTree);
+
+      /**
+       * Returns true if there are events that have not been delivered yet.
+       */
+      bool hasEvents() const;
+
+      /**
+       * Removes all events that have not been delivered yet.
+       */
+      void clearEvents();
+
     protected:
       typedef std::list<std::shared_ptr<CSWEvent> > EventContainer;
 
+      struct Subscription
+      {
+        unsigned long nSequence;              //order of subscription, gives the order of delivery
+        const CSWObject* pObjectKey;
+        std::weak_ptr<CSWObject> pObject;
+        CSWIEventDealable* pEventDealable;
+      };
+      typedef std::vector<Subscription> SubscriptionContainer;
+
       CSWEventManager();
 
+      void addSubscription(SubscriptionContainer& subscriptions, std::shared_ptr<CSWObject> pObject);
+      void deliver(std::shared_ptr<CSWEvent> pEvent, const Subscription& subscription);
+
       EventContainer m_EventContainer;
+      std::unordered_map<std::type_index, SubscriptionContainer> m_TypedSubscriptions;
+      SubscriptionContainer m_GeneralSubscriptions;
+      unsigned long m_nNextSequence;
   };
 
+
+
+  template <class MessageType>
+  void CSWEventManager::subscribe(std::shared_ptr<CSWObject> pObject)
+  {
+    subscribe(pObject, typeid(MessageType));
+  }
+
 }
\ No newline at end of file
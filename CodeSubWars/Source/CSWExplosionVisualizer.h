@@ -15,28 +15,41 @@ namespace CodeSubWars
 
       ~CSWExplosionVisualizer();
 
+      /**
+       * Enables collecting new entries. Disabled by default since entries are only needed if the world is drawn.
+       */
+      void setEnabled(bool bEnabled);
+
       void addExplosion(const Vector3D& vecPosition, const double& fRadius);
 
       void clear();
-        
-      void draw();
+
+      /**
+       * Adds the current explosions as instances of a unit sphere and removes the faded ones.
+       */
+      void collect(Mesh::InstanceContainer& instances);
     
     protected:
       struct ExplosionEntry
       {
-        ExplosionEntry() : vecPosition(0, 0, 0), fRadius(0), fTimeToStop(-1), bDrawn(false) {}
+        ExplosionEntry() : vecPosition(0, 0, 0), fRadius(0), fTimeToStop(-1), bCollected(false) {}
       
         Vector3D vecPosition;
         double fRadius;
         double fTimeToStop;
-        bool bDrawn;
+        bool bCollected;
       };
     
       typedef std::vector<ExplosionEntry> ExplosionContainer;
   
       CSWExplosionVisualizer();
 
+      static void addSphereInstance(const ExplosionEntry& explosion, double fAlpha, Mesh::InstanceContainer& instances);
+
+      bool m_bEnabled;
       ExplosionContainer m_Explosions;
+      //entries are added by the simulation and removed while collecting a render frame
+      std::mutex m_mtxEntries;
   };
 
 }
\ No newline at end of file
@@ -2,9 +2,8 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWExplosionVisualizer.h"
-#include "glut.h"
 
 namespace CodeSubWars
 {
@@ -20,28 +19,37 @@ namespace CodeSubWars
   }
 
 
+  void CSWExplosionVisualizer::setEnabled(bool bEnabled)
+  {
+    m_bEnabled = bEnabled;
+  }
+
+
   void CSWExplosionVisualizer::addExplosion(const Vector3D& vecPosition, const double& fRadius)
   {
-    //explosion can only be added in graphic mode
-    if (!qApp)
+    //only collected if something is drawing them
+    if (!m_bEnabled)
       return;
 
     ExplosionEntry e;
     e.vecPosition = vecPosition;
     e.fRadius = fRadius;
     e.fTimeToStop = ARSTD::Time::getTime() + fRadius/50.0*0.25;
+    std::lock_guard<std::mutex> lck(m_mtxEntries);
     m_Explosions.push_back(e);
   }
 
 
   void CSWExplosionVisualizer::clear()
   {
+    std::lock_guard<std::mutex> lck(m_mtxEntries);
     m_Explosions.clear();
   }
 
 
-  void CSWExplosionVisualizer::draw()
+  void CSWExplosionVisualizer::collect(Mesh::InstanceContainer& instances)
   {
+    std::lock_guard<std::mutex> lck(m_mtxEntries);
     if (m_Explosions.empty())
       return;
   
@@ -50,62 +58,44 @@ namespace CodeSubWars
   
     double fCurrentTime = ARSTD::Time::getTime();
 
-    glPushAttrib(GL_ALL_ATTRIB_BITS);
-      glEnable(GL_DEPTH_TEST);
-      glDepthMask(false);
-      glDisable(GL_LIGHTING);
-      glEnable(GL_COLOR_MATERIAL);
-
-      glPolygonMode(GL_FRONT, GL_FILL);
-
-      glCullFace(GL_BACK);    
-      glEnable(GL_CULL_FACE);
-    
-      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-      glEnable(GL_BLEND);
-      glMatrixMode(GL_MODELVIEW);
-      glPushMatrix();
-
-      GLUquadricObj* pSphere = gluNewQuadric();
-      gluQuadricDrawStyle(pSphere, GLU_FILL);
-      Matrix44D mat;
-      ExplosionContainer::iterator it = m_Explosions.begin();
-      for (; it != m_Explosions.end(); ++it)
+    ExplosionContainer::iterator it = m_Explosions.begin();
+    for (; it != m_Explosions.end(); ++it)
+    {
+      if (fCurrentTime < it->fTimeToStop)
       {
-        if (fCurrentTime < it->fTimeToStop)
-        {
-          assert(50.0/it->fRadius*2*(it->fTimeToStop - fCurrentTime) <= 0.5);
-          glColor4d(1.0, 0.5, 0.1, 50.0/it->fRadius*2*(it->fTimeToStop - fCurrentTime));
-          mat.getTranslation() = it->vecPosition;
-          glLoadMatrixd(mat.pData);
-
-          gluSphere(pSphere, it->fRadius, 10, 10);
-        
-          it->bDrawn = true;
-          newExplosions.push_back(*it);    
-        }
-        else if (!it->bDrawn)
-        {
-          //at least one 'flash' must be drawn
-          glColor4d(1.0, 0.5, 0.1, 0.5);
-          mat.getTranslation() = it->vecPosition;
-          glLoadMatrixd(mat.pData);
-
-          gluSphere(pSphere, it->fRadius, 10, 10);
-        }
+        assert(50.0/it->fRadius*2*(it->fTimeToStop - fCurrentTime) <= 0.5);
+        addSphereInstance(*it, 50.0/it->fRadius*2*(it->fTimeToStop - fCurrentTime), instances);
+      
+        it->bCollected = true;
+        newExplosions.push_back(*it);    
       }
-
-      glDepthMask(true);
-      glPopMatrix();
-      gluDeleteQuadric(pSphere);
-    glPopAttrib();
+      else if (!it->bCollected)
+      {
+        //at least one 'flash' must be drawn
+        addSphereInstance(*it, 0.5, instances);
+      }
+    }
 
     m_Explosions.swap(newExplosions);
   }
 
 
   CSWExplosionVisualizer::CSWExplosionVisualizer()
+  : m_bEnabled(false)
+  {
+  }
+
+
+  void CSWExplosionVisualizer::addSphereInstance(const ExplosionEntry& explosion, double fAlpha,
+                                                 Mesh::InstanceContainer& instances)
   {
+    Mesh::Instance instance;
+    instance.matTransform = Matrix44F(Matrix44D(Vector3D(explosion.fRadius, 0, 0), 
+                                                Vector3D(0, explosion.fRadius, 0), 
+                                                Vector3D(0, 0, explosion.fRadius), 
+                                                explosion.vecPosition));
+    instance.vecColor = Vector4F(1.0f, 0.5f, 0.1f, static_cast<float>(fAlpha));
+    instances.push_back(instance);
   }
 
 }
\ No newline at end of file
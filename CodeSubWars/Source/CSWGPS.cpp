@@ -2,8 +2,9 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWGPS.h"
+#include "CSWObjectPool.h"
 #include "CSWWorld.h"
 #include "CSWEvent.h"
 #include "CSWEventManager.h"
@@ -13,7 +14,7 @@ namespace CodeSubWars
 
   CSWGPS::PtrType CSWGPS::create(const std::string& strName, CSWEvent::PtrType pEvent)
   {
-    return PtrType(new CSWGPS(strName, pEvent));
+    return CSWObjectPool::create<CSWGPS>([&](void* pBlock) { return new (pBlock) CSWGPS(strName, pEvent); });
   }
 
 
@@ -2,9 +2,10 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWUtilities.h"
 #include "CSWGyroCompass.h"
+#include "CSWObjectPool.h"
 #include "CSWSubmarine.h"
 #include "CSWEvent.h"
 #include "CSWEventManager.h"
@@ -14,7 +15,7 @@ namespace CodeSubWars
 
   CSWGyroCompass::PtrType CSWGyroCompass::create(const std::string& strName, CSWEvent::PtrType pEvent)
   {
-    return PtrType(new CSWGyroCompass(strName, pEvent));
+    return CSWObjectPool::create<CSWGyroCompass>([&](void* pBlock) { return new (pBlock) CSWGyroCompass(strName, pEvent); });
   }
 
 
@@ -2,7 +2,7 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWHomingTorpedo.h"
 #include "CSWWorld.h"
 #include "CSWSettings.h"
@@ -30,13 +30,13 @@ namespace CodeSubWars
   }
 
 
-  void CSWHomingTorpedo::draw()
+  void CSWHomingTorpedo::collectRenderData(CSWRenderFrame& frame, CSWRenderFrame::Entry& entry)
   {
-    CSWWeapon::draw();
+    CSWWeapon::collectRenderData(frame, entry);
 
     if (CSWWorld::getInstance()->getSettings()->getSelectedObject() == getSharedThis())
     {
-      getActiveSonar()->draw();
+      getActiveSonar()->collectRenderData(frame);
     }
   }
 
@@ -29,7 +29,7 @@ namespace CodeSubWars
       virtual void update();
 
       //for debugging stuff
-      virtual void draw();
+      virtual void collectRenderData(CSWRenderFrame& frame, CSWRenderFrame::Entry& entry);
 
     protected:
       CSWHomingTorpedo(const std::string& strName, const Matrix44D& matBaseTObject, double fLength);
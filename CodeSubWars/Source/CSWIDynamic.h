@@ -20,11 +20,12 @@ namespace CodeSubWars
       typedef std::vector<std::pair<Vector3D, Vector3D> > ForceContainer;
       typedef std::pair<Vector3D, double> MassPoint; //position and mass
       typedef std::vector<MassPoint> MassPointContainer;
-      typedef std::pair<MassPointContainer::iterator, MassPointContainer::iterator> MassPointContainerRange;
+      typedef std::pair<MassPointContainer::const_iterator, MassPointContainer::const_iterator> MassPointContainerRange;
 
       virtual ~CSWIDynamic() {}
 
       virtual void updatePosition() = 0;
+      virtual bool isSleeping() const = 0;
 
       //in world coordsystem
       virtual void resetForce() = 0;
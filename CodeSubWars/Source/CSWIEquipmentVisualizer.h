@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "CSWInformationSnapshot.h"
+
 namespace CodeSubWars
 {
 
@@ -15,7 +17,11 @@ namespace CodeSubWars
     public:
       virtual ~CSWIEquipmentVisualizer() {}
     
-      virtual void updateContent() = 0;
+      /**
+       * Shows the equipment as given in the snapshot of the selected object. The visualizers never access the
+       * equipment itself, so they need no lock of the world.
+       */
+      virtual void updateContent(const CSWInformationSnapshot::PtrType& pInformation) = 0;
   };
 
 }
\ No newline at end of file
@@ -8,6 +8,7 @@ namespace CodeSubWars
 {
 
   class CSWEvent;
+  class CSWEventManager;
 
   /**
    * Objects with this property can send or receive events.
@@ -25,6 +26,10 @@ namespace CodeSubWars
       virtual void receiveEvent(std::shared_ptr<CSWEvent> pEvent) = 0;
       virtual void processReceivedQueuedEvents() = 0;
 
+      //Is called when the object is attached to the world. The object subscribes here to the messages of events without receiver it wants 
+      //to get (see CSWEventManager::subscribe()).
+      virtual void subscribeEvents(std::shared_ptr<CSWEventManager> pEventManager) = 0;
+
       //This method must be overriden in the specialized class. This methode is called if an event has been received by the object that should be 
       //processed. Returning true reports the eventmanager that the event passed to the object has successfully processed and delete it.
       //When returning false the event will be delivered the next time again until it expires or processed successfully.
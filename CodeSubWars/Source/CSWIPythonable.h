@@ -28,6 +28,10 @@ namespace CodeSubWars
 
       virtual std::shared_ptr<PythonContext> getPythonContext() = 0;
       virtual void setPythonContext(std::shared_ptr<PythonContext> context) = 0;
+
+      //the state of the object defined in python stored in world snapshots, empty if it has none
+      virtual std::string getPickledState() { return std::string(); }
+      virtual void setPickledState(const std::string& strState) {}
   };
 
 }
\ No newline at end of file
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "CSWRenderFrame.h"
+
 
 namespace CodeSubWars
 {
@@ -18,7 +20,9 @@ namespace CodeSubWars
 
       virtual ~CSWISolid() {}
 
-      virtual void draw() = 0;
+      //Adds what is needed to draw the object. The surface is set in the entry of the object, debugging geometry
+      //is added to the frame.
+      virtual void collectRenderData(CSWRenderFrame& frame, CSWRenderFrame::Entry& entry) = 0;
 
       //given in locale coordsystem
       virtual const Mesh::PtrType getSurface() const = 0;
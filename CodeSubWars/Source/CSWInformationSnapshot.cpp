@@ -0,0 +1,271 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#include "CorePrecompiledHeader.h"
+#include "CSWInformationSnapshot.h"
+#include "PythonContext.h"
+
+#include "CSWObject.h"
+#include "CSWCamera.h"
+#include "CSWWeapon.h"
+#include "CSWWeaponSupply.h"
+#include "CSWEquipment.h"
+#include "CSWEngine.h"
+#include "CSWActiveSonar.h"
+#include "CSWPassiveSonar.h"
+#include "CSWMap.h"
+#include "CSWWeaponBattery.h"
+
+#include "CSWICommandable.h"
+#include "CSWIDamageable.h"
+#include "CSWIDynamic.h"
+#include "CSWIEventDealable.h"
+#include "CSWIPythonable.h"
+#include "CSWIRechargeable.h"
+#include "CSWIResourceProvider.h"
+#include "CSWISolid.h"
+#include "CSWISoundReceiver.h"
+
+
+namespace CodeSubWars
+{
+
+  const size_t CSWInformationSnapshot::MAX_NUM_MESSAGES = 30;
+
+
+  CSWInformationSnapshot::PtrType CSWInformationSnapshot::create(CSWObject::PtrType pObjectTree, CSWObject::PtrType pSelectedObject,
+                                                                 const std::vector<boost::tuples::tuple<std::string, double, double> >& load,
+                                                                 const PtrType& pPrevious, bool bObjectTreeChanged)
+  {
+    std::shared_ptr<CSWInformationSnapshot> pSnapshot(new CSWInformationSnapshot());
+    pSnapshot->nSequence = pPrevious ? pPrevious->nSequence + 1 : 0;
+    pSnapshot->fTime = ARSTD::Time::getTime();
+    pSnapshot->load = load;
+
+    if (!pPrevious || !pPrevious->pObjects || bObjectTreeChanged)
+    {
+      std::shared_ptr<ObjectContainer> pObjects(new ObjectContainer());
+      if (pObjectTree)
+      {
+        CSWObject::ChildRange range = pObjectTree->getChildRange();
+        for (CSWObject::ChildIterator it = range.first; it != range.second; ++it)
+        {
+          if (CSWObject::PtrType pChild = std::dynamic_pointer_cast<CSWObject>(*it))
+            pSnapshot->collectObjects(pChild, -1, *pObjects);
+        }
+      }
+      pSnapshot->pObjects = pObjects;
+      pSnapshot->nObjectTreeVersion = pPrevious ? pPrevious->nObjectTreeVersion + 1 : 0;
+    }
+    else
+    {
+      pSnapshot->pObjects = pPrevious->pObjects;
+      pSnapshot->nObjectTreeVersion = pPrevious->nObjectTreeVersion;
+    }
+
+    if (pSelectedObject)
+      pSnapshot->collectSelectedObject(pSelectedObject, pPrevious);
+
+    return pSnapshot;
+  }
+
+
+  CSWInformationSnapshot::~CSWInformationSnapshot()
+  {
+  }
+
+
+  CSWInformationSnapshot::CSWInformationSnapshot()
+  : nSequence(0),
+    fTime(0),
+    nObjectTreeVersion(0),
+    nProperties(0),
+    nStackDepth(0),
+    nNumExecutedCommands(0),
+    fCurrentCommandProgress(-1),
+    fHealth(0),
+    fTotalMass(0),
+    vecVelocity(0, 0, 0),
+    vecAcceleration(0, 0, 0),
+    vecAngularVelocity(0, 0, 0),
+    vecAngularAcceleration(0, 0, 0),
+    fFillLevel(0),
+    fAngleOfBeam(0),
+    vecSoundDirection(0, 0, 0),
+    fSoundLevel(0),
+    fMaxForce(0),
+    fIntensity(0),
+    bAllowDirectionChanges(false),
+    vecScanDirection(0, 0, 0),
+    fMaximalDistance(0),
+    nMaxNumWeapons(0)
+  {
+  }
+
+
+  void CSWInformationSnapshot::collectObjects(CSWObject::PtrType pObject, int nParent, ObjectContainer& objects)
+  {
+    if (std::dynamic_pointer_cast<CSWCamera>(pObject))
+      return;
+
+    ObjectEntry entry;
+    entry.strName = pObject->getName();
+    entry.nParent = nParent;
+    entry.bWeapon = std::dynamic_pointer_cast<CSWWeapon>(pObject) != NULL;
+    entry.pObject = pObject;
+    objects.push_back(entry);
+
+    int nIndex = static_cast<int>(objects.size()) - 1;
+    CSWObject::ChildRange range = pObject->getChildRange();
+    for (CSWObject::ChildIterator it = range.first; it != range.second; ++it)
+    {
+      if (CSWObject::PtrType pChild = std::dynamic_pointer_cast<CSWObject>(*it))
+        collectObjects(pChild, nIndex, objects);
+    }
+  }
+
+
+  void CSWInformationSnapshot::collectSelectedObject(CSWObject::PtrType pObject, const PtrType& pPrevious)
+  {
+    //commands and events may be defined in python
+    PythonContext::PtrType pyContext = PythonContext::createEmpty();
+    if (CSWIPythonable::PtrType pPythonObject = std::dynamic_pointer_cast<CSWIPythonable>(pObject))
+      pyContext = pPythonObject->getPythonContext();
+    auto lck = pyContext->makeCurrent();
+
+    pSelectedObject = pObject;
+    strName = pObject->getName();
+    matWorldTransform = pObject->getWorldTransform();
+
+    if (CSWICommandable::PtrType pObj = std::dynamic_pointer_cast<CSWICommandable>(pObject))
+    {
+      nProperties |= COMMANDABLE;
+      ARSTD::CommandProcessor::PtrType pCommandProcessor = pObj->getCommandProcessor();
+      nStackDepth = pCommandProcessor->getCurrentStackDepth();
+      nNumExecutedCommands = pCommandProcessor->getNumExecutedCommands();
+      fCurrentCommandProgress = pCommandProcessor->getCurrentCommandProgress();
+      if (fCurrentCommandProgress >= 0)
+      {
+        strCurrentCommandName = pCommandProcessor->getCurrentCommandName();
+        strCurrentCommandDetails = pCommandProcessor->getCurrentCommandDetails();
+      }
+      ARSTD::CommandProcessor::CommandConstRange range = pCommandProcessor->getWaitingCommands();
+      for (ARSTD::CommandProcessor::CommandConstIterator itCommand = range.first; itCommand != range.second; ++itCommand)
+        waitingCommandNames.push_back((*itCommand)->getName());
+    }
+    if (CSWIDamageable::PtrType pObj = std::dynamic_pointer_cast<CSWIDamageable>(pObject))
+    {
+      nProperties |= DAMAGEABLE;
+      fHealth = pObj->getHealth();
+      strHealthState = "Unknown";
+      if (pObj->isAlive())
+        strHealthState = "Alive";
+      else if (pObj->isZombie())
+        strHealthState = "Zombie";
+      else if (pObj->isDead())
+        strHealthState = "Dead";
+    }
+    if (CSWIDynamic::PtrType pObj = std::dynamic_pointer_cast<CSWIDynamic>(pObject))
+    {
+      nProperties |= DYNAMIC;
+      fTotalMass = pObj->getTotalMass();
+      vecVelocity = pObj->getVelocity();
+      vecAcceleration = pObj->getAcceleration();
+      vecAngularVelocity = pObj->getAngularVelocity();
+      vecAngularAcceleration = pObj->getAngularAcceleration();
+    }
+    if (CSWIEventDealable::PtrType pObj = std::dynamic_pointer_cast<CSWIEventDealable>(pObject))
+    {
+      nProperties |= EVENTDEALABLE;
+      strEventInformation = pObj->getCurrentInformation();
+
+      //messages are fetched only once from the object, so the previous ones are carried over
+      if (pPrevious && pPrevious->pSelectedObject.lock() == pObject)
+        eventMessages = pPrevious->eventMessages;
+      std::string strMessage = pObj->getCurrentMessage();
+      if (!strMessage.empty())
+        eventMessages.push_back(std::make_pair(nSequence, strMessage));
+      if (eventMessages.size() > MAX_NUM_MESSAGES)
+        eventMessages.erase(eventMessages.begin(), eventMessages.end() - MAX_NUM_MESSAGES);
+    }
+    if (CSWIResourceProvider::PtrType pObj = std::dynamic_pointer_cast<CSWIResourceProvider>(pObject))
+    {
+      nProperties |= RESOURCE_PROVIDER;
+      strResourceInformation = pObj->getCurrentInfo();
+    }
+    if (CSWIRechargeable::PtrType pObj = std::dynamic_pointer_cast<CSWIRechargeable>(pObject))
+    {
+      nProperties |= RECHARGEABLE;
+      strAcceptedResources = CSWWeaponSupply::translate(pObj->getAcceptedResourceIDs());
+      strRechargingResources = CSWWeaponSupply::translate(pObj->getRechargingIDs());
+      fFillLevel = pObj->getFillLevel();
+    }
+    if (CSWISolid::PtrType pObj = std::dynamic_pointer_cast<CSWISolid>(pObject))
+    {
+      nProperties |= SOLID;
+      size = pObj->getSurfaceBoundingBox().getSize();
+    }
+    if (std::dynamic_pointer_cast<CSWEquipment>(pObject))
+    {
+      nProperties |= EQUIPMENT;
+      collectEquipment(pObject);
+    }
+    if (CSWISoundReceiver::PtrType pObj = std::dynamic_pointer_cast<CSWISoundReceiver>(pObject))
+    {
+      nProperties |= SOUND_RECEIVER;
+      fAngleOfBeam = pObj->getAngleOfBeam();
+      vecSoundDirection = pObj->getDirection();
+      fSoundLevel = pObj->getLevel();
+    }
+  }
+
+
+  void CSWInformationSnapshot::collectEquipment(CSWObject::PtrType pObject)
+  {
+    if (CSWObject::PtrType pSolidParent = pObject->findFirstParent<CSWISolid>())
+      matSolidParentTransform = pSolidParent->getWorldTransform();
+
+    if (CSWEngine::PtrType pEngine = std::dynamic_pointer_cast<CSWEngine>(pObject))
+    {
+      nProperties |= ENGINE;
+      fMaxForce = pEngine->m_fMaxForce;
+      fIntensity = pEngine->m_fIntensity;
+      bAllowDirectionChanges = pEngine->m_bAllowDirectionChanges;
+    }
+    if (CSWActiveSonar::PtrType pActiveSonar = std::dynamic_pointer_cast<CSWActiveSonar>(pObject))
+    {
+      nProperties |= ACTIVE_SONAR;
+      vecScanDirection = pActiveSonar->getDirection();
+      fMaximalDistance = pActiveSonar->getMaximalDistance();
+      boost::circular_buffer<CSWActiveSonar::ScanLine>::const_iterator it = pActiveSonar->m_LastScans.begin();
+      for (; it != pActiveSonar->m_LastScans.end(); ++it)
+        activeSonarScans.push_back(std::make_pair(it->segment.getPoint2(), it->segment.getLength()));
+    }
+    if (CSWPassiveSonar::PtrType pPassiveSonar = std::dynamic_pointer_cast<CSWPassiveSonar>(pObject))
+    {
+      nProperties |= PASSIVE_SONAR;
+      passiveSonarScans.assign(pPassiveSonar->m_LastScanValues.begin(), pPassiveSonar->m_LastScanValues.end());
+    }
+    if (CSWMap::PtrType pMap = std::dynamic_pointer_cast<CSWMap>(pObject))
+    {
+      nProperties |= MAP;
+      CSWMap::MapElementContainer::const_iterator it = pMap->m_Map.begin();
+      for (; it != pMap->m_Map.end(); ++it)
+      {
+        MapEntry entry = {it->second.nID, it->second.vecWorldTPosition, it->second.vecWorldTVelocity, 
+                          it->second.nLevel, it->second.fTime};
+        mapEntries.push_back(entry);
+      }
+    }
+    if (CSWWeaponBattery::PtrType pWeaponBattery = std::dynamic_pointer_cast<CSWWeaponBattery>(pObject))
+    {
+      nProperties |= WEAPON_BATTERY;
+      nMaxNumWeapons = pWeaponBattery->m_nMaxSize;
+      CSWWeaponBattery::WeaponContainer::const_iterator it = pWeaponBattery->m_WeaponContainer.begin();
+      for (; it != pWeaponBattery->m_WeaponContainer.end(); ++it)
+        weaponNames.push_back((*it)->getName());
+    }
+  }
+
+}
\ No newline at end of file
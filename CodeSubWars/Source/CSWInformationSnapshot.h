@@ -0,0 +1,158 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#pragma once
+
+
+namespace CodeSubWars
+{
+
+  class CSWObject;
+
+  /**
+   * Immutable copy of everything the information views display. It is taken by the simulation between two steps
+   * (with the python context of the selected object held there) and published to the gui, so the gui neither needs
+   * the world locks nor the python interpreter to show the current state.
+   */
+  class CSWInformationSnapshot
+  {
+    public:
+      typedef std::shared_ptr<const CSWInformationSnapshot> PtrType;
+
+      enum Properties
+      {
+        COMMANDABLE = 1,
+        DAMAGEABLE = 2,
+        DYNAMIC = 4,
+        EVENTDEALABLE = 8,
+        RESOURCE_PROVIDER = 16,
+        RECHARGEABLE = 32,
+        SOLID = 64,
+        SOUND_RECEIVER = 128,
+        EQUIPMENT = 256,
+        ENGINE = 512,
+        ACTIVE_SONAR = 1024,
+        PASSIVE_SONAR = 2048,
+        MAP = 4096,
+        WEAPON_BATTERY = 8192
+      };
+
+      struct ObjectEntry
+      {
+        std::string strName;
+        int nParent;      //index of the parent entry, -1 for top level objects
+        bool bWeapon;
+        std::weak_ptr<CSWObject> pObject;
+      };
+
+      struct MapEntry
+      {
+        unsigned long nID;
+        Vector3D vecPosition;
+        Vector3D vecVelocity;
+        unsigned long nLevel;
+        double fTime;
+      };
+
+      typedef std::vector<ObjectEntry> ObjectContainer;
+      typedef std::vector<std::pair<long long, std::string> > MessageContainer;   //sequence, message
+
+      /**
+       * Takes a new snapshot.
+       * @param pPrevious The previously published snapshot. Unchanged parts (e.g. the object list) are shared with it.
+       * @param bObjectTreeChanged Must be true if objects have been attached or detached since the previous snapshot.
+       */
+      static PtrType create(std::shared_ptr<CSWObject> pObjectTree, std::shared_ptr<CSWObject> pSelectedObject,
+                            const std::vector<boost::tuples::tuple<std::string, double, double> >& load,
+                            const PtrType& pPrevious, bool bObjectTreeChanged);
+
+      ~CSWInformationSnapshot();
+
+      long long nSequence;
+      double fTime;
+      std::vector<boost::tuples::tuple<std::string, double, double> > load;
+
+      //all objects in preorder (without cameras), shared between snapshots as long as the tree does not change
+      long long nObjectTreeVersion;
+      std::shared_ptr<const ObjectContainer> pObjects;
+
+      //selected object
+      std::weak_ptr<CSWObject> pSelectedObject;
+      int nProperties;
+      std::string strName;
+      Matrix44D matWorldTransform;
+
+      //CSWICommandable
+      int nStackDepth;
+      int nNumExecutedCommands;
+      double fCurrentCommandProgress;
+      std::string strCurrentCommandName;
+      std::string strCurrentCommandDetails;
+      std::vector<std::string> waitingCommandNames;
+
+      //CSWIDamageable
+      double fHealth;
+      std::string strHealthState;
+
+      //CSWIDynamic
+      double fTotalMass;
+      Vector3D vecVelocity;
+      Vector3D vecAcceleration;
+      Vector3D vecAngularVelocity;
+      Vector3D vecAngularAcceleration;
+
+      //CSWIEventDealable (the last messages, each with the sequence of the snapshot that fetched it)
+      std::string strEventInformation;
+      MessageContainer eventMessages;
+
+      //CSWIResourceProvider
+      std::string strResourceInformation;
+
+      //CSWIRechargeable
+      std::string strAcceptedResources;
+      std::string strRechargingResources;
+      double fFillLevel;
+
+      //CSWISolid
+      Size3D size;
+
+      //CSWISoundReceiver
+      double fAngleOfBeam;
+      Vector3D vecSoundDirection;
+      double fSoundLevel;
+
+      //CSWEquipment (the world transform of the solid object that carries it)
+      Matrix44D matSolidParentTransform;
+
+      //CSWEngine
+      double fMaxForce;
+      double fIntensity;
+      bool bAllowDirectionChanges;
+
+      //CSWActiveSonar (the last detected points in world coordinates with their distance)
+      Vector3D vecScanDirection;
+      double fMaximalDistance;
+      std::vector<std::pair<Vector3D, double> > activeSonarScans;
+
+      //CSWPassiveSonar (the last directions in world coordinates with their level)
+      std::vector<std::pair<Vector3D, double> > passiveSonarScans;
+
+      //CSWMap
+      std::vector<MapEntry> mapEntries;
+
+      //CSWWeaponBattery
+      int nMaxNumWeapons;
+      std::vector<std::string> weaponNames;
+
+    protected:
+      CSWInformationSnapshot();
+
+      void collectObjects(std::shared_ptr<CSWObject> pObject, int nParent, ObjectContainer& objects);
+      void collectSelectedObject(std::shared_ptr<CSWObject> pObject, const PtrType& pPrevious);
+      void collectEquipment(std::shared_ptr<CSWObject> pObject);
+
+      static const size_t MAX_NUM_MESSAGES;
+  };
+
+}
\ No newline at end of file
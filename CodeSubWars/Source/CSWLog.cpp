@@ -2,9 +2,10 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWLog.h"
-#include <arstd/misc/Time.h>
+#include "CSWUtilities.h"
+#include <arstd/Misc/Time.h>
 
 
 namespace CodeSubWars
@@ -19,45 +20,264 @@ namespace CodeSubWars
 
   CSWLog::~CSWLog()
   {
-    QString s = QDateTime::currentDateTime().toString(QString("yyyy/MM/dd hh:mm:ss.zzz")) + "   application closed\n"; 
-    m_LogFile << s.toStdString();
+    {
+      std::lock_guard<std::mutex> lck(m_mtxWriter);
+      m_bStop = true;
+    }
+    m_cvLinesQueued.notify_one();
+    m_cvLinesWritten.notify_all();
+    m_Writer.join();
+
+    m_LogFile << format(std::chrono::system_clock::now(), 0, "application closed") << "\n";
+
+    while (m_pFirst)
+    {
+      Line* pLine = m_pFirst;
+      m_pFirst = pLine->pNext.load();
+      delete pLine;
+    }
   }
 
 
-  void CSWLog::setLogOutput(QTextEdit* pTextEdit)
+  void CSWLog::setLogOutput(const OutputFunction& output)
   {
-    m_pTextEdit = pTextEdit;
+    std::lock_guard<std::mutex> lck(m_mtxLog);
+    m_Output = output;
   }
 
 
   void CSWLog::resetLogOutput()
   {
-    m_pTextEdit = NULL;
+    flush();
+    std::lock_guard<std::mutex> lck(m_mtxLog);
+    m_Output = OutputFunction();
   }
 
 
   void CSWLog::log(const std::string& str)
   {
-    QString s = QDateTime::currentDateTime().toString(QString("yyyy/MM/dd hh:mm:ss.zzz")) + QString("   ") + str.c_str(); 
-    if (m_pTextEdit)
-      m_pTextEdit->append(s);
-    else
-      std::cout << s.toStdString() << "\n";
+    enqueue(str);
+  }
+
 
-    m_LogFile << s.toStdString() << "\n";
-    
+  void CSWLog::log(const std::string& strSource, const std::string& str)
+  {
+    unsigned long nDroppedBefore = 0;
+    if (!isAcceptedFrom(strSource, nDroppedBefore))
+      return;
+
+    if (nDroppedBefore)
+    {
+      std::stringstream ss;
+      ss << strSource << ": " << nDroppedBefore << " lines dropped (too many lines)";
+      enqueue(ss.str());
+    }
+    enqueue(str);
+  }
+
+
+  void CSWLog::flush()
+  {
+    unsigned long long nLines = m_nEnqueuedLines.load();
+    std::unique_lock<std::mutex> lck(m_mtxWriter);
+    m_cvLinesQueued.notify_one();
+    m_cvLinesWritten.wait(lck, [&]() { return m_nWrittenLines >= nLines || m_bStop; });
   }
 
 
   CSWLog::CSWLog()
-  : m_pTextEdit(NULL)
+  : m_pLast(new Line()),
+    m_nQueuedBytes(0),
+    m_nDroppedLines(0),
+    m_nEnqueuedLines(0),
+    m_CachedDateTime(-1),
+    m_nWrittenLines(0),
+    m_bStop(false)
   {
-    QDir().mkdir("log");
+    m_pFirst = m_pLast.load();
+    m_pFirst->pNext = NULL;
+
+    for (int n = 0; n < NUMBER_SOURCE_LIMITS; ++n)
+    {
+      m_SourceLimits[n].nSourceHash = 0;
+      m_SourceLimits[n].nNextArrivalTime = 0;
+      m_SourceLimits[n].nDropped = 0;
+    }
+
+    ARSTD::FileSystem::createDirectory("log");
     m_LogFile.open("log/events.log", std::ios::out | std::ios::app);
     assert(m_LogFile.is_open());
   
-    QString s = QDateTime::currentDateTime().toString(QString("yyyy/MM/dd hh:mm:ss.zzz")) + "   application started\n"; 
-    m_LogFile << s.toStdString();
+    m_LogFile << format(std::chrono::system_clock::now(), 0, "application started") << "\n";
+    m_LogFile.flush();
+
+    m_Writer = std::thread(&CSWLog::writeLines, this);
+  }
+
+
+  bool CSWLog::isAcceptedFrom(const std::string& strSource, unsigned long& nDroppedBefore)
+  {
+    size_t nSourceHash = std::hash<std::string>()(strSource);
+    if (!nSourceHash)
+      nSourceHash = 1;
+
+    //find the slot of the source by linear probing, if all slots are taken sources share their limit
+    SourceLimit* pLimit = &m_SourceLimits[nSourceHash % NUMBER_SOURCE_LIMITS];
+    for (int n = 0; n < NUMBER_SOURCE_LIMITS; ++n)
+    {
+      SourceLimit& limit = m_SourceLimits[(nSourceHash + n) % NUMBER_SOURCE_LIMITS];
+      size_t nSlotHash = 0;
+      if (limit.nSourceHash.compare_exchange_strong(nSlotHash, nSourceHash) || nSlotHash == nSourceHash)
+      {
+        pLimit = &limit;
+        break;
+      }
+    }
+
+    //generic cell rate algorithm: a line is accepted if it does not arrive earlier than the burst allows
+    const long long nInterval = 1000000/MAX_LINES_PER_SECOND;
+    const long long nTolerance = nInterval*(MAX_BURST_LINES - 1);
+    long long nNow = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    long long nNextArrivalTime = pLimit->nNextArrivalTime.load();
+    do
+    {
+      if (nNextArrivalTime - nNow > nTolerance)
+      {
+        ++pLimit->nDropped;
+        return false;
+      }
+    }
+    while (!pLimit->nNextArrivalTime.compare_exchange_weak(nNextArrivalTime, std::max(nNextArrivalTime, nNow) + nInterval));
+
+    nDroppedBefore = pLimit->nDropped.exchange(0);
+    return true;
+  }
+
+
+  void CSWLog::enqueue(const std::string& str)
+  {
+    size_t nBytes = sizeof(Line) + str.size();
+    if (m_nQueuedBytes.fetch_add(nBytes) + nBytes > MAX_QUEUED_BYTES)
+    {
+      m_nQueuedBytes -= nBytes;
+      ++m_nDroppedLines;
+      return;
+    }
+
+    Line* pLine = new Line();
+    pLine->pNext.store(NULL, std::memory_order_relaxed);
+    pLine->time = std::chrono::system_clock::now();
+    pLine->fSimulationTime = ARSTD::Time::getTime();
+    pLine->strText = str;
+
+    Line* pPrevious = m_pLast.exchange(pLine, std::memory_order_acq_rel);
+    pPrevious->pNext.store(pLine, std::memory_order_release);
+
+    ++m_nEnqueuedLines;
+    m_cvLinesQueued.notify_one();
+  }
+
+
+  CSWLog::Line* CSWLog::dequeue()
+  {
+    //the first line is already written, its successor becomes the new first line
+    Line* pNext = m_pFirst->pNext.load(std::memory_order_acquire);
+    if (!pNext)
+      return NULL;
+
+    delete m_pFirst;
+    m_pFirst = pNext;
+    return pNext;
+  }
+
+
+  void CSWLog::writeLines()
+  {
+    while (true)
+    {
+      size_t nLines = writeQueuedLines();
+
+      std::unique_lock<std::mutex> lck(m_mtxWriter);
+      m_nWrittenLines += nLines;
+      m_cvLinesWritten.notify_all();
+      if (nLines)
+        continue;
+      if (m_bStop)
+        break;
+      //a line may be queued right before waiting, so the queue is also checked periodically
+      m_cvLinesQueued.wait_for(lck, std::chrono::milliseconds(50));
+    }
+  }
+
+
+  size_t CSWLog::writeQueuedLines()
+  {
+    std::vector<std::string> lines;
+    while (Line* pLine = dequeue())
+    {
+      lines.push_back(format(pLine->time, pLine->fSimulationTime, pLine->strText));
+      m_nQueuedBytes -= sizeof(Line) + pLine->strText.size();
+      std::string().swap(pLine->strText);
+    }
+    size_t nLines = lines.size();
+
+    unsigned long nDropped = m_nDroppedLines.exchange(0);
+    if (nDropped)
+    {
+      std::stringstream ss;
+      ss << nDropped << " lines dropped (log queue is full)";
+      lines.push_back(format(std::chrono::system_clock::now(), ARSTD::Time::getTime(), ss.str()));
+    }
+
+    if (lines.empty())
+      return 0;
+
+    {
+      std::lock_guard<std::mutex> lck(m_mtxLog);
+      std::vector<std::string>::const_iterator it = lines.begin();
+      for (; it != lines.end(); ++it)
+      {
+        if (m_Output)
+          m_Output(*it);
+        else
+          std::cout << *it << "\n";
+      }
+    }
+
+    std::vector<std::string>::const_iterator it = lines.begin();
+    for (; it != lines.end(); ++it)
+      m_LogFile << *it << "\n";
+    m_LogFile.flush();
+
+    return nLines;
+  }
+
+
+  std::string CSWLog::format(const std::chrono::system_clock::time_point& time, double fSimulationTime, const std::string& str)
+  {
+    //the date changes at most once per second, so it is formatted only then
+    std::time_t t = std::chrono::system_clock::to_time_t(time);
+    if (t != m_CachedDateTime)
+    {
+      std::tm localTime;
+#ifdef _WIN32
+      localtime_s(&localTime, &t);
+#else
+      localtime_r(&t, &localTime);
+#endif
+      char pBuffer[64];
+      size_t nLength = strftime(pBuffer, sizeof(pBuffer), "%Y/%m/%d %H:%M:%S", &localTime);
+      m_strCachedDateTime.assign(pBuffer, nLength);
+      m_CachedDateTime = t;
+    }
+
+    int nMilliseconds = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count() % 1000);
+    long long nSimulationTime = static_cast<long long>(fSimulationTime*100);
+    char pBuffer[64];
+    snprintf(pBuffer, sizeof(pBuffer), ".%03d   %d:%02d:%02d.%02d   ", nMilliseconds,
+             static_cast<int>(nSimulationTime/360000), static_cast<int>(nSimulationTime/6000 % 60),
+             static_cast<int>(nSimulationTime/100 % 60), static_cast<int>(nSimulationTime % 100));
+    return m_strCachedDateTime + pBuffer + str;
   }
 
 }
\ No newline at end of file
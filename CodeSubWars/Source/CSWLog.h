@@ -8,24 +8,106 @@
 namespace CodeSubWars
 {
 
+  /**
+   * Application log. All methods may be called from different threads.
+   * Lines are only queued by the logging threads and formatted and written by a background thread, so logging never
+   * waits for the disk or the gui. Each line is stamped with the wall clock time and the simulation time at the moment
+   * it was logged. Lines of a source that logs too often and lines exceeding the memory budget of the queue are
+   * dropped. The number of dropped lines is logged instead.
+   */
   class CSWLog
   {
     public:
       typedef std::shared_ptr<CSWLog> PtrType;
+      typedef std::function<void(const std::string&)> OutputFunction;
     
       static PtrType getInstance();
 
       virtual ~CSWLog();
 
-      void setLogOutput(QTextEdit* pTextEdit);
+      /**
+       * Sets a function that receives every formatted log line additionally to the log file. If no output
+       * is set the lines are written to the console. The function is called by the writer thread.
+       */
+      void setLogOutput(const OutputFunction& output);
+
+      /**
+       * Writes all pending lines to the current output before it is removed.
+       */
       void resetLogOutput();
+
+      /**
+       * Logs a line of the application. These lines are never rate limited.
+       */
       void log(const std::string& str);
+
+      /**
+       * Logs a line of the given source (e.g. the name of a submarine). Each source may log MAX_LINES_PER_SECOND 
+       * lines per second on average and MAX_BURST_LINES lines at once, further lines are dropped.
+       */
+      void log(const std::string& strSource, const std::string& str);
+
+      /**
+       * Blocks until all lines logged before are written.
+       */
+      void flush();
+
+      static const int MAX_LINES_PER_SECOND = 20;
+      static const int MAX_BURST_LINES = 100;
+      static const size_t MAX_QUEUED_BYTES = 4*1024*1024;
     
     protected:
+      struct Line
+      {
+        std::atomic<Line*> pNext;
+        std::chrono::system_clock::time_point time;
+        double fSimulationTime;
+        std::string strText;
+      };
+
+      struct SourceLimit
+      {
+        std::atomic<size_t> nSourceHash;          //0 if the slot is unused
+        std::atomic<long long> nNextArrivalTime;  //theoretical arrival time of the next line in microseconds
+        std::atomic<unsigned long> nDropped;
+      };
+
+      static const int NUMBER_SOURCE_LIMITS = 64;
+
       CSWLog();
 
-      QTextEdit* m_pTextEdit;
+      bool isAcceptedFrom(const std::string& strSource, unsigned long& nDroppedBefore);
+      void enqueue(const std::string& str);
+      Line* dequeue();
+
+      void writeLines();
+      size_t writeQueuedLines();
+      std::string format(const std::chrono::system_clock::time_point& time, double fSimulationTime, const std::string& str);
+
+      //multiple producer single consumer queue (d. vyukov), m_pFirst is only accessed by the writer thread
+      std::atomic<Line*> m_pLast;
+      Line* m_pFirst;
+      std::atomic<size_t> m_nQueuedBytes;
+      std::atomic<unsigned long> m_nDroppedLines;
+      std::atomic<unsigned long long> m_nEnqueuedLines;
+
+      SourceLimit m_SourceLimits[NUMBER_SOURCE_LIMITS];
+
+      //used by the writer thread only
+      std::time_t m_CachedDateTime;
+      std::string m_strCachedDateTime;
       std::fstream m_LogFile;
+
+      std::mutex m_mtxWriter;
+      unsigned long long m_nWrittenLines;
+      std::condition_variable m_cvLinesQueued;
+      std::condition_variable m_cvLinesWritten;
+      std::atomic<bool> m_bStop;
+      std::thread m_Writer;
+
+      //the output is set by the gui while the writer thread uses it
+      std::mutex m_mtxLog;
+      OutputFunction m_Output;
   };
 
 }
\ No newline at end of file
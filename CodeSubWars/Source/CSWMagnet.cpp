@@ -2,8 +2,9 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWMagnet.h"
+#include "CSWShapeCache.h"
 #include "CSWEvent.h"
 #include "CSWCollisionDetectedMessage.h"
 
@@ -37,7 +38,7 @@ namespace CodeSubWars
     double fDist;  
     Vector3D vecWorldTMassPoint;
     CSWIDynamic::MassPointContainerRange range = getMassPointRange();
-    CSWIDynamic::MassPointContainer::iterator itMassPoint = range.first;
+    CSWIDynamic::MassPointContainer::const_iterator itMassPoint = range.first;
     for (; itMassPoint != range.second; ++itMassPoint)
     {
       vecWorldTMassPoint = getWorldTransform()*itMassPoint->first;
@@ -57,10 +58,10 @@ namespace CodeSubWars
 
   CSWMagnet::CSWMagnet(const std::string& strName, const Matrix44D& matBaseTObject, const Size3D& size)
   : CSWDamDynSolCol(strName, matBaseTObject, 
-                    Mesh::createBox(Matrix44D(Vector3D(-size.getWidth()/2.0, 
-                                                       -size.getHeight()/2.0, 
-                                                       -size.getDepth()/2.0)),
-                                    size),
+                    CSWShapeCache::getInstance()->getBoxMesh(Vector3D(-size.getWidth()/2.0, 
+                                                                      -size.getHeight()/2.0, 
+                                                                      -size.getDepth()/2.0),
+                                                             size),
                     true),
     m_fPower(size.getVolume())
   {
@@ -2,9 +2,9 @@
 // Released under the MIT license. (see license.txt)
 
   
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWMap.h"
-#include "CSWMapVisualizer.h"
+#include "CSWObjectPool.h"
 
 
 namespace CodeSubWars
@@ -25,7 +25,7 @@ namespace CodeSubWars
 
   CSWMap::PtrType CSWMap::create(const std::string& strName)
   {
-    return PtrType(new CSWMap(strName));
+    return CSWObjectPool::create<CSWMap>([&](void* pBlock) { return new (pBlock) CSWMap(strName); });
   }
 
 
@@ -34,14 +34,6 @@ namespace CodeSubWars
   }
 
 
-  QWidget* CSWMap::getInformationWidget(QWidget* pParent)
-  {
-    if (!m_pVisualizer)
-      m_pVisualizer = new CSWMapVisualizer(pParent, std::dynamic_pointer_cast<CSWMap>(getSharedThis()));
-    return m_pVisualizer;
-  }
-
-
   void CSWMap::update()
   {
     CSWEquipment::update();
@@ -242,8 +234,7 @@ namespace CodeSubWars
 
 
   CSWMap::CSWMap(const std::string& strName)
-  : CSWEquipment(strName, Matrix44D(), 0, 0),
-    m_pVisualizer(NULL)
+  : CSWEquipment(strName, Matrix44D(), 0, 0)
   {
   }
 
@@ -9,8 +9,7 @@
 namespace CodeSubWars
 {
 
-  class CSWMapVisualizer;
-  class CSWMap3DView;
+  class CSWInformationSnapshot;
   class CSWMapElement;
 
   /**
@@ -40,9 +39,6 @@ namespace CodeSubWars
 
       virtual ~CSWMap();
 
-      //defined methods from CSWEquipment
-      virtual QWidget* getInformationWidget(QWidget* pParent);
-
       //defined methods from IUpdateable
       virtual void update();
 
@@ -126,7 +122,7 @@ namespace CodeSubWars
       int removeElements(const Vector3D& vecPosition, double fRadius, unsigned long nLevel, unsigned long nNotLevel = 0);
 
      
-      friend CSWMap3DView; 
+      friend CSWInformationSnapshot; 
     protected:  
       typedef std::pair<double, CSWMapElement> ElementHelper;
       typedef std::list<ElementHelper> MapElementContainer;
@@ -144,7 +140,6 @@ namespace CodeSubWars
       static const double EQUAL_POSITION_DISTANCE;
     
       MapElementContainer m_Map;
-      CSWMapVisualizer* m_pVisualizer;
   };
 
   bool isElementNotValid(const CSWMap::ElementHelper& el);
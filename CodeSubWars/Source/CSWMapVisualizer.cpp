@@ -12,10 +12,9 @@
 namespace CodeSubWars
 {
 
-  CSWMap3DView::CSWMap3DView(QWidget* pParent, CSWMap::PtrType pMap)
+  CSWMap3DView::CSWMap3DView(QWidget* pParent)
   : OpenGLView(pParent),
     m_pMainCamera(CSWCamera::create("Map", Matrix44D())),
-    m_pMap(pMap),
     m_matMapTCamera(Vector3D(1, 0, 0),
                     Vector3D(0, 0, 1),
                     Vector3D(0, -1, 0),
@@ -25,14 +24,20 @@ namespace CodeSubWars
   }
 
 
+  void CSWMap3DView::setInformation(const CSWInformationSnapshot::PtrType& pInformation)
+  {
+    m_pInformation = pInformation;
+  }
+
+
   void CSWMap3DView::draw()
   {
-    CSWMap::PtrType pMap = m_pMap.lock();
     CSWCamera::PtrType pCam = m_pCamera.lock();
-    if (!pMap || !pCam)
+    if (!m_pInformation || !(m_pInformation->nProperties & CSWInformationSnapshot::MAP) || !pCam)
       return;
+    const CSWInformationSnapshot& info = *m_pInformation;
   
-    pCam->setTransform(pMap->getWorldTransform()*m_matMapTCamera);
+    pCam->setTransform(info.matWorldTransform*m_matMapTCamera);
     pCam->calcWorldTransforms();
 
     glPushAttrib(GL_ALL_ATTRIB_BITS);
@@ -44,7 +49,7 @@ namespace CodeSubWars
       //draw scan area
       glPushMatrix();
         Matrix44D mat2(pCam->getWorldTransform());
-        mat2.getTranslation() = pMap->getWorldTransform().getTranslation();
+        mat2.getTranslation() = info.matWorldTransform.getTranslation();
         glLoadMatrixd(mat2.pData);
       
         glDisable(GL_BLEND);
@@ -72,54 +77,54 @@ namespace CodeSubWars
 
       //draw detected points with velocities
       glEnable(GL_BLEND);
-      CSWMap::MapElementContainer::const_iterator it = pMap->m_Map.begin();
-      for (; it != pMap->m_Map.end(); ++it)
+      std::vector<CSWInformationSnapshot::MapEntry>::const_iterator it = info.mapEntries.begin();
+      for (; it != info.mapEntries.end(); ++it)
       {
         //velocity
         glColor3d(0, 0.7, 0.6);
         glLineWidth(2);
         glBegin(GL_LINES);
-          glVertex3dv(it->second.vecWorldTPosition.pData);
-          glVertex3dv((it->second.vecWorldTPosition + it->second.vecWorldTVelocity).pData);
+          glVertex3dv(it->vecPosition.pData);
+          glVertex3dv((it->vecPosition + it->vecVelocity).pData);
         glEnd();
 
         //position
-        std::pair<Vector3D, Vector3D> colors = determineColor(it->second.nLevel);
+        std::pair<Vector3D, Vector3D> colors = determineColor(it->nLevel);
         glColor3dv(colors.second.pData);      
         glPointSize(14);
         glBegin(GL_POINTS);
-          glVertex3dv(it->second.vecWorldTPosition.pData);
+          glVertex3dv(it->vecPosition.pData);
         glEnd();
 
         glColor3d(0, 0, 0);      
         glPointSize(8);
         glBegin(GL_POINTS);
-          glVertex3dv(it->second.vecWorldTPosition.pData);
+          glVertex3dv(it->vecPosition.pData);
         glEnd();
 
         glColor3dv(colors.first.pData);      
         glPointSize(6);
         glBegin(GL_POINTS);
-          glVertex3dv(it->second.vecWorldTPosition.pData);
+          glVertex3dv(it->vecPosition.pData);
         glEnd();
       }
 
       glColor3f(1.0, 1.0, 1.0); 
       glListBase(1000);
-      it = pMap->m_Map.begin();
-      for (; it != pMap->m_Map.end(); ++it)
+      it = info.mapEntries.begin();
+      for (; it != info.mapEntries.end(); ++it)
       {
         std::stringstream ss;
         ss.precision(1);
         ss.setf(std::ios::fixed);
         ss << "  " 
-           << it->second.nID << "/"
-           << (ARSTD::Time::getTime() - it->second.fTime);
-        glRasterPos3dv(it->second.vecWorldTPosition.pData);
+           << it->nID << "/"
+           << (info.fTime - it->fTime);
+        glRasterPos3dv(it->vecPosition.pData);
         glCallLists(static_cast<GLsizei>(ss.str().size()), GL_UNSIGNED_BYTE, ss.str().c_str()); 
       }
     
-      ARSTD::OpenGLTools::paintTripod(pMap->getWorldTransform(), 100);
+      ARSTD::OpenGLTools::paintTripod(info.matWorldTransform, 100);
   
       //draw world coord tripod in lower left corner
       drawWorldTripod();
@@ -192,18 +197,19 @@ namespace CodeSubWars
 
 
 
-  CSWMapVisualizer::CSWMapVisualizer(QWidget* pParent, CSWMap::PtrType pMap)
+  CSWMapVisualizer::CSWMapVisualizer(QWidget* pParent)
   : QWidget(pParent, NULL)
   {
     QHBoxLayout* pLayout = new QHBoxLayout(this); 
     pLayout->setMargin(1);
-    m_pView = new CSWMap3DView(this, pMap);
+    m_pView = new CSWMap3DView(this);
     pLayout->addWidget(m_pView);
   }
 
 
-  void CSWMapVisualizer::updateContent()
+  void CSWMapVisualizer::updateContent(const CSWInformationSnapshot::PtrType& pInformation)
   {
+    m_pView->setInformation(pInformation);
     update();
   }
 
@@ -10,14 +10,15 @@
 namespace CodeSubWars
 {
 
-  class CSWMap;
   class CSWCamera;
 
   class CSWMap3DView : public OpenGLView
   {
     public:
-      CSWMap3DView(QWidget* pParent, std::shared_ptr<CSWMap> pMap);
+      CSWMap3DView(QWidget* pParent);
     
+      void setInformation(const CSWInformationSnapshot::PtrType& pInformation);
+
       virtual void draw();
     
     protected:
@@ -30,7 +31,7 @@ namespace CodeSubWars
       static std::pair<Vector3D, Vector3D> determineColor(unsigned int nValue);
   
       std::shared_ptr<CSWCamera> m_pMainCamera;
-      std::weak_ptr<CSWMap> m_pMap;
+      CSWInformationSnapshot::PtrType m_pInformation;
       Matrix44D m_matMapTCamera;
   };
 
@@ -40,9 +41,9 @@ namespace CodeSubWars
                            public CSWIEquipmentVisualizer
   {
     public:
-      CSWMapVisualizer(QWidget* pParent, std::shared_ptr<CSWMap> pMap);
+      CSWMapVisualizer(QWidget* pParent);
     
-      virtual void updateContent();
+      virtual void updateContent(const CSWInformationSnapshot::PtrType& pInformation);
     
     protected:
       virtual void paintEvent(QPaintEvent* pEvent);
@@ -2,7 +2,7 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWMessageCollisionObjects.h"
 
 #include "CSWICollideable.h"
@@ -11,6 +11,7 @@
 #include "CSWSettings.h"
 #include "CSWBattleStatistics.h"
 #include "CSWTrigger.h"
+#include "CSWCollisionFilter.h"
 
 /*
   @todo extract handling of collision in seperate class CollisionHandler with default collision method collide(CSWObject*, CSWObject*). 
@@ -31,8 +32,7 @@ namespace CodeSubWars
 
   CSWMessageDeleteCollisionObjects::CSWMessageDeleteCollisionObjects()
   {
-    DT_RemoveDefaultResponse(CSWWorld::getInstance()->getResponseTable(), 
-                             &(CSWMessageInitializeCollisionObjects::collide));
+    CSWWorld::getInstance()->getCollisionFilter()->clear();
   }
 
 
@@ -80,9 +80,7 @@ namespace CodeSubWars
   {
   //  dtEnableCaching();
 
-    DT_AddDefaultResponse(CSWWorld::getInstance()->getResponseTable(), 
-                          &(CSWMessageInitializeCollisionObjects::collide),
-                          DT_DEPTH_RESPONSE, NULL);
+    CSWWorld::getInstance()->getCollisionFilter()->update(CSWWorld::getInstance()->getSettings()->getCollidableProperties());
   }
 
 
@@ -151,6 +149,7 @@ namespace CodeSubWars
     if (!pCollideableObjA || !pCollideableObjB)
       throw std::runtime_error("tried to solve collision for non collidable objects");
 
+    //trigger/trigger pairs are only tested by a simple response (see CSWCollisionFilter) if they are displayed
     if (std::dynamic_pointer_cast<CSWTrigger>(pObjectA) && 
         std::dynamic_pointer_cast<CSWTrigger>(pObjectB))
     {
@@ -161,7 +160,9 @@ namespace CodeSubWars
       }
       return DT_CONTINUE;  
     }
-  
+
+    if (!coll_data)
+      return DT_CONTINUE;
 
     Vector3D vecWorldTP1(coll_data->point1[0], coll_data->point1[1], coll_data->point1[2]);
     Vector3D vecWorldTP2(coll_data->point2[0], coll_data->point2[1], coll_data->point2[2]);
@@ -169,16 +170,7 @@ namespace CodeSubWars
     Vector3D vecObjectATP1 = pObjectA->getInvertWorldTransform()*vecWorldTP1;
     Vector3D vecObjectBTP2 = pObjectB->getInvertWorldTransform()*vecWorldTP2;
 
-    //given normal is directed away from ObjectB
-    Vector3D vecWorldTP2ToP1(coll_data->normal[0], coll_data->normal[1], coll_data->normal[2]);
-    vecWorldTP2ToP1 = -vecWorldTP2ToP1;
-    double fPenetrationDepth = vecWorldTP2ToP1.getLength();
-    vecWorldTP2ToP1 /= fPenetrationDepth;
-
-    if (fPenetrationDepth < EPSILON)
-      return DT_CONTINUE;
-
-
+    //collisions with triggers are witnessed responses, they only deliver a common point and no normal
     if (CSWTrigger::PtrType pTrigger = std::dynamic_pointer_cast<CSWTrigger>(pObjectA))
     {
       if (CSWWorld::getInstance()->getSettings()->getCollidableProperties() & CSWSettings::DISPLAY_OBJECT_TRIGGER_COLLISION)
@@ -201,6 +193,16 @@ namespace CodeSubWars
     }
 
 
+    //given normal is directed away from ObjectB
+    Vector3D vecWorldTP2ToP1(coll_data->normal[0], coll_data->normal[1], coll_data->normal[2]);
+    vecWorldTP2ToP1 = -vecWorldTP2ToP1;
+    double fPenetrationDepth = vecWorldTP2ToP1.getLength();
+    vecWorldTP2ToP1 /= fPenetrationDepth;
+
+    if (fPenetrationDepth < EPSILON)
+      return DT_CONTINUE;
+
+
     if (CSWWorld::getInstance()->getSettings()->getCollidableProperties() & CSWSettings::DISPLAY_OBJECT_OBJECT_COLLISION)
     {
       pCollideableObjA->setHit(true);
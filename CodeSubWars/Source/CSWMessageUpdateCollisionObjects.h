@@ -7,6 +7,8 @@
 
 #include "CSWICollideable.h"
 #include "CSWObject.h"
+#include "CSWSettings.h"
+#include "CSWCollisionFilter.h"
 
 
 namespace CodeSubWars
@@ -38,6 +40,12 @@ namespace CodeSubWars
   template<typename ObjectType>
   CSWMessageUpdateCollisionObjects<ObjectType>::~CSWMessageUpdateCollisionObjects()
   {
+    //the displayed collisions may have been changed in the preferences
+    CSWWorld::getInstance()->getCollisionFilter()->update(CSWWorld::getInstance()->getSettings()->getCollidableProperties());
+    //only moving objects need their new transform, static and sleeping ones keep the uploaded one
+    CSWWorld::getInstance()->getCollisionFilter()->setupTransforms();
+    //now all objects are at their new positions, fast objects can check what they passed on their way
+    CSWWorld::getInstance()->getCollisionFilter()->sweepContinuousObjects();
     DT_Test(CSWWorld::getInstance()->getScene(), CSWWorld::getInstance()->getResponseTable());
   }
 
@@ -50,7 +58,6 @@ namespace CodeSubWars
       return;
 
     pCollideableObject->prepare();
-    pCollideableObject->setupTransform();
   }
 
 }
\ No newline at end of file
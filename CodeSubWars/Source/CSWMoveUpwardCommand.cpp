@@ -2,7 +2,7 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWMoveUpwardCommand.h"
 #include "CSWControlCenter.h"
 #include "CSWEngine.h"
@@ -14,8 +14,8 @@
 namespace CodeSubWars
 {
 
-  CSWMoveUpwardCommand::PtrType CSWMoveUpwardCommand::create(CSWControlCenter::PtrType& pControlCenter,
-                                                             CSWEngine::PtrType& pEngine, 
+  CSWMoveUpwardCommand::PtrType CSWMoveUpwardCommand::create(const CSWControlCenter::PtrType& pControlCenter,
+                                                             const CSWEngine::PtrType& pEngine, 
                                                              double fSetRelativePosition, double fPositionTolerance,
                                                              double fEndVelocity, double fVelocityTolerance, 
                                                              int nProperty, double fMaxIntensity)
@@ -27,8 +27,8 @@ namespace CodeSubWars
   }
 
 
-  CSWMoveUpwardCommand::PtrType CSWMoveUpwardCommand::create(CSWControlCenter::PtrType& pControlCenter,
-                                                             CSWEngine::PtrType& pEngine, 
+  CSWMoveUpwardCommand::PtrType CSWMoveUpwardCommand::create(const CSWControlCenter::PtrType& pControlCenter,
+                                                             const CSWEngine::PtrType& pEngine, 
                                                              const Vector3D& vecPos, double fPositionTolerance,
                                                              double fEndVelocity, double fVelocityTolerance, 
                                                              int nProperty, double fMaxIntensity)
@@ -29,15 +29,15 @@ namespace CodeSubWars
 
       //position stuff is in m; positiv means forward
       //velocity stuff is in m/s; positiv means forward
-      static PtrType create(std::shared_ptr<CSWControlCenter>& pControlCenter,
-                            std::shared_ptr<CSWEngine>& pEngine, 
+      static PtrType create(const std::shared_ptr<CSWControlCenter>& pControlCenter,
+                            const std::shared_ptr<CSWEngine>& pEngine, 
                             double fSetRelativePosition, double fPositionTolerance,
                             double fEndVelocity, double fVelocityTolerance, 
                             int nProperty = POSITION | VELOCITY,
                             double fMaxIntensity = 1.0);
 
-      static PtrType create(std::shared_ptr<CSWControlCenter>& pControlCenter,
-                            std::shared_ptr<CSWEngine>& pEngine, 
+      static PtrType create(const std::shared_ptr<CSWControlCenter>& pControlCenter,
+                            const std::shared_ptr<CSWEngine>& pEngine, 
                             const Vector3D& vecPos, double fPositionTolerance,
                             double fEndVelocity, double fVelocityTolerance, 
                             int nProperty = POSITION | VELOCITY,
@@ -2,8 +2,9 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWMovingPropertiesSensor.h"
+#include "CSWObjectPool.h"
 #include "CSWSubmarine.h"
 #include "CSWEvent.h"
 #include "CSWEventManager.h"
@@ -13,7 +14,7 @@ namespace CodeSubWars
 
   CSWMovingPropertiesSensor::PtrType CSWMovingPropertiesSensor::create(const std::string& strName, CSWEvent::PtrType pEvent)
   {
-    return PtrType(new CSWMovingPropertiesSensor(strName, pEvent));
+    return CSWObjectPool::create<CSWMovingPropertiesSensor>([&](void* pBlock) { return new (pBlock) CSWMovingPropertiesSensor(strName, pEvent); });
   }
 
 
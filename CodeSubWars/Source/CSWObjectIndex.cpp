@@ -0,0 +1,250 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#include "CorePrecompiledHeader.h"
+#include "CSWObjectIndex.h"
+#include "CSWObject.h"
+#include "CSWISolid.h"
+
+
+namespace CodeSubWars
+{
+
+  CSWObjectIndex::PtrType CSWObjectIndex::create(double fCellSize)
+  {
+    return PtrType(new CSWObjectIndex(fCellSize));
+  }
+
+
+  CSWObjectIndex::~CSWObjectIndex()
+  {
+  }
+
+
+  void CSWObjectIndex::reset(CSWObject::PtrType pObjectTree)
+  {
+    clear();
+    if (!pObjectTree)
+      return;
+
+    m_Names.insert(std::make_pair(pObjectTree->getName(), pObjectTree));
+    ARSTD::Node::ChildConstRange range = pObjectTree->getChildRange();
+    for (ARSTD::Node::ChildConstIterator it = range.first; it != range.second; ++it)
+    {
+      CSWObject::PtrType pObject = std::dynamic_pointer_cast<CSWObject>(*it);
+      if (pObject)
+        insert(pObject);
+    }
+  }
+
+
+  void CSWObjectIndex::clear()
+  {
+    m_Names.clear();
+    m_Solids.clear();
+    m_Cells.clear();
+    m_bPositionsValid = true;
+  }
+
+
+  void CSWObjectIndex::insert(CSWObject::PtrType pObject)
+  {
+    insertNames(pObject);
+
+    if (!std::dynamic_pointer_cast<CSWISolid>(pObject))
+      return;
+
+    CellKey key = calcCellKey(pObject->getTransform().getTranslation());
+    if (!m_Solids.insert(std::make_pair(pObject, key)).second)
+      return;
+    //stale cells are rebuilt with the next query anyway
+    if (m_bPositionsValid)
+      insertIntoCell(pObject, key);
+  }
+
+
+  void CSWObjectIndex::remove(CSWObject::PtrType pObject)
+  {
+    removeNames(pObject);
+
+    SolidContainer::iterator itFound = m_Solids.find(pObject);
+    if (itFound == m_Solids.end())
+      return;
+    if (m_bPositionsValid)
+      removeFromCell(pObject, itFound->second);
+    m_Solids.erase(itFound);
+  }
+
+
+  CSWObject::PtrType CSWObjectIndex::findObject(const std::string& strName) const
+  {
+    std::unordered_multimap<std::string, CSWObject::PtrType>::const_iterator itFound = m_Names.find(strName);
+    if (itFound == m_Names.end())
+      return CSWObject::PtrType();
+    return itFound->second;
+  }
+
+
+  CSWObject::PtrType CSWObjectIndex::findSolid(const Vector3D& vecWorldTPosition, double fDistance)
+  {
+    if (!m_bPositionsValid)
+      rebuildCells();
+
+    int nMinX = calcCellCoord(vecWorldTPosition.x - fDistance);
+    int nMinY = calcCellCoord(vecWorldTPosition.y - fDistance);
+    int nMinZ = calcCellCoord(vecWorldTPosition.z - fDistance);
+    int nMaxX = calcCellCoord(vecWorldTPosition.x + fDistance);
+    int nMaxY = calcCellCoord(vecWorldTPosition.y + fDistance);
+    int nMaxZ = calcCellCoord(vecWorldTPosition.z + fDistance);
+
+    //for large distances testing all solids is cheaper than visiting the cells
+    double fNumCells = static_cast<double>(nMaxX - nMinX + 1)*(nMaxY - nMinY + 1)*(nMaxZ - nMinZ + 1);
+    if (fNumCells > static_cast<double>(m_Solids.size()))
+    {
+      SolidContainer::const_iterator it = m_Solids.begin();
+      for (; it != m_Solids.end(); ++it)
+      {
+        if ((it->first->getTransform().getTranslation() - vecWorldTPosition).getLength() < fDistance)
+          return it->first;
+      }
+      return CSWObject::PtrType();
+    }
+
+    for (int nX = nMinX; nX <= nMaxX; ++nX)
+    {
+      for (int nY = nMinY; nY <= nMaxY; ++nY)
+      {
+        for (int nZ = nMinZ; nZ <= nMaxZ; ++nZ)
+        {
+          CellContainer::const_iterator itCell = m_Cells.find(calcCellKey(nX, nY, nZ));
+          if (itCell == m_Cells.end())
+            continue;
+
+          std::vector<CSWObject::PtrType>::const_iterator it = itCell->second.begin();
+          for (; it != itCell->second.end(); ++it)
+          {
+            if (((*it)->getTransform().getTranslation() - vecWorldTPosition).getLength() < fDistance)
+              return *it;
+          }
+        }
+      }
+    }
+    return CSWObject::PtrType();
+  }
+
+
+  void CSWObjectIndex::invalidatePositions()
+  {
+    m_bPositionsValid = false;
+  }
+
+
+  CSWObjectIndex::CSWObjectIndex(double fCellSize)
+  : m_fCellSize(fCellSize),
+    m_bPositionsValid(true)
+  {
+    assert(m_fCellSize > 0);
+  }
+
+
+  void CSWObjectIndex::insertNames(CSWObject::PtrType pObject)
+  {
+    m_Names.insert(std::make_pair(pObject->getName(), pObject));
+
+    ARSTD::Node::ChildConstRange range = pObject->getChildRange();
+    for (ARSTD::Node::ChildConstIterator it = range.first; it != range.second; ++it)
+    {
+      CSWObject::PtrType pChild = std::dynamic_pointer_cast<CSWObject>(*it);
+      if (pChild)
+        insertNames(pChild);
+    }
+  }
+
+
+  void CSWObjectIndex::removeNames(CSWObject::PtrType pObject)
+  {
+    typedef std::unordered_multimap<std::string, CSWObject::PtrType>::iterator NameIterator;
+    std::pair<NameIterator, NameIterator> range = m_Names.equal_range(pObject->getName());
+    for (NameIterator it = range.first; it != range.second; ++it)
+    {
+      if (it->second == pObject)
+      {
+        m_Names.erase(it);
+        break;
+      }
+    }
+
+    ARSTD::Node::ChildConstRange childRange = pObject->getChildRange();
+    for (ARSTD::Node::ChildConstIterator it = childRange.first; it != childRange.second; ++it)
+    {
+      CSWObject::PtrType pChild = std::dynamic_pointer_cast<CSWObject>(*it);
+      if (pChild)
+        removeNames(pChild);
+    }
+  }
+
+
+  void CSWObjectIndex::insertIntoCell(const CSWObject::PtrType& pSolid, CellKey key)
+  {
+    m_Cells[key].push_back(pSolid);
+  }
+
+
+  void CSWObjectIndex::removeFromCell(const CSWObject::PtrType& pSolid, CellKey key)
+  {
+    CellContainer::iterator itCell = m_Cells.find(key);
+    if (itCell == m_Cells.end())
+      return;
+
+    std::vector<CSWObject::PtrType>& solids = itCell->second;
+    std::vector<CSWObject::PtrType>::iterator itFound = std::find(solids.begin(), solids.end(), pSolid);
+    if (itFound != solids.end())
+    {
+      *itFound = solids.back();
+      solids.pop_back();
+    }
+    if (solids.empty())
+      m_Cells.erase(itCell);
+  }
+
+
+  void CSWObjectIndex::rebuildCells()
+  {
+    //the cell vectors keep their capacity since most solids stay in their cell
+    CellContainer::iterator itCell = m_Cells.begin();
+    for (; itCell != m_Cells.end(); ++itCell)
+      itCell->second.clear();
+
+    SolidContainer::iterator it = m_Solids.begin();
+    for (; it != m_Solids.end(); ++it)
+    {
+      it->second = calcCellKey(it->first->getTransform().getTranslation());
+      insertIntoCell(it->first, it->second);
+    }
+    m_bPositionsValid = true;
+  }
+
+
+  int CSWObjectIndex::calcCellCoord(double fValue) const
+  {
+    return static_cast<int>(floor(fValue/m_fCellSize));
+  }
+
+
+  CSWObjectIndex::CellKey CSWObjectIndex::calcCellKey(int nX, int nY, int nZ) const
+  {
+    //21 bits per axis are far more than the world needs
+    const CellKey MASK = (1ull << 21) - 1;
+    return ((static_cast<CellKey>(nX) & MASK) << 42) | 
+           ((static_cast<CellKey>(nY) & MASK) << 21) | 
+           (static_cast<CellKey>(nZ) & MASK);
+  }
+
+
+  CSWObjectIndex::CellKey CSWObjectIndex::calcCellKey(const Vector3D& vecPosition) const
+  {
+    return calcCellKey(calcCellCoord(vecPosition.x), calcCellCoord(vecPosition.y), calcCellCoord(vecPosition.z));
+  }
+
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#pragma once
+
+
+namespace CodeSubWars
+{
+
+  class CSWObject;
+
+  /**
+   * Finds objects of the object tree by name and solid objects by position without walking the tree. The names of 
+   * all objects below an attached object are indexed, the solids only on the first level of the tree. CSWWorld keeps
+   * it in sync by attaching and detaching objects only through attachToObjectTree() and detachFromObjectTree(), the 
+   * objects are renamed before they are attached.
+   * The positions of the solids are taken when they are inserted and when the index is used the first time after 
+   * invalidatePositions(), which the world calls whenever the transforms of the objects have been updated.
+   */
+  class CSWObjectIndex
+  {
+    public:
+      typedef std::shared_ptr<CSWObjectIndex> PtrType;
+
+      static PtrType create(double fCellSize = 100);
+
+      ~CSWObjectIndex();
+
+      /**
+       * Replaces the content with all objects of the given tree.
+       */
+      void reset(std::shared_ptr<CSWObject> pObjectTree);
+      void clear();
+
+      /**
+       * Adds the object and all objects below it. Must be called after the object has been attached to the root.
+       */
+      void insert(std::shared_ptr<CSWObject> pObject);
+      void remove(std::shared_ptr<CSWObject> pObject);
+
+      /**
+       * @return One of the objects with the given name or null if none exists.
+       */
+      std::shared_ptr<CSWObject> findObject(const std::string& strName) const;
+
+      /**
+       * @return One of the solid objects which position is closer than the given distance or null if none exists.
+       */
+      std::shared_ptr<CSWObject> findSolid(const Vector3D& vecWorldTPosition, double fDistance);
+
+      void invalidatePositions();
+
+    protected:
+      typedef unsigned long long CellKey;
+      typedef std::unordered_map<CellKey, std::vector<std::shared_ptr<CSWObject> > > CellContainer;
+      typedef std::unordered_map<std::shared_ptr<CSWObject>, CellKey> SolidContainer;
+
+      CSWObjectIndex(double fCellSize);
+
+      void insertNames(std::shared_ptr<CSWObject> pObject);
+      void removeNames(std::shared_ptr<CSWObject> pObject);
+
+      void insertIntoCell(const std::shared_ptr<CSWObject>& pSolid, CellKey key);
+      void removeFromCell(const std::shared_ptr<CSWObject>& pSolid, CellKey key);
+      void rebuildCells();
+
+      int calcCellCoord(double fValue) const;
+      CellKey calcCellKey(int nX, int nY, int nZ) const;
+      CellKey calcCellKey(const Vector3D& vecPosition) const;
+
+      double m_fCellSize;
+      std::unordered_multimap<std::string, std::shared_ptr<CSWObject> > m_Names;
+      //each solid with the cell it is currently sorted into
+      SolidContainer m_Solids;
+      CellContainer m_Cells;
+      bool m_bPositionsValid;
+  };
+
+}
\ No newline at end of file
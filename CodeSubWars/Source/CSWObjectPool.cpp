@@ -0,0 +1,212 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#include "CorePrecompiledHeader.h"
+#include "CSWObjectPool.h"
+
+
+namespace CodeSubWars
+{
+
+  const std::size_t CSWObjectPool::ALIGNMENT = alignof(std::max_align_t);
+  const std::size_t CSWObjectPool::CHUNK_SIZE = 64*1024;
+  const std::size_t CSWObjectPool::MIN_BLOCKS_PER_CHUNK = 8;
+
+
+  CSWObjectPool::PtrType CSWObjectPool::getInstance()
+  {
+    static PtrType pInstance = PtrType(new CSWObjectPool());
+    return pInstance;
+  }
+
+
+  CSWObjectPool::~CSWObjectPool()
+  {
+  }
+
+
+  void* CSWObjectPool::allocate(std::size_t nSize)
+  {
+    return getPool(nSize).allocate();
+  }
+
+
+  void CSWObjectPool::deallocate(void* pBlock, std::size_t nSize)
+  {
+    getPool(nSize).deallocate(pBlock);
+  }
+
+
+  void CSWObjectPool::releaseUnused()
+  {
+    std::lock_guard<std::mutex> lck(m_mtxPools);
+    std::map<std::size_t, std::unique_ptr<Pool> >::iterator it = m_Pools.begin();
+    for (; it != m_Pools.end(); ++it)
+      it->second->releaseUnused();
+  }
+
+
+  std::size_t CSWObjectPool::getNumberAllocatedBlocks()
+  {
+    std::lock_guard<std::mutex> lck(m_mtxPools);
+    std::size_t nNumber = 0;
+    std::map<std::size_t, std::unique_ptr<Pool> >::iterator it = m_Pools.begin();
+    for (; it != m_Pools.end(); ++it)
+      nNumber += it->second->getNumberAllocatedBlocks();
+    return nNumber;
+  }
+
+
+  std::size_t CSWObjectPool::getNumberChunks()
+  {
+    std::lock_guard<std::mutex> lck(m_mtxPools);
+    std::size_t nNumber = 0;
+    std::map<std::size_t, std::unique_ptr<Pool> >::iterator it = m_Pools.begin();
+    for (; it != m_Pools.end(); ++it)
+      nNumber += it->second->getNumberChunks();
+    return nNumber;
+  }
+
+
+  CSWObjectPool::CSWObjectPool()
+  {
+  }
+
+
+  CSWObjectPool::Pool& CSWObjectPool::getPool(std::size_t nSize)
+  {
+    //every block must be able to hold the link of the free list
+    std::size_t nBlockSize = (std::max(nSize, sizeof(void*)) + ALIGNMENT - 1)/ALIGNMENT*ALIGNMENT;
+
+    std::lock_guard<std::mutex> lck(m_mtxPools);
+    std::unique_ptr<Pool>& pPool = m_Pools[nBlockSize];
+    if (!pPool)
+      pPool.reset(new Pool(nBlockSize));
+    return *pPool;
+  }
+
+
+
+  CSWObjectPool::Pool::Pool(std::size_t nBlockSize)
+  : m_nBlockSize(nBlockSize),
+    m_nBlocksPerChunk(std::max(MIN_BLOCKS_PER_CHUNK, CHUNK_SIZE/nBlockSize)),
+    m_pFreeList(NULL),
+    m_nNumberAllocatedBlocks(0)
+  {
+  }
+
+
+  CSWObjectPool::Pool::~Pool()
+  {
+    assert(!m_nNumberAllocatedBlocks);
+    std::vector<char*>::iterator it = m_Chunks.begin();
+    for (; it != m_Chunks.end(); ++it)
+      ::operator delete(*it);
+  }
+
+
+  void* CSWObjectPool::Pool::allocate()
+  {
+    std::lock_guard<std::mutex> lck(m_mtxPool);
+    if (!m_pFreeList)
+      addChunk();
+
+    void* pBlock = m_pFreeList;
+    m_pFreeList = *static_cast<void**>(pBlock);
+    ++m_nNumberAllocatedBlocks;
+    return pBlock;
+  }
+
+
+  void CSWObjectPool::Pool::deallocate(void* pBlock)
+  {
+    std::lock_guard<std::mutex> lck(m_mtxPool);
+    assert(m_nNumberAllocatedBlocks);
+    *static_cast<void**>(pBlock) = m_pFreeList;
+    m_pFreeList = pBlock;
+    --m_nNumberAllocatedBlocks;
+  }
+
+
+  void CSWObjectPool::Pool::releaseUnused()
+  {
+    std::lock_guard<std::mutex> lck(m_mtxPool);
+    std::vector<char*> freeBlocks;
+    for (void* pBlock = m_pFreeList; pBlock; pBlock = *static_cast<void**>(pBlock))
+      freeBlocks.push_back(static_cast<char*>(pBlock));
+    std::sort(freeBlocks.begin(), freeBlocks.end(), std::less<char*>());
+
+    //the chunk of a block is the last one starting at or before it
+    std::vector<std::size_t> freeBlocksPerChunk(m_Chunks.size(), 0);
+    std::vector<char*>::const_iterator itBlock = freeBlocks.begin();
+    for (; itBlock != freeBlocks.end(); ++itBlock)
+    {
+      std::vector<char*>::iterator itChunk = std::upper_bound(m_Chunks.begin(), m_Chunks.end(), *itBlock, std::less<char*>());
+      assert(itChunk != m_Chunks.begin());
+      ++freeBlocksPerChunk[itChunk - m_Chunks.begin() - 1];
+    }
+
+    std::vector<char*> usedChunks;
+    std::vector<bool> releasedChunks(m_Chunks.size(), false);
+    for (std::size_t nChunk = 0; nChunk < m_Chunks.size(); ++nChunk)
+    {
+      if (freeBlocksPerChunk[nChunk] == m_nBlocksPerChunk)
+      {
+        ::operator delete(m_Chunks[nChunk]);
+        releasedChunks[nChunk] = true;
+      }
+      else
+      {
+        usedChunks.push_back(m_Chunks[nChunk]);
+      }
+    }
+
+    //relink the remaining free blocks in ascending order, the blocks of a chunk are counted in the same order
+    m_pFreeList = NULL;
+    std::size_t nChunk = m_Chunks.size();
+    std::size_t nRemainingInChunk = 0;
+    std::vector<char*>::reverse_iterator itFree = freeBlocks.rbegin();
+    for (; itFree != freeBlocks.rend(); ++itFree)
+    {
+      while (!nRemainingInChunk)
+        nRemainingInChunk = freeBlocksPerChunk[--nChunk];
+      --nRemainingInChunk;
+      if (releasedChunks[nChunk])
+        continue;
+      *reinterpret_cast<void**>(*itFree) = m_pFreeList;
+      m_pFreeList = *itFree;
+    }
+    m_Chunks.swap(usedChunks);
+  }
+
+
+  std::size_t CSWObjectPool::Pool::getNumberAllocatedBlocks()
+  {
+    std::lock_guard<std::mutex> lck(m_mtxPool);
+    return m_nNumberAllocatedBlocks;
+  }
+
+
+  std::size_t CSWObjectPool::Pool::getNumberChunks()
+  {
+    std::lock_guard<std::mutex> lck(m_mtxPool);
+    return m_Chunks.size();
+  }
+
+
+  void CSWObjectPool::Pool::addChunk()
+  {
+    char* pChunk = static_cast<char*>(::operator new(m_nBlockSize*m_nBlocksPerChunk));
+    m_Chunks.insert(std::upper_bound(m_Chunks.begin(), m_Chunks.end(), pChunk, std::less<char*>()), pChunk);
+
+    //link the blocks in ascending order, so consecutive objects are placed next to each other
+    for (std::size_t nBlock = m_nBlocksPerChunk; nBlock > 0; --nBlock)
+    {
+      char* pBlock = pChunk + (nBlock - 1)*m_nBlockSize;
+      *reinterpret_cast<void**>(pBlock) = m_pFreeList;
+      m_pFreeList = pBlock;
+    }
+  }
+
+}
\ No newline at end of file
@@ -0,0 +1,152 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#pragma once
+
+
+namespace CodeSubWars
+{
+
+  /**
+   * Fixed block pools for the objects that are created and destroyed frequently: weapons, the equipment of the
+   * submarines and their components. Each block size has its own pool, so the objects of a concrete type are placed
+   * next to each other in a few chunks and reuse the blocks of destroyed objects instead of allocating from the heap.
+   * The control blocks of the shared pointers are taken from the pools as well. All methods may be called from
+   * different threads.
+   */
+  class CSWObjectPool
+  {
+    public:
+      typedef std::shared_ptr<CSWObjectPool> PtrType;
+
+      static PtrType getInstance();
+
+      ~CSWObjectPool();
+
+      /**
+       * Constructs an object in a block of the pool for its type. The constructor is called by the given function
+       * with the block, so create() methods can use their protected constructors:
+       * @code
+       * return CSWObjectPool::create<GreenTorpedo>([&](void* pBlock) { return new (pBlock) GreenTorpedo(strName, matBaseTObject, fLength); });
+       * @endcode
+       * @return The shared pointer owning the object. It returns the block to the pool when the object is deleted.
+       */
+      template <typename Type, typename Construct>
+      static std::shared_ptr<Type> create(Construct construct);
+
+      void* allocate(std::size_t nSize);
+      void deallocate(void* pBlock, std::size_t nSize);
+
+      /**
+       * Returns the chunks without allocated blocks to the heap and sorts the free blocks by address, so the objects
+       * of the next battle are placed close to each other again. Objects still alive are not affected.
+       */
+      void releaseUnused();
+
+      std::size_t getNumberAllocatedBlocks();
+      std::size_t getNumberChunks();
+
+    protected:
+      //blocks are aligned like memory returned by new
+      static const std::size_t ALIGNMENT;
+      //approximate size of a chunk, larger objects get a minimal number of blocks per chunk
+      static const std::size_t CHUNK_SIZE;
+      static const std::size_t MIN_BLOCKS_PER_CHUNK;
+
+      class Pool
+      {
+        public:
+          Pool(std::size_t nBlockSize);
+          ~Pool();
+
+          void* allocate();
+          void deallocate(void* pBlock);
+          void releaseUnused();
+
+          std::size_t getNumberAllocatedBlocks();
+          std::size_t getNumberChunks();
+
+        protected:
+          void addChunk();
+
+          std::mutex m_mtxPool;
+          const std::size_t m_nBlockSize;
+          const std::size_t m_nBlocksPerChunk;
+          //sorted by address
+          std::vector<char*> m_Chunks;
+          //the first bytes of a free block point to the next free block
+          void* m_pFreeList;
+          std::size_t m_nNumberAllocatedBlocks;
+      };
+
+      template <typename Type>
+      struct Deleter
+      {
+        Deleter(Pool& pool) : pPool(&pool) {}
+
+        void operator () (Type* pObject) const
+        {
+          pObject->~Type();
+          pPool->deallocate(pObject);
+        }
+
+        Pool* pPool;
+      };
+
+      //places the control blocks of the shared pointers in the pools and keeps the pools alive until the last one is released
+      template <typename Type>
+      class Allocator
+      {
+        public:
+          typedef Type value_type;
+
+          Allocator(PtrType pObjectPool) : m_pObjectPool(pObjectPool) {}
+          template <typename Other>
+          Allocator(const Allocator<Other>& other) : m_pObjectPool(other.m_pObjectPool) {}
+
+          Type* allocate(std::size_t n) { return static_cast<Type*>(m_pObjectPool->allocate(n*sizeof(Type))); }
+          void deallocate(Type* p, std::size_t n) { m_pObjectPool->deallocate(p, n*sizeof(Type)); }
+
+          template <typename Other>
+          bool operator == (const Allocator<Other>& other) const { return m_pObjectPool == other.m_pObjectPool; }
+          template <typename Other>
+          bool operator != (const Allocator<Other>& other) const { return m_pObjectPool != other.m_pObjectPool; }
+
+          PtrType m_pObjectPool;
+      };
+
+      CSWObjectPool();
+
+      Pool& getPool(std::size_t nSize);
+
+      std::mutex m_mtxPools;
+      //block size -> pool
+      std::map<std::size_t, std::unique_ptr<Pool> > m_Pools;
+  };
+
+
+
+  template <typename Type, typename Construct>
+  std::shared_ptr<Type> CSWObjectPool::create(Construct construct)
+  {
+    static_assert(alignof(Type) <= alignof(std::max_align_t), "type needs a stronger alignment than the blocks of the pool");
+
+    PtrType pObjectPool = getInstance();
+    static Pool& pool = pObjectPool->getPool(sizeof(Type));
+
+    void* pBlock = pool.allocate();
+    Type* pObject = NULL;
+    try
+    {
+      pObject = construct(pBlock);
+    }
+    catch (...)
+    {
+      pool.deallocate(pBlock);
+      throw;
+    }
+    return std::shared_ptr<Type>(pObject, Deleter<Type>(pool), Allocator<Type>(pObjectPool));
+  }
+
+}
\ No newline at end of file
@@ -2,14 +2,14 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWPassiveSonar.h"
+#include "CSWObjectPool.h"
 #include "CSWSoundReceiver.h"
 #include "CSWWorld.h"
 #include "CSWSettings.h"
 #include "CSWMap.h"
-#include "CSWPassiveSonarVisualizer.h"
-#include "glut.h"
+#include "CSWISolid.h"
 
 
 namespace CodeSubWars
@@ -17,7 +17,7 @@ namespace CodeSubWars
 
   CSWPassiveSonar::PtrType CSWPassiveSonar::create(const std::string& strName, const Matrix44D& matBaseTObject)
   {
-    return PtrType(new CSWPassiveSonar(strName, matBaseTObject));
+    return CSWObjectPool::create<CSWPassiveSonar>([&](void* pBlock) { return new (pBlock) CSWPassiveSonar(strName, matBaseTObject); });
   }
 
 
@@ -26,14 +26,6 @@ namespace CodeSubWars
   }
 
 
-  QWidget* CSWPassiveSonar::getInformationWidget(QWidget* pParent)
-  {
-    if (!m_pVisualizer)
-      m_pVisualizer = new CSWPassiveSonarVisualizer(pParent, std::dynamic_pointer_cast<CSWPassiveSonar>(getSharedThis()));
-    return m_pVisualizer;
-  }
-
-
   void CSWPassiveSonar::update()
   {
     CSWSonar::update();
@@ -46,67 +38,37 @@ namespace CodeSubWars
   }
 
 
-  void CSWPassiveSonar::draw()
+  void CSWPassiveSonar::collectRenderData(CSWRenderFrame& frame) const
   {
     if (CSWWorld::getInstance()->getSettings()->getVariousProperties() & CSWSettings::DISPLAY_PASSIVE_SONAR_SCAN)
     {
       //for debugging only
-      glPushAttrib(GL_ALL_ATTRIB_BITS);
-        glPushMatrix();
-        glLoadMatrixd(getWorldTransform().pData);
-        glDisable(GL_LIGHTING);
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-        glDisable(GL_CULL_FACE);
-
-        glShadeModel(GL_SMOOTH);
-
-        glDepthMask(false);
-        glEnable(GL_DEPTH_TEST);
-
-        double fValue = 0;
-        int nNumValues = 0;
-        boost::circular_buffer<std::pair<Vector3D, double> >::const_iterator it = m_LastScanValues.begin();
-        for (; nNumValues < 10 && it != m_LastScanValues.end(); ++it, ++nNumValues) fValue += it->second;
-        if (nNumValues)
-          fValue /= nNumValues;
-        fValue /= 150;
-        if (fValue > 1)
-          fValue = 1;
-      
-        if (getAngleOfBeam() < 85)
-        {
-          glBegin(GL_TRIANGLE_FAN);
-            assert(m_Vertices.size() > 2);
-          
-            glColor4d(fValue, 0, 0.5, 0.25 + fValue*0.25);
-            glVertex3dv(m_Vertices.front().pData);
-
-            glColor4d(fValue, 0, 0.5, 0);
-            std::vector<Vector3D>::const_iterator it = boost::next(m_Vertices.begin());
-            for (; it != m_Vertices.end(); ++it)
-            {
-              glVertex3dv(it->pData);
-            }
-
-            glVertex3dv(boost::next(m_Vertices.begin())->pData);
-          
-          glEnd();
-        }
-        else 
-        {
-          glColor4d(fValue, 0, 0.5, 0.2 + fValue*0.2);
-          GLUquadricObj* pQuad = gluNewQuadric();
-          gluQuadricDrawStyle(pQuad, GLU_FILL);
-          gluSphere(pQuad, 1000, 10, 10);
-          gluDeleteQuadric(pQuad);
-        }
+      double fValue = 0;
+      int nNumValues = 0;
+      boost::circular_buffer<std::pair<Vector3D, double> >::const_iterator it = m_LastScanValues.begin();
+      for (; nNumValues < 10 && it != m_LastScanValues.end(); ++it, ++nNumValues) fValue += it->second;
+      if (nNumValues)
+        fValue /= nNumValues;
+      fValue /= 150;
+      if (fValue > 1)
+        fValue = 1;
       
-        glDepthMask(true);
-        glPopMatrix();
-      glPopAttrib();
+      if (getAngleOfBeam() < 85)
+      {
+        assert(m_Vertices.size() > 2);
+        CSWRenderFrame::Geometry fan(CSWRenderFrame::Geometry::TRIANGLE_FAN, getWorldTransform());
+        fan.vertices = m_Vertices;
+        fan.vertices.push_back(*boost::next(m_Vertices.begin()));
+        fan.colors.resize(fan.vertices.size(), Vector4D(fValue, 0, 0.5, 0));
+        fan.colors.front() = Vector4D(fValue, 0, 0.5, 0.25 + fValue*0.25);
+        frame.addGeometry(fan);
+      }
+      else 
+      {
+        static const Mesh::PtrType pSphere = Mesh::createEllipsoid(Matrix44D(), Vector3D(2000, 2000, 2000), 10, 10, 0, 10);
+        frame.addMeshGeometry(pSphere, getWorldTransform(), Vector4D(fValue, 0, 0.5, 0.2 + fValue*0.2),
+                              CSWRenderFrame::MeshGeometry::FILL);
+      }
     }  
   }
 
@@ -151,6 +113,7 @@ namespace CodeSubWars
   void CSWPassiveSonar::addSound(const Vector3D& vecWorldTPosEmitter, const double& fLevel)
   {
     m_pSoundReceiver->addSound(vecWorldTPosEmitter, getWorldTransform().getTranslation(), getDirection(), fLevel);
+    m_pBearingSpectrum->addSound(vecWorldTPosEmitter, fLevel);
   }
 
 
@@ -165,6 +128,21 @@ namespace CodeSubWars
     findMaximum();
     m_LastScanValues.push_front(std::make_pair(getDirection(), getLevel()));
     m_pSoundReceiver->reset();
+
+    //the bearings are relative to the carrying object because the sonar itself turns with its direction
+    Matrix44D matWorldTReceiver(getWorldTransform());
+    Vector3D vecWorldTHullCenter(matWorldTReceiver.getTranslation());
+    double fHullRadius = 0;
+    CSWObject::PtrType pHull = findFirstParent<CSWISolid>();
+    if (CSWISolid::PtrType pSolid = std::dynamic_pointer_cast<CSWISolid>(pHull))
+    {
+      const Matrix44D& matWorldTHull = pHull->getWorldTransform();
+      matWorldTReceiver = Matrix44D(matWorldTHull.getXAxis(), matWorldTHull.getYAxis(), matWorldTHull.getZAxis(), 
+                                    matWorldTReceiver.getTranslation());
+      vecWorldTHullCenter = matWorldTHull.getTranslation();
+      fHullRadius = pSolid->getSurfaceBoundingBox().getDiagonalLength()*0.5;
+    }
+    m_pBearingSpectrum->reset(matWorldTReceiver, vecWorldTHullCenter, fHullRadius);
   }
 
 
@@ -200,11 +178,23 @@ namespace CodeSubWars
   }
 
 
+  CSWBearingSpectrum::BearingContainer CSWPassiveSonar::getBearings(const double& fMinLevel) const
+  {
+    return m_pBearingSpectrum->getPeaks(fMinLevel);
+  }
+
+
+  const double& CSWPassiveSonar::getBearingResolution() const
+  {
+    return m_pBearingSpectrum->getResolution();
+  }
+
+
   CSWPassiveSonar::CSWPassiveSonar(const std::string& strName, const Matrix44D& matBaseTObject)
   : CSWSonar(strName, matBaseTObject),
     m_pSoundReceiver(CSWSoundReceiver::create()),
+    m_pBearingSpectrum(CSWBearingSpectrum::create()),
     m_LastScanValues(50),
-    m_pVisualizer(NULL),
     m_fAdjustingEndTime(0),
     m_bFoundMaximum(false),
     m_bFindingMaximum(false)
@@ -6,13 +6,13 @@
 
 #include "CSWSonar.h"
 #include "CSWISoundReceiver.h"
+#include "CSWBearingSpectrum.h"
 
 namespace CodeSubWars
 {
 
   class CSWSoundReceiver;
-  class CSWPassiveSonar3DView;
-  class CSWPassiveSonarVisualizer;
+  class CSWInformationSnapshot;
 
   /**
    * This class specializes a sonar to a passive sonar. It detects environmental sounds of sound emitting objects.
@@ -27,14 +27,11 @@ namespace CodeSubWars
 
       virtual ~CSWPassiveSonar();
 
-      //defined methods from CSWEquipment
-      virtual QWidget* getInformationWidget(QWidget* pParent);
-
       //defined methods from IUpdateable
       virtual void update();
 
       //defined methods from CSWSonar
-      virtual void draw();
+      virtual void collectRenderData(CSWRenderFrame& frame) const;
       virtual Vector3D getAdditionalDirection(const Vector3D& vecCurrentDir, const Vector3D& vecUp) const;
 
       //defined methods from ISoundReceiver
@@ -89,7 +86,24 @@ namespace CodeSubWars
        */
       bool hasAdjusted() const;
 
-      friend CSWPassiveSonar3DView;
+      /**
+       * Returns the directions of all sound sources that have been received within the last time step. In contrast
+       * to getLevel() this does not depend on the beam: the sounds from all directions are collected in bins of
+       * getBearingResolution() degree and every bin that is louder than its neighbors is returned. So the bearings of
+       * all audible objects are available at once without adjusting the direction. Sounds emitted within the own 
+       * hull are ignored.
+       * @param fMinLevel The minimal sound pressure level in dB of the returned bearings.
+       * @return The bearings sorted by descending level. The azimuth and elevation are relative to the object that
+       *         carries the sonar.
+       */
+      CSWBearingSpectrum::BearingContainer getBearings(const double& fMinLevel) const;
+
+      /**
+       * @return The angular size in degree of the bins the bearings are collected in.
+       */
+      const double& getBearingResolution() const;
+
+      friend CSWInformationSnapshot;
     protected:  
       CSWPassiveSonar(const std::string& strName, const Matrix44D& matBaseTObject);
 
@@ -98,9 +112,9 @@ namespace CodeSubWars
   
       //property implementations
       std::shared_ptr<CSWSoundReceiver> m_pSoundReceiver;
+      CSWBearingSpectrum::PtrType m_pBearingSpectrum;
 
       boost::circular_buffer<std::pair<Vector3D, double> > m_LastScanValues; //direction in world coordinates, level
-      CSWPassiveSonarVisualizer* m_pVisualizer;
     
       double m_fAdjustingEndTime;
       bool m_bFoundMaximum;
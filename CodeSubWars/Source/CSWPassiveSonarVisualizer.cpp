@@ -4,9 +4,7 @@
 
 #include "PrecompiledHeader.h"
 #include "CSWPassiveSonarVisualizer.h"
-#include "CSWPassiveSonar.h"
 #include "CSWCamera.h"
-#include "CSWISolid.h"
 #include "CSWUtilities.h"
 #include "glut.h"
 
@@ -14,11 +12,9 @@
 namespace CodeSubWars
 {
 
-  CSWPassiveSonar3DView::CSWPassiveSonar3DView(QWidget* pParent, CSWPassiveSonar::PtrType pPassiveSonar)
+  CSWPassiveSonar3DView::CSWPassiveSonar3DView(QWidget* pParent)
   : OpenGLView(pParent),
     m_pMainCamera(CSWCamera::create("PassiveSonar", Matrix44D())),
-    m_pPassiveSonar(pPassiveSonar),
-    m_pSolidParent(pPassiveSonar->findFirstParent<CSWISolid>()),
     m_matPassiveSonarTCamera(Vector3D(1, 0, 0),
                              Vector3D(0, 0, 1),
                              Vector3D(0, -1, 0),
@@ -28,16 +24,20 @@ namespace CodeSubWars
   }
 
 
+  void CSWPassiveSonar3DView::setInformation(const CSWInformationSnapshot::PtrType& pInformation)
+  {
+    m_pInformation = pInformation;
+  }
+
+
   void CSWPassiveSonar3DView::draw()
   {
-    CSWPassiveSonar::PtrType pPassiveSonar = m_pPassiveSonar.lock();
-    CSWObject::PtrType pSolidParent = m_pSolidParent.lock();
-    CSWISoundReceiver::PtrType pSoundReceiver = std::dynamic_pointer_cast<CSWISoundReceiver>(pPassiveSonar);
     CSWCamera::PtrType pCam = m_pCamera.lock();
-    if (!pPassiveSonar || !pSoundReceiver || !pSolidParent || !pCam)
+    if (!m_pInformation || !(m_pInformation->nProperties & CSWInformationSnapshot::PASSIVE_SONAR) || !pCam)
       return;
+    const CSWInformationSnapshot& info = *m_pInformation;
   
-    pCam->setTransform(pSolidParent->getWorldTransform()*m_matPassiveSonarTCamera);
+    pCam->setTransform(info.matSolidParentTransform*m_matPassiveSonarTCamera);
     pCam->calcWorldTransforms();
 
     glPushAttrib(GL_ALL_ATTRIB_BITS);
@@ -49,7 +49,7 @@ namespace CodeSubWars
       //draw scan area
       glPushMatrix();
         Matrix44D mat2(pCam->getWorldTransform());
-        mat2.getTranslation() = pPassiveSonar->getWorldTransform().getTranslation();
+        mat2.getTranslation() = info.matWorldTransform.getTranslation();
         glLoadMatrixd(mat2.pData);
       
         glDisable(GL_BLEND);
@@ -82,9 +82,9 @@ namespace CodeSubWars
       glLineWidth(4);
       glBegin(GL_LINES);
         glColor4d(0.3, 0.3, 0.6, 1);      
-        glVertex3dv(pPassiveSonar->getWorldTransform().getTranslation().pData);
+        glVertex3dv(info.matWorldTransform.getTranslation().pData);
         glColor4d(0.3, 0.3, 0.6, 0);      
-        glVertex3dv((pPassiveSonar->getWorldTransform().getTranslation() + pSoundReceiver->getDirection()*150.0).pData);
+        glVertex3dv((info.matWorldTransform.getTranslation() + info.vecSoundDirection*150.0).pData);
       glEnd();
 
   //    glDisable(GL_BLEND);
@@ -93,16 +93,16 @@ namespace CodeSubWars
       //draw detected points
       glLineWidth(2);
       glBegin(GL_LINE_STRIP);
-        boost::circular_buffer<std::pair<Vector3D, double> >::const_iterator it = pPassiveSonar->m_LastScanValues.begin();
-        for (; it != pPassiveSonar->m_LastScanValues.end(); ++it)
+        std::vector<std::pair<Vector3D, double> >::const_iterator it = info.passiveSonarScans.begin();
+        for (; it != info.passiveSonarScans.end(); ++it)
         {
-          Vector3D vec = pPassiveSonar->getWorldTransform().getTranslation() + it->first*it->second;
+          Vector3D vec = info.matWorldTransform.getTranslation() + it->first*it->second;
           glColor3dv(CSWUtilities::calcColorR2G2B(it->second/150).pData);      
           glVertex3dv(vec.pData);
         }
       glEnd();
 
-      ARSTD::OpenGLTools::paintTripod(pSolidParent->getWorldTransform(), 10);
+      ARSTD::OpenGLTools::paintTripod(info.matSolidParentTransform, 10);
   
       //draw world coord tripod in lower left corner
       drawWorldTripod();
@@ -150,18 +150,19 @@ namespace CodeSubWars
 
 
 
-  CSWPassiveSonarVisualizer::CSWPassiveSonarVisualizer(QWidget* pParent, CSWPassiveSonar::PtrType pPassiveSonar)
+  CSWPassiveSonarVisualizer::CSWPassiveSonarVisualizer(QWidget* pParent)
   : QWidget(pParent, NULL)
   {
     QHBoxLayout* pLayout = new QHBoxLayout(this); 
     pLayout->setMargin(1);
-    m_pView = new CSWPassiveSonar3DView(this, pPassiveSonar);
+    m_pView = new CSWPassiveSonar3DView(this);
     pLayout->addWidget(m_pView);
   }
 
 
-  void CSWPassiveSonarVisualizer::updateContent()
+  void CSWPassiveSonarVisualizer::updateContent(const CSWInformationSnapshot::PtrType& pInformation)
   {
+    m_pView->setInformation(pInformation);
     update();
   }
 
@@ -4,23 +4,21 @@
 
 #pragma once
 
-//#include "boost/weak_ptr.hpp"
-
 #include "OpenGLView.h"
 #include "CSWIEquipmentVisualizer.h"
 
 namespace CodeSubWars
 {
 
-  class CSWObject;
-  class CSWPassiveSonar;
   class CSWCamera;
 
   class CSWPassiveSonar3DView : public OpenGLView
   {
     public:
-      CSWPassiveSonar3DView(QWidget* pParent, std::shared_ptr<CSWPassiveSonar> m_pPassiveSonar);
+      CSWPassiveSonar3DView(QWidget* pParent);
     
+      void setInformation(const CSWInformationSnapshot::PtrType& pInformation);
+
       virtual void draw();
     
     protected:
@@ -31,8 +29,7 @@ namespace CodeSubWars
       virtual void timerEvent(QTimerEvent*);
     
       std::shared_ptr<CSWCamera> m_pMainCamera;
-      std::weak_ptr<CSWPassiveSonar> m_pPassiveSonar;
-      std::weak_ptr<CSWObject> m_pSolidParent;
+      CSWInformationSnapshot::PtrType m_pInformation;
       Matrix44D m_matPassiveSonarTCamera;
   };
 
@@ -43,9 +40,9 @@ namespace CodeSubWars
                                     public CSWIEquipmentVisualizer
   {
     public:
-      CSWPassiveSonarVisualizer(QWidget* pParent, std::shared_ptr<CSWPassiveSonar> pPassiveSonar);
+      CSWPassiveSonarVisualizer(QWidget* pParent);
     
-      virtual void updateContent();
+      virtual void updateContent(const CSWInformationSnapshot::PtrType& pInformation);
     
     protected:
       virtual void paintEvent(QPaintEvent* pEvent);
@@ -106,7 +106,7 @@ namespace CodeSubWars
       }
       catch (...)
       {
-        CSWLog::getInstance()->log(getName() + "::copy() throws an exception");
+        CSWLog::getInstance()->log(getName(), getName() + "::copy() throws an exception");
         throw;
       }
       return result;
@@ -120,7 +120,7 @@ namespace CodeSubWars
       }
       catch (...)
       {
-        CSWLog::getInstance()->log(getName() + "::initialize() throws an exception");
+        CSWLog::getInstance()->log(getName(), getName() + "::initialize() throws an exception");
         throw;
       }
     }
@@ -133,7 +133,7 @@ namespace CodeSubWars
       }
       catch (...)
       {
-        CSWLog::getInstance()->log(getName() + "::step() throws an exception");
+        CSWLog::getInstance()->log(getName(), getName() + "::step() throws an exception");
         throw;
       }
     }
@@ -146,7 +146,7 @@ namespace CodeSubWars
       }
       catch (...)
       {
-        CSWLog::getInstance()->log(getName() + "::cleanup() throws an exception");
+        CSWLog::getInstance()->log(getName(), getName() + "::cleanup() throws an exception");
         throw;
       }
     }
@@ -159,13 +159,13 @@ namespace CodeSubWars
       }
       catch (...)
       {
-        CSWLog::getInstance()->log("command::getName() throws an exception (using default name)");
+        CSWLog::getInstance()->log("command", "command::getName() throws an exception (using default name)");
         PyErr_Print();
         return "command";
       }
     }
   
-    unsigned __int64 getRessourceID() const
+    ARSTD::uint64 getRessourceID() const
     {
       if (boost::python::override getRessourceID = this->get_override("getRessourceID"))
       {
@@ -175,13 +175,13 @@ namespace CodeSubWars
         }
         catch (...)
         {
-          CSWLog::getInstance()->log(getName() + "::getRessourceID() throws an exception (use default ressource id)");
+          CSWLog::getInstance()->log(getName(), getName() + "::getRessourceID() throws an exception (use default ressource id)");
           PyErr_Print();
         }
       }
       return CSWPyCommand::getRessourceID();
     }
-    unsigned __int64 default_getRessourceID() const { return this->CSWPyCommand::getRessourceID(); }
+    ARSTD::uint64 default_getRessourceID() const { return this->CSWPyCommand::getRessourceID(); }
 
     std::string getDetails() const
     {
@@ -193,7 +193,7 @@ namespace CodeSubWars
         }
         catch (...)
         {
-          CSWLog::getInstance()->log(getName() + "::getDetails() throws an exception (use default detail description)");
+          CSWLog::getInstance()->log(getName(), getName() + "::getDetails() throws an exception (use default detail description)");
           PyErr_Print();
         }
       }
@@ -203,10 +203,10 @@ namespace CodeSubWars
   };
 
 
-  CSWSetEngineDirectionCommand::PtrType (*CSWSetEngineDirectionCommand_create1)(CSWEngine::PtrType&, const double&, const double&) 
+  CSWSetEngineDirectionCommand::PtrType (*CSWSetEngineDirectionCommand_create1)(const CSWEngine::PtrType&, const double&, const double&) 
     = &CSWSetEngineDirectionCommand::create; 
   
-  CSWSetEngineDirectionCommand::PtrType (*CSWSetEngineDirectionCommand_create2)(CSWEngine::PtrType&, const Vector3D&) 
+  CSWSetEngineDirectionCommand::PtrType (*CSWSetEngineDirectionCommand_create2)(const CSWEngine::PtrType&, const Vector3D&) 
     = &CSWSetEngineDirectionCommand::create; 
 
 
@@ -217,20 +217,20 @@ namespace CodeSubWars
     = &CSWCommands::setMainEngineDirection; 
 
 
-  CSWFireCommand::PtrType CSWFireCommand_create1(std::shared_ptr<CSWWeaponBattery>& pWeaponBattery)
+  CSWFireCommand::PtrType CSWFireCommand_create1(const std::shared_ptr<CSWWeaponBattery>& pWeaponBattery)
   {
     return CSWFireCommand::create(pWeaponBattery);
   }
 
-  CSWFireCommand::PtrType CSWFireCommand_create2(std::shared_ptr<CSWWeaponBattery>& pWeaponBattery, 
+  CSWFireCommand::PtrType CSWFireCommand_create2(const std::shared_ptr<CSWWeaponBattery>& pWeaponBattery, 
                                                  double fArmDelay)
   {
     return CSWFireCommand::create(pWeaponBattery, fArmDelay);
   }
 
-  CSWFireCommand::PtrType CSWFireCommand_create3(std::shared_ptr<CSWWeaponBattery>& pWeaponBattery, 
+  CSWFireCommand::PtrType CSWFireCommand_create3(const std::shared_ptr<CSWWeaponBattery>& pWeaponBattery, 
                                                  double fArmDelay,
-                                                 std::shared_ptr<CSWWeapon>& pWeapon)
+                                                 const std::shared_ptr<CSWWeapon>& pWeapon)
   {
     return CSWFireCommand::create(pWeaponBattery, fArmDelay, pWeapon);
   }
@@ -0,0 +1,175 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#include "CorePrecompiledHeader.h"
+#include "CSWPyProfiler.h"
+
+
+namespace CodeSubWars
+{
+
+  namespace
+  {
+    thread_local double fOverheadTime = 0;
+  }
+
+
+  CSWPyProfiler::PtrType CSWPyProfiler::create(const std::string& strName)
+  {
+    return PtrType(new CSWPyProfiler(strName));
+  }
+
+
+  CSWPyProfiler::~CSWPyProfiler()
+  {
+  }
+
+
+  void CSWPyProfiler::attach()
+  {
+    //the thread state keeps the only reference to the capsule, so it is released together with the interpreter
+    PyObject* pCapsule = PyCapsule_New(this, NULL, NULL);
+    if (!pCapsule)
+    {
+      PyErr_Clear();
+      return;
+    }
+    m_pCurrent = &m_Root;
+    PyEval_SetProfile(&CSWPyProfiler::profile, pCapsule);
+    Py_DECREF(pCapsule);
+  }
+
+
+  void CSWPyProfiler::detach()
+  {
+    PyEval_SetProfile(NULL, NULL);
+    m_pCurrent = &m_Root;
+  }
+
+
+  const std::string& CSWPyProfiler::getName() const
+  {
+    return m_strName;
+  }
+
+
+  void CSWPyProfiler::write(std::ostream& os) const
+  {
+    std::map<const void*, std::unique_ptr<Node> >::const_iterator it = m_Root.children.begin();
+    for (; it != m_Root.children.end(); ++it)
+      write(os, *it->second, m_strName);
+  }
+
+
+  double CSWPyProfiler::getOverheadTime()
+  {
+    return fOverheadTime;
+  }
+
+
+  CSWPyProfiler::CSWPyProfiler(const std::string& strName)
+  : m_strName(strName),
+    m_Root(strName, NULL),
+    m_pCurrent(&m_Root),
+    m_fLastTime(0)
+  {
+  }
+
+
+  int CSWPyProfiler::profile(PyObject* pObject, PyFrameObject* pFrame, int nWhat, PyObject* pArg)
+  {
+    CSWPyProfiler* pProfiler = static_cast<CSWPyProfiler*>(PyCapsule_GetPointer(pObject, NULL));
+    if (!pProfiler)
+      return 0;
+
+    double fEnterTime = ARSTD::Time::getThreadTime();
+    //time outside of python (between two calls from the simulation) belongs to the root and is not recorded
+    if (pProfiler->m_pCurrent != &pProfiler->m_Root)
+      pProfiler->m_pCurrent->fTime += fEnterTime - pProfiler->m_fLastTime;
+
+    switch (nWhat)
+    {
+      case PyTrace_CALL:
+      {
+        PyCodeObject* pCode = PyFrame_GetCode(pFrame);
+        pProfiler->enter(pCode, pFrame, NULL);
+        Py_DECREF(pCode);
+        break;
+      }
+      case PyTrace_C_CALL:
+      {
+        //bound builtin methods are new objects on every access, their method definition is not
+        if (PyCFunction_Check(pArg))
+          pProfiler->enter(reinterpret_cast<PyCFunctionObject*>(pArg)->m_ml, NULL, pArg);
+        else
+          pProfiler->enter(pArg, NULL, pArg);
+        break;
+      }
+      case PyTrace_RETURN:
+      case PyTrace_C_RETURN:
+      case PyTrace_C_EXCEPTION:
+      {
+        pProfiler->leave();
+        break;
+      }
+    }
+
+    //taken after the bookkeeping to keep the profiler's own costs out of the result and the cpu accounts
+    pProfiler->m_fLastTime = ARSTD::Time::getThreadTime();
+    fOverheadTime += pProfiler->m_fLastTime - fEnterTime;
+    return 0;
+  }
+
+
+  void CSWPyProfiler::enter(const void* pKey, PyFrameObject* pFrame, PyObject* pFunction)
+  {
+    std::unique_ptr<Node>& pChild = m_pCurrent->children[pKey];
+    if (!pChild)
+    {
+      std::stringstream ss;
+      if (pFrame)
+      {
+        PyCodeObject* pCode = PyFrame_GetCode(pFrame);
+        std::string strFileName = PyUnicode_AsUTF8(pCode->co_filename);
+        std::string::size_type nIdx = strFileName.find_last_of("/\\");
+        if (nIdx != std::string::npos)
+          strFileName = strFileName.substr(nIdx + 1);
+        ss << PyUnicode_AsUTF8(pCode->co_name) << " (" << strFileName << ":" << pCode->co_firstlineno << ")";
+        Py_DECREF(pCode);
+      }
+      else
+      {
+        ss << PyEval_GetFuncName(pFunction) << " (builtin)";
+      }
+
+      //semicolons separate the frames in the written stacks
+      std::string strName = ss.str();
+      std::replace(strName.begin(), strName.end(), ';', ':');
+      pChild.reset(new Node(strName, m_pCurrent));
+    }
+    m_pCurrent = pChild.get();
+  }
+
+
+  void CSWPyProfiler::leave()
+  {
+    //returns of calls that were entered before attaching are ignored
+    if (m_pCurrent->pParent)
+      m_pCurrent = m_pCurrent->pParent;
+  }
+
+
+  void CSWPyProfiler::write(std::ostream& os, const Node& node, const std::string& strStack)
+  {
+    std::string strNodeStack = strStack + ";" + node.strName;
+    long long nMicroseconds = static_cast<long long>(node.fTime*1e6 + 0.5);
+    if (nMicroseconds > 0)
+      os << strNodeStack << " " << nMicroseconds << "\n";
+
+    std::map<const void*, std::unique_ptr<Node> >::const_iterator it = node.children.begin();
+    for (; it != node.children.end(); ++it)
+      write(os, *it->second, strNodeStack);
+  }
+
+}
\ No newline at end of file
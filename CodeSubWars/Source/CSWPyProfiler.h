@@ -0,0 +1,75 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#pragma once
+
+
+namespace CodeSubWars
+{
+
+  /**
+   * Attributes the processor time spent in python code of one submarine to its call stacks. It hooks into the
+   * profile callback of the submarine's interpreter and only keeps a tree of call stacks with accumulated times,
+   * so the overhead per python call is small. The result is written in the collapsed stack format that can be
+   * turned into a flamegraph (e.g. by flamegraph.pl or speedscope).
+   */
+  class CSWPyProfiler
+  {
+    public:
+      typedef std::shared_ptr<CSWPyProfiler> PtrType;
+
+      static PtrType create(const std::string& strName);
+
+      ~CSWPyProfiler();
+
+      /**
+       * Installs the profiler for the current python thread state. The gil of the profiled interpreter must be held.
+       */
+      void attach();
+
+      /**
+       * Removes the profiler from the current python thread state. The gil of the profiled interpreter must be held.
+       */
+      void detach();
+
+      const std::string& getName() const;
+
+      /**
+       * Writes all recorded stacks prefixed with the profiler name. One line per stack, the value is given in microseconds.
+       */
+      void write(std::ostream& os) const;
+
+      /**
+       * Returns the processor time the profilers have spent in their hooks on the calling thread so far. It is
+       * subtracted from the time accounted to the submarines (see CSWCPUAccount::getTime()).
+       */
+      static double getOverheadTime();
+
+    protected:
+      struct Node
+      {
+        Node(const std::string& strName, Node* pParent) : strName(strName), pParent(pParent), fTime(0) {}
+
+        std::string strName;
+        Node* pParent;
+        double fTime;
+        std::map<const void*, std::unique_ptr<Node> > children;
+      };
+
+      CSWPyProfiler(const std::string& strName);
+
+      static int profile(PyObject* pObject, PyFrameObject* pFrame, int nWhat, PyObject* pArg);
+
+      void enter(const void* pKey, PyFrameObject* pFrame, PyObject* pFunction);
+      void leave();
+
+      static void write(std::ostream& os, const Node& node, const std::string& strStack);
+
+      std::string m_strName;
+      Node m_Root;
+      Node* m_pCurrent;
+      double m_fLastTime;
+  };
+
+}
\ No newline at end of file
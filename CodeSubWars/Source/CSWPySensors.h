@@ -6,6 +6,7 @@
 
 #include <boost/python/copy_const_reference.hpp>
 #include <boost/python/return_value_policy.hpp>
+#include <boost/python/suite/indexing/vector_indexing_suite.hpp>
 
 #include "CSWSensor.h"
 #include "CSWGPS.h"
@@ -101,6 +102,27 @@ BOOST_PYTHON_MODULE(CodeSubWars_Sensors)
     .def("isTargetSubmarine", &CSWActiveSonar::isTargetSubmarine)
     .def("isTargetWeapon", &CSWActiveSonar::isTargetWeapon)
     .def("getTargetPosition", &CSWActiveSonar::getTargetPosition, boost::python::return_value_policy<boost::python::copy_const_reference>())
+    .def("scan", &CSWActiveSonar::scan)
+    .def("isScanReady", &CSWActiveSonar::isScanReady)
+    .def("createFanDirections", &CSWActiveSonar::createFanDirections)
+    .staticmethod("createFanDirections")
+    .def("createConeDirections", &CSWActiveSonar::createConeDirections)
+    .staticmethod("createConeDirections")
+  ;
+
+  boost::python::class_<CSWSonarEcho>("CSWSonarEcho", boost::python::no_init)
+    .def_readonly("vecWorldTDirection", &CSWSonarEcho::vecWorldTDirection)
+    .def_readonly("fDistance", &CSWSonarEcho::fDistance)
+    .def_readonly("vecTargetPosition", &CSWSonarEcho::vecTargetPosition)
+    .def_readonly("bTargetDetected", &CSWSonarEcho::bTargetDetected)
+    .def_readonly("bTargetDynamic", &CSWSonarEcho::bTargetDynamic)
+    .def_readonly("bTargetBorder", &CSWSonarEcho::bTargetBorder)
+    .def_readonly("bTargetSubmarine", &CSWSonarEcho::bTargetSubmarine)
+    .def_readonly("bTargetWeapon", &CSWSonarEcho::bTargetWeapon)
+  ;
+
+  boost::python::class_<std::vector<CSWSonarEcho> >("SonarEchoContainer")
+    .def(boost::python::vector_indexing_suite<std::vector<CSWSonarEcho> >())
   ;
 
   boost::python::class_<CSWPassiveSonar, boost::python::bases<CSWSonar>, boost::noncopyable>("CSWPassiveSonar", boost::python::no_init)
@@ -110,6 +132,19 @@ BOOST_PYTHON_MODULE(CodeSubWars_Sensors)
     .def("adjustDirectionToMaximum", &CSWPassiveSonar::adjustDirectionToMaximum)
     .def("isAdjusting", &CSWPassiveSonar::isAdjusting)
     .def("hasAdjusted", &CSWPassiveSonar::hasAdjusted)
+    .def("getBearings", &CSWPassiveSonar::getBearings)
+    .def("getBearingResolution", &CSWPassiveSonar::getBearingResolution, boost::python::return_value_policy<boost::python::copy_const_reference>())
+  ;
+
+  boost::python::class_<CSWBearing>("CSWBearing", boost::python::no_init)
+    .def_readonly("vecWorldTDirection", &CSWBearing::vecWorldTDirection)
+    .def_readonly("fAzimuth", &CSWBearing::fAzimuth)
+    .def_readonly("fElevation", &CSWBearing::fElevation)
+    .def_readonly("fLevel", &CSWBearing::fLevel)
+  ;
+
+  boost::python::class_<std::vector<CSWBearing> >("BearingContainer")
+    .def(boost::python::vector_indexing_suite<std::vector<CSWBearing> >())
   ;
 
   boost::python::register_ptr_to_python<std::shared_ptr<CSWSensor> >();
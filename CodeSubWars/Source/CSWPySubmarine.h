@@ -16,6 +16,7 @@
 #include "CSWPythonable.h"
 
 #include "CSWSubmarine.h"
+#include "CSWCPUAccount.h"
 
 
 namespace CodeSubWars
@@ -101,7 +102,7 @@ namespace CodeSubWars
       /**
        * This method must be overriden in the specialized class. This methode is called periodically about every 10ms.
        * The main function should be checking sensors, seting up commands or something like that. The specialized class can implement everything 
-       * here, but the execution time must not exceed 6ms in average. If it does the object will be kicked from the world!
+       * here, but the processor time must not exceed the cpu budget (default 6ms) in average. If it does the object will be kicked from the world!
        */
       virtual void update() { CSWSubmarine::update(); }
 
@@ -110,7 +111,7 @@ namespace CodeSubWars
        * processed. Returning true reports the eventmanager that the event passed to the object has successfully processed and delete it.
        * When returning false the event will be delivered the next time again until it expires or processed successfully.
        * The main function should be reacting to events e.g. seting up commands or something like that. The specialized class can implement everything 
-       * here, but the execution time must not exceed 6ms in average. If it does the object will be kicked from the world!
+       * here, but the processor time must not exceed the cpu budget (default 6ms) in average. If it does the object will be kicked from the world!
        * @param pEvent The incoming event that should be processed.
        * @return True if the incoming event has been successfully processed. When returning false the event will be delivered next time again.
        */
@@ -121,6 +122,21 @@ namespace CodeSubWars
        * Its ensured that this method is called directly before destructing.
        */
       virtual void finalize() { CSWSubmarine::finalize(); }
+
+      /**
+       * This method can be overriden if the submarine should be continued correctly from a world snapshot. The returned
+       * object must be picklable and is passed to setSnapshotState() when the snapshot is restored. Commands and 
+       * events are not part of a snapshot.
+       * @return The state of the submarine.
+       */
+      //getSnapshotState()
+
+      /**
+       * This method can be overriden to restore the state returned by getSnapshotState(). It is called after all 
+       * objects of the world have been restored and before update() is called again.
+       * @param state The state returned by getSnapshotState() when the snapshot was taken.
+       */
+      //setSnapshotState(state)
     
       /**
        * Returns the command processor.
@@ -287,15 +303,8 @@ namespace CodeSubWars
   struct CSWPySubmarineWrapper : public CSWPySubmarine, boost::python::wrapper<CSWPySubmarine>
   {
     CSWPySubmarineWrapper(std::string name, double fLength) 
-    : CSWPySubmarine(name, fLength),
-      m_UpdateTimes(NUM_CYCLES),
-      m_ProcessEventTimes(NUM_CYCLES)
+    : CSWPySubmarine(name, fLength)
     {
-      for (int i = 0; i < NUM_CYCLES; ++i)
-      {
-        m_UpdateTimes.push_back(0);
-        m_ProcessEventTimes.push_back(0);
-      }
     }
 
 
@@ -316,7 +325,7 @@ namespace CodeSubWars
         catch (...)
         {
           CSWWorld::getInstance()->getWorldGuard()->addErroneousObject(getSharedThis(), CSWWorldGuard::FATAL);
-          CSWLog::getInstance()->log(getName() + "::initialize() throws an exception");
+          CSWLog::getInstance()->log(getName(), getName() + "::initialize() throws an exception");
           PyErr_Print();
         }
       }
@@ -349,25 +358,23 @@ namespace CodeSubWars
       //PyEval_AcquireThread(state);
       try
       {
-        double fStart = ARSTD::Time::getRealTime();
+        double fStart = CSWCPUAccount::getTime();
       
         this->get_override("update")(); 
       
-        m_UpdateTimes.push_back(ARSTD::Time::getRealTime() - fStart);
-        double fAvgTime = std::accumulate(m_UpdateTimes.begin(), m_UpdateTimes.end(), 0.0) / m_UpdateTimes.capacity();
-        if (fAvgTime > Constants::CRITICAL_CONSUMING_TIME)
+        if (getCPUAccount()->add(CSWCPUAccount::UPDATE, CSWCPUAccount::getTime() - fStart))
         {
           CSWWorld::getInstance()->getWorldGuard()->addErroneousObject(getSharedThis(), CSWWorldGuard::FATAL);
           std::stringstream ss;
           ss << getName() << "::update() causes critical processor load (" 
-             << fAvgTime*1000.0 << "ms)";
-          CSWLog::getInstance()->log(ss.str());
+             << getCPUAccount()->getAverageTime(CSWCPUAccount::UPDATE)*1000.0 << "ms)";
+          CSWLog::getInstance()->log(getName(), ss.str());
         }
       }
       catch (...)
       {
         CSWWorld::getInstance()->getWorldGuard()->addErroneousObject(getSharedThis(), CSWWorldGuard::FATAL);
-        CSWLog::getInstance()->log(getName() + "::update() throws an exception");
+        CSWLog::getInstance()->log(getName(), getName() + "::update() throws an exception");
         PyErr_Print();
       }
       //PyEval_ReleaseThread(state);
@@ -385,25 +392,23 @@ namespace CodeSubWars
       bool bResult = true;
       try
       {
-        double fStart = ARSTD::Time::getRealTime();
+        double fStart = CSWCPUAccount::getTime();
       
         bResult = this->get_override("processEvent")(pEvent);
       
-        m_ProcessEventTimes.push_back(ARSTD::Time::getRealTime() - fStart);
-        double fAvgTime = std::accumulate(m_ProcessEventTimes.begin(), m_ProcessEventTimes.end(), 0.0) / m_UpdateTimes.capacity();
-        if (fAvgTime > Constants::CRITICAL_CONSUMING_TIME)
+        if (getCPUAccount()->add(CSWCPUAccount::PROCESS_EVENT, CSWCPUAccount::getTime() - fStart))
         {
           CSWWorld::getInstance()->getWorldGuard()->addErroneousObject(getSharedThis(), CSWWorldGuard::FATAL);
           std::stringstream ss;
           ss << getName() << "::processEvent() causes critical processor load (" 
-              << fAvgTime*1000.0 << "ms)";
-          CSWLog::getInstance()->log(ss.str());
+              << getCPUAccount()->getAverageTime(CSWCPUAccount::PROCESS_EVENT)*1000.0 << "ms)";
+          CSWLog::getInstance()->log(getName(), ss.str());
         }
       }
       catch (...)
       {
         CSWWorld::getInstance()->getWorldGuard()->addErroneousObject(getSharedThis(), CSWWorldGuard::FATAL);
-        CSWLog::getInstance()->log(getName() + "::processEvent() throws an exception");
+        CSWLog::getInstance()->log(getName(), getName() + "::processEvent() throws an exception");
         PyErr_Print();
       }
       //PyEval_ReleaseThread(state);
@@ -437,7 +442,7 @@ namespace CodeSubWars
         {
           //on exception this object is not added to erroneous objects because finalize is only called before destruction 
           //of the object. that means the object is already in removing "process".
-          CSWLog::getInstance()->log(getName() + "::finalize() throws an exception");
+          CSWLog::getInstance()->log(getName(), getName() + "::finalize() throws an exception");
           PyErr_Print();
         }
       }
@@ -455,9 +460,47 @@ namespace CodeSubWars
     }
 
 
-    static const int NUM_CYCLES = 100;  
-    boost::circular_buffer<double> m_UpdateTimes;
-    boost::circular_buffer<double> m_ProcessEventTimes;
+    virtual std::string getPickledState()
+    {
+      auto lck = getPythonContext()->makeCurrent();
+      try
+      {
+        if (boost::python::override getSnapshotState = this->get_override("getSnapshotState"))
+        {
+          boost::python::object pickled = boost::python::import("pickle").attr("dumps")(getSnapshotState());
+          char* pBuffer = NULL;
+          Py_ssize_t nSize = 0;
+          if (PyBytes_AsStringAndSize(pickled.ptr(), &pBuffer, &nSize) == 0)
+            return std::string(pBuffer, nSize);
+        }
+      }
+      catch (...)
+      {
+        CSWLog::getInstance()->log(getName(), getName() + "::getSnapshotState() throws an exception");
+        PyErr_Print();
+      }
+      return std::string();
+    }
+
+
+    virtual void setPickledState(const std::string& strState)
+    {
+      auto lck = getPythonContext()->makeCurrent();
+      try
+      {
+        if (boost::python::override setSnapshotState = this->get_override("setSnapshotState"))
+        {
+          boost::python::object pickled(boost::python::handle<>(PyBytes_FromStringAndSize(strState.data(), strState.size())));
+          setSnapshotState(boost::python::import("pickle").attr("loads")(pickled));
+        }
+      }
+      catch (...)
+      {
+        CSWWorld::getInstance()->getWorldGuard()->addErroneousObject(getSharedThis(), CSWWorldGuard::FATAL);
+        CSWLog::getInstance()->log(getName(), getName() + "::setSnapshotState() throws an exception");
+        PyErr_Print();
+      }
+    }
   };
 
 }
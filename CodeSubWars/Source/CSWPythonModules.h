@@ -0,0 +1,21 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#pragma once
+
+
+namespace CodeSubWars
+{
+
+  /**
+   * Registers the CodeSubWars python modules with the interpreter. This must be done once before the interpreter is
+   * initialized, by the gui as well as by the headless runner.
+   */
+  class CSWPythonModules
+  {
+    public:
+      static void registerModules();
+  };
+
+}
\ No newline at end of file
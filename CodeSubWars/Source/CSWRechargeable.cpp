@@ -2,8 +2,9 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWRechargeable.h"
+#include "CSWObjectPool.h"
 #include "CSWWorld.h"
 #include "CSWObject.h"
 #include "CSWIRechargeable.h"
@@ -15,7 +16,7 @@ namespace CodeSubWars
 
   CSWRechargeable::PtrType CSWRechargeable::create(const unsigned long& nAcceptedResourceIDs)
   {
-    return PtrType(new CSWRechargeable(nAcceptedResourceIDs));
+    return CSWObjectPool::create<CSWRechargeable>([&](void* pBlock) { return new (pBlock) CSWRechargeable(nAcceptedResourceIDs); });
   }
 
 
@@ -42,8 +43,8 @@ namespace CodeSubWars
     if (getRechargingIDs())
       return getRechargingIDs();
 
-    ARSTD::Element::PtrType pFoundElement = ARSTD::Element::findElement(CSWWorld::getInstance()->getObjectTree(), strResourceProvider);
-    CSWIResourceProvider::PtrType pResourceProvider = std::dynamic_pointer_cast<CSWIResourceProvider>(pFoundElement);
+    CSWObject::PtrType pFoundObject = CSWWorld::getInstance()->getObject(strResourceProvider);
+    CSWIResourceProvider::PtrType pResourceProvider = std::dynamic_pointer_cast<CSWIResourceProvider>(pFoundObject);
     if (pResourceProvider && std::dynamic_pointer_cast<CSWIRechargeable>(pRechargeable))
     {
       m_nRechargingIDs = pResourceProvider->requestRecharge(pRechargeable, nResourceIDs);
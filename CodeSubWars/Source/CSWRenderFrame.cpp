@@ -0,0 +1,176 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#include "CorePrecompiledHeader.h"
+#include "CSWRenderFrame.h"
+
+#include "CSWObject.h"
+#include "CSWCamera.h"
+#include "CSWISolid.h"
+#include "CSWIDamageable.h"
+#include "CSWWeapon.h"
+
+
+namespace CodeSubWars
+{
+
+  namespace
+  {
+    void collectEntry(CSWObject* pObject, CSWRenderFrame::Entry& entry, CSWRenderFrame& frame)
+    {
+      entry.pObject = pObject;
+      if (CSWISolid* pSolid = dynamic_cast<CSWISolid*>(pObject))
+      {
+        entry.bSolid = true;
+        entry.surfaceBoundingBox = pSolid->getSurfaceBoundingBox();
+        pSolid->collectRenderData(frame, entry);
+      }
+
+      //weapons have no health bar
+      CSWIDamageable* pDamageable = dynamic_cast<CSWIDamageable*>(pObject);
+      if (pDamageable && !dynamic_cast<CSWWeapon*>(pObject))
+        entry.fHealth = pDamageable->getHealth();
+
+      if (CSWCamera* pCamera = dynamic_cast<CSWCamera*>(pObject))
+        entry.fFieldOfView = pCamera->getFieldOfView();
+    }
+
+
+    void collectCameras(const CSWObject* pObject, CSWRenderFrame& frame)
+    {
+      ARSTD::Node::ChildConstRange range = pObject->getChildRange();
+      for (ARSTD::Node::ChildConstIterator it = range.first; it != range.second; ++it)
+      {
+        CSWObject* pChild = dynamic_cast<CSWObject*>(it->get());
+        if (!pChild)
+          continue;
+
+        if (dynamic_cast<CSWCamera*>(pChild))
+        {
+          //the transformation is calculated here since cameras are moved by the gui also if no battle is running
+          CSWRenderFrame::Entry entry;
+          entry.matWorldTransform = pChild->calcRootTObject();
+          entry.bDrawable = false;
+          collectEntry(pChild, entry, frame);
+          frame.objects.push_back(entry);
+        }
+        collectCameras(pChild, frame);
+      }
+    }
+  }
+
+
+  CSWRenderFrame::Entry::Entry()
+  : pObject(NULL),
+    nParent(-1),
+    bDrawable(true),
+    vecColor(1, 1, 1, 1),
+    bSolid(false),
+    fHealth(-1),
+    fFieldOfView(0)
+  {
+  }
+
+
+  CSWRenderFrame::Geometry::Geometry(Type type, const Matrix44D& matWorldTransform, double fSize)
+  : type(type),
+    matWorldTransform(matWorldTransform),
+    fSize(fSize)
+  {
+  }
+
+
+  CSWRenderFrame::CSWRenderFrame()
+  : fTime(0),
+    pSelectedObject(NULL),
+    pSelectedSolidObject(NULL)
+  {
+  }
+
+
+  void CSWRenderFrame::collect(CSWObject::PtrType pObjectTree, CSWObject::PtrType pSelectedObject,
+                               CSWObject::PtrType pSelectedSolidObject)
+  {
+    clear();
+    fTime = ARSTD::Time::getTime();
+    this->pSelectedObject = pSelectedObject.get();
+    this->pSelectedSolidObject = pSelectedSolidObject.get();
+    if (pSelectedObject)
+      strSelectedObjectName = pSelectedObject->getName();
+    if (!pObjectTree)
+      return;
+
+    Entry root;
+    root.matWorldTransform = pObjectTree->getWorldTransform();
+    collectEntry(pObjectTree.get(), root, *this);
+    objects.push_back(root);
+
+    CSWObject::ChildRange range = pObjectTree->getChildRange();
+    for (CSWObject::ChildIterator it = range.first; it != range.second; ++it)
+    {
+      CSWObject* pChild = dynamic_cast<CSWObject*>(it->get());
+      if (!pChild)
+        continue;
+
+      Entry entry;
+      entry.matWorldTransform = dynamic_cast<CSWCamera*>(pChild) ? pChild->calcRootTObject() : pChild->getWorldTransform();
+      entry.nParent = 0;
+      collectEntry(pChild, entry, *this);
+      objects.push_back(entry);
+    }
+
+    //the children of the first level are already contained
+    for (size_t i = 1, nNumDrawables = objects.size(); i < nNumDrawables; ++i)
+      collectCameras(objects[i].pObject, *this);
+  }
+
+
+  void CSWRenderFrame::clear()
+  {
+    objects.clear();
+    pSelectedObject = NULL;
+    pSelectedSolidObject = NULL;
+    strSelectedObjectName.clear();
+    geometries.clear();
+    meshGeometries.clear();
+    explosions.clear();
+    sounds.clear();
+  }
+
+
+  const CSWRenderFrame::Entry* CSWRenderFrame::find(const CSWObject* pObject) const
+  {
+    ObjectContainer::const_iterator it = objects.begin();
+    for (; it != objects.end(); ++it)
+    {
+      if (it->pObject == pObject)
+        return &*it;
+    }
+    return NULL;
+  }
+
+
+  void CSWRenderFrame::addGeometry(const Geometry& geometry)
+  {
+    if (!geometry.vertices.empty() && !geometry.colors.empty())
+      geometries.push_back(geometry);
+  }
+
+
+  void CSWRenderFrame::addMeshGeometry(const Mesh::PtrType pMesh, const Matrix44D& matWorldTransform,
+                                       const Vector4D& vecColor, MeshGeometry::Mode mode, double fSize)
+  {
+    if (!pMesh)
+      return;
+
+    MeshGeometry geometry;
+    geometry.pMesh = pMesh;
+    geometry.matWorldTransform = matWorldTransform;
+    geometry.vecColor = vecColor;
+    geometry.mode = mode;
+    geometry.fSize = fSize;
+    meshGeometries.push_back(geometry);
+  }
+
+}
\ No newline at end of file
@@ -0,0 +1,120 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#pragma once
+
+
+namespace CodeSubWars
+{
+
+  class CSWObject;
+
+  /**
+   * Everything the scene views need to draw one state of the world. It is filled by the simulation thread after each
+   * step and handed over to the gui by CSWWorld without a lock. The frame only holds copies and the immutable meshes
+   * of the objects, so drawing never touches the objects themselves.
+   */
+  struct CSWRenderFrame
+  {
+    struct Entry
+    {
+      Entry();
+
+      //identifies the object for lookups, it is never dereferenced since the object may be destroyed meanwhile
+      const CSWObject* pObject;
+      Matrix44D matWorldTransform;
+      //index of the parent entry or -1
+      int nParent;
+      //false for the cameras below the first tree level which are only needed to setup the views
+      bool bDrawable;
+      //the drawn surface and its color, null for invisible objects
+      Mesh::PtrType pSurface;
+      Vector4D vecColor;
+      //true for solid objects, the bounding box of their surface is given in the local coordsystem
+      bool bSolid;
+      BoundingBoxD surfaceBoundingBox;
+      //between 0 and 1, negative if no health bar is drawn
+      double fHealth;
+      //only set for cameras
+      double fFieldOfView;
+    };
+
+    /**
+     * Unlit debugging geometry like force lines and sonar scans. The vertices are given relative to the transform.
+     */
+    struct Geometry
+    {
+      enum Type
+      {
+        POINTS,
+        LINES,
+        TRIANGLES,
+        TRIANGLE_FAN
+      };
+
+      Geometry(Type type = LINES, const Matrix44D& matWorldTransform = Matrix44D(), double fSize = 1);
+
+      Type type;
+      Matrix44D matWorldTransform;
+      std::vector<Vector3D> vertices;
+      //one color for each vertex or one for all
+      std::vector<Vector4D> colors;
+      //point size or line width
+      double fSize;
+    };
+
+    /**
+     * Unlit debugging mesh like a collision mesh or mass points.
+     */
+    struct MeshGeometry
+    {
+      enum Mode
+      {
+        FILL,
+        WIREFRAME,
+        POINTS
+      };
+
+      Mesh::PtrType pMesh;
+      Matrix44D matWorldTransform;
+      Vector4D vecColor;
+      Mode mode;
+      //point size or line width
+      double fSize;
+    };
+
+    typedef std::vector<Entry> ObjectContainer;
+    typedef std::vector<Geometry> GeometryContainer;
+    typedef std::vector<MeshGeometry> MeshGeometryContainer;
+
+    CSWRenderFrame();
+
+    /**
+     * Replaces the content with the current state of the world. The root and its direct children are drawn,
+     * cameras are collected from the whole tree.
+     */
+    void collect(std::shared_ptr<CSWObject> pObjectTree, std::shared_ptr<CSWObject> pSelectedObject,
+                 std::shared_ptr<CSWObject> pSelectedSolidObject);
+
+    void clear();
+
+    const Entry* find(const CSWObject* pObject) const;
+
+    void addGeometry(const Geometry& geometry);
+    void addMeshGeometry(const Mesh::PtrType pMesh, const Matrix44D& matWorldTransform, const Vector4D& vecColor,
+                         MeshGeometry::Mode mode, double fSize = 1);
+
+    double fTime;
+    ObjectContainer objects;
+    const CSWObject* pSelectedObject;
+    const CSWObject* pSelectedSolidObject;
+    std::string strSelectedObjectName;
+    GeometryContainer geometries;
+    MeshGeometryContainer meshGeometries;
+    //transforms and colors of unit spheres
+    Mesh::InstanceContainer explosions;
+    Mesh::InstanceContainer sounds;
+  };
+
+}
\ No newline at end of file
@@ -0,0 +1,356 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#include "PrecompiledHeader.h"
+#include "CSWReplayRenderApplication.h"
+#include "Constants.h"
+#include "CSWLog.h"
+#include "CSWReplayRenderer.h"
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#endif
+
+
+namespace CodeSubWars
+{
+
+  CSWReplayRenderApplication::CSWReplayRenderApplication(int argc, char** argv)
+  : m_nArgc(argc),
+    m_pArgv(argv),
+    m_bParametersValid(true),
+    m_Format(PNG),
+    m_nWidth(1280),
+    m_nHeight(720),
+    m_fFramesPerSecond(25),
+    m_fTimeRatio(1),
+    m_nSamples(4)
+  {
+    int nReadData = 0;
+    for (int i = 0; i < argc - 1 && m_bParametersValid; ++i)
+    {
+      std::pair<ParameterType, std::string> result = determineParameterType(argv[i + 1]);
+      switch (result.first)
+      {
+        case UNKNOWN:
+        {
+          m_bParametersValid = false;
+          break;
+        }
+        case RUNNING_MODE:
+        {
+          m_strRecordFileName = result.second;
+          m_bParametersValid &= !m_strRecordFileName.empty();
+          break;
+        }
+        case OUTPUT_TYPE:
+        {
+          m_strOutput = result.second;
+          m_bParametersValid &= !m_strOutput.empty();
+          break;
+        }
+        case FORMAT_TYPE:
+        {
+          if (result.second == "png")
+            m_Format = PNG;
+          else if (result.second == "raw")
+            m_Format = RAW;
+          else
+            m_bParametersValid = false;
+          break;
+        }
+        case WIDTH_TYPE:
+        {
+          int t = atoi(result.second.c_str());
+          if (t >= 16 && t <= 8192)
+            m_nWidth = t;
+          else
+            m_bParametersValid = false;
+          break;
+        }
+        case HEIGHT_TYPE:
+        {
+          int t = atoi(result.second.c_str());
+          if (t >= 16 && t <= 8192)
+            m_nHeight = t;
+          else
+            m_bParametersValid = false;
+          break;
+        }
+        case FPS_TYPE:
+        {
+          double t = atof(result.second.c_str());
+          if (t > 0 && t <= 1000)
+            m_fFramesPerSecond = t;
+          else
+            m_bParametersValid = false;
+          break;
+        }
+        case TIMERATIO_TYPE:
+        {
+          double t = atof(result.second.c_str());
+          if (t > 0)
+            m_fTimeRatio = t;
+          else
+            m_bParametersValid = false;
+          break;
+        }
+        case SAMPLES_TYPE:
+        {
+          int t = atoi(result.second.c_str());
+          if (t >= 0 && t <= 16)
+            m_nSamples = t;
+          else
+            m_bParametersValid = false;
+          break;
+        }
+      }
+      nReadData |= result.first;
+    }
+
+    //at least running mode must given
+    m_bParametersValid &= (nReadData & RUNNING_MODE) != 0;
+
+    if (m_strOutput.empty())
+      m_strOutput = m_Format == PNG ? "replay" : "replay.rgb";
+  }
+
+
+  CSWReplayRenderApplication::~CSWReplayRenderApplication()
+  {
+  }
+
+
+  int CSWReplayRenderApplication::run()
+  {
+    //the frames may be streamed to the standard output, so all messages go to the error output
+    std::cerr << "CodeSubWars v" << Constants::getVersion().getAsString() << " beta\n";
+    std::cerr << "Copyright (c) 2005-2022 " << Constants::AUTHOR << ". All rights reserved.\n";
+    std::cerr << "Released under the MIT license. (see license.txt)\n\n";
+
+    if (!m_bParametersValid)
+    {
+      showSyntax();
+      return 2;
+    }
+
+    CSWLog::getInstance()->setLogOutput([](const std::string& str) { std::cerr << str << "\n"; });
+    CSWLog::getInstance()->log("starting in render mode ...");
+
+    CSWBRImporter::TimeSliceDataContainer dataContainer;
+    int nResult = 1;
+    if (!CSWBRImporter::loadREC(QString::fromStdString(m_strRecordFileName), dataContainer) || dataContainer.empty())
+      CSWLog::getInstance()->log("could not read battle record " + m_strRecordFileName);
+    else
+      nResult = renderFrames(dataContainer);
+
+    CSWLog::getInstance()->resetLogOutput();
+    return nResult;
+  }
+
+
+  int CSWReplayRenderApplication::renderFrames(const CSWBRImporter::TimeSliceDataContainer& dataContainer)
+  {
+    QGuiApplication app(m_nArgc, m_pArgv);
+
+    QSurfaceFormat format;
+    format.setDepthBufferSize(24);
+    format.setProfile(QSurfaceFormat::CompatibilityProfile);
+
+    QOffscreenSurface surface;
+    surface.setFormat(format);
+    surface.create();
+
+    QOpenGLContext context;
+    context.setFormat(format);
+    if (!surface.isValid() || !context.create() || !context.makeCurrent(&surface))
+    {
+      CSWLog::getInstance()->log("could not create an offscreen opengl context");
+      return 1;
+    }
+
+    QOpenGLFramebufferObjectFormat fboFormat;
+    fboFormat.setAttachment(QOpenGLFramebufferObject::Depth);
+    fboFormat.setSamples(m_nSamples);
+    QOpenGLFramebufferObject fbo(m_nWidth, m_nHeight, fboFormat);
+    if (!fbo.isValid())
+    {
+      CSWLog::getInstance()->log("could not create a framebuffer object of the requested size");
+      return 1;
+    }
+
+    FILE* pRawFile = NULL;
+    if (m_Format == RAW)
+    {
+      if (m_strOutput == "-")
+      {
+#ifdef _WIN32
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+        pRawFile = stdout;
+      }
+      else
+      {
+        pRawFile = fopen(m_strOutput.c_str(), "wb");
+      }
+    }
+    else
+    {
+      ARSTD::FileSystem::createDirectory(m_strOutput);
+    }
+    if (m_Format == RAW && !pRawFile)
+    {
+      CSWLog::getInstance()->log("could not open " + m_strOutput);
+      return 1;
+    }
+
+    //same state as the views set up for their contexts
+    fbo.bind();
+    glViewport(0, 0, m_nWidth, m_nHeight);
+    glClearColor(0, 0, 0, 0);
+    glEnable(GL_LINE_SMOOTH);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glHint(GL_LINE_SMOOTH_HINT, GL_DONT_CARE);
+    glShadeModel(GL_FLAT);
+
+    CSWReplayRenderer::PtrType pRenderer = CSWReplayRenderer::create();
+    Matrix44D matWorldTCamera = CSWReplayRenderer::getOverviewCameraTransform();
+    double fAspectRatio = static_cast<double>(m_nWidth)/m_nHeight;
+
+    double fStartTime = dataContainer.front().first;
+    double fTimeStep = m_fTimeRatio/m_fFramesPerSecond;
+    int nNumFrames = static_cast<int>((dataContainer.back().first - fStartTime)/fTimeStep) + 1;
+
+    std::stringstream ss;
+    ss << "rendering " << nNumFrames << " frames of " << m_nWidth << "x" << m_nHeight << " to " << m_strOutput << " ...";
+    CSWLog::getInstance()->log(ss.str());
+
+    //a frame is written while the next one is rendered
+    std::future<bool> writtenFrame;
+    bool bSucceeded = true;
+    double fStartRealTime = ARSTD::Time::getRealTime();
+    CSWBRImporter::TimeSliceData data;
+    int nFrame = 0;
+    for (; nFrame < nNumFrames && bSucceeded; ++nFrame)
+    {
+      CSWBRImporter::interpolate(dataContainer, fStartTime + nFrame*fTimeStep, data);
+
+      fbo.bind();
+      glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+      CSWReplayRenderer::setupCameraAndLight(matWorldTCamera, 45, fAspectRatio);
+      pRenderer->draw(data);
+      QImage image = fbo.toImage().convertToFormat(QImage::Format_RGB888);
+
+      if (writtenFrame.valid())
+        bSucceeded = writtenFrame.get();
+
+      if (m_Format == RAW)
+      {
+        writtenFrame = std::async(std::launch::async, [image, pRawFile]()
+        {
+          size_t nLineSize = static_cast<size_t>(image.width())*3;
+          for (int y = 0; y < image.height(); ++y)
+          {
+            if (fwrite(image.constScanLine(y), 1, nLineSize, pRawFile) != nLineSize)
+              return false;
+          }
+          return true;
+        });
+      }
+      else
+      {
+        QString strFileName = QString("%1/frame_%2.png").arg(QString::fromStdString(m_strOutput)).arg(nFrame, 6, 10, QChar('0'));
+        writtenFrame = std::async(std::launch::async, [image, strFileName]() { return image.save(strFileName, "PNG"); });
+      }
+    }
+    if (writtenFrame.valid())
+      bSucceeded &= writtenFrame.get();
+    double fRealTime = ARSTD::Time::getRealTime() - fStartRealTime;
+
+    fbo.release();
+    context.doneCurrent();
+    if (pRawFile && pRawFile != stdout)
+      fclose(pRawFile);
+    else if (pRawFile)
+      fflush(pRawFile);
+
+    if (!bSucceeded)
+    {
+      CSWLog::getInstance()->log("could not write frame to " + m_strOutput);
+      return 1;
+    }
+
+    ss.str("");
+    ss << "rendered " << nFrame << " frames in " << fRealTime << "s (" << nFrame/std::max(fRealTime, 0.001) << " frames/s)";
+    CSWLog::getInstance()->log(ss.str());
+    return 0;
+  }
+
+
+  std::pair<CSWReplayRenderApplication::ParameterType, std::string> CSWReplayRenderApplication::determineParameterType(const std::string& value)
+  {
+    std::pair<ParameterType, std::string> result(UNKNOWN, "");
+    if (value.size() <= 2)
+      return result;
+    if (value[0] != '-')
+      return result;
+
+    const std::pair<std::string, ParameterType> KEYS[] =
+    {
+      std::make_pair(std::string("render"), RUNNING_MODE),
+      std::make_pair(std::string("output"), OUTPUT_TYPE),
+      std::make_pair(std::string("format"), FORMAT_TYPE),
+      std::make_pair(std::string("width"), WIDTH_TYPE),
+      std::make_pair(std::string("height"), HEIGHT_TYPE),
+      std::make_pair(std::string("fps"), FPS_TYPE),
+      std::make_pair(std::string("timeratio"), TIMERATIO_TYPE),
+      std::make_pair(std::string("samples"), SAMPLES_TYPE)
+    };
+
+    for (size_t i = 0; i < sizeof(KEYS)/sizeof(KEYS[0]); ++i)
+    {
+      if (value.compare(1, KEYS[i].first.size() + 1, KEYS[i].first + "=") == 0)
+      {
+        result.first = KEYS[i].second;
+        result.second = value.substr(KEYS[i].first.size() + 2);
+        return result;
+      }
+    }
+
+    return result;
+  }
+
+
+  void CSWReplayRenderApplication::showSyntax()
+  {
+    std::cerr << "Renders a battle record offscreen to a png sequence or a raw video stream.\n";
+    std::cerr << "\n";
+    std::cerr << "Syntax: CodeSubWars -render=file [-output=path] [-format=<png|raw>] [-width=n] [-height=n] [-fps=x]\n";
+    std::cerr << "                    [-timeratio=x] [-samples=n]\n";
+    std::cerr << "\n";
+    std::cerr << "  -render     The battle record (.br) that should be rendered. The other parameters are only valid\n";
+    std::cerr << "              when this is set.\n";
+    std::cerr << "\n";
+    std::cerr << "  -output     For png the directory the frames are written to as frame_<number>.png. Default is replay.\n";
+    std::cerr << "              For raw the file the frames are written to or - for the standard output. Default is\n";
+    std::cerr << "              replay.rgb.\n";
+    std::cerr << "\n";
+    std::cerr << "  -format     png writes one image per frame. raw writes the frames as rgb24 from top to bottom without\n";
+    std::cerr << "              header, e.g. for ffmpeg -f rawvideo -pix_fmt rgb24 -s <width>x<height> -r <fps> -i -.\n";
+    std::cerr << "              Default is png.\n";
+    std::cerr << "\n";
+    std::cerr << "  -width      The width of the frames in pixels. Must be in range [16, 8192]. Default is 1280.\n";
+    std::cerr << "\n";
+    std::cerr << "  -height     The height of the frames in pixels. Must be in range [16, 8192]. Default is 720.\n";
+    std::cerr << "\n";
+    std::cerr << "  -fps        The frames per second of the video. Default is 25.\n";
+    std::cerr << "\n";
+    std::cerr << "  -timeratio  The battle time in seconds shown in one second of video. Default is 1.\n";
+    std::cerr << "\n";
+    std::cerr << "  -samples    The number of samples per pixel for antialiasing. Must be in range [0, 16]. Default is 4.\n";
+  }
+
+}
\ No newline at end of file
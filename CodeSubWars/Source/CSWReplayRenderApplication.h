@@ -0,0 +1,75 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#pragma once
+
+#include "IO/CSWBRImporter.h"
+
+
+namespace CodeSubWars
+{
+
+  /**
+   * Renders a battle record offscreen into a png sequence or a raw rgb video stream without showing a window. The
+   * frames are taken at a fixed rate from the interpolated record and drawn as fast as possible, so many records can
+   * be reviewed without a window. On linux the qt platform is selected with QT_QPA_PLATFORM. The offscreen platform
+   * creates its opengl context via glx, so it still needs an x server; on machines without display run it in a
+   * virtual one (e.g. xvfb-run) or use a platform with egl contexts (e.g. eglfs on a kms device).
+   */
+  class CSWReplayRenderApplication
+  {
+    public:
+
+      CSWReplayRenderApplication(int argc, char** argv);
+      ~CSWReplayRenderApplication();
+
+      /**
+       * Renders all frames of the record.
+       * @return Returns 0 on success, 1 if the record could not be read or rendered and 2 if the parameters are
+       *         invalid.
+       */
+      int run();
+
+    protected:
+      enum ParameterType
+      {
+        UNKNOWN = 0,
+        RUNNING_MODE = 1,
+        OUTPUT_TYPE = 2,
+        FORMAT_TYPE = 4,
+        WIDTH_TYPE = 8,
+        HEIGHT_TYPE = 16,
+        FPS_TYPE = 32,
+        TIMERATIO_TYPE = 64,
+        SAMPLES_TYPE = 128
+      };
+
+      enum FormatType
+      {
+        PNG = 0,
+        RAW = 1
+      };
+
+      int renderFrames(const CSWBRImporter::TimeSliceDataContainer& dataContainer);
+
+      std::pair<ParameterType, std::string> determineParameterType(const std::string& value);
+
+      void showSyntax();
+
+      //qt keeps references to the arguments as long as the application exists
+      int m_nArgc;
+      char** m_pArgv;
+
+      bool m_bParametersValid;
+      std::string m_strRecordFileName;
+      std::string m_strOutput;
+      FormatType m_Format;
+      int m_nWidth;
+      int m_nHeight;
+      double m_fFramesPerSecond;
+      double m_fTimeRatio;
+      int m_nSamples;
+  };
+
+}
\ No newline at end of file
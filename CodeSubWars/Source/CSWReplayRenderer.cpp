@@ -0,0 +1,156 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#include "PrecompiledHeader.h"
+#include "CSWWorld.h"
+#include "CSWReplayRenderer.h"
+
+
+namespace CodeSubWars
+{
+
+  CSWReplayRenderer::PtrType CSWReplayRenderer::create()
+  {
+    return PtrType(new CSWReplayRenderer());
+  }
+
+
+  CSWReplayRenderer::~CSWReplayRenderer()
+  {
+  }
+
+
+  Matrix44D CSWReplayRenderer::getOverviewCameraTransform()
+  {
+    return Matrix44D(Vector3D(1, 0, 0),
+                     Vector3D(0, 0, 1),
+                     Vector3D(0, -1, 0),
+                     Vector3D(0, 2300, 0));
+  }
+
+
+  void CSWReplayRenderer::setupCameraAndLight(const Matrix44D& matWorldTCamera, double fFieldOfView, double fAspectRatio)
+  {
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    gluPerspective(fFieldOfView, fAspectRatio, 1, 20000);
+
+    Vector3D vecPos(matWorldTCamera.getTranslation());
+    Vector3D vecDir(matWorldTCamera.getZAxis());       
+    Vector3D vecUp(matWorldTCamera.getYAxis());
+  
+    gluLookAt(vecPos.x, vecPos.y, vecPos.z, 
+              vecPos.x + vecDir.x, vecPos.y + vecDir.y, vecPos.z + vecDir.z, 
+              vecUp.x, vecUp.y, vecUp.z);
+
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+  
+    GLfloat lightPosition[] = {static_cast<GLfloat>(vecPos.x), static_cast<GLfloat>(vecPos.y), static_cast<GLfloat>(vecPos.z), 1.0f};
+    glLightfv(GL_LIGHT0, GL_POSITION, lightPosition);
+    glLightfv(GL_LIGHT0, GL_DIFFUSE, Vector4F(1, 1, 1, 1).pData);
+  }
+
+
+  void CSWReplayRenderer::draw(const CSWBRImporter::TimeSliceData& data)
+  {
+    glPushAttrib(GL_ALL_ATTRIB_BITS);
+      glShadeModel(GL_SMOOTH);
+
+      glEnable(GL_LIGHTING);
+      glEnable(GL_LIGHT0);
+
+      glPolygonMode(GL_FRONT, GL_FILL);
+
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+      glEnable(GL_BLEND);
+
+      glColorMaterial(GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
+      glEnable(GL_COLOR_MATERIAL);
+
+      glDepthFunc(GL_LESS);
+      glEnable(GL_DEPTH_TEST);
+
+      m_BoxInstances.clear();
+      m_BoxInstances.reserve(data.size());
+      CSWBRImporter::TimeSliceData::const_iterator it = data.begin();
+      CSWBRImporter::TimeSliceData::const_iterator itEnd = data.end();
+      for (; it != itEnd; ++it)
+      {
+        if (it->second.strName.find("envBorder") == std::string::npos)
+        {
+          ARSTD::OpenGLTools::paintTripod(it->second.matWorldTObject, 30);
+
+          const Size3D& size = it->second.size;
+          Matrix44D matScale(Vector3D(size.getWidth(), 0, 0), Vector3D(0, size.getHeight(), 0), 
+                             Vector3D(0, 0, size.getDepth()), Vector3D(0, 0, 0));
+          Mesh::Instance instance;
+          instance.matTransform = Matrix44F(it->second.matWorldTObject*matScale);
+          instance.vecColor = Vector4F(it->second.color);
+          m_BoxInstances.push_back(instance);
+        }
+      }
+      ARSTD::MeshRenderer::renderInstances(*m_pBox, m_BoxInstances);
+
+
+      //draw world cube
+      glPushAttrib(GL_ALL_ATTRIB_BITS);
+
+        glDisable(GL_CULL_FACE);
+
+        glEnable(GL_COLOR_MATERIAL);
+        glColorMaterial(GL_FRONT, GL_DIFFUSE);
+
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+        glShadeModel(GL_FLAT);
+        glDisable(GL_LIGHTING);
+        glColor4d(0, 0, 1, 0.2);
+
+        glEnable(GL_DEPTH_TEST);
+        glDepthMask(false);
+
+        BoundingBoxD bbox(Matrix44D(Vector3D(-CSWWorld::CUBE_SIZE.getDepth()/2 + CSWWorld::CUBE_THICKNESS, 
+                                             -CSWWorld::CUBE_SIZE.getHeight()/2 + CSWWorld::CUBE_THICKNESS, 
+                                             -CSWWorld::CUBE_SIZE.getDepth()/2 + CSWWorld::CUBE_THICKNESS)), 
+                          Size3D(CSWWorld::CUBE_SIZE.getWidth() - CSWWorld::CUBE_THICKNESS*2, 
+                                 CSWWorld::CUBE_SIZE.getHeight() - CSWWorld::CUBE_THICKNESS*2, 
+                                 CSWWorld::CUBE_SIZE.getDepth() - CSWWorld::CUBE_THICKNESS*2));
+
+        glBegin(GL_QUADS);
+          for (int iCnt = 0; iCnt < 6; ++iCnt) 
+          {
+            glVertex3dv(bbox.getRectangle(iCnt).getPoint0().pData);
+            glVertex3dv(bbox.getRectangle(iCnt).getPoint1().pData);
+            glVertex3dv(bbox.getRectangle(iCnt).getPoint2().pData);
+            glVertex3dv(bbox.getRectangle(iCnt).getPoint3().pData);
+          } 
+        glEnd();
+
+        glDisable(GL_LIGHTING);
+        glColor3d(0, 0, 1);
+        glLineWidth(2);
+        glBegin(GL_LINES);
+          for (int iCnt = 0; iCnt < 12; ++iCnt) 
+          {
+            glVertex3dv(bbox.getSegment(iCnt).getPoint1().pData);
+            glVertex3dv(bbox.getSegment(iCnt).getPoint2().pData);
+          } 
+        glEnd();
+        glDepthMask(true);
+      glPopAttrib();
+
+    glPopAttrib();
+  }
+
+
+  CSWReplayRenderer::CSWReplayRenderer()
+  : m_pBox(Mesh::createBox(Matrix44D(Vector3D(-0.5, -0.5, -0.5)), Size3D(1, 1, 1)))
+  {
+  }
+
+}
\ No newline at end of file
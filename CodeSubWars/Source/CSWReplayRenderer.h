@@ -0,0 +1,49 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#pragma once
+
+#include "IO/CSWBRImporter.h"
+
+
+namespace CodeSubWars
+{
+
+  /**
+   * Draws one time slice of a battle record into the current opengl context. It is used by the replay view and by
+   * the offscreen rendering of records, so both show the same picture.
+   */
+  class CSWReplayRenderer
+  {
+    public:
+      typedef std::shared_ptr<CSWReplayRenderer> PtrType;
+
+      static PtrType create();
+
+      ~CSWReplayRenderer();
+
+      /**
+       * @return The camera above the world looking down to its center that replays start with.
+       */
+      static Matrix44D getOverviewCameraTransform();
+
+      /**
+       * Sets the projection to look from the given camera and puts the light at its position.
+       */
+      static void setupCameraAndLight(const Matrix44D& matWorldTCamera, double fFieldOfView, double fAspectRatio);
+
+      /**
+       * Draws all objects of the time slice and the world cube with the current projection.
+       */
+      void draw(const CSWBRImporter::TimeSliceData& data);
+
+    protected:
+      CSWReplayRenderer();
+
+      //all objects are drawn as instances of one unit box scaled to their size
+      Mesh::PtrType m_pBox;
+      Mesh::InstanceContainer m_BoxInstances;
+  };
+
+}
\ No newline at end of file
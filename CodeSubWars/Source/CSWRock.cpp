@@ -2,8 +2,9 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWRock.h"
+#include "CSWShapeCache.h"
 
 
 namespace CodeSubWars
@@ -16,10 +17,10 @@ namespace CodeSubWars
 
   CSWRock::CSWRock(const std::string& strName, const Matrix44D& matBaseTObject, const Size3D& size)
   : CSWDamDynSolCol(strName, matBaseTObject, 
-                    Mesh::createBox(Matrix44D(Vector3D(-size.getWidth()/2.0, 
-                                                       -size.getHeight()/2.0, 
-                                                       -size.getDepth()/2.0)),
-                                    size),
+                    CSWShapeCache::getInstance()->getBoxMesh(Vector3D(-size.getWidth()/2.0, 
+                                                                      -size.getHeight()/2.0, 
+                                                                      -size.getDepth()/2.0),
+                                                             size),
                     true)
   {
     assert(size.getWidth() > 0 && size.getHeight() > 0 && size.getDepth() > 0);
@@ -2,8 +2,9 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWScanBox.h"
+#include "CSWShapeCache.h"
 
 namespace CodeSubWars
 {
@@ -34,8 +35,8 @@ namespace CodeSubWars
 
   CSWScanBox::CSWScanBox(const std::string& strName, const Matrix44D& matBaseTObject, 
                          const double& fEdgeLength)
-  : CSWTrigger(strName, matBaseTObject, Mesh::createBox(Matrix44D(Vector3D(-fEdgeLength*0.5, -fEdgeLength*0.5, -fEdgeLength*0.5)),
-                                                        Size3D(fEdgeLength, fEdgeLength, fEdgeLength)))
+  : CSWTrigger(strName, matBaseTObject, CSWShapeCache::getInstance()->getBoxMesh(Vector3D(-fEdgeLength*0.5, -fEdgeLength*0.5, -fEdgeLength*0.5),
+                                                                                 Size3D(fEdgeLength, fEdgeLength, fEdgeLength)))
   {
   }
 
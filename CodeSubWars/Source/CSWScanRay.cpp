@@ -2,8 +2,10 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWScanRay.h"
+#include "CSWObjectPool.h"
+#include "CSWShapeCache.h"
 
 namespace CodeSubWars
 {
@@ -11,7 +13,7 @@ namespace CodeSubWars
   CSWScanRay::PtrType CSWScanRay::create(const std::string& strName, const Matrix44D& matBaseTObject, 
                                          const double& fLength)
   {
-    return PtrType(new CSWScanRay(strName, matBaseTObject, fLength));
+    return CSWObjectPool::create<CSWScanRay>([&](void* pBlock) { return new (pBlock) CSWScanRay(strName, matBaseTObject, fLength); });
   }
 
 
@@ -59,8 +61,8 @@ namespace CodeSubWars
 
   CSWScanRay::CSWScanRay(const std::string& strName, const Matrix44D& matBaseTObject, 
                          const double& fLength)
-  : CSWTrigger(strName, matBaseTObject, Mesh::createBox(Matrix44D(Vector3D(-0.5, -0.5, 0)),
-                                                        Size3D(1, 1, fLength))),
+  : CSWTrigger(strName, matBaseTObject, CSWShapeCache::getInstance()->getBoxMesh(Vector3D(-0.5, -0.5, 0),
+                                                                                 Size3D(1, 1, fLength))),
     m_fLength(fLength)
   {
   }
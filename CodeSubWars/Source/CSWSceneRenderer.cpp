@@ -0,0 +1,461 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#include "PrecompiledHeader.h"
+#include "CSWSceneRenderer.h"
+#include "Constants.h"
+#include "CSWWorld.h"
+#include "CSWSettings.h"
+
+
+namespace CodeSubWars
+{
+
+  GLubyte CSWSceneRenderer::m_Border[20] = {0xff, 0xff, 0xff, 0xff, 0xff,
+                                            0x80, 0x00, 0x00, 0x00, 0x40,
+                                            0x80, 0x00, 0x00, 0x00, 0x40,
+                                            0xff, 0xff, 0xff, 0xff, 0xff};
+
+
+  CSWSceneRenderer::PtrType CSWSceneRenderer::create()
+  {
+    return PtrType(new CSWSceneRenderer());
+  }
+
+
+  CSWSceneRenderer::~CSWSceneRenderer()
+  {
+  }
+
+
+  void CSWSceneRenderer::draw(const CSWRenderFrame& frame)
+  {
+    if (frame.objects.empty())
+      return;
+
+    CSWRenderFrame::ObjectContainer::const_iterator itEntry = frame.objects.begin();
+    for (; itEntry != frame.objects.end(); ++itEntry)
+    {
+      if (!itEntry->bDrawable)
+        continue;
+
+      drawEntry(frame, *itEntry);
+      if (itEntry->pSurface)
+        m_pMeshBatch->add(itEntry->pSurface, Matrix44F(itEntry->matWorldTransform), Vector4F(itEntry->vecColor));
+    }
+
+    drawGeometries(frame);
+
+    glPushAttrib(GL_ALL_ATTRIB_BITS);
+      setupMaterial();
+      m_pMeshBatch->render();
+    glPopAttrib();
+
+    drawWorldCube();
+
+    for (itEntry = frame.objects.begin(); itEntry != frame.objects.end(); ++itEntry)
+    {
+      if (itEntry->bDrawable)
+        drawOverlay(frame, *itEntry);
+    }
+
+    drawSpheres(frame.explosions, false);
+    drawSpheres(frame.sounds, true);
+  }
+
+
+  void CSWSceneRenderer::setupMaterial()
+  {
+    glShadeModel(GL_SMOOTH);
+
+    glEnable(GL_LIGHTING);
+    glEnable(GL_LIGHT0);
+
+    glPolygonMode(GL_FRONT, GL_FILL);
+
+    glCullFace(GL_BACK);    
+    glEnable(GL_CULL_FACE);
+
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glEnable(GL_BLEND);
+
+    glColorMaterial(GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
+    glEnable(GL_COLOR_MATERIAL);
+
+    glDepthFunc(GL_LESS);
+    glEnable(GL_DEPTH_TEST);
+  }
+
+
+  CSWSceneRenderer::CSWSceneRenderer()
+  : m_pMeshBatch(MeshBatch::create()),
+    m_pSphere(Mesh::createEllipsoid(Matrix44D(), Vector3D(2, 2, 2), 10, 10, 0, 10))
+  {
+  }
+
+
+  void CSWSceneRenderer::drawEntry(const CSWRenderFrame& frame, const CSWRenderFrame::Entry& entry)
+  {
+    if (CSWWorld::getInstance()->getSettings()->getVariousProperties() & CSWSettings::DISPLAY_OBJECT_TREE)
+    {
+      if (entry.nParent >= 0)
+      {
+        //"debuging" line that connects child with parent
+        glPushAttrib(GL_ALL_ATTRIB_BITS);
+          glDisable(GL_LIGHTING);
+          glShadeModel(GL_SMOOTH);
+          glLineWidth(1);
+          glColor3f(1.0, 0.0, 0.0); 
+          glBegin(GL_LINES);
+            glVertex3dv(frame.objects[entry.nParent].matWorldTransform.getTranslation().pData);
+            glVertex3dv(entry.matWorldTransform.getTranslation().pData);
+          glEnd();
+        glPopAttrib();
+      }
+    }
+
+    if (frame.pSelectedObject != entry.pObject && frame.pSelectedSolidObject != entry.pObject)
+      return;
+
+    glPushAttrib(GL_ALL_ATTRIB_BITS);
+      Size3D objSize(10, 10, 10);
+      if (entry.bSolid)
+        objSize = entry.surfaceBoundingBox.getSize()*1.5;
+
+      if (frame.pSelectedObject == entry.pObject)
+      {
+        glDisable(GL_DEPTH_TEST);
+        double fTripodLength = std::max(std::max(objSize.getWidth(), objSize.getHeight()), objSize.getDepth())*0.1;
+        ARSTD::OpenGLTools::paintTripod(entry.matWorldTransform, fTripodLength);
+      }
+
+      if (frame.pSelectedSolidObject == entry.pObject)
+      {
+        glEnable(GL_DEPTH_TEST);
+        ARSTD::OpenGLTools::paintHighLightBox(entry.matWorldTransform, objSize, Vector4D(1, 0.9, 0, 0.6));
+      }
+    glPopAttrib();
+  }
+
+
+  void CSWSceneRenderer::drawGeometries(const CSWRenderFrame& frame)
+  {
+    if (frame.geometries.empty() && frame.meshGeometries.empty())
+      return;
+
+    //for debugging only
+    glPushAttrib(GL_ALL_ATTRIB_BITS);
+      glMatrixMode(GL_MODELVIEW);
+      glPushMatrix();
+
+      glDisable(GL_LIGHTING);
+      glEnable(GL_BLEND);
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+      glDisable(GL_CULL_FACE);
+      glShadeModel(GL_SMOOTH);
+
+      glDepthMask(false);
+      glEnable(GL_DEPTH_TEST);
+
+      CSWRenderFrame::MeshGeometryContainer::const_iterator itMesh = frame.meshGeometries.begin();
+      for (; itMesh != frame.meshGeometries.end(); ++itMesh)
+      {
+        glLoadMatrixd(itMesh->matWorldTransform.pData);
+        glPolygonMode(GL_FRONT_AND_BACK, itMesh->mode == CSWRenderFrame::MeshGeometry::FILL ? GL_FILL : 
+                                         itMesh->mode == CSWRenderFrame::MeshGeometry::WIREFRAME ? GL_LINE : GL_POINT);
+        glPointSize(static_cast<GLfloat>(itMesh->fSize));
+        glLineWidth(static_cast<GLfloat>(itMesh->fSize));
+        glColor4dv(itMesh->vecColor.pData);
+        ARSTD::MeshRenderer::render(*itMesh->pMesh);
+      }
+
+      glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+      CSWRenderFrame::GeometryContainer::const_iterator it = frame.geometries.begin();
+      for (; it != frame.geometries.end(); ++it)
+      {
+        glLoadMatrixd(it->matWorldTransform.pData);
+        glPointSize(static_cast<GLfloat>(it->fSize));
+        glLineWidth(static_cast<GLfloat>(it->fSize));
+
+        GLenum mode = GL_LINES;
+        switch (it->type)
+        {
+          case CSWRenderFrame::Geometry::POINTS: mode = GL_POINTS; break;
+          case CSWRenderFrame::Geometry::LINES: mode = GL_LINES; break;
+          case CSWRenderFrame::Geometry::TRIANGLES: mode = GL_TRIANGLES; break;
+          case CSWRenderFrame::Geometry::TRIANGLE_FAN: mode = GL_TRIANGLE_FAN; break;
+        }
+
+        bool bColorPerVertex = it->colors.size() == it->vertices.size();
+        glColor4dv(it->colors.front().pData);
+        glBegin(mode);
+          for (size_t i = 0; i < it->vertices.size(); ++i)
+          {
+            if (bColorPerVertex)
+              glColor4dv(it->colors[i].pData);
+            glVertex3dv(it->vertices[i].pData);
+          }
+        glEnd();
+      }
+
+      glDepthMask(true);
+      glPopMatrix();
+    glPopAttrib();
+  }
+
+
+  void CSWSceneRenderer::drawWorldCube()
+  {
+    glPushAttrib(GL_ALL_ATTRIB_BITS);
+
+      glDisable(GL_CULL_FACE);
+    
+      glEnable(GL_COLOR_MATERIAL);
+      glColorMaterial(GL_FRONT, GL_DIFFUSE);
+
+      glEnable(GL_BLEND);
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+      glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+      glShadeModel(GL_FLAT);
+      glDisable(GL_LIGHTING);
+      glColor4d(0, 0, 1, 0.2);
+
+      glEnable(GL_DEPTH_TEST);
+      glDepthMask(false);
+
+      BoundingBoxD bbox(Matrix44D(Vector3D(-CSWWorld::CUBE_SIZE.getDepth()/2 + CSWWorld::CUBE_THICKNESS, 
+                                           -CSWWorld::CUBE_SIZE.getHeight()/2 + CSWWorld::CUBE_THICKNESS, 
+                                           -CSWWorld::CUBE_SIZE.getDepth()/2 + CSWWorld::CUBE_THICKNESS)), 
+                        Size3D(CSWWorld::CUBE_SIZE.getWidth() - CSWWorld::CUBE_THICKNESS*2, 
+                               CSWWorld::CUBE_SIZE.getHeight() - CSWWorld::CUBE_THICKNESS*2, 
+                               CSWWorld::CUBE_SIZE.getDepth() - CSWWorld::CUBE_THICKNESS*2));
+
+      glBegin(GL_QUADS);
+        for (int iCnt = 0; iCnt < 6; ++iCnt) 
+        {
+          glVertex3dv(bbox.getRectangle(iCnt).getPoint0().pData);
+          glVertex3dv(bbox.getRectangle(iCnt).getPoint1().pData);
+          glVertex3dv(bbox.getRectangle(iCnt).getPoint2().pData);
+          glVertex3dv(bbox.getRectangle(iCnt).getPoint3().pData);
+        } 
+      glEnd();    
+
+      glDisable(GL_LIGHTING);
+      glColor3d(0, 0, 1);
+      glLineWidth(2);
+      glBegin(GL_LINES);
+        for (int iCnt = 0; iCnt < 12; ++iCnt) 
+        {
+          glVertex3dv(bbox.getSegment(iCnt).getPoint1().pData);
+          glVertex3dv(bbox.getSegment(iCnt).getPoint2().pData);
+        } 
+      glEnd();
+      glDepthMask(true);
+    glPopAttrib();
+  }
+
+
+  void CSWSceneRenderer::drawOverlay(const CSWRenderFrame& frame, const CSWRenderFrame::Entry& entry)
+  {
+    if (!(CSWWorld::getInstance()->getSettings()->getDamageableProperties() & CSWSettings::DISPLAY_HEALTH) &&
+        !(CSWWorld::getInstance()->getSettings()->getVariousProperties() & CSWSettings::INCREASE_VISIBILITY_OF_SMALL_OBJECTS) &&
+        frame.pSelectedObject != entry.pObject)
+    return;
+
+    AxisAlignedBoundingBoxD bbObject;  
+    Vector3D vecWindowTPosition;
+    Vector3D vecWindowTCenterPosition;
+    if (entry.bSolid)
+    {
+      std::vector<Vector3D> points(9);
+      points[0] = entry.matWorldTransform.getTranslation();
+      for (int i = 1; i < points.size(); ++i) points[i] = entry.matWorldTransform*entry.surfaceBoundingBox.getPoint(i - 1);
+      std::vector<Vector3D> windowPoints = getWindowCoords(points);
+      if (windowPoints.empty())
+        return;
+
+      bbObject = ARSTD::AxisAlignedBoundingBoxD::buildAroundPoints(windowPoints);
+      vecWindowTPosition = Vector3D(windowPoints[0].x, bbObject.getMin().y, windowPoints[0].z);
+      vecWindowTCenterPosition = windowPoints[0];
+    }
+    else
+    {
+      std::pair<bool, Vector3D> result = getWindowCoords(entry.matWorldTransform.getTranslation());
+      if (!result.first)
+        return;
+      bbObject.setMin(result.second);
+      bbObject.setMax(result.second);
+      vecWindowTPosition = result.second;
+      vecWindowTCenterPosition = result.second;
+    }
+
+    if (vecWindowTCenterPosition.z < 0 || vecWindowTCenterPosition.z >= 1)
+      return;
+  
+    glPushAttrib(GL_ALL_ATTRIB_BITS);
+
+      glDisable(GL_DEPTH_TEST);
+      glDisable(GL_LIGHTING);
+    
+      int viewport[4];
+      glGetIntegerv(GL_VIEWPORT, viewport);
+
+      glMatrixMode(GL_PROJECTION);
+      glPushMatrix();
+      glLoadIdentity();
+      glOrtho(0, viewport[2], 0, viewport[3], -10, 10);
+
+      if (CSWWorld::getInstance()->getSettings()->getDamageableProperties() & CSWSettings::DISPLAY_HEALTH &&
+          entry.fHealth >= 0)
+      {
+        GLubyte bar[8];
+      
+        ARSTD::uint32 val = (1 << (31 - static_cast<int>(entry.fHealth*31))) - 1;
+        val = ~val;
+        bar[0] = (val & 0xff000000) >> 24;
+        bar[1] = (val & 0x00ff0000) >> 16;
+        bar[2] = (val & 0x0000ff00) >> 8;
+        bar[3] = (val & 0x000000ff);
+        bar[4] = bar[0]; bar[5] = bar[1]; bar[6] = bar[2]; bar[7] = bar[3];
+
+        Vector3D vecColor(0, 0, 0);
+        vecColor.r = entry.fHealth < 0.5 ? 1.0 : -2.0*entry.fHealth + 2;
+        vecColor.g = entry.fHealth < 0.5 ? 2.0*entry.fHealth : 1.0;
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+        glColor3dv(vecColor.pData);
+        glRasterPos3i(vecWindowTPosition.x, vecWindowTPosition.y - 20, vecWindowTPosition.z);
+        glBitmap(32, 2, 16.0, 1.0, 0.0, 0.0, bar);
+
+        glColor3d(0.4, 0.4, 0.4);
+        //seting up the raster position again makes the color to be set!
+        glRasterPos3i(vecWindowTPosition.x, vecWindowTPosition.y - 20, vecWindowTPosition.z);
+        glBitmap(34, 4, 17.0, 2.0, 0.0, 0.0, m_Border);
+      }
+            
+      if (frame.pSelectedObject == entry.pObject)
+      {
+        const std::string& strName = frame.strSelectedObjectName;
+        glColor3d(1.0, 1.0, 1.0);
+        glRasterPos3i(vecWindowTPosition.x - strName.size()*9/2, vecWindowTPosition.y - 40, vecWindowTPosition.z);
+        glListBase(1000);
+        glCallLists((GLsizei)strName.size(), GL_UNSIGNED_BYTE, strName.c_str()); 
+      }
+
+      double fSquaredSize = bbObject.getWidth()*bbObject.getWidth() + bbObject.getHeight()*bbObject.getHeight();
+      if ((CSWWorld::getInstance()->getSettings()->getVariousProperties() & CSWSettings::INCREASE_VISIBILITY_OF_SMALL_OBJECTS) &&
+          fSquaredSize < 144 &&
+          entry.bSolid)
+      {
+        glMatrixMode(GL_MODELVIEW);
+        glPushMatrix();
+        glLoadMatrixd(Matrix44D(vecWindowTCenterPosition).pData);
+
+        glEnable(GL_DEPTH_TEST);
+        glDepthMask(false);
+        glColor4d(1.0, 1.0, 0.0, fSquaredSize < 64 ? 0.3 : -0.3/80*fSquaredSize + 0.54);
+
+        GLUquadricObj* pSphere = gluNewQuadric();
+        gluQuadricDrawStyle(pSphere, GLU_FILL);
+        glEnable(GL_COLOR_MATERIAL);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        gluDisk(pSphere, 0.0, 4.0, 10, 1);
+        gluDeleteQuadric(pSphere);
+
+        glDepthMask(true);
+        glPopMatrix();
+      }
+
+      glMatrixMode(GL_PROJECTION);
+      glPopMatrix();
+
+    glPopAttrib();
+  }
+
+
+  void CSWSceneRenderer::drawSpheres(const Mesh::InstanceContainer& instances, bool bLighting)
+  {
+    if (instances.empty())
+      return;
+
+    glPushAttrib(GL_ALL_ATTRIB_BITS);
+      glEnable(GL_DEPTH_TEST);
+      glDepthMask(false);
+
+      glShadeModel(GL_SMOOTH);
+
+      if (bLighting)
+      {
+        glEnable(GL_LIGHTING);
+        glEnable(GL_LIGHT0);
+      }
+      else
+      {
+        glDisable(GL_LIGHTING);
+      }
+      glEnable(GL_COLOR_MATERIAL);
+
+      glPolygonMode(GL_FRONT, GL_FILL);
+
+      glCullFace(GL_BACK);    
+      glEnable(GL_CULL_FACE);
+    
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+      glEnable(GL_BLEND);
+      glMatrixMode(GL_MODELVIEW);
+      glPushMatrix();
+      glLoadIdentity();
+
+      ARSTD::MeshRenderer::renderInstances(*m_pSphere, instances);
+
+      glDepthMask(true);
+      glPopMatrix();
+    glPopAttrib();
+  }
+
+
+  std::pair<bool, Vector3D> CSWSceneRenderer::getWindowCoords(const Vector3D& vecWorldTPos)
+  {
+    std::vector<Vector3D> windowPositions = getWindowCoords(std::vector<Vector3D>(1, vecWorldTPos));
+    if (windowPositions.empty())
+      return std::make_pair(false, Vector3D());
+    return std::make_pair(true, windowPositions.front());
+  }
+
+
+  std::vector<Vector3D> CSWSceneRenderer::getWindowCoords(const std::vector<Vector3D>& positions)
+  {
+    //the positions are given in world coordinates, the camera is part of the projection
+    int viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    Matrix44D matIdentity;
+
+    Matrix44D matCurrentProjection;
+    glGetDoublev(GL_PROJECTION_MATRIX, matCurrentProjection.pData);
+
+    std::vector<Vector3D> windowPositions(positions.size());
+    int nResult = GL_TRUE;
+    std::vector<Vector3D>::const_iterator it = positions.begin();
+    std::vector<Vector3D>::iterator itWndPos = windowPositions.begin();
+    for (; it != positions.end() && nResult == GL_TRUE; ++it, ++itWndPos)
+    {
+      nResult &= gluProject(it->x, it->y, it->z,
+                            matIdentity.pData,
+                            matCurrentProjection.pData,
+                            viewport,
+                            &itWndPos->x, &itWndPos->y, &itWndPos->z);
+    }
+  
+    if (nResult != GL_TRUE)
+      windowPositions.clear();
+    return windowPositions;
+  }
+
+}
\ No newline at end of file
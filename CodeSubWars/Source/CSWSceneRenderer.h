@@ -0,0 +1,52 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#pragma once
+
+#include "CSWRenderFrame.h"
+
+namespace CodeSubWars
+{
+
+  /**
+   * Draws the render frames of the world with opengl. Only the frame is read, so drawing needs no lock of the world
+   * and never touches the simulated objects.
+   */
+  class CSWSceneRenderer
+  {
+    public:
+      typedef std::shared_ptr<CSWSceneRenderer> PtrType;
+
+      static PtrType create();
+
+      ~CSWSceneRenderer();
+
+      void draw(const CSWRenderFrame& frame);
+
+      /**
+       * Sets up the lighting and blending all solids are drawn with.
+       */
+      static void setupMaterial();
+
+    protected:
+      CSWSceneRenderer();
+
+      void drawEntry(const CSWRenderFrame& frame, const CSWRenderFrame::Entry& entry);
+      void drawGeometries(const CSWRenderFrame& frame);
+      void drawWorldCube();
+      void drawOverlay(const CSWRenderFrame& frame, const CSWRenderFrame::Entry& entry);
+      void drawSpheres(const Mesh::InstanceContainer& instances, bool bLighting);
+
+      static std::pair<bool, Vector3D> getWindowCoords(const Vector3D& vecWorldTPos);
+      static std::vector<Vector3D> getWindowCoords(const std::vector<Vector3D>& positions);
+
+      static GLubyte m_Border[20];
+
+      //all solids of a frame are collected and drawn together before the transparent world cube
+      MeshBatch::PtrType m_pMeshBatch;
+      //explosions and sounds are drawn as instances of one unit sphere
+      Mesh::PtrType m_pSphere;
+  };
+
+}
\ No newline at end of file
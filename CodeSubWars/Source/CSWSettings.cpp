@@ -2,8 +2,9 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWSettings.h"
+#include "Constants.h"
 #include "CSWObject.h"
 #include "CSWISolid.h"
 
@@ -23,29 +24,46 @@ namespace CodeSubWars
     m_PropertyTree.put("Options.Damageable", m_nDamageableProperties);
     m_PropertyTree.put("Options.Dynamic", m_nDynamicProperties);
     m_PropertyTree.put("Options.Various", m_nVariousProperties);
+    m_PropertyTree.put("Options.CPUBudget", m_fCPUBudget);
     write_xml("preferences.cfg", m_PropertyTree);
   }
 
 
   CSWObject::PtrType CSWSettings::getSelectedObject()
   {
+    std::lock_guard<std::mutex> lck(m_mtxSelection);
     return m_pSelectedObject.lock();
   }
 
 
   void CSWSettings::setSelectedObject(CSWObject::PtrType pObject)
   {
+    CSWObject::PtrType pSolidObject = pObject->findFirstParent<CSWISolid>();
+
+    std::lock_guard<std::mutex> lck(m_mtxSelection);
     m_pSelectedObject = pObject;
-    m_pSelectedSolidObject = pObject->findFirstParent<CSWISolid>();
+    m_pSelectedSolidObject = pSolidObject;
   }
 
 
   std::shared_ptr<CSWObject> CSWSettings::getSelectedSolidObject()
   {
+    std::lock_guard<std::mutex> lck(m_mtxSelection);
     return m_pSelectedSolidObject.lock();
   }
 
 
+  void CSWSettings::deselectObject(CSWObject::PtrType pObject)
+  {
+    std::lock_guard<std::mutex> lck(m_mtxSelection);
+    if (m_pSelectedObject.lock() == pObject || m_pSelectedSolidObject.lock() == pObject)
+    {
+      m_pSelectedObject.reset();
+      m_pSelectedSolidObject.reset();
+    }
+  }
+
+
   void CSWSettings::setCollidableProperties(int nProperties)
   {
     m_nCollidableProperties = nProperties;
@@ -94,6 +112,18 @@ namespace CodeSubWars
   }
 
 
+  void CSWSettings::setCPUBudget(double fBudget)
+  {
+    m_fCPUBudget = fBudget;
+  }
+
+
+  double CSWSettings::getCPUBudget() const
+  {
+    return m_fCPUBudget;
+  }
+
+
   CSWSettings::CSWSettings()
   {
     try
@@ -108,6 +138,7 @@ namespace CodeSubWars
     m_nDamageableProperties = m_PropertyTree.get("Options.Damageable", 1);
     m_nDynamicProperties = m_PropertyTree.get("Options.Dynamic", 0);
     m_nVariousProperties = m_PropertyTree.get("Options.Various", 311);
+    m_fCPUBudget = m_PropertyTree.get("Options.CPUBudget", Constants::CRITICAL_CONSUMING_TIME);
   }
 
 
@@ -48,7 +48,8 @@ namespace CodeSubWars
         STORE_WORLD_PERIODICALLY = 32,
         DISPLAY_OBJECT_TREE = 64,
         DISPLAY_WEAPONS_IN_OBJECT_TREE = 128,
-        AUTOMATIC_BATTLE_STOP = 256
+        AUTOMATIC_BATTLE_STOP = 256,
+        PROFILE_SUBMARINES = 512
       };
 
 
@@ -62,6 +63,11 @@ namespace CodeSubWars
 
       std::shared_ptr<CSWObject> getSelectedSolidObject();
 
+      /**
+       * Resets the selection if the object or its solid parent is selected.
+       */
+      void deselectObject(std::shared_ptr<CSWObject> pObject);
+
       void setCollidableProperties(int nProperties);
       int getCollidableProperties() const;
 
@@ -73,18 +79,25 @@ namespace CodeSubWars
 
       void setVariousProperties(int nProperties);
       int getVariousProperties() const;
+
+      //Processor time in seconds a submarine may consume on average per call of update, processEvent or command step.
+      void setCPUBudget(double fBudget);
+      double getCPUBudget() const;
     
     protected:
       CSWSettings();
 
       boost::property_tree::ptree m_PropertyTree;
 
+      //the selection is changed by the simulation thread and read by the gui
+      std::mutex m_mtxSelection;
       std::weak_ptr<CSWObject> m_pSelectedObject;
       std::weak_ptr<CSWObject> m_pSelectedSolidObject;
       int m_nCollidableProperties;
       int m_nDamageableProperties;
       int m_nDynamicProperties;
       int m_nVariousProperties;
+      double m_fCPUBudget;
   };
 
 }
\ No newline at end of file
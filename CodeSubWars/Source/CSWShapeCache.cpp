@@ -0,0 +1,195 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#include "CorePrecompiledHeader.h"
+#include "CSWShapeCache.h"
+
+#include "CSWSubmarineMesh.h"
+
+
+namespace CodeSubWars
+{
+
+  namespace
+  {
+    std::vector<double> makeParameters(const Vector3D& vec)
+    {
+      std::vector<double> parameters;
+      parameters.push_back(vec.x);
+      parameters.push_back(vec.y);
+      parameters.push_back(vec.z);
+      return parameters;
+    }
+
+
+    std::vector<double> makeParameters(const Vector3D& vec1, const Vector3D& vec2)
+    {
+      std::vector<double> parameters(makeParameters(vec1));
+      parameters.push_back(vec2.x);
+      parameters.push_back(vec2.y);
+      parameters.push_back(vec2.z);
+      return parameters;
+    }
+
+
+    Vector3D getVector(const Size3D& size)
+    {
+      return Vector3D(size.getWidth(), size.getHeight(), size.getDepth());
+    }
+  }
+
+
+  CSWShapeCache::PtrType CSWShapeCache::getInstance()
+  {
+    static PtrType pInstance = PtrType(new CSWShapeCache());
+    return pInstance;
+  }
+
+
+  CSWShapeCache::~CSWShapeCache()
+  {
+  }
+
+
+  Mesh::PtrType CSWShapeCache::getSubmarineMesh(double fLength)
+  {
+    return getMesh(Key(SUBMARINE_MESH_ENTRY, std::vector<double>(1, fLength)), [this, fLength]()
+    {
+      Mesh::PtrType pBaseMesh = getMesh(Key(SUBMARINE_BASE_MESH_ENTRY, std::vector<double>()), []()
+      {
+        std::istrstream stream(reinterpret_cast<const char*>(SUBMARINE_MESH), sizeof(SUBMARINE_MESH));
+        return Mesh::readSTL(stream);
+      });
+      return pBaseMesh->transformed(Matrix44D(Vector4D(fLength, 0, 0, 0),
+                                              Vector4D(0, fLength, 0, 0),
+                                              Vector4D(0, 0, fLength, 0),
+                                              Vector4D(0, 0, 0, 1)));
+    });
+  }
+
+
+  Mesh::PtrType CSWShapeCache::getBoxMesh(const Vector3D& vecMin, const Size3D& size)
+  {
+    return getMesh(Key(BOX_MESH_ENTRY, makeParameters(vecMin, getVector(size))), [&vecMin, &size]()
+    {
+      return Mesh::createBox(Matrix44D(vecMin), size);
+    });
+  }
+
+
+  Mesh::PtrType CSWShapeCache::getEllipsoidMesh(const Vector3D& vecCenter, const Vector3D& vecDiameter)
+  {
+    return getMesh(Key(ELLIPSOID_MESH_ENTRY, makeParameters(vecCenter, vecDiameter)), [&vecCenter, &vecDiameter]()
+    {
+      return Mesh::createEllipsoid(Matrix44D(vecCenter), vecDiameter);
+    });
+  }
+
+
+  Mesh::PtrType CSWShapeCache::getCapsuleMesh(const Vector3D& vecStart, const Vector3D& vecEnd, double fRadius)
+  {
+    Vector3D vecDiameter(fRadius*2, fRadius*2, fRadius*2);
+    if (vecStart.getDistance(vecEnd) < EPSILON)
+      return getEllipsoidMesh(vecStart, vecDiameter);
+
+    std::vector<double> parameters(makeParameters(vecStart, vecEnd));
+    parameters.push_back(fRadius);
+    return getMesh(Key(CAPSULE_MESH_ENTRY, parameters), [&vecStart, &vecEnd, &vecDiameter, fRadius]()
+    {
+      Matrix44D matStart(vecStart);
+      matStart.getXAxis() = (vecEnd - vecStart).getNormalized();
+      matStart.getYAxis() = matStart.getXAxis().getPerpendicular();
+      matStart.getZAxis() = matStart.getXAxis()%matStart.getYAxis();
+      Matrix44D matEnd(matStart);
+      matEnd.getTranslation() = vecEnd;
+
+      Mesh::PtrType pMesh = Mesh::createEllipsoid(matStart, vecDiameter, 16, 16, 0, 8);
+      pMesh->add(Mesh::createCylinder(matStart, (vecEnd - vecStart).getLength(), fRadius*2, fRadius*2));
+      pMesh->add(Mesh::createEllipsoid(matEnd, vecDiameter, 16, 16, 8, 16));
+      return pMesh;
+    });
+  }
+
+
+  CSWDynamic::MassPropertiesPtrType CSWShapeCache::getMassProperties(const Mesh::PtrType pMassMesh)
+  {
+    std::lock_guard<std::recursive_mutex> lck(m_mtxCache);
+    std::pair<Mesh::PtrType, CSWDynamic::MassPropertiesPtrType>& entry = m_MassProperties[pMassMesh.get()];
+    if (!entry.second)
+      entry = std::make_pair(pMassMesh, CSWDynamic::calcMassProperties(pMassMesh));
+    return entry.second;
+  }
+
+
+  CSWShapeCache::ShapePtrType CSWShapeCache::getBoxShape(const Size3D& size)
+  {
+    return getShape(Key(BOX_SHAPE_ENTRY, makeParameters(getVector(size))), [&size]()
+    {
+      return DT_NewBox(size.getWidth(), size.getHeight(), size.getDepth());
+    });
+  }
+
+
+  CSWShapeCache::ShapePtrType CSWShapeCache::getPointShape(const Vector3D& vecPosition)
+  {
+    return getShape(Key(POINT_SHAPE_ENTRY, makeParameters(vecPosition)), [&vecPosition]()
+    {
+      return DT_NewPoint(static_cast<Vector3F>(vecPosition).pData);
+    });
+  }
+
+
+  CSWShapeCache::ShapePtrType CSWShapeCache::getLineSegmentShape(const Vector3D& vecStart, const Vector3D& vecEnd)
+  {
+    return getShape(Key(LINE_SEGMENT_SHAPE_ENTRY, makeParameters(vecStart, vecEnd)), [&vecStart, &vecEnd]()
+    {
+      return DT_NewLineSegment(static_cast<Vector3F>(vecStart).pData, static_cast<Vector3F>(vecEnd).pData);
+    });
+  }
+
+
+  void CSWShapeCache::clear()
+  {
+    std::lock_guard<std::recursive_mutex> lck(m_mtxCache);
+    m_Meshes.clear();
+    m_Shapes.clear();
+    m_MassProperties.clear();
+  }
+
+
+  CSWShapeCache::CSWShapeCache()
+  {
+  }
+
+
+  Mesh::PtrType CSWShapeCache::getMesh(const Key& key, const std::function<Mesh::PtrType()>& create)
+  {
+    std::lock_guard<std::recursive_mutex> lck(m_mtxCache);
+    std::map<Key, Mesh::PtrType>::iterator it = m_Meshes.find(key);
+    if (it != m_Meshes.end())
+      return it->second;
+
+    Mesh::PtrType pMesh = create();
+    m_Meshes[key] = pMesh;
+    return pMesh;
+  }
+
+
+  CSWShapeCache::ShapePtrType CSWShapeCache::getShape(const Key& key, const std::function<DT_ShapeHandle()>& create)
+  {
+    std::lock_guard<std::recursive_mutex> lck(m_mtxCache);
+    std::map<Key, ShapePtrType>::iterator it = m_Shapes.find(key);
+    if (it != m_Shapes.end())
+      return it->second;
+
+    DT_ShapeHandle hDTShape = create();
+    if (!hDTShape)
+      throw std::runtime_error("CSWShapeCache::getShape(): shape was not correctly created");
+
+    ShapePtrType pShape(hDTShape, &DT_DeleteShape);
+    m_Shapes[key] = pShape;
+    return pShape;
+  }
+
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#pragma once
+
+#include "CSWDynamic.h"
+
+
+namespace CodeSubWars
+{
+
+  /**
+   * Shares the meshes, mass properties and collision shapes of objects with the same type and size. Creating them is
+   * done once, so spawning many submarines or weapons of the same kind does not parse, tessellate or allocate them again.
+   * The returned meshes are shared and must not be changed. The collision shapes are deleted when the last object
+   * using them and the cache have released them. All methods may be called from different threads.
+   */
+  class CSWShapeCache
+  {
+    public:
+      typedef std::shared_ptr<CSWShapeCache> PtrType;
+      typedef std::shared_ptr<std::remove_pointer<DT_ShapeHandle>::type> ShapePtrType;
+
+      static PtrType getInstance();
+
+      ~CSWShapeCache();
+
+      //given in local coordsystem
+      Mesh::PtrType getSubmarineMesh(double fLength);
+      Mesh::PtrType getBoxMesh(const Vector3D& vecMin, const Size3D& size);
+      Mesh::PtrType getEllipsoidMesh(const Vector3D& vecCenter, const Vector3D& vecDiameter);
+
+      /**
+       * @return A capsule around the segment from start to end or a sphere if both are equal.
+       */
+      Mesh::PtrType getCapsuleMesh(const Vector3D& vecStart, const Vector3D& vecEnd, double fRadius);
+
+      CSWDynamic::MassPropertiesPtrType getMassProperties(const Mesh::PtrType pMassMesh);
+
+      ShapePtrType getBoxShape(const Size3D& size);
+      ShapePtrType getPointShape(const Vector3D& vecPosition);
+      ShapePtrType getLineSegmentShape(const Vector3D& vecStart, const Vector3D& vecEnd);
+
+      /**
+       * Releases all cached entries. Entries still used by objects stay valid.
+       */
+      void clear();
+
+    protected:
+      enum EntryType
+      {
+        SUBMARINE_MESH_ENTRY = 0,
+        SUBMARINE_BASE_MESH_ENTRY,
+        BOX_MESH_ENTRY,
+        ELLIPSOID_MESH_ENTRY,
+        CAPSULE_MESH_ENTRY,
+        BOX_SHAPE_ENTRY,
+        POINT_SHAPE_ENTRY,
+        LINE_SEGMENT_SHAPE_ENTRY
+      };
+
+      //type and scale parameters of an entry
+      typedef std::pair<int, std::vector<double> > Key;
+
+      CSWShapeCache();
+
+      Mesh::PtrType getMesh(const Key& key, const std::function<Mesh::PtrType()>& create);
+      ShapePtrType getShape(const Key& key, const std::function<DT_ShapeHandle()>& create);
+
+      //creating the submarine mesh needs the cached base mesh
+      std::recursive_mutex m_mtxCache;
+      std::map<Key, Mesh::PtrType> m_Meshes;
+      std::map<Key, ShapePtrType> m_Shapes;
+      //the mass mesh is stored with its properties, so its address is not reused for another mesh
+      std::map<const Mesh*, std::pair<Mesh::PtrType, CSWDynamic::MassPropertiesPtrType> > m_MassProperties;
+  };
+
+}
\ No newline at end of file
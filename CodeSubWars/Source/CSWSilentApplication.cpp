@@ -2,13 +2,15 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWSilentApplication.h"
 #include "Constants.h"
 #include "CSWWorld.h"
 #include "CSWObject.h"
 #include "CSWLog.h"
 #include "CSWUtilities.h"
+#include "CSWSettings.h"
+#include "CSWWorldSnapshot.h"
 
 
 namespace CodeSubWars
@@ -19,7 +21,10 @@ namespace CodeSubWars
     m_WorldType(CSWWorld::DEFAULT_1),
     m_BattleType(CSWWorld::SINGLE),
     m_nTeamSize(3),
-    m_fTimeStep(0.01)
+    m_fTimeStep(0.01),
+    m_fCPUBudget(-1),
+    m_bProfile(false),
+    m_fSnapshotTime(-1)
   {
     checkRequirements();
   
@@ -44,6 +49,8 @@ namespace CodeSubWars
           int t = atoi(result.second.c_str());
           if (t >= 1 && t <= 5)
             m_WorldType = static_cast<CSWWorld::WorldType>(t);
+          else if (ARSTD::FileSystem::getSuffix(result.second) == "xml")
+            m_strWorldFileName = result.second;
           else
             m_bParametersValid = false;        
           break;
@@ -76,6 +83,35 @@ namespace CodeSubWars
             m_bParametersValid = false;        
           break;
         }
+        case CPUBUDGET_TYPE:
+        {
+          double t = atof(result.second.c_str());
+          if (t > 0 && t <= 1000)
+            m_fCPUBudget = t/1000.0;
+          else
+            m_bParametersValid = false;        
+          break;
+        }
+        case PROFILE_TYPE:
+        {
+          m_bProfile = true;
+          break;
+        }
+        case SNAPSHOT_TYPE:
+        {
+          m_strSnapshotFileName = result.second;
+          m_bParametersValid &= !m_strSnapshotFileName.empty();
+          break;
+        }
+        case SNAPSHOTAT_TYPE:
+        {
+          double t = atof(result.second.c_str());
+          if (t > 0)
+            m_fSnapshotTime = t;
+          else
+            m_bParametersValid = false;        
+          break;
+        }
       }
       nReadData |= result.first;
     }
@@ -93,7 +129,7 @@ namespace CodeSubWars
   void CSWSilentApplication::run()
   {
     std::cout << "CodeSubWars v" << Constants::getVersion().getAsString() << " beta\n";
-    std::cout << "Copyright (c) 2005-2022 " << qPrintable(Constants::AUTHOR) << ". All rights reserved.\n";
+    std::cout << "Copyright (c) 2005-2022 " << Constants::AUTHOR << ". All rights reserved.\n";
     std::cout << "Released under the MIT license. (see license.txt)\n\n";
 
     if (!m_bParametersValid)
@@ -114,33 +150,77 @@ namespace CodeSubWars
       strBattleType = "team";
   
     std::stringstream ss;
-    ss << "parameters: world = " << m_WorldType << " battle = " << strBattleType;
+    ss << "parameters: world = ";
+    if (m_strWorldFileName.empty())
+      ss << m_WorldType;
+    else
+      ss << m_strWorldFileName;
+    ss << " battle = " << strBattleType;
     if (m_BattleType == CSWWorld::TEAM)
       ss << " teamsize = " << m_nTeamSize;
     ss << " timestep = " << m_fTimeStep;
+    if (m_fCPUBudget > 0)
+      ss << " cpubudget = " << m_fCPUBudget*1000.0 << "ms";
+    if (m_bProfile)
+      ss << " profile";
+    if (!m_strSnapshotFileName.empty())
+      ss << " snapshot = " << m_strSnapshotFileName;
+    if (m_fSnapshotTime > 0)
+      ss << " snapshotat = " << m_fSnapshotTime << "s";
     CSWLog::getInstance()->log(ss.str());  
+
+    //the settings are stored on exit, so command line overrides are restored afterwards
+    CSWSettings::PtrType pSettings = CSWWorld::getInstance()->getSettings();
+    int nVariousProperties = pSettings->getVariousProperties();
+    double fCPUBudget = pSettings->getCPUBudget();
+    if (m_fCPUBudget > 0)
+      pSettings->setCPUBudget(m_fCPUBudget);
+    if (m_bProfile)
+      pSettings->setVariousProperties(nVariousProperties | CSWSettings::PROFILE_SUBMARINES);
   
     //calculate average over last 5 seconds
     boost::circular_buffer<double> timeRatios(5.0/m_fTimeStep);
   
     CSWLog::getInstance()->log("initializing ...");
-    CSWWorld::getInstance()->newWorld(m_WorldType);
+    if (!m_strSnapshotFileName.empty())
+    {
+      //world, battle and submarines are taken from the snapshot
+      CSWWorldSnapshot::PtrType pSnapshot = CSWWorldSnapshot::read(m_strSnapshotFileName);
+      if (!pSnapshot)
+        CSWLog::getInstance()->log("could not read snapshot " + m_strSnapshotFileName);
+      else
+        CSWWorld::getInstance()->restoreSnapshot(pSnapshot, ARSTD::Time::MANUAL);
+    }
+    else
+    {
+      if (m_strWorldFileName.empty())
+        CSWWorld::getInstance()->newWorld(m_WorldType);
+      else
+        CSWWorld::getInstance()->newWorld(m_strWorldFileName);
   
-    CSWWorld::getInstance()->newBattle(CSWUtilities::determineAvailableSubmarines("submarines"), 
-                                       m_BattleType, m_nTeamSize, ARSTD::Time::MANUAL);
+      CSWWorld::getInstance()->newBattle(CSWUtilities::determineAvailableSubmarines("Submarines"), 
+                                         m_BattleType, m_nTeamSize, ARSTD::Time::MANUAL);
+    }
   
     double fOldRealTime = ARSTD::Time::getRealTime();
     double fStartRealTime = fOldRealTime;
   
     CSWLog::getInstance()->log("running ... (press ESC to stop)");
     std::cout << "\n";
-    while (!_kbhit() && CSWWorld::getInstance()->isBattleRunning())
+    while (!ARSTD::Console::isKeyPressed() && CSWWorld::getInstance()->isBattleRunning())
     {
       //recalculate the world
       CSWWorld::getInstance()->recalculate();
 
       //add time step to time
       ARSTD::Time::step(m_fTimeStep);
+
+      //weapons in flight, pending events and commands are not stored, so the snapshot is taken at the first step without them
+      if (m_fSnapshotTime > 0 && ARSTD::Time::getTime() >= m_fSnapshotTime && CSWWorld::getInstance()->isSnapshotPossible())
+      {
+        m_fSnapshotTime = -1;
+        writeSnapshot();
+      }
     
       //calculate average
       double fCurrentRealTime = ARSTD::Time::getRealTime();
@@ -167,9 +247,31 @@ namespace CodeSubWars
       CSWWorld::getInstance()->finalizeBattle();
       CSWWorld::getInstance()->finalizeWorld();
     }
-    CSWLog::getInstance()->log(("total simulated time: " + 
-                                QString::number(fSimulatedTime, 'f', 2) +
-                                " ratio: " + QString::number(fSimulatedTime/(ARSTD::Time::getRealTime() - fStartRealTime), 'f', 2)).toStdString());
+    pSettings->setVariousProperties(nVariousProperties);
+    pSettings->setCPUBudget(fCPUBudget);
+
+    std::stringstream ssResult;
+    ssResult.precision(2);
+    ssResult.setf(std::ios::fixed);
+    ssResult << "total simulated time: " << fSimulatedTime
+             << " ratio: " << fSimulatedTime/(ARSTD::Time::getRealTime() - fStartRealTime);
+    CSWLog::getInstance()->log(ssResult.str());
+  }
+
+
+  void CSWSilentApplication::writeSnapshot()
+  {
+    CSWWorldSnapshot::PtrType pSnapshot = CSWWorld::getInstance()->takeSnapshot();
+    if (!pSnapshot)
+      return;
+
+    const std::string strPath = "snapshots";
+    ARSTD::FileSystem::createDirectory(strPath);
+    std::string strFileName = strPath + "/" + CSWUtilities::getUniqueFilename(strPath) + ".snapshot";
+    if (pSnapshot->write(strFileName))
+      CSWLog::getInstance()->log("snapshot written to " + strFileName);
+    else
+      CSWLog::getInstance()->log("could not write snapshot " + strFileName);
   }
 
 
@@ -193,6 +295,10 @@ namespace CodeSubWars
     const std::string BATTLE_KEY = "battle";
     const std::string TEAMSIZE_KEY = "teamsize";
     const std::string TIMESTEP_KEY = "timestep";
+    const std::string CPUBUDGET_KEY = "cpubudget";
+    const std::string PROFILE_KEY = "profile";
+    const std::string SNAPSHOT_KEY = "snapshot";
+    const std::string SNAPSHOTAT_KEY = "snapshotat";
   
     if (value.substr(1, value.size() - 1) == RUNNING_MODE_KEY)
     {
@@ -201,6 +307,13 @@ namespace CodeSubWars
       return result;
     }
 
+    if (value.substr(1, value.size() - 1) == PROFILE_KEY)
+    {
+      result.first = PROFILE_TYPE;
+      result.second = value.substr(1, value.size() - 1);
+      return result;
+    }
+
     size_t nIdx = value.find(WORLD_KEY + "=");
     if (nIdx != std::string::npos)
     {
@@ -232,6 +345,30 @@ namespace CodeSubWars
       result.second = value.substr(nIdx + TIMESTEP_KEY.size() + 1, value.size() - (nIdx + TIMESTEP_KEY.size() + 1));
       return result;
     }
+
+    nIdx = value.find(CPUBUDGET_KEY + "=");
+    if (nIdx != std::string::npos)
+    {
+      result.first = CPUBUDGET_TYPE;
+      result.second = value.substr(nIdx + CPUBUDGET_KEY.size() + 1, value.size() - (nIdx + CPUBUDGET_KEY.size() + 1));
+      return result;
+    }
+
+    nIdx = value.find(SNAPSHOTAT_KEY + "=");
+    if (nIdx != std::string::npos)
+    {
+      result.first = SNAPSHOTAT_TYPE;
+      result.second = value.substr(nIdx + SNAPSHOTAT_KEY.size() + 1, value.size() - (nIdx + SNAPSHOTAT_KEY.size() + 1));
+      return result;
+    }
+
+    nIdx = value.find(SNAPSHOT_KEY + "=");
+    if (nIdx != std::string::npos)
+    {
+      result.first = SNAPSHOT_TYPE;
+      result.second = value.substr(nIdx + SNAPSHOT_KEY.size() + 1, value.size() - (nIdx + SNAPSHOT_KEY.size() + 1));
+      return result;
+    }
   
     return result;
   }
@@ -241,12 +378,14 @@ namespace CodeSubWars
   {
     std::cout << "A physics based three dimensional programming game.\n";
     std::cout << "\n";
-    std::cout << "Syntax: CodeSubWars [-silent] [-world=<1-5>] [-battle=<single|team>] [-teamsize=<3|5|10>] [-timestep=x]\n";
+    std::cout << "Syntax: CodeSubWars [-silent] [-world=<1-5|file>] [-battle=<single|team>] [-teamsize=<3|5|10>] [-timestep=x]\n";
+    std::cout << "                   [-cpubudget=x] [-profile] [-snapshot=<file>] [-snapshotat=x]\n";
     std::cout << "\n";
     std::cout << "  -silent     Using this parameter makes the application starts without graphical output.\n";
     std::cout << "              The other parameters are only valid when this is set.\n";
     std::cout << "\n";
     std::cout << "  -world      With this parameter the predefined world environment can be choosen. Default is 1.\n";
+    std::cout << "              Other worlds are given by the file name of their definition (*.xml).\n";
     std::cout << "\n";
     std::cout << "  -battle     This parameter indicates which battle mode should be run. Default is single.\n";
     std::cout << "\n";
@@ -254,6 +393,21 @@ namespace CodeSubWars
     std::cout << "\n";
     std::cout << "  -timestep   Here the time step in seconds for each simulation step can be set. The given\n";
     std::cout << "              value must be in range [0.01, 0.1]. Default is 0.01.\n";
+    std::cout << "\n";
+    std::cout << "  -cpubudget  The processor time in milliseconds a submarine may consume on average per call\n";
+    std::cout << "              of update, processEvent or command step before it is kicked. Default is taken\n";
+    std::cout << "              from the preferences (6ms).\n";
+    std::cout << "\n";
+    std::cout << "  -profile    Profiles the python code of each submarine and writes the collapsed stacks to\n";
+    std::cout << "              log/profile_<date>.folded at the end of the battle (e.g. for flamegraph.pl).\n";
+    std::cout << "\n";
+    std::cout << "  -snapshot   Continues the battle stored in the given snapshot file instead of starting a new\n";
+    std::cout << "              one. World, battle and submarines are taken from the snapshot. Several processes\n";
+    std::cout << "              can continue the same snapshot independently.\n";
+    std::cout << "\n";
+    std::cout << "  -snapshotat Writes a snapshot of the battle to snapshots/<date>.snapshot when the given\n";
+    std::cout << "              simulated time in seconds is reached. It is delayed until no weapon is in\n";
+    std::cout << "              flight and no event or command is pending, since these are not stored.\n";
   }
 
 }
\ No newline at end of file
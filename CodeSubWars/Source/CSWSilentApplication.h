@@ -27,19 +27,29 @@ namespace CodeSubWars
         WORLD_TYPE = 4,
         BATTLE_TYPE = 8,
         TEAMSIZE_TYPE = 16,
-        TIMESTEP_TYPE = 32
+        TIMESTEP_TYPE = 32,
+        CPUBUDGET_TYPE = 64,
+        PROFILE_TYPE = 128,
+        SNAPSHOT_TYPE = 256,
+        SNAPSHOTAT_TYPE = 512
       };
 
       void checkRequirements();    
+      void writeSnapshot();
       std::pair<ParameterType, std::string> determineParameterType(const std::string& value);
     
       void showSyntax();
     
       bool m_bParametersValid;
       CSWWorld::WorldType m_WorldType;
+      std::string m_strWorldFileName;
       CSWWorld::BattleType m_BattleType;
       int m_nTeamSize;
       double m_fTimeStep;
+      double m_fCPUBudget;
+      bool m_bProfile;
+      std::string m_strSnapshotFileName;
+      double m_fSnapshotTime;
   };
 
 }
\ No newline at end of file
@@ -0,0 +1,178 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#include "CorePrecompiledHeader.h"
+#include "CSWSimulationThread.h"
+#include "CSWWorld.h"
+#include "CSWLog.h"
+
+
+namespace CodeSubWars
+{
+
+  const double CSWSimulationThread::MIN_STEP_TIME = 0.01;
+  const double CSWSimulationThread::IDLE_WAIT_TIME = 0.01;
+
+
+  CSWSimulationThread::PtrType CSWSimulationThread::getInstance()
+  {
+    static PtrType pInstance = PtrType(new CSWSimulationThread());
+    return pInstance;
+  }
+
+
+  CSWSimulationThread::~CSWSimulationThread()
+  {
+    stop();
+  }
+
+
+  void CSWSimulationThread::start()
+  {
+    if (isRunning())
+      return;
+
+    m_bStop = false;
+    m_Thread = std::thread(&CSWSimulationThread::run, this);
+  }
+
+
+  void CSWSimulationThread::stop()
+  {
+    if (!isRunning())
+      return;
+
+    {
+      std::lock_guard<std::mutex> lck(m_mtxTasks);
+      m_bStop = true;
+    }
+    m_TasksAvailable.notify_all();
+    m_Thread.join();
+
+    //tasks that came in while stopping are executed here, nobody waits for them in vain
+    executeTasks();
+  }
+
+
+  bool CSWSimulationThread::isRunning() const
+  {
+    return m_Thread.joinable();
+  }
+
+
+  void CSWSimulationThread::invoke(const Task& task)
+  {
+    if (!isRunning() || std::this_thread::get_id() == m_Thread.get_id())
+    {
+      task();
+      return;
+    }
+
+    std::packaged_task<void()> packagedTask(task);
+    std::future<void> result = packagedTask.get_future();
+    {
+      std::lock_guard<std::mutex> lck(m_mtxTasks);
+      m_Tasks.push_back(std::move(packagedTask));
+    }
+    m_TasksAvailable.notify_one();
+
+    result.get();
+  }
+
+
+  void CSWSimulationThread::post(const Task& task)
+  {
+    //nobody waits for the result, so errors can only be logged
+    Task loggingTask = [task]()
+    {
+      try
+      {
+        task();
+      }
+      catch (std::exception& e)
+      {
+        CSWLog::getInstance()->log(std::string("error while executing a task on the simulation thread: ") + e.what());
+      }
+    };
+
+    if (!isRunning() || std::this_thread::get_id() == m_Thread.get_id())
+    {
+      loggingTask();
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lck(m_mtxTasks);
+      m_Tasks.push_back(std::packaged_task<void()>(loggingTask));
+    }
+    m_TasksAvailable.notify_one();
+  }
+
+
+  CSWSimulationThread::CSWSimulationThread()
+  : m_bStop(false)
+  {
+  }
+
+
+  void CSWSimulationThread::run()
+  {
+    while (!m_bStop)
+    {
+      bool bTasksExecuted = executeTasks();
+
+      CSWWorld::PtrType pWorld = CSWWorld::getInstance();
+      double fTimeRatio = ARSTD::Time::getTimeRatio();
+      if (!pWorld->isBattleRunning() || fTimeRatio <= 0)
+      {
+        //nothing is simulated but the tasks may have changed the world or moved a camera
+        if (bTasksExecuted)
+          pWorld->publishRenderFrame();
+        waitForTasks(IDLE_WAIT_TIME);
+        continue;
+      }
+
+      double fStepStartTime = ARSTD::Time::getTime();
+      try
+      {
+        pWorld->recalculate();
+      }
+      catch (std::exception& e)
+      {
+        CSWLog::getInstance()->log(std::string("simulation failed -> stopping battle: ") + e.what());
+        pWorld->finalizeBattle();
+      }
+      pWorld->publishRenderFrame();
+
+      //the next step integrates the simulated time since this one started, small time ratios would only produce tiny steps
+      double fRemainingTime = MIN_STEP_TIME - (ARSTD::Time::getTime() - fStepStartTime);
+      if (fRemainingTime > 0)
+        waitForTasks(fRemainingTime/fTimeRatio);
+    }
+  }
+
+
+  bool CSWSimulationThread::executeTasks()
+  {
+    std::deque<std::packaged_task<void()> > tasks;
+    {
+      std::lock_guard<std::mutex> lck(m_mtxTasks);
+      tasks.swap(m_Tasks);
+    }
+
+    std::deque<std::packaged_task<void()> >::iterator it = tasks.begin();
+    for (; it != tasks.end(); ++it)
+      (*it)();
+
+    return !tasks.empty();
+  }
+
+
+  void CSWSimulationThread::waitForTasks(double fSeconds)
+  {
+    std::unique_lock<std::mutex> lck(m_mtxTasks);
+    m_TasksAvailable.wait_for(lck, std::chrono::duration<double>(fSeconds), [this]() { return m_bStop || !m_Tasks.empty(); });
+  }
+
+}
\ No newline at end of file
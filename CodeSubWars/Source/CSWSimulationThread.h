@@ -0,0 +1,63 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#pragma once
+
+
+namespace CodeSubWars
+{
+
+  /**
+   * Runs the simulation steps of CSWWorld on a dedicated thread, so drawing never slows down the simulation. The steps
+   * follow each other as fast as the current time ratio requires. After each step the state is published as a render
+   * frame for the scene views.
+   * Everything that changes the world or runs python (new world, new battle, stopping, selecting, moving cameras) must
+   * be executed on this thread via invoke() or post(). If the thread is not started both execute immediately.
+   */
+  class CSWSimulationThread
+  {
+    public:
+      typedef std::shared_ptr<CSWSimulationThread> PtrType;
+      typedef std::function<void()> Task;
+
+      static PtrType getInstance();
+
+      ~CSWSimulationThread();
+
+      void start();
+      void stop();
+      bool isRunning() const;
+
+      /**
+       * Executes the task on the simulation thread between two steps and waits until it is done. Exceptions of the task
+       * are rethrown to the caller.
+       */
+      void invoke(const Task& task);
+
+      /**
+       * Executes the task on the simulation thread between two steps without waiting for it.
+       */
+      void post(const Task& task);
+
+    protected:
+      //simulated seconds a step should at least advance, avoids stepping needlessly often at small time ratios
+      static const double MIN_STEP_TIME;
+      //real seconds waited for new tasks while no battle is running
+      static const double IDLE_WAIT_TIME;
+
+      CSWSimulationThread();
+
+      void run();
+      bool executeTasks();
+      void waitForTasks(double fSeconds);
+
+      std::thread m_Thread;
+      std::atomic<bool> m_bStop;
+
+      std::mutex m_mtxTasks;
+      std::condition_variable m_TasksAvailable;
+      std::deque<std::packaged_task<void()> > m_Tasks;
+  };
+
+}
\ No newline at end of file
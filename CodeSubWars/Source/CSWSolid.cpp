@@ -2,8 +2,10 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWSolid.h"
+#include "CSWObjectPool.h"
+#include "CSWWorld.h"
 
 
 
@@ -12,7 +14,7 @@ namespace CodeSubWars
 
   CSWSolid::PtrType CSWSolid::create(const Mesh::PtrType pSurface)
   {
-    return PtrType(new CSWSolid(pSurface));
+    return CSWObjectPool::create<CSWSolid>([&](void* pBlock) { return new (pBlock) CSWSolid(pSurface); });
   }
 
 
@@ -21,43 +23,10 @@ namespace CodeSubWars
   }
 
 
-  void CSWSolid::draw(const Matrix44D& mat)
+  void CSWSolid::collectRenderData(CSWRenderFrame::Entry& entry) const
   {
-    glPushAttrib(GL_ALL_ATTRIB_BITS);
-      glShadeModel(GL_SMOOTH);
-
-      glEnable(GL_LIGHTING);
-      glEnable(GL_LIGHT0);
-
-      glPolygonMode(GL_FRONT, GL_FILL);
-
-      glCullFace(GL_BACK);    
-      glEnable(GL_CULL_FACE);
-
-      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-      glEnable(GL_BLEND);
-
-      glColorMaterial(GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
-      glEnable(GL_COLOR_MATERIAL);
-
-      glDepthFunc(GL_LESS);
-      glEnable(GL_DEPTH_TEST);
-
-      glColor4dv(m_vecColor.pData);
-
-      m_pSurface->render();
-
-  //  //bounding box for debugging
-  //  glShadeModel(GL_FLAT);
-  //  glDisable(GL_LIGHTING);
-  //  glBegin(GL_LINES);
-  //    for (int iCnt = 0; iCnt < 12; ++iCnt) 
-  //    {
-  //      glVertex3dv(m_BoundingBox.getSegment(iCnt).getPoint1().pData);
-  //      glVertex3dv(m_BoundingBox.getSegment(iCnt).getPoint2().pData);
-  //    }
-  //  glEnd();
-    glPopAttrib();
+    entry.pSurface = m_pSurface;
+    entry.vecColor = m_vecColor;
   }
 
 
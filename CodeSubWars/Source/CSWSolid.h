@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "CSWRenderFrame.h"
+
 namespace CodeSubWars
 {
 
@@ -15,7 +17,10 @@ namespace CodeSubWars
       static PtrType create(const Mesh::PtrType pSurface);
       ~CSWSolid();
 
-      void draw(const Matrix44D& mat);
+      /**
+       * Sets the surface and its color as the one drawn for the entry.
+       */
+      void collectRenderData(CSWRenderFrame::Entry& entry) const;
 
       //given in local coordsystem
       const Mesh::PtrType getMesh() const;
@@ -2,9 +2,10 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWSonar.h"
 #include "CSWMap.h"
+#include "CSWUtilities.h"
 
 
 namespace CodeSubWars
@@ -233,7 +234,7 @@ namespace CodeSubWars
     m_ScanDirectionMode(FULL),
     m_ScanVelocityMode(FAST),
     m_ScanRangeMode(NEAR_RANGE),
-    m_fActiveAutomaticRotationTimePeriod((rand()%4000)/1000.0), //initialize with random period so the sonar scanner have different relative directions
+    m_fActiveAutomaticRotationTimePeriod(CSWUtilities::getRandomInteger(0, 3999)/1000.0), //initialize with random period so the sonar scanner have different relative directions
     m_fOldTime(0),
     m_vecMainScanDirection(0, 0, 1),
     m_vecMainScanUp(0, 1, 0),
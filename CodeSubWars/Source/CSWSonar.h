@@ -10,6 +10,7 @@ namespace CodeSubWars
 {
 
   class CSWMap;
+  struct CSWRenderFrame;
 
   /**
    * This is the base class for sonar like functionality.
@@ -59,7 +60,8 @@ namespace CodeSubWars
       //defined methods from IUpdateable
       virtual void update();
 
-      virtual void draw() = 0;
+      //adds the scans for debugging
+      virtual void collectRenderData(CSWRenderFrame& frame) const = 0;
     
       virtual Vector3D getAdditionalDirection(const Vector3D& vecCurrentDir, const Vector3D& vecUp) const = 0;
 
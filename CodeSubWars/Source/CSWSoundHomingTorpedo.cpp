@@ -2,7 +2,7 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWSoundHomingTorpedo.h"
 #include "CSWWorld.h"
 #include "CSWSettings.h"
@@ -35,13 +35,13 @@ namespace CodeSubWars
   }
 
 
-  void CSWSoundHomingTorpedo::draw()
+  void CSWSoundHomingTorpedo::collectRenderData(CSWRenderFrame& frame, CSWRenderFrame::Entry& entry)
   {
-    CSWWeapon::draw();
+    CSWWeapon::collectRenderData(frame, entry);
 
     if (CSWWorld::getInstance()->getSettings()->getSelectedObject() == getSharedThis())
     {
-      getPassiveSonar()->draw();
+      getPassiveSonar()->collectRenderData(frame);
     }
   }
 
@@ -2,10 +2,11 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWObject.h"
 #include "CSWISoundReceiver.h"
 #include "CSWSoundReceiver.h"
+#include "CSWObjectPool.h"
 
 
 namespace CodeSubWars
@@ -13,7 +14,7 @@ namespace CodeSubWars
 
   CSWSoundReceiver::PtrType CSWSoundReceiver::create()
   {
-    return PtrType(new CSWSoundReceiver());
+    return CSWObjectPool::create<CSWSoundReceiver>([&](void* pBlock) { return new (pBlock) CSWSoundReceiver(); });
   }
 
 
@@ -15,11 +15,19 @@ namespace CodeSubWars
 
       ~CSWSoundVisualizer();
 
+      /**
+       * Enables collecting new entries. Disabled by default since entries are only needed if the world is drawn.
+       */
+      void setEnabled(bool bEnabled);
+
       void addSound(const Vector3D& vecPosition, const double& fIntensity, long nEmitterID);
 
       void clear();
-        
-      void draw();
+
+      /**
+       * Adds the current sound waves as instances of a unit sphere and removes the faded ones.
+       */
+      void collect(Mesh::InstanceContainer& instances);
     
     protected:
       struct SoundEntry
@@ -36,7 +44,10 @@ namespace CodeSubWars
   
       CSWSoundVisualizer();
 
+      bool m_bEnabled;
       SoundContainer m_Sounds;
+      //entries are added by the simulation and removed while collecting a render frame
+      std::mutex m_mtxEntries;
   };
 
 }
\ No newline at end of file
@@ -2,11 +2,10 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWSoundVisualizer.h"
 #include "CSWWorld.h"
 #include "CSWSettings.h"
-#include "glut.h"
 
 
 namespace CodeSubWars
@@ -23,10 +22,16 @@ namespace CodeSubWars
   }
 
 
+  void CSWSoundVisualizer::setEnabled(bool bEnabled)
+  {
+    m_bEnabled = bEnabled;
+  }
+
+
   void CSWSoundVisualizer::addSound(const Vector3D& vecPosition, const double& fIntensity, long nEmitterID)
   {
-    //explosion can only be added in graphic mode
-    if (!qApp)
+    //only collected if something is drawing them
+    if (!m_bEnabled)
       return;
 
     if (!(CSWWorld::getInstance()->getSettings()->getVariousProperties() & CSWSettings::DISPLAY_SOUND_EMITTING))
@@ -39,6 +44,7 @@ namespace CodeSubWars
     e.fStartIntensity = fIntensityIndB < 250 ? fIntensityIndB : 250;
     e.fStartTime = ARSTD::Time::getTime();
 
+    std::lock_guard<std::mutex> lck(m_mtxEntries);
     SoundContainer::iterator itFound = m_Sounds.find(nEmitterID);
     if (itFound == m_Sounds.end())
     {
@@ -55,80 +61,54 @@ namespace CodeSubWars
 
   void CSWSoundVisualizer::clear()
   {
+    std::lock_guard<std::mutex> lck(m_mtxEntries);
     m_Sounds.clear();
   }
 
 
-  void CSWSoundVisualizer::draw()
+  void CSWSoundVisualizer::collect(Mesh::InstanceContainer& instances)
   {
+    std::lock_guard<std::mutex> lck(m_mtxEntries);
     if (m_Sounds.empty())
       return;
   
-    SoundContainer newSounds;
-  
     double fCurrentTime = ARSTD::Time::getTime();
 
-    glPushAttrib(GL_ALL_ATTRIB_BITS);
-      glEnable(GL_DEPTH_TEST);
-      glDepthMask(false);
-
-      glShadeModel(GL_SMOOTH);
-
-      glEnable(GL_LIGHTING);
-      glEnable(GL_LIGHT0);
-      glEnable(GL_COLOR_MATERIAL);
-
-      glPolygonMode(GL_FRONT, GL_FILL);
-
-      glCullFace(GL_BACK);    
-      glEnable(GL_CULL_FACE);
-    
-      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-      glEnable(GL_BLEND);
-      glMatrixMode(GL_MODELVIEW);
-      glPushMatrix();
-
-      GLUquadricObj* pSphere = gluNewQuadric();
-      gluQuadricDrawStyle(pSphere, GLU_FILL);
-      Matrix44D mat;
-      SoundContainer::iterator itSounds = m_Sounds.begin();
-      for (; itSounds != m_Sounds.end(); ++itSounds)
+    //faded sounds and emitters without sounds are removed in place
+    SoundContainer::iterator itSounds = m_Sounds.begin();
+    while (itSounds != m_Sounds.end())
+    {
+      SoundEmits::iterator itEmits = itSounds->second.begin();
+      while (itEmits != itSounds->second.end())
       {
-        SoundEmits newEmits;
-        SoundEmits::iterator itEmits = itSounds->second.begin();
-        for (; itEmits != itSounds->second.end(); ++itEmits)
+        double fElapsedTime = fCurrentTime - itEmits->second.fStartTime;
+        double fRadius = 100*fElapsedTime;
+        double fAlpha = 1*(1/(fElapsedTime + 1) - 0.15 - (0.5 - 0.5*itEmits->second.fStartIntensity/250));
+        if (fAlpha > 0)
         {
-          double fElapsedTime = fCurrentTime - itEmits->second.fStartTime;
-          double fRadius = 100*fElapsedTime;
-          double fAlpha = 1*(1/(fElapsedTime + 1) - 0.15 - (0.5 - 0.5*itEmits->second.fStartIntensity/250));
-          if (fAlpha > 0)
-          {
-            glColor4d(0.1, 0.2, 1.0, fAlpha);
-            mat.getTranslation() = itEmits->second.vecPosition;
-            glLoadMatrixd(mat.pData);
-
-            gluSphere(pSphere, fRadius, 10, 10);
-            newEmits.insert(*itEmits);
-          }
+          Mesh::Instance instance;
+          instance.matTransform = Matrix44F(Matrix44D(Vector3D(fRadius, 0, 0), Vector3D(0, fRadius, 0), 
+                                                      Vector3D(0, 0, fRadius), itEmits->second.vecPosition));
+          instance.vecColor = Vector4F(0.1f, 0.2f, 1.0f, static_cast<float>(fAlpha));
+          instances.push_back(instance);
+          ++itEmits;
         }
-  
-        if (!newEmits.empty())
+        else
         {
-          itSounds->second = newEmits;
-          newSounds.insert(*itSounds);
+          itEmits = itSounds->second.erase(itEmits);
         }
       }
 
-      glDepthMask(true);
-      glPopMatrix();
-      gluDeleteQuadric(pSphere);
-    glPopAttrib();
-
-    m_Sounds.swap(newSounds);
+      if (itSounds->second.empty())
+        itSounds = m_Sounds.erase(itSounds);
+      else
+        ++itSounds;
+    }
   }
 
 
   CSWSoundVisualizer::CSWSoundVisualizer()
+  : m_bEnabled(false)
   {
   }
 
@@ -2,7 +2,7 @@
 // Released under the MIT license. (see license.txt)
 
     
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "Constants.h"
 #include "CSWSubmarine.h"
 #include "CSWWorld.h"
@@ -10,6 +10,7 @@
 #include "CSWLog.h"
 #include "CSWSettings.h"
 #include "CSWBattleStatistics.h"
+#include "CSWCPUAccount.h"
 #include "CSWExplosionVisualizer.h"
 #include "CSWSoundVisualizer.h"
 
@@ -17,6 +18,7 @@
 #include "CSWEventDealable.h"
 #include "CSWSolid.h"
 #include "CSWCollideable.h"
+#include "CSWShapeCache.h"
 #include "CSWPythonable.h"
 
 #include "CSWEventManager.h"
@@ -31,7 +33,6 @@
 #include "CSWWeaponBattery.h"
 #include "CSWWeaponSupply.h"
 
-#include "CSWSubmarineMesh.h"
 
 #include "GreenMine.h"
 #include "YellowMine.h"
@@ -44,7 +45,6 @@ namespace CodeSubWars
 {
 
   const double CSWSubmarine::MAX_OAR_ANGLE = PI/2;
-  const int CSWSubmarine::NUM_CYCLES = 100;  
 
   
   CSWSubmarine::~CSWSubmarine()
@@ -73,6 +73,13 @@ namespace CodeSubWars
   }
 
 
+  void CSWSubmarine::subscribeEvents(CSWEventManager::PtrType pEventManager)
+  {
+    //submarines get all broadcasts, their python code decides what to do with them
+    pEventManager->subscribeAll(getSharedThis());
+  }
+
+
   std::string CSWSubmarine::getCurrentInformation() const
   {
     return m_pEventDealable->getCurrentInformation();
@@ -91,19 +98,17 @@ namespace CodeSubWars
       return;
     try
     {
-      double fStart = ARSTD::Time::getRealTime();
+      double fStart = CSWCPUAccount::getTime();
     
       std::string strCurrentCommandName = m_pCommandable->getCommandProcessor()->getCurrentCommandName();
       m_pCommandable->step();
     
-      m_Times.push_back(ARSTD::Time::getRealTime() - fStart);
-      double fAvgTime = std::accumulate(m_Times.begin(), m_Times.end(), 0) / m_Times.capacity();
-      if (fAvgTime > Constants::CRITICAL_CONSUMING_TIME)
+      if (m_pCPUAccount->add(CSWCPUAccount::STEP, CSWCPUAccount::getTime() - fStart))
       {
         CSWWorld::getInstance()->getWorldGuard()->addErroneousObject(getSharedThis(), CSWWorldGuard::FATAL);
         std::stringstream ss;
         ss << getName() << "::" << strCurrentCommandName << " causes critical processor load (" 
-            << fAvgTime*1000.0 << "ms)";
+            << m_pCPUAccount->getAverageTime(CSWCPUAccount::STEP)*1000.0 << "ms)";
         CSWLog::getInstance()->log(ss.str());
       }
     }
@@ -131,27 +136,17 @@ namespace CodeSubWars
     AxisAlignedBoundingBoxD aabb = getSurface()->getAxisAlignedBoundingBox();
 
     double fRadius = std::max(aabb.getWidth(), aabb.getHeight())*0.5;
-    Vector3D vecDiameter(fRadius*2, fRadius*2, fRadius*2);
 
     Vector3D vecStart = aabb.getMin() + Vector3D(aabb.getWidth()*0.5, aabb.getHeight()*0.5, fRadius);
     Vector3D vecEnd = aabb.getMax() - Vector3D(aabb.getWidth()*0.5, aabb.getHeight()*0.5, fRadius);
 
-    DT_ShapeHandle hDTShape = DT_NewLineSegment(static_cast<Vector3F>(vecStart).pData, static_cast<Vector3F>(vecEnd).pData);
-    DT_ObjectHandle hDTObject = DT_CreateObject(this, hDTShape);
+    CSWShapeCache::ShapePtrType pDTShape = CSWShapeCache::getInstance()->getLineSegmentShape(vecStart, vecEnd);
+    DT_ObjectHandle hDTObject = DT_CreateObject(this, pDTShape.get());
     DT_SetMargin(hDTObject, fRadius);
 
-    Matrix44D matStart(vecStart);
-    matStart.getXAxis() = (vecEnd - vecStart).getNormalized();
-    matStart.getYAxis() = matStart.getXAxis().getPerpendicular();
-    matStart.getZAxis() = matStart.getXAxis()%matStart.getYAxis();
-    Matrix44D matEnd(matStart);
-    matEnd.getTranslation() = vecEnd;
-
-    Mesh::PtrType pCollisionMesh = Mesh::createEllipsoid(matStart, vecDiameter, 16, 16, 0, 8);
-    pCollisionMesh->add(Mesh::createCylinder(matStart, (vecEnd - vecStart).getLength(), fRadius*2, fRadius*2));
-    pCollisionMesh->add(Mesh::createEllipsoid(matEnd, vecDiameter, 16, 16, 8, 16));
+    Mesh::PtrType pCollisionMesh = CSWShapeCache::getInstance()->getCapsuleMesh(vecStart, vecEnd, fRadius);
   
-    m_pCollideable->initializeEnvironment(hDTShape, hDTObject, Matrix44D::IDENTITY, pCollisionMesh);
+    m_pCollideable->initializeEnvironment(this, pDTShape, hDTObject, Matrix44D::IDENTITY, pCollisionMesh);
   }
 
 
@@ -260,9 +255,10 @@ namespace CodeSubWars
 
       if (pDamObj)
       {
-        pDamObj->addDamage(m_fMaxExplosionDamage*fDistanceExplosionReduceFactor);
+        double fDamage = m_fMaxExplosionDamage*fDistanceExplosionReduceFactor;
+        pDamObj->addDamage(fDamage);
 
-        CSWWorld::getInstance()->getBattleStatistics()->reportHit(getSharedThis(), pObject);
+        CSWWorld::getInstance()->getBattleStatistics()->reportHit(getSharedThis(), pObject, fDamage);
         if (!pDamObj->isAlive())
           CSWWorld::getInstance()->getBattleStatistics()->reportKill(getSharedThis(), pObject);
       }
@@ -303,17 +299,17 @@ namespace CodeSubWars
   }
 
 
-  void CSWSubmarine::draw()
+  void CSWSubmarine::collectRenderData(CSWRenderFrame& frame, CSWRenderFrame::Entry& entry)
   {
     if (!isAlive())
       return;
   
-    CSWDamDynSolCol::draw();
+    CSWDamDynSolCol::collectRenderData(frame, entry);
   
     if (CSWWorld::getInstance()->getSettings()->getSelectedSolidObject() == getSharedThis())
     {
-      m_pControlCenter->getActiveSonar()->draw();
-      m_pControlCenter->getPassiveSonar()->draw();
+      m_pControlCenter->getActiveSonar()->collectRenderData(frame);
+      m_pControlCenter->getPassiveSonar()->collectRenderData(frame);
     }
   }
 
@@ -354,17 +350,32 @@ namespace CodeSubWars
   }
 
 
+  const std::string& CSWSubmarine::getBotName() const
+  {
+    return m_strBotName;
+  }
+
+
+  void CSWSubmarine::setBotName(const std::string& strBotName)
+  {
+    m_strBotName = strBotName;
+  }
+
+
+  CSWCPUAccount::PtrType CSWSubmarine::getCPUAccount()
+  {
+    return m_pCPUAccount;
+  }
+
+
   CSWSubmarine::CSWSubmarine(const std::string& strName, const Matrix44D& matBaseTObject, double fLength)
   : CSWDamDynSolCol(strName, matBaseTObject,
-                    Mesh::readSTL(std::istrstream(reinterpret_cast<const char*>(SUBMARINE_MESH), sizeof(SUBMARINE_MESH)))->transformed(Matrix44D(Vector4D(fLength, 0, 0, 0),
-                                                                                                                                                 Vector4D(0, fLength, 0, 0),
-                                                                                                                                                 Vector4D(0, 0, fLength, 0),
-                                                                                                                                                 Vector4D(0, 0, 0, 1))),
+                    CSWShapeCache::getInstance()->getSubmarineMesh(fLength),
                     false),
     m_pEventDealable(CSWEventDealable::create()),
     m_pCommandable(CSWCommandable::create()),
     m_pControlCenter(CSWControlCenter::create(strName + ".ControlCenter", Matrix44D())),
-    m_Times(NUM_CYCLES),
+    m_pCPUAccount(CSWCPUAccount::create()),
     m_nTeamID(0)
   {
     if (fLength < 30 || fLength > 110)
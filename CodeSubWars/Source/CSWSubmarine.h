@@ -18,6 +18,7 @@ namespace CodeSubWars
   class CSWCommandable;
 
   class CSWCommands;
+  class CSWCPUAccount;
 
   class CSWEngine;
   class CSWControlCenter;
@@ -45,6 +46,7 @@ namespace CodeSubWars
       //defined methods for eventdealable
       virtual void receiveEvent(std::shared_ptr<CSWEvent> pEvent);
       virtual void processReceivedQueuedEvents();
+      virtual void subscribeEvents(std::shared_ptr<CSWEventManager> pEventManager);
       virtual std::string getCurrentInformation() const;
       virtual std::string getCurrentMessage() const;
 
@@ -52,7 +54,7 @@ namespace CodeSubWars
       //processed. Returning true reports the eventmanager that the event passed to the object has successfully processed and delete it.
       //When returning false the event will be delivered the next time again until it expires or processed successfully.
       //The main function should be reacting to events e.g. seting up commands or something like that. The specialized class can implement everything 
-      //here, but the execution time must not exceed 6ms in average. If it does the object will be kicked from the world!
+      //here, but the processor time must not exceed the cpu budget (default 6ms) in average. If it does the object will be kicked from the world!
       //@param pEvent The incoming event that should be processed.
       //@return True if the incoming event has been successfully processed. When returning false the event will be delivered next time again.
       virtual bool processEvent(std::shared_ptr<CSWEvent> pEvent) { return true; }
@@ -67,7 +69,7 @@ namespace CodeSubWars
 
       //This method must be overriden in the specialized class. This methode is called periodically about every 10ms.
       //The main function should be checking sensors, seting up commands or something like that. The specialized class can implement everything 
-      //here, but the execution time must not exceed 6ms in average. If it does the object will be kicked from the world!
+      //here, but the processor time must not exceed the cpu budget (default 6ms) in average. If it does the object will be kicked from the world!
       virtual void update();
 
 
@@ -89,8 +91,8 @@ namespace CodeSubWars
       virtual void finalizeSoundEmission();
 
 
-      //defined methods for solid (draw debug stuff)
-      virtual void draw();
+      //defined methods for solid (adds debug stuff)
+      virtual void collectRenderData(CSWRenderFrame& frame, CSWRenderFrame::Entry& entry);
 
       Vector3D makeLocalDirection(const Vector3D& vecWorldTDirection);
       Vector3D makeGlobalDirection(const Vector3D& vecObjectTDirection);
@@ -100,6 +102,13 @@ namespace CodeSubWars
       int getTeamID() const;
       void setTeamID(int nID);
 
+      //name of the submarine file the submarine was created from, team members share it
+      const std::string& getBotName() const;
+      void setBotName(const std::string& strBotName);
+
+      //Returns the processor time consumed by the user code of this submarine.
+      std::shared_ptr<CSWCPUAccount> getCPUAccount();
+
       friend CSWCommands;
 
     protected:
@@ -118,7 +127,6 @@ namespace CodeSubWars
       std::shared_ptr<CSWWeaponBattery> getBackWeaponBattery();
 
       static const double MAX_OAR_ANGLE; //in Degree
-      static const int NUM_CYCLES;  
     
       //special properties
       std::shared_ptr<CSWEventDealable> m_pEventDealable;
@@ -137,13 +145,14 @@ namespace CodeSubWars
       std::shared_ptr<CSWWeaponBattery> m_pFrontRightWeaponBattery;
       std::shared_ptr<CSWWeaponBattery> m_pBackWeaponBattery;
     
-      boost::circular_buffer<double> m_Times;
+      std::shared_ptr<CSWCPUAccount> m_pCPUAccount;
   
       double m_fExplosionPower;
       double m_fExplosionRadius;
       double m_fMaxExplosionDamage;
     
       int m_nTeamID;
+      std::string m_strBotName;
   };
 
 }
\ No newline at end of file
@@ -0,0 +1,248 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#include "CorePrecompiledHeader.h"
+#include "CSWTournamentResults.h"
+
+
+namespace CodeSubWars
+{
+
+  CSWBotResult::CSWBotResult()
+  : nNumBattles(0),
+    nNumWins(0),
+    nNumKills(0),
+    nNumDeaths(0),
+    nNumHits(0),
+    nNumFiredWeapons(0),
+    fDamageDealt(0),
+    fDamageTaken(0),
+    fRating(CSWTournamentResults::INITIAL_RATING)
+  {
+  }
+
+
+  double CSWBotResult::getWinRate() const
+  {
+    return nNumBattles > 0 ? static_cast<double>(nNumWins)/nNumBattles : 0;
+  }
+
+
+
+  const double CSWTournamentResults::INITIAL_RATING = 1500;
+  const double CSWTournamentResults::RATING_FACTOR = 32;
+
+
+  CSWTournamentResults::PtrType CSWTournamentResults::create(const std::string& strFileName)
+  {
+    return PtrType(new CSWTournamentResults(strFileName));
+  }
+
+
+  CSWTournamentResults::~CSWTournamentResults()
+  {
+  }
+
+
+  bool CSWTournamentResults::load()
+  {
+    m_Results.clear();
+    m_nNumBattles = 0;
+
+    std::ifstream is(m_strFileName.c_str());
+    if (!is)
+      return !ARSTD::FileSystem::exists(m_strFileName);
+
+    //battle,world,bot,rank,kills,deaths,hits,fired,damage_dealt,damage_taken
+    std::string strBattleID;
+    std::string strWorld;
+    ParticipantContainer participants;
+    std::string strLine;
+    std::getline(is, strLine);
+    while (std::getline(is, strLine))
+    {
+      std::vector<std::string> fields;
+      std::string::size_type nStart = 0;
+      std::string::size_type nEnd = 0;
+      while ((nEnd = strLine.find(',', nStart)) != std::string::npos)
+      {
+        fields.push_back(strLine.substr(nStart, nEnd - nStart));
+        nStart = nEnd + 1;
+      }
+      fields.push_back(strLine.substr(nStart));
+      if (fields.size() != 10)
+        continue;
+
+      //the rows of a battle are consecutive
+      if (fields[0] != strBattleID)
+      {
+        if (!participants.empty())
+          account(strWorld, participants);
+        participants.clear();
+        strBattleID = fields[0];
+        strWorld = fields[1];
+      }
+
+      Participant participant;
+      participant.strBot = fields[2];
+      participant.nRank = atoi(fields[3].c_str());
+      participant.nNumKills = atoi(fields[4].c_str());
+      participant.nNumDeaths = atoi(fields[5].c_str());
+      participant.nNumHits = atoi(fields[6].c_str());
+      participant.nNumFiredWeapons = atoi(fields[7].c_str());
+      participant.fDamageDealt = atof(fields[8].c_str());
+      participant.fDamageTaken = atof(fields[9].c_str());
+      participants.push_back(participant);
+    }
+    if (!participants.empty())
+      account(strWorld, participants);
+
+    return true;
+  }
+
+
+  bool CSWTournamentResults::addBattle(const std::string& strBattleID, const std::string& strWorld, const ParticipantContainer& participants)
+  {
+    if (participants.empty())
+      return false;
+
+    std::stringstream ss;
+    if (!ARSTD::FileSystem::exists(m_strFileName))
+      ss << "battle,world,bot,rank,kills,deaths,hits,fired,damage_dealt,damage_taken\n";
+    ParticipantContainer::const_iterator it = participants.begin();
+    for (; it != participants.end(); ++it)
+    {
+      ss << getField(strBattleID) << "," << getField(strWorld) << "," << getField(it->strBot) << "," 
+         << it->nRank << "," << it->nNumKills << "," << it->nNumDeaths << "," << it->nNumHits << "," 
+         << it->nNumFiredWeapons << "," << it->fDamageDealt << "," << it->fDamageTaken << "\n";
+    }
+
+    //the battle is written at once, so battles of other processes do not interleave
+    {
+      std::ofstream os(m_strFileName.c_str(), std::ios::out | std::ios::app);
+      std::string str = ss.str();
+      os.write(str.c_str(), str.size());
+      if (!os)
+        return false;
+    }
+
+    return load();
+  }
+
+
+  const CSWBotResult* CSWTournamentResults::find(const std::string& strBot, const std::string& strWorld) const
+  {
+    WorldResultMap::const_iterator itWorld = m_Results.find(strWorld);
+    if (itWorld == m_Results.end())
+      return NULL;
+    BotResultMap::const_iterator itBot = itWorld->second.find(strBot);
+    if (itBot == itWorld->second.end())
+      return NULL;
+    return &itBot->second;
+  }
+
+
+  CSWTournamentResults::BotResultContainer CSWTournamentResults::getRanking(const std::string& strWorld) const
+  {
+    BotResultContainer results;
+    WorldResultMap::const_iterator itWorld = m_Results.find(strWorld);
+    if (itWorld == m_Results.end())
+      return results;
+
+    BotResultMap::const_iterator itBot = itWorld->second.begin();
+    for (; itBot != itWorld->second.end(); ++itBot)
+      results.push_back(itBot->second);
+    std::sort(results.begin(), results.end(),
+              [](const CSWBotResult& lhs, const CSWBotResult& rhs) { return lhs.fRating > rhs.fRating; });
+    return results;
+  }
+
+
+  int CSWTournamentResults::getNumberBattles() const
+  {
+    return m_nNumBattles;
+  }
+
+
+  CSWTournamentResults::CSWTournamentResults(const std::string& strFileName)
+  : m_strFileName(strFileName),
+    m_nNumBattles(0)
+  {
+  }
+
+
+  void CSWTournamentResults::account(const std::string& strWorld, const ParticipantContainer& participants)
+  {
+    account(m_Results[strWorld], strWorld, participants);
+    account(m_Results[""], "", participants);
+    ++m_nNumBattles;
+  }
+
+
+  void CSWTournamentResults::account(BotResultMap& results, const std::string& strWorld, const ParticipantContainer& participants)
+  {
+    std::vector<CSWBotResult*> botResults;
+    ParticipantContainer::const_iterator it = participants.begin();
+    for (; it != participants.end(); ++it)
+    {
+      CSWBotResult& result = results[it->strBot];
+      if (!result.nNumBattles)
+      {
+        result.strBot = it->strBot;
+        result.strWorld = strWorld;
+      }
+      botResults.push_back(&result);
+    }
+
+    //every participant plays a duel against each other, the rating changes of one battle are based on the ratings
+    //before the battle
+    size_t nNumParticipants = participants.size();
+    std::vector<double> ratingChanges(nNumParticipants, 0);
+    if (nNumParticipants > 1)
+    {
+      double fFactor = RATING_FACTOR/(nNumParticipants - 1);
+      for (size_t i = 0; i < nNumParticipants; ++i)
+      {
+        for (size_t j = i + 1; j < nNumParticipants; ++j)
+        {
+          double fExpected = 1/(1 + pow(10.0, (botResults[j]->fRating - botResults[i]->fRating)/400));
+          double fScore = participants[i].nRank < participants[j].nRank ? 1 : 
+                          participants[i].nRank > participants[j].nRank ? 0 : 0.5;
+          ratingChanges[i] += fFactor*(fScore - fExpected);
+          ratingChanges[j] -= fFactor*(fScore - fExpected);
+        }
+      }
+    }
+
+    for (size_t i = 0; i < nNumParticipants; ++i)
+    {
+      const Participant& participant = participants[i];
+      CSWBotResult& result = *botResults[i];
+      bool bWon = participant.nRank == 1;
+      for (size_t j = 0; j < nNumParticipants && bWon; ++j)
+        bWon = j == i || participants[j].nRank > 1;
+
+      ++result.nNumBattles;
+      result.nNumWins += bWon ? 1 : 0;
+      result.nNumKills += participant.nNumKills;
+      result.nNumDeaths += participant.nNumDeaths;
+      result.nNumHits += participant.nNumHits;
+      result.nNumFiredWeapons += participant.nNumFiredWeapons;
+      result.fDamageDealt += participant.fDamageDealt;
+      result.fDamageTaken += participant.fDamageTaken;
+      result.fRating += ratingChanges[i];
+    }
+  }
+
+
+  std::string CSWTournamentResults::getField(const std::string& str)
+  {
+    //names are written without quoting
+    std::string strField(str);
+    std::replace(strField.begin(), strField.end(), ',', '_');
+    std::replace(strField.begin(), strField.end(), '\n', '_');
+    return strField;
+  }
+
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#pragma once
+
+
+namespace CodeSubWars
+{
+
+  /**
+   * The accumulated results of one submarine (bot) in one world setup or in all world setups.
+   */
+  struct CSWBotResult
+  {
+    CSWBotResult();
+
+    double getWinRate() const;
+
+    std::string strBot;
+    std::string strWorld;     ///< Empty for the results of all world setups.
+    int nNumBattles;
+    int nNumWins;             ///< Battles the bot finished alone on the first rank.
+    int nNumKills;
+    int nNumDeaths;
+    int nNumHits;
+    int nNumFiredWeapons;
+    double fDamageDealt;
+    double fDamageTaken;
+    double fRating;           ///< Elo rating, each battle is accounted as duel of every pair of participants.
+  };
+
+
+  /**
+   * Store of the results of many battles. Each battle is appended as one block of rows to a csv file, so several
+   * processes may add battles to the same file. The accumulated results and ratings are kept in memory per bot and
+   * world setup and are rebuilt from the file in the order the battles were added.
+   */
+  class CSWTournamentResults
+  {
+    public:
+      typedef std::shared_ptr<CSWTournamentResults> PtrType;
+      typedef std::vector<CSWBotResult> BotResultContainer;
+
+      /**
+       * The result of one bot in one battle. In team battles all submarines of the bot are accounted together.
+       */
+      struct Participant
+      {
+        std::string strBot;
+        int nRank;
+        int nNumKills;
+        int nNumDeaths;
+        int nNumHits;
+        int nNumFiredWeapons;
+        double fDamageDealt;
+        double fDamageTaken;
+      };
+
+      typedef std::vector<Participant> ParticipantContainer;
+
+      static const double INITIAL_RATING;
+      static const double RATING_FACTOR;
+
+      static PtrType create(const std::string& strFileName);
+
+      ~CSWTournamentResults();
+
+      /**
+       * Reads all battles of the file. Battles added by other processes are accounted in the order of the file.
+       * @return False if the file exists but could not be read.
+       */
+      bool load();
+
+      /**
+       * Appends the battle to the file and reloads it.
+       * @return False if the battle could not be written.
+       */
+      bool addBattle(const std::string& strBattleID, const std::string& strWorld, const ParticipantContainer& participants);
+
+      /**
+       * @return The results of the bot in the given world setup or in all world setups if no world is given. NULL if 
+       *         the bot has no battle there.
+       */
+      const CSWBotResult* find(const std::string& strBot, const std::string& strWorld = "") const;
+
+      /**
+       * @return The results of all bots in the given world setup or in all world setups, sorted by descending rating.
+       */
+      BotResultContainer getRanking(const std::string& strWorld = "") const;
+
+      int getNumberBattles() const;
+
+    protected:
+      //bot -> result
+      typedef std::unordered_map<std::string, CSWBotResult> BotResultMap;
+      //world -> results of the bots
+      typedef std::unordered_map<std::string, BotResultMap> WorldResultMap;
+
+      CSWTournamentResults(const std::string& strFileName);
+
+      void account(const std::string& strWorld, const ParticipantContainer& participants);
+      void account(BotResultMap& results, const std::string& strWorld, const ParticipantContainer& participants);
+
+      static std::string getField(const std::string& str);
+
+      std::string m_strFileName;
+      WorldResultMap m_Results;
+      int m_nNumBattles;
+  };
+
+}
\ No newline at end of file
@@ -2,11 +2,13 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWTransceiver.h"
+#include "CSWObjectPool.h"
 #include "CSWEventDealable.h"
 
 #include "CSWEvent.h"
+#include "CSWEventManager.h"
 #include "CSWTransceiverMessage.h"
 
 
@@ -18,7 +20,7 @@ namespace CodeSubWars
 
   CSWTransceiver::PtrType CSWTransceiver::create(const std::string& strName)
   {
-    return PtrType(new CSWTransceiver(strName));
+    return CSWObjectPool::create<CSWTransceiver>([&](void* pBlock) { return new (pBlock) CSWTransceiver(strName); });
   }
 
 
@@ -39,6 +41,12 @@ namespace CodeSubWars
   }
 
 
+  void CSWTransceiver::subscribeEvents(CSWEventManager::PtrType pEventManager)
+  {
+    pEventManager->subscribe<CSWTransceiverMessage>(getSharedThis());
+  }
+
+
   bool CSWTransceiver::processEvent(CSWEvent::PtrType pEvent)
   {
     //get all messages an decrypt (front received first)
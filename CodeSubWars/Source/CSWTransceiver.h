@@ -31,6 +31,7 @@ namespace CodeSubWars
       //defined methods for eventdealable
       virtual void receiveEvent(std::shared_ptr<CSWEvent> pEvent);
       virtual void processReceivedQueuedEvents();
+      virtual void subscribeEvents(std::shared_ptr<CSWEventManager> pEventManager);
       virtual bool processEvent(std::shared_ptr<CSWEvent> pEvent);
       virtual std::string getCurrentInformation() const;
       virtual std::string getCurrentMessage() const;
@@ -2,7 +2,7 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWTrigger.h"
 #include "CSWCollideable.h"
 
@@ -15,12 +15,9 @@ namespace CodeSubWars
   }
 
 
-  void CSWTrigger::draw()
+  void CSWTrigger::collectRenderData(CSWRenderFrame& frame) const
   {
-    glPushMatrix();
-    glLoadMatrixd(getWorldTransform().pData);
-    m_pCollideable->draw(getTransform());
-    glPopMatrix();
+    m_pCollideable->collectRenderData(frame, getWorldTransform());
   }
 
 
@@ -40,14 +37,14 @@ namespace CodeSubWars
   {
     BoundingBoxD bbox(m_pCollideable->getMesh()->getAxisAlignedBoundingBox());
     Size3D size = bbox.getSize();
-    DT_ShapeHandle hDTShape = DT_NewBox(size.getWidth(), size.getHeight(), size.getDepth());
+    CSWShapeCache::ShapePtrType pDTShape = CSWShapeCache::getInstance()->getBoxShape(size);
 
-    DT_ObjectHandle hDTObject = DT_CreateObject(this, hDTShape);
+    DT_ObjectHandle hDTObject = DT_CreateObject(this, pDTShape.get());
 
     Matrix44D matObjectTCollisionShape(Vector3D(bbox.getCenter()));
-    Mesh::PtrType pCollisionMesh = Mesh::createBox(bbox.getCoordSystem(), bbox.getSize());
+    Mesh::PtrType pCollisionMesh = CSWShapeCache::getInstance()->getBoxMesh(bbox.getCoordSystem().getTranslation(), size);
 
-    m_pCollideable->initializeEnvironment(hDTShape, hDTObject, matObjectTCollisionShape, pCollisionMesh);
+    m_pCollideable->initializeEnvironment(this, pDTShape, hDTObject, matObjectTCollisionShape, pCollisionMesh);
   }
 
 
@@ -59,7 +56,7 @@ namespace CodeSubWars
 
   void CSWTrigger::setupTransform()
   {
-    m_pCollideable->setupTransform(getSharedThis());
+    m_pCollideable->setupTransform();
   }
 
 
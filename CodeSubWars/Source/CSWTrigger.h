@@ -13,6 +13,7 @@ namespace CodeSubWars
 {
 
   class CSWCollideable;
+  struct CSWRenderFrame;
 
   // the base class for tirgger objects
   class CSWTrigger : public CSWObject,
@@ -23,7 +24,8 @@ namespace CodeSubWars
 
       virtual ~CSWTrigger();
 
-      void draw();
+      //adds the collision mesh for debugging
+      void collectRenderData(CSWRenderFrame& frame) const;
 
       //defined methods for collideable
       virtual const Mesh::PtrType getCollisionMesh() const;
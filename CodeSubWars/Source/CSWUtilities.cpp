@@ -2,9 +2,8 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWUtilities.h"
-#include "glut.h"
 
 
 namespace CodeSubWars
@@ -76,11 +75,26 @@ namespace CodeSubWars
   }
 
 
+  std::mt19937& CSWUtilities::getRandomGenerator()
+  {
+    static std::mt19937 generator;
+    return generator;
+  }
+
+
+  int CSWUtilities::getRandomInteger(int nMin, int nMax)
+  {
+    return std::uniform_int_distribution<int>(nMin, nMax)(getRandomGenerator());
+  }
+
+
   Vector3D CSWUtilities::getRandomPosition()
   {
-    return Vector3D((rand() - RAND_MAX/2)/static_cast<double>(RAND_MAX), 
-                    (rand() - RAND_MAX/2)/static_cast<double>(RAND_MAX), 
-                    (rand() - RAND_MAX/2)/static_cast<double>(RAND_MAX));
+    std::uniform_real_distribution<double> distribution(-0.5, 0.5);
+    double x = distribution(getRandomGenerator());
+    double y = distribution(getRandomGenerator());
+    double z = distribution(getRandomGenerator());
+    return Vector3D(x, y, z);
   }
 
 
@@ -102,21 +116,18 @@ namespace CodeSubWars
   }
 
 
-  QString CSWUtilities::getUniqueFilename(const QString strPath)
+  std::string CSWUtilities::getUniqueFilename(const std::string& strPath)
   {
-    if (!QDir().exists(strPath))
+    if (!ARSTD::FileSystem::isDirectory(strPath))
       throw std::runtime_error("could not determine unique file");
 
-    QString strFileName;
+    std::string strFileName;
     int nCntTries(50);
     bool bSuccess(false);
     while (!bSuccess && --nCntTries > 0)
     {
-      strFileName = QDateTime::currentDateTime().toString("yyyy-MM-dd__hh-mm-ss-zzz");
-      std::stringstream path;
-      path << strPath.toStdString() << "/" << strFileName.toStdString();
-
-      bSuccess = !QFile(path.str().c_str()).exists();
+      strFileName = getCurrentDateTime("%Y-%m-%d__%H-%M-%S-%f");
+      bSuccess = !ARSTD::FileSystem::exists(strPath + "/" + strFileName);
     }
   
     if (!bSuccess)
@@ -126,6 +137,35 @@ namespace CodeSubWars
   }
 
 
+  std::string CSWUtilities::getCurrentDateTime(const std::string& strFormat)
+  {
+    std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+    std::time_t t = std::chrono::system_clock::to_time_t(now);
+    int nMilliseconds = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000);
+
+    std::tm localTime;
+#ifdef _WIN32
+    localtime_s(&localTime, &t);
+#else
+    localtime_r(&t, &localTime);
+#endif
+
+    //strftime does not know milliseconds
+    std::string strFormatWithMilliseconds(strFormat);
+    std::string::size_type nIdx = strFormatWithMilliseconds.find("%f");
+    if (nIdx != std::string::npos)
+    {
+      std::stringstream ss;
+      ss << std::setw(3) << std::setfill('0') << nMilliseconds;
+      strFormatWithMilliseconds.replace(nIdx, 2, ss.str());
+    }
+
+    char pBuffer[128];
+    size_t nLength = strftime(pBuffer, sizeof(pBuffer), strFormatWithMilliseconds.c_str(), &localTime);
+    return std::string(pBuffer, nLength);
+  }
+
+
   Vector4D CSWUtilities::interpolateComponentsLinear(const Vector4D& vec1, const Vector4D& vec2, double fFactor)
   {
     if (fFactor <= 0)
@@ -140,58 +180,6 @@ namespace CodeSubWars
   }
 
 
-  std::pair<bool, Vector3D> CSWUtilities::getWindowCoords(const Vector3D& vecWorldTPos)
-  {
-    int viewport[4];
-    glGetIntegerv(GL_VIEWPORT, viewport);
-
-    Matrix44D matCurrentModelview;
-    glGetDoublev(GL_MODELVIEW_MATRIX, matCurrentModelview.pData);
-
-    Matrix44D matCurrentProjection;
-    glGetDoublev(GL_PROJECTION_MATRIX, matCurrentProjection.pData);
-
-    Vector3D vecWindowTPosition;
-    int nResult = gluProject(vecWorldTPos.x, vecWorldTPos.y, vecWorldTPos.z,
-                             matCurrentModelview.pData,
-                             matCurrentProjection.pData,
-                             viewport,
-                             &vecWindowTPosition.x, &vecWindowTPosition.y, &vecWindowTPosition.z);
-  
-    return std::make_pair(nResult == GL_TRUE, vecWindowTPosition);
-  }
-
-
-  std::vector<Vector3D> CSWUtilities::getWindowCoords(const std::vector<Vector3D> positions)
-  {
-    int viewport[4];
-    glGetIntegerv(GL_VIEWPORT, viewport);
-
-    Matrix44D matCurrentModelview;
-    glGetDoublev(GL_MODELVIEW_MATRIX, matCurrentModelview.pData);
-
-    Matrix44D matCurrentProjection;
-    glGetDoublev(GL_PROJECTION_MATRIX, matCurrentProjection.pData);
-
-    std::vector<Vector3D> windowPositions(positions.size());
-    int nResult = GL_TRUE;
-    std::vector<Vector3D>::const_iterator it = positions.begin();
-    std::vector<Vector3D>::iterator itWndPos = windowPositions.begin();
-    for (; it != positions.end() && nResult == GL_TRUE; ++it, ++itWndPos)
-    {
-      nResult &= gluProject(it->x, it->y, it->z,
-                            matCurrentModelview.pData,
-                            matCurrentProjection.pData,
-                            viewport,
-                            &itWndPos->x, &itWndPos->y, &itWndPos->z);
-    }
-  
-    if (nResult != GL_TRUE)
-      windowPositions.clear();
-    return windowPositions;
-  }
-
-
   Vector3D CSWUtilities::calcColorR2G2B(double fValue)
   {
     Vector3D col(0, 0, 0);
@@ -223,20 +211,14 @@ namespace CodeSubWars
 
   bool CSWUtilities::isValidSubmarineFile(const std::string& strAbsPath, const std::string& strSubmarineName)
   {
-    QFile file(strAbsPath.c_str());
-    file.open(QIODevice::ReadOnly);
-    QTextStream stream(&file);
-    while (!stream.atEnd())
+    std::ifstream file(strAbsPath.c_str());
+    std::string strLine;
+    while (std::getline(file, strLine))
     {
-      QString strLine = stream.readLine();
-      strLine.replace(" ", "");
-      if (strLine.contains(QString("class") + strSubmarineName.c_str() + "(CSWPySubmarine):"))
-      {
-        file.close();
+      strLine.erase(std::remove(strLine.begin(), strLine.end(), ' '), strLine.end());
+      if (strLine.find("class" + strSubmarineName + "(CSWPySubmarine):") != std::string::npos)
         return true;
-      }
     }
-    file.close();
     return false;
   }
 
@@ -244,32 +226,29 @@ namespace CodeSubWars
   CSWUtilities::SubmarineFileContainer CSWUtilities::determineAvailableSubmarines(const std::string& strAbsPath)
   {
     SubmarineFileContainer submarines;
-    QDir d(QString(strAbsPath.c_str()));
-  
-    d.setFilter(QDir::Files | QDir::Dirs | QDir::NoSymLinks);
-    d.setSorting(QDir::Name);
-
-    QFileInfoList list = d.entryInfoList();
+    std::vector<ARSTD::FileSystem::Entry> entries = ARSTD::FileSystem::getEntries(strAbsPath);
     // if directory does not exist do nothing
-    if (list.isEmpty())
+    if (entries.empty())
       return CSWUtilities::SubmarineFileContainer();
 
     // scan given directory
-    for (int i = 0; i < list.size(); ++i) 
+    std::vector<ARSTD::FileSystem::Entry>::const_iterator it = entries.begin();
+    for (; it != entries.end(); ++it)
     {
-      QFileInfo fi = list.at(i);
+      std::string strAbsFileName = ARSTD::FileSystem::getAbsolutePath(strAbsPath + "/" + it->strName);
   
-      if (fi.isFile() && fi.suffix() == "py")
+      if (!it->bDirectory && ARSTD::FileSystem::getSuffix(it->strName) == "py")
       {
-        if (CSWUtilities::isValidSubmarineFile(fi.absoluteFilePath().toStdString(), fi.baseName().toStdString()))
+        std::string strBaseName = ARSTD::FileSystem::getBaseName(it->strName);
+        if (CSWUtilities::isValidSubmarineFile(strAbsFileName, strBaseName))
         {
-          submarines[fi.baseName().toStdString()] = fi.absoluteFilePath().toStdString();
+          submarines[strBaseName] = strAbsFileName;
         }
       }
-      else if (fi.isDir() && fi.fileName() != "." && fi.fileName() != ".." && !fi.isSymLink())
+      else if (it->bDirectory)
       {
         // subdir found -> scan
-        SubmarineFileContainer subs = determineAvailableSubmarines(fi.absoluteFilePath().toStdString());
+        SubmarineFileContainer subs = determineAvailableSubmarines(strAbsFileName);
         submarines.insert(subs.begin(), subs.end());
       }
     }
@@ -22,17 +22,29 @@ namespace CodeSubWars
       static Vector3D determineAngles(const Matrix44D& mat);
       static Vector3D determineAngles(const Matrix33D& mat);
 
+      /**
+       * Returns the random generator of the simulation. All random numbers of the simulation are taken from it, so
+       * its state can be stored and restored with a world snapshot.
+       */
+      static std::mt19937& getRandomGenerator();
+
+      //returns a random number in range [nMin, nMax]
+      static int getRandomInteger(int nMin, int nMax);
+
       static Vector3D getRandomPosition();
       static Vector3D getRandomDirection();
       static Matrix44D getRandomOrientation();
 
-      static QString getUniqueFilename(const QString strPath);
+      static std::string getUniqueFilename(const std::string& strPath);
+
+      /**
+       * Returns the current local date and time formatted like strftime(). Additionally %f is replaced by the 
+       * milliseconds.
+       */
+      static std::string getCurrentDateTime(const std::string& strFormat);
     
       static Vector4D interpolateComponentsLinear(const Vector4D& vec1, const Vector4D& vec2, double fFactor);
 
-      static std::pair<bool, Vector3D> getWindowCoords(const Vector3D& vecWorldTPos);
-
-      static std::vector<Vector3D> getWindowCoords(const std::vector<Vector3D> positions);
     
       static Vector3D calcColorR2G2B(double fValue);
 
@@ -2,7 +2,7 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWVariousCommands.h"
 #include "CSWEngine.h"
 #include "CSWEvent.h"
@@ -14,7 +14,7 @@
 namespace CodeSubWars
 {
 
-  CSWSetEngineIntensityCommand::PtrType CSWSetEngineIntensityCommand::create(CSWEngine::PtrType& pEngine, const double& fIntensity)
+  CSWSetEngineIntensityCommand::PtrType CSWSetEngineIntensityCommand::create(const CSWEngine::PtrType& pEngine, const double& fIntensity)
   {
     return PtrType(new CSWSetEngineIntensityCommand(pEngine, fIntensity));
   }
@@ -68,13 +68,13 @@ namespace CodeSubWars
 
 
 
-  CSWSetEngineDirectionCommand::PtrType CSWSetEngineDirectionCommand::create(CSWEngine::PtrType& pEngine, const double& fHAngle, const double& fVAngle)
+  CSWSetEngineDirectionCommand::PtrType CSWSetEngineDirectionCommand::create(const CSWEngine::PtrType& pEngine, const double& fHAngle, const double& fVAngle)
   {
     return PtrType(new CSWSetEngineDirectionCommand(pEngine, fHAngle, fVAngle));
   }
 
 
-  CSWSetEngineDirectionCommand::PtrType CSWSetEngineDirectionCommand::create(CSWEngine::PtrType& pEngine, const Vector3D& vecDirection)
+  CSWSetEngineDirectionCommand::PtrType CSWSetEngineDirectionCommand::create(const CSWEngine::PtrType& pEngine, const Vector3D& vecDirection)
   {
     return PtrType(new CSWSetEngineDirectionCommand(pEngine, vecDirection));
   }
@@ -216,9 +216,9 @@ namespace CodeSubWars
 
 
 
-  CSWFireCommand::PtrType CSWFireCommand::create(CSWWeaponBattery::PtrType& pWeaponBattery, 
+  CSWFireCommand::PtrType CSWFireCommand::create(const CSWWeaponBattery::PtrType& pWeaponBattery, 
                                                  double fArmDelay, 
-                                                 CSWWeapon::PtrType& pWeapon)
+                                                 const CSWWeapon::PtrType& pWeapon)
   {
     return PtrType(new CSWFireCommand(pWeaponBattery, fArmDelay, pWeapon));
   }
@@ -286,7 +286,7 @@ namespace CodeSubWars
 
 
 
-  CSWRechargeWeaponBatteryCommand::PtrType CSWRechargeWeaponBatteryCommand::create(CSWWeaponBattery::PtrType& pWeaponBattery, 
+  CSWRechargeWeaponBatteryCommand::PtrType CSWRechargeWeaponBatteryCommand::create(const CSWWeaponBattery::PtrType& pWeaponBattery, 
                                                                                    const std::string& strSupplyName,
                                                                                    unsigned long nResourceIDs)
   {
@@ -29,7 +29,7 @@ namespace CodeSubWars
        * @param fIntensity The new intensity in range [-1, 1].
        * @return Returns the new constructed command.
        */
-      static PtrType create(std::shared_ptr<CSWEngine>& pEngine, const double& fIntensity);
+      static PtrType create(const std::shared_ptr<CSWEngine>& pEngine, const double& fIntensity);
 
       virtual ARSTD::Command::PtrType copy() const;
 
@@ -66,7 +66,7 @@ namespace CodeSubWars
        * @param fVAngle The new vertical angle. Positiv means upward (in degree).
        * @return Returns the new constructed command.
        */
-      static PtrType create(std::shared_ptr<CSWEngine>& pEngine, const double& fHAngle, const double& fVAngle);
+      static PtrType create(const std::shared_ptr<CSWEngine>& pEngine, const double& fHAngle, const double& fVAngle);
 
       /**
        * Creates a new command that let the given engine change its direction.
@@ -74,7 +74,7 @@ namespace CodeSubWars
        * @param vecDirection The new direction relative to its parent.
        * @return Returns the new constructed command.
        */
-      static PtrType create(std::shared_ptr<CSWEngine>& pEngine, const Vector3D& vecDirection);
+      static PtrType create(const std::shared_ptr<CSWEngine>& pEngine, const Vector3D& vecDirection);
 
       virtual ARSTD::Command::PtrType copy() const;
 
@@ -150,9 +150,9 @@ namespace CodeSubWars
        *                If None is given the next available Weapon will be launched. (by default None)
        * @return Returns the new constructed command.
        */
-      static PtrType create(std::shared_ptr<CSWWeaponBattery>& pWeaponBattery, 
+      static PtrType create(const std::shared_ptr<CSWWeaponBattery>& pWeaponBattery, 
                             double fArmDelay = 5.0,
-                            std::shared_ptr<CSWWeapon>& pWeapon = std::shared_ptr<CSWWeapon>());
+                            const std::shared_ptr<CSWWeapon>& pWeapon = std::shared_ptr<CSWWeapon>());
 
       virtual ARSTD::Command::PtrType copy() const;
 
@@ -193,7 +193,7 @@ namespace CodeSubWars
        * @param nResourceIDs The ORed combination of resourceIDs that should be recharged at that supply.
        * @return Returns the new constructed command.
        */
-      static PtrType create(std::shared_ptr<CSWWeaponBattery>& pWeaponBattery, 
+      static PtrType create(const std::shared_ptr<CSWWeaponBattery>& pWeaponBattery, 
                             const std::string& strSupplyName, 
                             unsigned long nResourceIDs);
 
@@ -2,10 +2,11 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWWall.h"
 #include "CSWSolid.h"
 #include "CSWCollideable.h"
+#include "CSWShapeCache.h"
 #include "CSWEvent.h"
 #include "CSWCollisionDetectedMessage.h"
 
@@ -20,12 +21,12 @@ namespace CodeSubWars
   }
 
 
-  void CSWWall::draw()
+  void CSWWall::collectRenderData(CSWRenderFrame& frame, CSWRenderFrame::Entry& entry)
   {
-    m_pSolid->draw(getTransform());
+    m_pSolid->collectRenderData(entry);
 
     //for debugging collision
-    m_pCollideable->draw(getTransform());
+    m_pCollideable->collectRenderData(frame, entry.matWorldTransform);
   }
 
 
@@ -56,19 +57,10 @@ namespace CodeSubWars
   CSWWall::CSWWall(const std::string& strName, const Matrix44D& matBaseTObject, const Size3D& size)
   : CSWObject(strName, matBaseTObject)
   {
-    Matrix44D mat1(Vector3D(1, 0, 0),
-                   Vector3D(0, 1, 0),
-                   Vector3D(0, 0, 1),
-                   Vector3D(-size.getWidth()/2.0, -size.getHeight()/2.0, -size.getDepth()/2.0));
-    Mesh::PtrType pSurface = Mesh::createBox(mat1, size);
+    //surface and collision mesh are the same box
+    Mesh::PtrType pSurface = CSWShapeCache::getInstance()->getBoxMesh(Vector3D(-size.getWidth()/2.0, -size.getHeight()/2.0, -size.getDepth()/2.0), size);
     m_pSolid = CSWSolid::create(pSurface);
-
-    Matrix44D mat2(Vector3D(1, 0, 0),
-                   Vector3D(0, 1, 0),
-                   Vector3D(0, 0, 1),
-                   Vector3D(-size.getWidth()/2.0, -size.getHeight()/2.0, -size.getDepth()/2.0));
-    Mesh::PtrType pCollisionMesh = Mesh::createBox(mat2, size);
-    m_pCollideable = CSWCollideable::create(pCollisionMesh);
+    m_pCollideable = CSWCollideable::create(pSurface);
   
     setColor(Vector4D(1, 1, 0, 1));
   }
@@ -90,14 +82,14 @@ namespace CodeSubWars
   {
     BoundingBoxD bbox(m_pCollideable->getMesh()->getAxisAlignedBoundingBox());
     Size3D size = bbox.getSize();
-    DT_ShapeHandle hDTShape = DT_NewBox(size.getWidth(), size.getHeight(), size.getDepth());
+    CSWShapeCache::ShapePtrType pDTShape = CSWShapeCache::getInstance()->getBoxShape(size);
 
-    DT_ObjectHandle hDTObject = DT_CreateObject(this, hDTShape);
+    DT_ObjectHandle hDTObject = DT_CreateObject(this, pDTShape.get());
 
     Matrix44D matObjectTCollisionShape(Vector3D(bbox.getCenter()));
-    Mesh::PtrType pCollisionMesh = Mesh::createBox(bbox.getCoordSystem(), bbox.getSize());
+    Mesh::PtrType pCollisionMesh = CSWShapeCache::getInstance()->getBoxMesh(bbox.getCoordSystem().getTranslation(), size);
 
-    m_pCollideable->initializeEnvironment(hDTShape, hDTObject, matObjectTCollisionShape, pCollisionMesh);
+    m_pCollideable->initializeEnvironment(this, pDTShape, hDTObject, matObjectTCollisionShape, pCollisionMesh);
   }
 
 
@@ -109,7 +101,7 @@ namespace CodeSubWars
 
   void CSWWall::setupTransform()
   {
-    m_pCollideable->setupTransform(getSharedThis());
+    m_pCollideable->setupTransform();
   }
 
 
@@ -28,7 +28,7 @@ namespace CodeSubWars
       virtual ~CSWWall();
 
       //defined methods for solid
-      virtual void draw();
+      virtual void collectRenderData(CSWRenderFrame& frame, CSWRenderFrame::Entry& entry);
       virtual const Mesh::PtrType getSurface() const;
       virtual const BoundingBoxD& getSurfaceBoundingBox() const;
       virtual void setColor(const Vector4D& vecColor);
@@ -2,7 +2,7 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWWorld.h"
 #include "CSWBattleStatistics.h"
 #include "CSWExplosionVisualizer.h"
@@ -13,6 +13,7 @@
 #include "CSWExplosionDetectedMessage.h"
 #include "CSWISoundReceiver.h"
 #include "CSWCollideable.h"
+#include "CSWShapeCache.h"
 
 
 namespace CodeSubWars
@@ -128,9 +129,10 @@ namespace CodeSubWars
     
       if (pDamObj)
       {
-        pDamObj->addDamage(m_fMaxDamage*fDistanceExplosionReduceFactor);
+        double fDamage = m_fMaxDamage*fDistanceExplosionReduceFactor;
+        pDamObj->addDamage(fDamage);
 
-        CSWWorld::getInstance()->getBattleStatistics()->reportHit(getSharedThis(), pObject);
+        CSWWorld::getInstance()->getBattleStatistics()->reportHit(getSharedThis(), pObject, fDamage);
         if (!pDamObj->isAlive())
           CSWWorld::getInstance()->getBattleStatistics()->reportKill(getSharedThis(), pObject);
       }
@@ -178,36 +180,22 @@ namespace CodeSubWars
     AxisAlignedBoundingBoxD aabb = getSurface()->getAxisAlignedBoundingBox();
 
     double fRadius = std::max(aabb.getWidth(), aabb.getHeight())*0.5;
-    Vector3D vecDiameter(fRadius*2, fRadius*2, fRadius*2);
 
     Vector3D vecStart = aabb.getMin() + Vector3D(aabb.getWidth()*0.5, aabb.getHeight()*0.5, fRadius);
     Vector3D vecEnd = aabb.getMax() - Vector3D(aabb.getWidth()*0.5, aabb.getHeight()*0.5, fRadius);
 
-    DT_ShapeHandle hDTShape = NULL;
-    Mesh::PtrType pCollisionMesh;
+    CSWShapeCache::ShapePtrType pDTShape;
     if (vecStart.getDistance(vecEnd) < EPSILON)
-    {
-      hDTShape = DT_NewPoint(static_cast<Vector3F>(vecStart).pData);
-      pCollisionMesh = Mesh::createEllipsoid(Matrix44D(vecStart), vecDiameter);
-    }
+      pDTShape = CSWShapeCache::getInstance()->getPointShape(vecStart);
     else
-    {
-      hDTShape = DT_NewLineSegment(static_cast<Vector3F>(vecStart).pData, static_cast<Vector3F>(vecEnd).pData);
-      Matrix44D matStart(vecStart);
-      matStart.getXAxis() = (vecEnd - vecStart).getNormalized();
-      matStart.getYAxis() = matStart.getXAxis().getPerpendicular();
-      matStart.getZAxis() = matStart.getXAxis()%matStart.getYAxis();
-      Matrix44D matEnd(matStart);
-      matEnd.getTranslation() = vecEnd;
-
-      pCollisionMesh = Mesh::createEllipsoid(matStart, vecDiameter, 16, 16, 0, 8);
-      pCollisionMesh->add(Mesh::createCylinder(matStart, (vecEnd - vecStart).getLength(), fRadius*2, fRadius*2));
-      pCollisionMesh->add(Mesh::createEllipsoid(matEnd, vecDiameter, 16, 16, 8, 16));
-    }
+      pDTShape = CSWShapeCache::getInstance()->getLineSegmentShape(vecStart, vecEnd);
+    Mesh::PtrType pCollisionMesh = CSWShapeCache::getInstance()->getCapsuleMesh(vecStart, vecEnd, fRadius);
 
-    DT_ObjectHandle hDTObject = DT_CreateObject(this, hDTShape);
+    DT_ObjectHandle hDTObject = DT_CreateObject(this, pDTShape.get());
     DT_SetMargin(hDTObject, fRadius);
-    m_pCollideable->initializeEnvironment(hDTShape, hDTObject, Matrix44D::IDENTITY, pCollisionMesh);
+    //weapons are fast enough to pass thin walls or small submarines within one step
+    m_pCollideable->enableContinuousCollision(fRadius);
+    m_pCollideable->initializeEnvironment(this, pDTShape, hDTObject, Matrix44D::IDENTITY, pCollisionMesh);
   }
 
 
@@ -285,6 +273,12 @@ namespace CodeSubWars
   }
 
 
+  void CSWWeapon::setShooter(CSWObject::PtrType pShooter)
+  {
+    m_pCollideable->setSweepSourceObject(pShooter);
+  }
+
+
   bool CSWWeapon::isShooterSubmarine() const
   {
     return m_bShooterSubmarine;
@@ -299,10 +293,10 @@ namespace CodeSubWars
 
   CSWWeapon::CSWWeapon(const std::string& strName, const Matrix44D& matBaseTObject, const Size3D& size)
   : CSWDamDynSolCol(strName, matBaseTObject, 
-                    Mesh::createEllipsoid(Matrix44D(Vector3D(0, 0, 0)),
-                                          Vector3D(size.getWidth(),
-                                                   size.getHeight(), 
-                                                   size.getDepth())),
+                    CSWShapeCache::getInstance()->getEllipsoidMesh(Vector3D(0, 0, 0),
+                                                                   Vector3D(size.getWidth(),
+                                                                            size.getHeight(), 
+                                                                            size.getDepth())),
                     true),
     m_fAbsLaunchTime(std::numeric_limits<double>::max()),
     m_fAbsArmTime(std::numeric_limits<double>::max()),
@@ -84,6 +84,12 @@ namespace CodeSubWars
 
       void setShooterName(const std::string& strName);
       const std::string& getShooterName() const;
+
+      /**
+       * Sets the object that released the weapon. The weapon starts within it, so it is not hit by the sweep of the 
+       * weapon until the weapon has left it.
+       */
+      void setShooter(std::shared_ptr<CSWObject> pShooter);
     
       bool isShooterSubmarine() const;
       void setShooterSubmarine(bool bVal);
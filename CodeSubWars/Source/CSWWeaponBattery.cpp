@@ -2,15 +2,15 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWWeaponBattery.h"
+#include "CSWObjectPool.h"
 #include "CSWRechargeable.h"
 #include "CSWWorld.h"
 #include "CSWWeapon.h"
 #include "CSWSubmarine.h"
 #include "CSWMessageCollisionObjects.h"
 #include "CSWIResourceProvider.h"
-#include "CSWWeaponBatteryVisualizer.h"
 #include "CSWWeaponSupply.h"
 #include "CSWBattleStatistics.h"
 //#include "Constants.h"
@@ -40,7 +40,7 @@ namespace CodeSubWars
   CSWWeaponBattery::PtrType CSWWeaponBattery::create(const std::string& strName, const Matrix44D& matBaseTObject, 
                                                      int nMaxSize, const unsigned long& nAcceptedResources)
   {
-    return PtrType(new CSWWeaponBattery(strName, matBaseTObject, nMaxSize, nAcceptedResources));
+    return CSWObjectPool::create<CSWWeaponBattery>([&](void* pBlock) { return new (pBlock) CSWWeaponBattery(strName, matBaseTObject, nMaxSize, nAcceptedResources); });
   }
 
 
@@ -61,14 +61,6 @@ namespace CodeSubWars
   }
 
 
-  QWidget* CSWWeaponBattery::getInformationWidget(QWidget* pParent)
-  {
-    if (!m_pVisualizer)
-      m_pVisualizer = new CSWWeaponBatteryVisualizer(pParent, std::dynamic_pointer_cast<CSWWeaponBattery>(getSharedThis()));
-    return m_pVisualizer;
-  }
-
-
   const unsigned long& CSWWeaponBattery::getRechargingIDs() const
   {
     return m_pRechargeable->getRechargingIDs();
@@ -176,6 +168,7 @@ namespace CodeSubWars
     if (!pSolObj)
       throw std::runtime_error("weapon was released by a not solid object");
     pWeapon->setShooterName(pSolObj->getName());
+    pWeapon->setShooter(pSolObj);
     pWeapon->setShooterSubmarine(findFirstParent<CSWSubmarine>() != nullptr);
     CSWWorld::getInstance()->getBattleStatistics()->reportWeaponFired(pSolObj);
 
@@ -186,7 +179,7 @@ namespace CodeSubWars
     bResult &= CSWMessageInitializeCollisionObjects::initializeCollision(pWeapon);
     if (!bResult)
       return bResult;
-    bResult &= CSWWorld::getInstance()->getObjectTree()->attach(pWeapon);
+    bResult &= CSWWorld::getInstance()->attachToObjectTree(pWeapon);
     //bResult &= pSolObj->attach(pWeapon);
     if (!bResult)
       return bResult;
@@ -267,8 +260,7 @@ namespace CodeSubWars
     m_fLastWeaponLaunched(-1e+10),
     m_fLeastWeaponLaunchDelay(1.0),
     m_fLastRechargeTime(0),
-    m_Cnt(0),
-    m_pVisualizer(NULL)
+    m_Cnt(0)
   {
   }
 
@@ -11,7 +11,7 @@ namespace CodeSubWars
 
   class CSWRechargeable;
   class CSWWeapon;
-  class CSWWeaponBatteryVisualizer;
+  class CSWInformationSnapshot;
 
 
   //struct WeaponLess : public std::binary_function<std::shared_ptr<CSWWeapon>, std::shared_ptr<CSWWeapon>, bool>
@@ -41,9 +41,6 @@ namespace CodeSubWars
       //defined methods from ARSTD::Element
       virtual void rename(const std::string& strOldName, const std::string& strNewName, bool bReplaceSubstrings = true);
 
-      //defined methods from CSWEquipment
-      virtual QWidget* getInformationWidget(QWidget* pParent);
-
       //defined methods from CSWIRechargeable
 
       /**
@@ -131,7 +128,7 @@ namespace CodeSubWars
       bool isEmpty() const;
     
 
-      friend CSWWeaponBatteryVisualizer;
+      friend CSWInformationSnapshot;
     protected:
       //due to problems when finding weapons that are given through python a self defined less operator is used.
       typedef std::set<std::shared_ptr<CSWWeapon>/*, WeaponLess*/> WeaponContainer;
@@ -155,7 +152,5 @@ namespace CodeSubWars
 
       double m_fLastRechargeTime;
       int m_Cnt;
-    
-      CSWWeaponBatteryVisualizer* m_pVisualizer;
   };
 }
\ No newline at end of file
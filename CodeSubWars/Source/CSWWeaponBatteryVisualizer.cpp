@@ -4,16 +4,13 @@
 
 #include "PrecompiledHeader.h"
 #include "CSWWeaponBatteryVisualizer.h"
-#include "CSWWeaponBattery.h"
-#include "CSWWeapon.h"
 
 
 namespace CodeSubWars
 {
 
-  CSWWeaponBatteryVisualizer::CSWWeaponBatteryVisualizer(QWidget* pParent, CSWWeaponBattery::PtrType pWeaponBattery)
+  CSWWeaponBatteryVisualizer::CSWWeaponBatteryVisualizer(QWidget* pParent)
   : QWidget(pParent),
-    m_pWeaponBattery(pWeaponBattery),
     m_nOldNumWeapons(-1)
   {
     QVBoxLayout* pLayout = new QVBoxLayout(this); 
@@ -35,26 +32,27 @@ namespace CodeSubWars
   }
 
 
-  void CSWWeaponBatteryVisualizer::updateContent()
+  void CSWWeaponBatteryVisualizer::updateContent(const CSWInformationSnapshot::PtrType& pInformation)
   {
-    if (CSWWeaponBattery::PtrType pWeaponBattery = m_pWeaponBattery.lock())
+    if (pInformation && (pInformation->nProperties & CSWInformationSnapshot::WEAPON_BATTERY))
     {
-      if (m_nOldNumWeapons == pWeaponBattery->getNumInserted())
+      int nNumWeapons = static_cast<int>(pInformation->weaponNames.size());
+      if (m_nOldNumWeapons == nNumWeapons)
         return;
-      m_nOldNumWeapons = pWeaponBattery->getNumInserted();
+      m_nOldNumWeapons = nNumWeapons;
     
       std::stringstream ss;
       ss.precision(1);
       ss.setf(std::ios::fixed);
-      ss << "Max. Weapons: " << pWeaponBattery->m_nMaxSize << "\n"
-         << "Current contains (" << pWeaponBattery->getNumInserted() << "): \n";
+      ss << "Max. Weapons: " << pInformation->nMaxNumWeapons << "\n"
+         << "Current contains (" << nNumWeapons << "): \n";
       m_pLabel->setText(ss.str().c_str());
     
       std::stringstream ss2;
-      CSWWeaponBattery::WeaponContainer::const_iterator it = pWeaponBattery->m_WeaponContainer.begin();
-      for (; it != pWeaponBattery->m_WeaponContainer.end(); ++it)
+      std::vector<std::string>::const_iterator it = pInformation->weaponNames.begin();
+      for (; it != pInformation->weaponNames.end(); ++it)
       {
-        ss2 << (*it)->getName() << "\n";
+        ss2 << *it << "\n";
       }
 
       m_pDetails->setText(ss2.str().c_str());
@@ -11,18 +11,15 @@
 namespace CodeSubWars
 {
 
-  class CSWWeaponBattery;
-
   class CSWWeaponBatteryVisualizer : public QWidget,
                                      public CSWIEquipmentVisualizer
   {
     public:
-      CSWWeaponBatteryVisualizer(QWidget* pParent, std::shared_ptr<CSWWeaponBattery> pWeaponBattery);
+      CSWWeaponBatteryVisualizer(QWidget* pParent);
     
-      virtual void updateContent();
+      virtual void updateContent(const CSWInformationSnapshot::PtrType& pInformation);
     
     protected:
-      std::weak_ptr<CSWWeaponBattery> m_pWeaponBattery;
       QLabel* m_pLabel;
       QTextEdit* m_pDetails;
     
@@ -2,8 +2,9 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWWeaponSupply.h"
+#include "CSWShapeCache.h"
 #include "CSWIRechargeable.h"
 #include "CSWResourceProvider.h"
 #include "CSWEvent.h"
@@ -104,10 +105,10 @@ namespace CodeSubWars
 
   CSWWeaponSupply::CSWWeaponSupply(const std::string& strName, const Matrix44D& matBaseTObject, const Size3D& size)
   : CSWDynSolCol(strName, matBaseTObject, 
-                 Mesh::createBox(Matrix44D(Vector3D(-size.getWidth()/2.0, 
-                                                    -size.getHeight()/2.0, 
-                                                    -size.getDepth()/2.0)),
-                                 size)),
+                 CSWShapeCache::getInstance()->getBoxMesh(Vector3D(-size.getWidth()/2.0, 
+                                                                   -size.getHeight()/2.0, 
+                                                                   -size.getDepth()/2.0),
+                                                          size)),
     m_pResourceProvider(CSWResourceProvider::create(300, GREEN_TORPEDO_ID /*| RED_TORPEDO_ID | BLUE_TORPEDO_ID*/ | GREEN_MINE_ID /*| YELLOW_MINE_ID*/)),
     m_fLastSentTime(0)
   {
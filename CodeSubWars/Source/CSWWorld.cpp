@@ -2,7 +2,7 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWWorld.h"
 #include "CSWLog.h"
 #include "CSWPyObjectLoader.h"
@@ -15,17 +15,20 @@
 #include "CSWMessageInitializeObjects.h"
 #include "CSWMessageCollectObjects.h"
 #include "CSWMessageCollisionObjects.h"
+#include "CSWCollisionFilter.h"
+#include "CSWShapeCache.h"
+#include "CSWObjectPool.h"
+#include "CSWObjectIndex.h"
 #include "CSWMessageUpdateCollisionObjects.h"
 #include "CSWMessageUpdateDamageObjects.h"
 #include "CSWMessageEmitSoundObjects.h"
 #include "CSWMessageRecalculateObjects.h"
 #include "CSWMessageUpdateProcessEventObjects.h"
 #include "CSWMessageStoreObjects.h"
-#include "CSWMessageDrawObjects.h"
-#include "CSWMessageDrawOverlayObjects.h"
 
 #include "CSWObject.h"
 #include "CSWIDynamic.h"
+#include "CSWICommandable.h"
 
 #include "CSWEvent.h"
 #include "CSWEventManager.h"
@@ -34,21 +37,20 @@
 #include "CSWUtilities.h"
 
 #include "CSWDummy.h"
-#include "CSWCamera.h"
+#include "CSWSolid.h"
 
 #include "CSWIPythonable.h"
 #include "PythonContext.h"
+#include "CSWPyProfiler.h"
+#include "CSWCPUAccount.h"
+#include "CSWInformationSnapshot.h"
+#include "CSWWorldSnapshot.h"
+#include "CSWWorldDefinition.h"
 
 #include "CSWSubmarine.h"
-#include "Border.h"
-#include "Wall.h"
-#include "Rock.h"
-#include "ActiveRock.h"
-#include "BlackHole.h"
-#include "Magnet.h"
+#include "CSWWeapon.h"
 #include "GreenTorpedo.h"
 #include "GreenMine.h"
-#include "WeaponSupply.h"
 
 namespace CodeSubWars
 {
@@ -82,40 +84,48 @@ namespace CodeSubWars
   }
 
 
-  DT_ResponseClass CSWWorld::getResponseClass()
+  std::shared_ptr<CSWCollisionFilter> CSWWorld::getCollisionFilter()
   {
-    return m_DTResponseClass;
+    return m_pCollisionFilter;
   }
 
 
   void CSWWorld::newWorld(WorldType type)
   {
-    QMutexLocker lckRecalc(&m_mtxRecalc);
-    QMutexLocker lckDraw(&m_mtxDraw);
+    std::stringstream ss;
+    ss << m_strWorldPath << "/default" << type << ".xml";
+    newWorld(ss.str());
+  }
+
+
+  bool CSWWorld::newWorld(const std::string& strFileName)
+  {
+    std::lock_guard<std::recursive_mutex> lckRecalc(m_mtxRecalc);
+
+    CSWWorldDefinition::PtrType pDefinition = CSWWorldDefinition::load(strFileName);
+    if (!pDefinition)
+      return false;
 
-    finalizeWorld(); 
+    //definitions are shared as long as their file does not change, so setting up the same world again (e.g. in
+    //batch runs) reuses the meshes and collision shapes of its objects
+    finalizeWorld(pDefinition != m_pWorldDefinition); 
+    m_pWorldDefinition = pDefinition;
 
     m_hDTScene = DT_CreateScene();
     m_hDTRespTable = DT_CreateRespTable();
-    m_DTResponseClass = DT_GenResponseClass(m_hDTRespTable);
+    m_pCollisionFilter = CSWCollisionFilter::create(m_hDTRespTable, &CSWMessageInitializeCollisionObjects::collide);
   
   
     ARSTD::Time::reset();
     ARSTD::Time::setTimeRatio(0);
 
-    if (type == DEFAULT_1)
-      setupEnvironment1();
-    else if (type == DEFAULT_2)
-      setupEnvironment2();
-    else if (type == DEFAULT_3)
-      setupEnvironment3();
-    else if (type == DEFAULT_4)
-      setupEnvironment4();
-    else if (type == DEFAULT_5)
-      setupEnvironment5();
-    else if (type == LOAD_WORLD)
-    {
-    }
+    m_strWorldName = ARSTD::FileSystem::getBaseName(strFileName);
+
+    std::stringstream ssRandomGeneratorState;
+    ssRandomGeneratorState << CSWUtilities::getRandomGenerator();
+    m_strWorldRandomGeneratorState = ssRandomGeneratorState.str();
+
+    setupEnvironment();
     assert(m_pObjectTree);
   
     calcWorldTransform();
@@ -125,22 +135,24 @@ namespace CodeSubWars
   
     m_bWorldInitialized = true;  
   
-    if (type == DEFAULT_1)
-      CSWLog::getInstance()->log("Default 1 environment successfully created");
-    else if (type == DEFAULT_2)
-      CSWLog::getInstance()->log("Default 2 environment successfully created");
-    else if (type == DEFAULT_3)
-      CSWLog::getInstance()->log("Default 3 environment successfully created");
+    CSWLog::getInstance()->log(pDefinition->getName() + " environment successfully created");
+    return true;
   }
 
 
   void CSWWorld::finalizeWorld()
+  {
+    finalizeWorld(true);
+  }
+
+
+  void CSWWorld::finalizeWorld(bool bClearShapeCache)
   {
     if (!m_pObjectTree)
       return;
 
-    QMutexLocker lckRecalc(&m_mtxRecalc);
-    QMutexLocker lckDraw(&m_mtxDraw);
+    std::lock_guard<std::recursive_mutex> lckRecalc(m_mtxRecalc);
+    m_RenderFrames.reset(CSWRenderFrame());
     
     finalizeBattle();
 
@@ -159,9 +171,15 @@ namespace CodeSubWars
     }
   
     m_pObjectTree.reset();
+    m_pObjectIndex->clear();
+    CSWEventManager::getInstance()->reset(CSWObject::PtrType());
 
+    m_pCollisionFilter.reset();
     DT_DestroyRespTable(m_hDTRespTable);
     DT_DestroyScene(m_hDTScene);
+    //the next world may use other sizes, shapes still used elsewhere stay alive
+    if (bClearShapeCache)
+      CSWShapeCache::getInstance()->clear();
    
     CSWLog::getInstance()->log("environment successfully removed");
   }
@@ -176,8 +194,7 @@ namespace CodeSubWars
         submarines.empty())
       return;
 
-    QMutexLocker lckRecalc(&m_mtxRecalc);
-    QMutexLocker lckDraw(&m_mtxDraw);
+    std::lock_guard<std::recursive_mutex> lckRecalc(m_mtxRecalc);
 
     //remove all subs
     //insert subs
@@ -200,19 +217,19 @@ namespace CodeSubWars
 
     ARSTD::Time::reset(timeMode);
 
-    QString logPath;
-    if (qApp)
-      logPath = qApp->applicationDirPath() + "/records";
-    else logPath = "records";
-    useNewRecordFileInPath(logPath.toStdString());
-
-    m_pBattleStatistics->initialize();
+    useNewRecordFileInPath(m_strRecordPath);
 
     m_BattleType = type;
+    m_nTeamSize = nTeamSize;
+    m_BattleSubmarines = submarines;
+    m_pBattleStatistics->initialize(m_strWorldName, m_BattleType == TEAM ? "team" : "single");
+
     m_LoadedSubmarines.clear();
     loadSubmarines(submarines, nTeamSize);
+    if (getSettings()->getVariousProperties() & CSWSettings::PROFILE_SUBMARINES)
+      attachProfilers();
 
-    srand((unsigned)time(NULL));
+    CSWUtilities::getRandomGenerator().seed(static_cast<unsigned int>(time(NULL)));
     std::vector<CSWObject::PtrType >::iterator it = m_LoadedSubmarines.begin();
     for (; it != m_LoadedSubmarines.end(); ++it)
     {
@@ -233,9 +250,9 @@ namespace CodeSubWars
       }
 
       if (m_BattleType == TEAM)
-        mat.getTranslation() = CSWUtilities::getRandomPosition()*2500.0;
+        mat.getTranslation() = CSWUtilities::getRandomPosition()*m_pWorldDefinition->getTeamSpawnExtent();
       else
-        mat.getTranslation() = CSWUtilities::getRandomPosition()*1500.0;
+        mat.getTranslation() = CSWUtilities::getRandomPosition()*m_pWorldDefinition->getSingleSpawnExtent();
     
       if (getSettings()->getVariousProperties() & CSWSettings::INITIALZE_SUBS_IN_PLANE)
       {
@@ -244,6 +261,7 @@ namespace CodeSubWars
       
       pObj->initializeDynamic(mat, Vector3D(0, 0, 0), Vector3D(0, 0, 0));
       attachObject(pObj);
+      m_pBattleStatistics->reportSubmarineAdded(pObj);
       CSWLog::getInstance()->log(pObj->getName() + " added");
     }
 
@@ -278,6 +296,10 @@ namespace CodeSubWars
     m_RecalcTimes.clear();
     m_UpdateProcessEventCalculateTimes.clear();
     m_CollisionCalculateTimes.clear();
+
+    std::vector<std::pair<std::string, double> >::iterator itLoad = m_AccumulatedLoad.begin();
+    for (; itLoad != m_AccumulatedLoad.end(); ++itLoad)
+      itLoad->second = 0;
   }
 
 
@@ -286,8 +308,8 @@ namespace CodeSubWars
     if (!m_bBattleInitialized)
       return;
 
-    QMutexLocker lckRecalc(&m_mtxRecalc);
-    QMutexLocker lckDraw(&m_mtxDraw);
+    std::lock_guard<std::recursive_mutex> lckRecalc(m_mtxRecalc);
+    m_RenderFrames.reset(CSWRenderFrame());
 
     m_bBattleInitialized = false;
 
@@ -312,6 +334,9 @@ namespace CodeSubWars
 
     CSWLog::getInstance()->log("battle statistics:");
     m_pBattleStatistics->write();
+    for (auto& pObj : objectsToRemove)
+      logCPUUsage(pObj);
+    writeProfiles();
     CSWLog::getInstance()->log("clean up environment");
 
 
@@ -323,46 +348,21 @@ namespace CodeSubWars
     {
       bool bResult = CSWMessageDeleteCollisionObjects::deleteCollision(*it);  
       (*it)->finalize();
-      bResult &= getObjectTree()->detach(*it);
+      bResult &= detachFromObjectTree(*it);
       if (bResult)
         CSWLog::getInstance()->log((*it)->getName() + " removed");
       else
         CSWLog::getInstance()->log((*it)->getName() + " could not correctly removed");
   
-      //PyThreadState* state = NULL;
-      PythonContext::PtrType pyContext;
-      if (CSWIPythonable::PtrType pPyObj = std::dynamic_pointer_cast<CSWIPythonable>(*it))
-      {
-        //state = pPyObj->getThreadState();
-        pyContext = pPyObj->getPythonContext();
-      }
-      if (pyContext)
-      {
-        auto lck = pyContext->makeCurrent();
-        it->reset();
-      }
-
-      //if (state)
-      //{
-      //  //gil must not be held
-      //  PyEval_AcquireThread(state);
-      //  //gil held
-
-      //  it->reset();
-
-      //  Py_EndInterpreter(state);
-      //  //gil held
-
-      //  //gil must be held
-      //  PyThreadState_Swap(m_pyMainState);
-
-      //  //gil must be held
-      //  PyEval_ReleaseThread(m_pyMainState);
-      //  //gil not held
-      //}    
+      destroyObject(*it);
     }
     objectsToRemove.clear();
 
+    std::vector<CSWObject::PtrType>::iterator itReleased = m_ReleasedObjects.begin();
+    for (; itReleased != m_ReleasedObjects.end(); ++itReleased)
+      destroyObject(*itReleased);
+    m_ReleasedObjects.clear();
+
     //close attached sink
     m_RecordStream.strict_sync();
     m_RecordStream.reset();
@@ -378,6 +378,9 @@ namespace CodeSubWars
 
     Py_FinalizeEx();
 
+    //the weapons and submarines of the battle are destroyed, so most chunks of the pools are unused now
+    CSWObjectPool::getInstance()->releaseUnused();
+
     ARSTD::Time::reset();
     ARSTD::Time::setTimeRatio(0);
    
@@ -408,6 +411,8 @@ namespace CodeSubWars
     if (m_pObjectTree == pObjectTree)
       return;
     m_pObjectTree = pObjectTree;
+    m_pObjectIndex->reset(m_pObjectTree);
+    CSWEventManager::getInstance()->reset(m_pObjectTree);
   }
 
 
@@ -421,225 +426,295 @@ namespace CodeSubWars
 
   CSWObject::PtrType CSWWorld::getObject(const Vector3D& vecWorldTPosition, const double& fDistance) const
   {
-    return CSWObject::findObject<CSWISolid>(m_pObjectTree, vecWorldTPosition, fDistance);
+    return m_pObjectIndex->findSolid(vecWorldTPosition, fDistance);
   }
 
 
-  bool CSWWorld::hasChanged(bool bResetModification)
+  CSWObject::PtrType CSWWorld::getObject(const std::string& strName) const
   {
-    return m_pObjectTree ? m_pObjectTree->getModifications(bResetModification) != CSWObject::Nothing : false;
+    return m_pObjectIndex->findObject(strName);
   }
 
 
-  bool CSWWorld::isBattleRunning() const
+  bool CSWWorld::attachToObjectTree(CSWObject::PtrType pObject)
   {
-    return m_bBattleInitialized;
+    if (!m_pObjectTree->attach(pObject))
+      return false;
+    m_pObjectIndex->insert(pObject);
+    CSWEventManager::getInstance()->registerObject(pObject);
+    return true;
   }
 
 
-  void CSWWorld::draw()
+  bool CSWWorld::detachFromObjectTree(CSWObject::PtrType pObject)
   {
-    if (!m_bWorldInitialized)
-      return;
+    if (!m_pObjectTree->detach(pObject))
+      return false;
+    m_pObjectIndex->remove(pObject);
+    CSWEventManager::getInstance()->unregisterObject(pObject);
+    return true;
+  }
 
-    QMutexLocker lckDraw(&m_mtxDraw);
 
-    CSWMessageDrawObjects<CSWObject> drawObjectsMessage;
-    CSWMessageDrawObjects<CSWObject>::broadcastMessage(m_pObjectTree, drawObjectsMessage, 1);
+  void CSWWorld::addObject(CSWObject::PtrType pObject, bool bChangePosition)
+  {
+    if (!m_bBattleInitialized)
+      throw std::runtime_error("object " + pObject->getName() + " can only be added to a running battle");
 
-    //draw world cube
-    glPushAttrib(GL_ALL_ATTRIB_BITS);
+    std::lock_guard<std::recursive_mutex> lckRecalc(m_mtxRecalc);
 
-      glDisable(GL_CULL_FACE);
-    
-      glEnable(GL_COLOR_MATERIAL);
-      glColorMaterial(GL_FRONT, GL_DIFFUSE);
+    attachObject(pObject, bChangePosition);
+    pObject->calcWorldTransforms();
+    if (!CSWMessageInitializeCollisionObjects::initializeCollision(pObject))
+      throw std::runtime_error("could not initialize collision for " + pObject->getName());
+  }
 
-      glEnable(GL_BLEND);
-      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-      glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+  bool CSWWorld::hasChanged(bool bResetModification)
+  {
+    return m_pObjectTree ? m_pObjectTree->getModifications(bResetModification) != CSWObject::Nothing : false;
+  }
+
 
-      glShadeModel(GL_FLAT);
-      glDisable(GL_LIGHTING);
-      glColor4d(0, 0, 1, 0.2);
+  CSWInformationSnapshot::PtrType CSWWorld::getInformation()
+  {
+    if (!isBattleRunning())
+    {
+      std::lock_guard<std::recursive_mutex> lckRecalc(m_mtxRecalc);
+      publishInformation();
+    }
+    else
+    {
+      m_bInformationRequested = true;
+    }
+    return std::atomic_load(&m_pInformation);
+  }
 
-      glEnable(GL_DEPTH_TEST);
-      glDepthMask(false);
 
-      BoundingBoxD bbox(Matrix44D(Vector3D(-CUBE_SIZE.getDepth()/2 + CUBE_THICKNESS, 
-                                           -CUBE_SIZE.getHeight()/2 + CUBE_THICKNESS, 
-                                           -CUBE_SIZE.getDepth()/2 + CUBE_THICKNESS)), 
-                        Size3D(CUBE_SIZE.getWidth() - CUBE_THICKNESS*2, 
-                               CUBE_SIZE.getHeight() - CUBE_THICKNESS*2, 
-                               CUBE_SIZE.getDepth() - CUBE_THICKNESS*2));
+  bool CSWWorld::isBattleRunning() const
+  {
+    return m_bBattleInitialized;
+  }
 
-      glBegin(GL_QUADS);
-        for (int iCnt = 0; iCnt < 6; ++iCnt) 
-        {
-          glVertex3dv(bbox.getRectangle(iCnt).getPoint0().pData);
-          glVertex3dv(bbox.getRectangle(iCnt).getPoint1().pData);
-          glVertex3dv(bbox.getRectangle(iCnt).getPoint2().pData);
-          glVertex3dv(bbox.getRectangle(iCnt).getPoint3().pData);
-        } 
-      glEnd();    
-
-      glDisable(GL_LIGHTING);
-      glColor3d(0, 0, 1);
-      glLineWidth(2);
-      glBegin(GL_LINES);
-        for (int iCnt = 0; iCnt < 12; ++iCnt) 
-        {
-          glVertex3dv(bbox.getSegment(iCnt).getPoint1().pData);
-          glVertex3dv(bbox.getSegment(iCnt).getPoint2().pData);
-        } 
-      glEnd();
-      glDepthMask(true);
-    glPopAttrib();
 
+  bool CSWWorld::isSnapshotPossible()
+  {
+    std::lock_guard<std::recursive_mutex> lckRecalc(m_mtxRecalc);
+    if (!m_bBattleInitialized || CSWEventManager::getInstance()->hasEvents())
+      return false;
 
-    CSWMessageDrawOverlayObjects<CSWObject> drawOverlayObjectsMessage;
-    CSWMessageDrawOverlayObjects<CSWObject>::broadcastMessage(m_pObjectTree, drawOverlayObjectsMessage, 1);
-  
-    m_pExplosionVisualizer->draw();
-    m_pSoundVisualizer->draw();
+    //weapons in flight are on the top level, commandable objects are the submarines
+    ARSTD::Node::ChildRange range = m_pObjectTree->getChildRange();
+    for (ARSTD::Node::ChildIterator itChild = range.first; itChild != range.second; ++itChild)
+    {
+      if (std::dynamic_pointer_cast<CSWWeapon>(*itChild))
+        return false;
+      CSWICommandable::PtrType pCommandable = std::dynamic_pointer_cast<CSWICommandable>(*itChild);
+      if (pCommandable && (pCommandable->getCommandProcessor()->isBusy() || 
+                           pCommandable->getCommandProcessor()->getCurrentStackDepth()))
+        return false;
+    }
+    return true;
   }
 
 
-  CSWWorld::CSWWorld()
-  : m_pSettings(CSWSettings::create()),
-    m_pWorldGuard(CSWWorldGuard::create()),
-    m_pBattleStatistics(CSWBattleStatistics::create()),
-    m_pExplosionVisualizer(CSWExplosionVisualizer::create()),
-    m_pSoundVisualizer(CSWSoundVisualizer::create()),
-    m_bWorldInitialized(false),
-    m_bBattleInitialized(false),
-    m_mtxRecalc(QMutex::Recursive),
-    m_mtxDraw(QMutex::Recursive),
-    m_pyMainState(NULL),
-    m_CalculateTimes(200),
-    m_TransformCalculateTimes(200),
-    m_RecalcTimes(200),
-    m_UpdateProcessEventCalculateTimes(200),
-    m_CollisionCalculateTimes(200)
+  CSWWorldSnapshot::PtrType CSWWorld::takeSnapshot()
   {
-    m_Load.push_back(boost::tuples::make_tuple("Total", 0, 0));
-    m_Load.push_back(boost::tuples::make_tuple("Transform", 0, 0));
-    m_Load.push_back(boost::tuples::make_tuple("Recalc", 0, 0));
-    m_Load.push_back(boost::tuples::make_tuple("Update/Events", 0, 0));
-    m_Load.push_back(boost::tuples::make_tuple("Collision", 0, 0));
+    std::lock_guard<std::recursive_mutex> lckRecalc(m_mtxRecalc);
+    if (!isSnapshotPossible())
+      return CSWWorldSnapshot::PtrType();
+
+    CSWWorldSnapshot::PtrType pSnapshot = CSWWorldSnapshot::create(m_pObjectTree);
+    pSnapshot->fTime = ARSTD::Time::getTime();
+    pSnapshot->strWorld = m_pWorldDefinition->getFileName();
+    pSnapshot->nBattleType = m_BattleType;
+    pSnapshot->nTeamSize = m_nTeamSize;
+    pSnapshot->submarines = m_BattleSubmarines;
+    pSnapshot->strWorldRandomGeneratorState = m_strWorldRandomGeneratorState;
+
+    std::stringstream ss;
+    ss << CSWUtilities::getRandomGenerator();
+    pSnapshot->strRandomGeneratorState = ss.str();
+    pSnapshot->strBattleStatisticsState = m_pBattleStatistics->getState();
+    return pSnapshot;
   }
 
 
-  void CSWWorld::setupEnvironment1()
+  bool CSWWorld::restoreSnapshot(std::shared_ptr<const CSWWorldSnapshot> pSnapshot, ARSTD::Time::Mode timeMode)
   {
-    m_pObjectTree = CSWDummy::create("Root");
+    if (!pSnapshot)
+      return false;
 
-    CSWBorder::PtrType pBorder;
-    pBorder = Border::create("envBorder1", Matrix44D(Vector3D(0, 0, CUBE_SIZE.getDepth()/2 - CUBE_THICKNESS/2)), 
-                             Size3D(CUBE_SIZE.getWidth() - 2*CUBE_THICKNESS - 2*CUBE_MARGIN, CUBE_SIZE.getHeight(), CUBE_THICKNESS));
-    attachObject(pBorder, false);
-    pBorder = Border::create("envBorder2", Matrix44D(Vector3D(0, 0, -CUBE_SIZE.getDepth()/2 + CUBE_THICKNESS/2)), 
-                             Size3D(CUBE_SIZE.getWidth() - 2*CUBE_THICKNESS - 2*CUBE_MARGIN, CUBE_SIZE.getHeight(), CUBE_THICKNESS));
-    attachObject(pBorder, false);
+    std::lock_guard<std::recursive_mutex> lckRecalc(m_mtxRecalc);
 
-    pBorder = Border::create("envBorder3", Matrix44D(Vector3D(CUBE_SIZE.getWidth()/2 - CUBE_THICKNESS/2, 0, 0)), 
-                             Size3D(CUBE_THICKNESS, CUBE_SIZE.getHeight(), CUBE_SIZE.getDepth()));
-    attachObject(pBorder, false);
-    pBorder = Border::create("envBorder4", Matrix44D(Vector3D(-CUBE_SIZE.getWidth()/2 + CUBE_THICKNESS/2, 0, 0)), 
-                             Size3D(CUBE_THICKNESS, CUBE_SIZE.getHeight(), CUBE_SIZE.getDepth()));
-    attachObject(pBorder, false);
+    //the world is set up with the same random numbers, so the same environment is created
+    std::stringstream ssWorldRandomGeneratorState(pSnapshot->strWorldRandomGeneratorState);
+    ssWorldRandomGeneratorState >> CSWUtilities::getRandomGenerator();
+    if (!newWorld(pSnapshot->strWorld))
+    {
+      CSWLog::getInstance()->log("could not restore snapshot: world " + pSnapshot->strWorld + " could not be set up");
+      return false;
+    }
+    newBattle(pSnapshot->submarines, static_cast<BattleType>(pSnapshot->nBattleType), pSnapshot->nTeamSize, timeMode);
+    if (!m_bBattleInitialized)
+    {
+      CSWLog::getInstance()->log("could not restore snapshot: battle could not be started");
+      return false;
+    }
 
-    pBorder = Border::create("envBorder5", Matrix44D(Vector3D(0, CUBE_SIZE.getHeight()/2 - CUBE_THICKNESS/2, 0)), 
-                             Size3D(CUBE_SIZE.getWidth() - 2*CUBE_THICKNESS - 2*CUBE_MARGIN, CUBE_THICKNESS, CUBE_SIZE.getDepth() - 2*CUBE_THICKNESS - 2*CUBE_MARGIN));
-    attachObject(pBorder, false);
-    pBorder = Border::create("envBorder6", Matrix44D(Vector3D(0, -CUBE_SIZE.getHeight()/2 + CUBE_THICKNESS/2, 0)), 
-                             Size3D(CUBE_SIZE.getWidth() - 2*CUBE_THICKNESS - 2*CUBE_MARGIN, CUBE_THICKNESS, CUBE_SIZE.getDepth() - 2*CUBE_THICKNESS - 2*CUBE_MARGIN));
-    attachObject(pBorder, false);
+    ARSTD::Time::reset(timeMode, pSnapshot->fTime);
+    std::stringstream ssRandomGeneratorState(pSnapshot->strRandomGeneratorState);
+    ssRandomGeneratorState >> CSWUtilities::getRandomGenerator();
 
+    //remove the objects of the battle that did not exist anymore when the snapshot was taken (e.g. killed submarines),
+    //their removal is already accounted in the restored statistics
+    std::set<std::string> storedObjects;
+    CSWWorldSnapshot::ObjectStateContainer::const_iterator itState = pSnapshot->objects.begin();
+    for (; itState != pSnapshot->objects.end(); ++itState)
+      storedObjects.insert(itState->strPath);
 
-    attachObject(CSWCamera::create("envMainCamera", Matrix44D(Vector3D(1, 0, 0),
-                                                              Vector3D(0, 0, 1),
-                                                              Vector3D(0, -1, 0),
-                                                              Vector3D(0, 2300, 0))));
+    std::vector<CSWObject::PtrType> objectsToRemove;
+    ARSTD::Node::ChildRange range = m_pObjectTree->getChildRange();
+    ARSTD::Node::ChildIterator itChild = range.first;
+    for (; itChild != range.second; ++itChild)
+    {
+      CSWObject::PtrType pObject = std::dynamic_pointer_cast<CSWObject>(*itChild);
+      if (pObject && pObject->getName().find("env") != 0 && !storedObjects.count(pObject->getName()))
+        objectsToRemove.push_back(pObject);
+    }
+    std::vector<CSWObject::PtrType>::iterator itObject = objectsToRemove.begin();
+    for (; itObject != objectsToRemove.end(); ++itObject)
+    {
+      CSWMessageDeleteCollisionObjects::deleteCollision(*itObject);
+      (*itObject)->finalize();
+      detachFromObjectTree(*itObject);
+      releaseObject(*itObject);
+    }
+
+    //commands given and events sent on initializing the battle are not part of the snapshot
+    range = m_pObjectTree->getChildRange();
+    for (itChild = range.first; itChild != range.second; ++itChild)
+    {
+      CSWICommandable::PtrType pCommandable = std::dynamic_pointer_cast<CSWICommandable>(*itChild);
+      if (!pCommandable)
+        continue;
+      PythonContext::PtrType pyContext = PythonContext::createEmpty();
+      if (CSWIPythonable::PtrType pPythonObject = std::dynamic_pointer_cast<CSWIPythonable>(*itChild))
+        pyContext = pPythonObject->getPythonContext();
+      auto lck = pyContext->makeCurrent();
+      pCommandable->getCommandProcessor()->cleanupStack();
+    }
+    CSWEventManager::getInstance()->clearEvents();
+
+    if (!m_pBattleStatistics->setState(pSnapshot->strBattleStatisticsState))
+      CSWLog::getInstance()->log("could not restore the battle statistics of the snapshot");
+
+    std::vector<std::string> missingObjects = pSnapshot->restore(m_pObjectTree);
+    std::vector<std::string>::const_iterator itMissing = missingObjects.begin();
+    for (; itMissing != missingObjects.end(); ++itMissing)
+      CSWLog::getInstance()->log("could not restore " + *itMissing + ": object does not exist");
+
+    calcWorldTransform();
+    m_fLastStoredTime = -std::numeric_limits<double>::max();
+
+    std::stringstream ss;
+    ss << "battle restored from snapshot at " << pSnapshot->fTime << "s";
+    CSWLog::getInstance()->log(ss.str());
+    return true;
   }
 
 
-  void CSWWorld::setupEnvironment2()
+  void CSWWorld::setRenderFramesEnabled(bool bEnabled)
   {
-    //only not damageable and not dynamic object can be environment.
-    //the objects state must not change over time.
-    setupEnvironment1();
-  
-  //  m_pObjectTree->attach(BlackHole::create("envBlackHole",
-  //                                          Matrix44D(Vector3D(0, 0, 0)), 
-  //                                          Size3D(3000, 3000, 3000)));
-
-  //  m_pObjectTree->attach(Rock::create("envRock1",
-  //                                     Matrix44D(Vector3D(200, 150, 400)), 
-  //                                     Size3D(50, 50, 50)));
-  //
-  //m_pObjectTree->attach(Rock::create("envRock2",
-  //                                    Matrix44D(Vector3D(0, 0, 600)), 
-  //                                    Size3D(50, 50, 50)));
-
-  //  attachObject(Wall::create("envWall1",
-  //                            Matrix44D(Vector3D(700, 20, 800)), 
-  //                            Size3D(400, 200, 50)));
-
-  //  m_pObjectTree->attach(Magnet::create("envMagnetA",
-  //                                       Matrix44D(Vector3D(-300, 0, 550)), 
-  //                                       Size3D(10, 10, 10)));
-
-    for (int i = 0; i < 20; ++i)
+    m_bRenderFramesEnabled = bEnabled;
+  }
+
+
+  void CSWWorld::publishRenderFrame()
+  {
+    if (!m_bRenderFramesEnabled)
+      return;
+
     {
-      attachObject(Rock::create(std::string("envRock") + ARSTD::Utilities::toString(i),
-                                Matrix44D(Vector3D(rand()%1500 - 750, rand()%1500 - 750, rand()%1500 - 750)), 
-                                Size3D(rand()%100 + 50, rand()%100 + 50, rand()%100 + 50)));
+      std::lock_guard<std::recursive_mutex> lckRecalc(m_mtxRecalc);
+
+      CSWRenderFrame& frame = m_RenderFrames.getBackBuffer();
+      if (m_bWorldInitialized)
+      {
+        frame.collect(m_pObjectTree, getSettings()->getSelectedObject(), getSettings()->getSelectedSolidObject());
+        m_pExplosionVisualizer->collect(frame.explosions);
+        m_pSoundVisualizer->collect(frame.sounds);
+      }
+      else
+      {
+        frame.clear();
+      }
+      m_RenderFrames.publish();
     }
+
+    destroyReleasedObjects();
   }
 
 
-  void CSWWorld::setupEnvironment3()
+  const CSWRenderFrame& CSWWorld::fetchRenderFrame()
   {
-    //only not damageable and not dynamic object can be environment.
-    //the objects state must not change over time.
-    setupEnvironment1();
-  
-    attachObject(WeaponSupply::create("envWeaponSupply", 
-                                       Matrix44D(Vector3D(0, 0, 0)), 
-                                       Size3D(100, 100, 100)));
+    m_RenderFrames.fetch();
+    return m_RenderFrames.getFrontBuffer();
   }
 
 
-  void CSWWorld::setupEnvironment4()
+  CSWWorld::CSWWorld()
+  : m_pObjectIndex(CSWObjectIndex::create()),
+    m_pSettings(CSWSettings::create()),
+    m_pWorldGuard(CSWWorldGuard::create()),
+    m_pBattleStatistics(CSWBattleStatistics::create()),
+    m_pExplosionVisualizer(CSWExplosionVisualizer::create()),
+    m_pSoundVisualizer(CSWSoundVisualizer::create()),
+    m_bWorldInitialized(false),
+    m_bBattleInitialized(false),
+    m_pyMainState(NULL),
+    m_BattleType(SINGLE),
+    m_nTeamSize(1),
+    m_strRecordPath("records"),
+    m_strWorldPath("Worlds"),
+    m_bInformationRequested(false),
+    m_nInformationTreeVersion(0),
+    m_bRenderFramesEnabled(false),
+    m_CalculateTimes(200),
+    m_TransformCalculateTimes(200),
+    m_RecalcTimes(200),
+    m_UpdateProcessEventCalculateTimes(200),
+    m_CollisionCalculateTimes(200)
   {
-    //only not damageable and not dynamic object can be environment.
-    //the objects state must not change over time.  
-    setupEnvironment1();
-  
-    attachObject(BlackHole::create("envBlackHole",
-                                   Matrix44D(Vector3D(0, 0, 0)), 
-                                   Size3D(110, 110, 110)));
+    m_Load.push_back(boost::tuples::make_tuple("Total", 0, 0));
+    m_Load.push_back(boost::tuples::make_tuple("Transform", 0, 0));
+    m_Load.push_back(boost::tuples::make_tuple("Recalc", 0, 0));
+    m_Load.push_back(boost::tuples::make_tuple("Update/Events", 0, 0));
+    m_Load.push_back(boost::tuples::make_tuple("Collision", 0, 0));
 
+    std::vector<boost::tuples::tuple<std::string, double, double> >::const_iterator it = m_Load.begin();
+    for (; it != m_Load.end(); ++it)
+      m_AccumulatedLoad.push_back(std::make_pair(it->get<0>(), 0.0));
   }
 
 
-  void CSWWorld::setupEnvironment5()
+  void CSWWorld::setupEnvironment()
   {
+    m_pObjectTree = CSWDummy::create("Root");
+    m_pObjectIndex->reset(m_pObjectTree);
+    CSWEventManager::getInstance()->reset(m_pObjectTree);
+
     //only not damageable and not dynamic object can be environment.
     //the objects state must not change over time.
-    setupEnvironment1();
-  
-    for (int i = 0; i < 5; ++i)
-    {
-      Matrix44D mat = CSWUtilities::getRandomOrientation();
-      mat.getTranslation() = Vector3D(rand()%1500 - 750, rand()%1500 - 750, rand()%1500 - 750);
-      attachObject(ActiveRock::create(std::string("envActiveRock") + ARSTD::Utilities::toString(i),
-                                      mat, 
-                                      Size3D(rand()%100 + 50, rand()%100 + 50, rand()%100 + 50)));
-    }
-
+    std::vector<CSWObject::PtrType> fixedObjects;
+    std::vector<CSWObject::PtrType> randomObjects;
+    m_pWorldDefinition->createObjects(fixedObjects, randomObjects);
+
+    std::vector<CSWObject::PtrType>::iterator it = fixedObjects.begin();
+    for (; it != fixedObjects.end(); ++it)
+      attachObject(*it, false);
+    for (it = randomObjects.begin(); it != randomObjects.end(); ++it)
+      attachObject(*it);
   }
 
 
@@ -649,7 +724,7 @@ namespace CodeSubWars
     std::string strOrgName = pObject->getName();
     std::string strNewName = strOrgName;
     int nCnt = 2;
-    while (CSWObject::findElement(m_pObjectTree, strNewName))
+    while (m_pObjectIndex->findObject(strNewName))
     {
       strNewName = strOrgName + ARSTD::Utilities::toString(nCnt);
       ++nCnt;
@@ -696,7 +771,7 @@ namespace CodeSubWars
       }
     }
 
-    m_pObjectTree->attach(pObject);
+    attachToObjectTree(pObject);
   }
 
 
@@ -707,7 +782,7 @@ namespace CodeSubWars
 
     bool bBattleRunning = false;
     {
-      QMutexLocker lckRecalc(&m_mtxRecalc);
+      std::lock_guard<std::recursive_mutex> lckRecalc(m_mtxRecalc);
     
       //store world 
       double fCurrentTime = ARSTD::Time::getTime();
@@ -783,40 +858,15 @@ namespace CodeSubWars
       CSWMessageUpdateDamageObjects<CSWObject>::ObjectContainer::const_iterator itEnd = collectedObjects.end();
       for (; itDeadObject != itEnd; ++itDeadObject)
       {
+        logCPUUsage(*itDeadObject);
+        m_pBattleStatistics->reportSubmarineRemoved(*itDeadObject);
         bool bResult = CSWMessageDeleteCollisionObjects::deleteCollision(*itDeadObject);  
         (*itDeadObject)->finalize();
-        bResult &= getObjectTree()->detach(*itDeadObject);
+        bResult &= detachFromObjectTree(*itDeadObject);
         if (!bResult)
           throw std::runtime_error(std::string((*itDeadObject)->getName()) + ": is dead and could not be correctly removed from world");
 
-        //PyThreadState* state = NULL;
-        PythonContext::PtrType pyContext;
-        if (CSWIPythonable::PtrType pPyObj = std::dynamic_pointer_cast<CSWIPythonable>(*itDeadObject))
-        {
-          //state = pPyObj->getThreadState();
-          pyContext = pPyObj->getPythonContext();
-        }
-        if (pyContext)
-        {
-          auto lck = pyContext->makeCurrent();
-          itDeadObject->reset();
-        }
-        //if (state)
-        //{
-        //  //gil must not be held
-        //  PyEval_AcquireThread(state);
-        //  //gil held
-
-        //  itDeadObject->reset();
-
-        //  Py_EndInterpreter(state);
-        //  //gil held
-
-        //  PyThreadState_Swap(m_pyMainState);
-        //  //gil must be held
-        //  PyEval_ReleaseThread(m_pyMainState);
-        //  //gil not held
-        //}
+        releaseObject(*itDeadObject);
       }
       collectedObjects.clear();
 
@@ -837,6 +887,15 @@ namespace CodeSubWars
       m_Load[3] = boost::tuples::make_tuple("Update/Events", result.first*1000, result.second*1000);
       result = calcStatistics(m_CollisionCalculateTimes.rbegin(), m_CollisionCalculateTimes.rend());
       m_Load[4] = boost::tuples::make_tuple("Collision", result.first*1000, result.second*1000);
+
+      m_AccumulatedLoad[0].second += m_CalculateTimes.back();
+      m_AccumulatedLoad[1].second += m_TransformCalculateTimes.back();
+      m_AccumulatedLoad[2].second += m_RecalcTimes.back();
+      m_AccumulatedLoad[3].second += m_UpdateProcessEventCalculateTimes.back();
+      m_AccumulatedLoad[4].second += m_CollisionCalculateTimes.back();
+
+      if (m_bInformationRequested)
+        publishInformation();
     }  
   
     if ((getSettings()->getVariousProperties() & CSWSettings::AUTOMATIC_BATTLE_STOP) && !bBattleRunning)
@@ -847,6 +906,30 @@ namespace CodeSubWars
   }
 
 
+  void CSWWorld::setRecordPath(const std::string& strPath)
+  {
+    m_strRecordPath = strPath;
+  }
+
+
+  const std::string& CSWWorld::getRecordPath() const
+  {
+    return m_strRecordPath;
+  }
+
+
+  void CSWWorld::setWorldPath(const std::string& strPath)
+  {
+    m_strWorldPath = strPath;
+  }
+
+
+  const std::string& CSWWorld::getWorldPath() const
+  {
+    return m_strWorldPath;
+  }
+
+
   void CSWWorld::store()
   {
     if (getSettings()->getVariousProperties() & CSWSettings::STORE_WORLD_PERIODICALLY)
@@ -859,13 +942,13 @@ namespace CodeSubWars
     if (!(getSettings()->getVariousProperties() & CSWSettings::STORE_WORLD_PERIODICALLY))
       return;
 
-    QDir().mkdir(strPath.c_str());
+    ARSTD::FileSystem::createDirectory(strPath);
 
     //close attached sink
     m_RecordStream.strict_sync();
     m_RecordStream.reset();
 
-    std::string strFileName = strPath + "/" + CSWUtilities::getUniqueFilename(strPath.c_str()).toStdString() + ".cbr";
+    std::string strFileName = strPath + "/" + CSWUtilities::getUniqueFilename(strPath) + ".cbr";
     boost::iostreams::file_sink fs(strFileName, std::ios::out | std::ios::binary);
   
     //on first call the header must be written. (total header size: 6 + 3 byte)
@@ -909,6 +992,18 @@ namespace CodeSubWars
   }
 
 
+  const std::string& CSWWorld::getWorldName() const
+  {
+    return m_strWorldName;
+  }
+
+
+  CSWWorldDefinition::PtrType CSWWorld::getWorldDefinition() const
+  {
+    return m_pWorldDefinition;
+  }
+
+
   CSWBattleStatistics::PtrType CSWWorld::getBattleStatistics()
   {
     return m_pBattleStatistics;
@@ -933,9 +1028,16 @@ namespace CodeSubWars
   }
 
 
+  const std::vector<std::pair<std::string, double> >& CSWWorld::getAccumulatedLoad() const
+  {
+    return m_AccumulatedLoad;
+  }
+
+
   void CSWWorld::calcWorldTransform()
   {
     m_pObjectTree->calcWorldTransforms();
+    m_pObjectIndex->invalidatePositions();
   }
 
 
@@ -958,6 +1060,7 @@ namespace CodeSubWars
         CSWSubmarine::PtrType pSubmarine = std::dynamic_pointer_cast<CSWSubmarine>(pObj);
         assert(pSubmarine);
         pSubmarine->setTeamID(nUniqueTeamID);
+        pSubmarine->setBotName(it->first);
       
         m_LoadedSubmarines.push_back(pObj);
       }
@@ -975,4 +1078,125 @@ namespace CodeSubWars
     m_SoundReceiverObjectContainer = collectMessage.getCollectedObjects()[1];
   }
 
+
+  void CSWWorld::attachProfilers()
+  {
+    std::vector<CSWObject::PtrType>::iterator it = m_LoadedSubmarines.begin();
+    for (; it != m_LoadedSubmarines.end(); ++it)
+    {
+      CSWIPythonable::PtrType pPyObj = std::dynamic_pointer_cast<CSWIPythonable>(*it);
+      if (!pPyObj || !pPyObj->getPythonContext())
+        continue;
+
+      CSWPyProfiler::PtrType pProfiler = CSWPyProfiler::create((*it)->getName());
+      {
+        auto lck = pPyObj->getPythonContext()->makeCurrent();
+        pProfiler->attach();
+      }
+      m_Profilers.push_back(std::make_pair(std::weak_ptr<PythonContext>(pPyObj->getPythonContext()), pProfiler));
+    }
+  }
+
+
+  void CSWWorld::writeProfiles()
+  {
+    if (m_Profilers.empty())
+      return;
+
+    std::string strFileName = "log/profile_" + CSWUtilities::getCurrentDateTime("%Y%m%d_%H%M%S") + ".folded";
+    std::ofstream os(strFileName.c_str());
+    std::vector<std::pair<std::weak_ptr<PythonContext>, CSWPyProfiler::PtrType> >::iterator it = m_Profilers.begin();
+    for (; it != m_Profilers.end(); ++it)
+    {
+      //interpreters of already removed submarines have released their profiler on destruction
+      if (PythonContext::PtrType pyContext = it->first.lock())
+      {
+        auto lck = pyContext->makeCurrent();
+        it->second->detach();
+      }
+      it->second->write(os);
+    }
+    m_Profilers.clear();
+
+    if (os)
+      CSWLog::getInstance()->log("submarine profiles written to " + strFileName);
+    else
+      CSWLog::getInstance()->log("could not write submarine profiles to " + strFileName);
+  }
+
+
+  void CSWWorld::logCPUUsage(CSWObject::PtrType pObject)
+  {
+    CSWSubmarine::PtrType pSubmarine = std::dynamic_pointer_cast<CSWSubmarine>(pObject);
+    if (!pSubmarine)
+      return;
+
+    CSWCPUAccount::PtrType pAccount = pSubmarine->getCPUAccount();
+    std::stringstream ss;
+    ss.precision(3);
+    ss.setf(std::ios::fixed);
+    ss << pSubmarine->getName() << " consumed " << pAccount->getTotalTime() << "s cpu time (";
+    for (int i = 0; i < CSWCPUAccount::NUM_CALL_TYPES; ++i)
+    {
+      CSWCPUAccount::CallType type = static_cast<CSWCPUAccount::CallType>(i);
+      ss << (i ? ", " : "") << CSWCPUAccount::getName(type) << " " << pAccount->getTotalTime(type) << "s";
+    }
+    ss << ")";
+    CSWLog::getInstance()->log(ss.str());
+  }
+
+
+  void CSWWorld::publishInformation()
+  {
+    m_bInformationRequested = false;
+    //compared by version, so the modification flags of the tree are left to the other users of hasChanged()
+    unsigned long long nTreeVersion = m_pObjectTree ? m_pObjectTree->getVersion() : 0;
+    bool bTreeChanged = nTreeVersion != m_nInformationTreeVersion;
+    m_nInformationTreeVersion = nTreeVersion;
+    CSWInformationSnapshot::PtrType pInformation = CSWInformationSnapshot::create(m_pObjectTree, getSettings()->getSelectedObject(), m_Load, 
+                                                                                  std::atomic_load(&m_pInformation), bTreeChanged);
+    std::atomic_store(&m_pInformation, pInformation);
+  }
+
+
+  void CSWWorld::releaseObject(CSWObject::PtrType& pObject)
+  {
+    //the gui must not get hold of it via the selection
+    getSettings()->deselectObject(pObject);
+
+    //the reference of the caller is taken, it must not be the last one dropped outside of the python context
+    if (m_bRenderFramesEnabled)
+      m_ReleasedObjects.push_back(std::move(pObject));
+    else
+      destroyObject(pObject);
+  }
+
+
+  void CSWWorld::destroyReleasedObjects()
+  {
+    if (m_ReleasedObjects.empty())
+      return;
+
+    //the published frames only identify objects by their address and never reach them, the gui only reads snapshots
+    std::vector<CSWObject::PtrType>::iterator it = m_ReleasedObjects.begin();
+    for (; it != m_ReleasedObjects.end(); ++it)
+      destroyObject(*it);
+    m_ReleasedObjects.clear();
+  }
+
+
+  void CSWWorld::destroyObject(CSWObject::PtrType& pObject)
+  {
+    //objects created by python must be destroyed within their interpreter
+    PythonContext::PtrType pyContext;
+    if (CSWIPythonable::PtrType pPyObj = std::dynamic_pointer_cast<CSWIPythonable>(pObject))
+      pyContext = pPyObj->getPythonContext();
+    if (pyContext)
+    {
+      auto lck = pyContext->makeCurrent();
+      pObject.reset();
+    }
+    pObject.reset();
+  }
+
 }
\ No newline at end of file
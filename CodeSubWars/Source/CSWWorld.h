@@ -5,6 +5,7 @@
 #pragma once
 
 #include "CSWUtilities.h"
+#include "CSWRenderFrame.h"
 
 namespace CodeSubWars
 {
@@ -15,20 +16,27 @@ namespace CodeSubWars
   class CSWBattleStatistics;
   class CSWExplosionVisualizer;
   class CSWSoundVisualizer;
+  class CSWPyProfiler;
+  class CSWInformationSnapshot;
+  class CSWWorldSnapshot;
+  class CSWWorldDefinition;
+  class CSWCollisionFilter;
+  class CSWObjectIndex;
+  class PythonContext;
 
   class CSWWorld
   {
     public:
       typedef std::shared_ptr<CSWWorld> PtrType;
     
+      //the predefined worlds, read from default<n>.xml in the world path
       enum WorldType
       {
         DEFAULT_1 = 1,
         DEFAULT_2 = 2,
         DEFAULT_3 = 3,
         DEFAULT_4 = 4,
-        DEFAULT_5 = 5,
-        LOAD_WORLD
+        DEFAULT_5 = 5
       };
     
       enum BattleType
@@ -47,9 +55,16 @@ namespace CodeSubWars
 
       DT_SceneHandle getScene();
       DT_RespTableHandle getResponseTable();
-      DT_ResponseClass getResponseClass();
+      std::shared_ptr<CSWCollisionFilter> getCollisionFilter();
 
       void newWorld(WorldType type);
+
+      /**
+       * Sets up the world described by the given definition file, see CSWWorldDefinition. The current world is 
+       * kept if the file could not be read.
+       * @return False if the definition could not be read.
+       */
+      bool newWorld(const std::string& strFileName);
       void finalizeWorld();
 
       void newBattle(const CSWUtilities::SubmarineFileContainer& submarines, 
@@ -65,34 +80,129 @@ namespace CodeSubWars
       void setObjectTree(const std::shared_ptr<CSWObject> pObjectTree);
 
       bool isOutside(const std::shared_ptr<CSWObject> pObject) const;
+
+      /**
+       * @return One of the solid objects on the first level of the tree which position is closer than the given 
+       *         distance or null if none exists.
+       */
       std::shared_ptr<CSWObject> getObject(const Vector3D& vecWorldTPosition, const double& fDistance) const;
 
+      /**
+       * @return The object of the tree with the given name or null if none exists.
+       */
+      std::shared_ptr<CSWObject> getObject(const std::string& strName) const;
+
+      /**
+       * Attaches the object to the root of the object tree, adds it to the name and placement index and registers its 
+       * event subscriptions. Objects must only be attached and detached through these methods, so the index and the 
+       * subscriptions stay in sync with the tree.
+       */
+      bool attachToObjectTree(std::shared_ptr<CSWObject> pObject);
+      bool detachFromObjectTree(std::shared_ptr<CSWObject> pObject);
+
+      /**
+       * Inserts an object into the running battle. Its collision is initialized immediately. Objects which 
+       * names do not start with "env" are removed on finalizing the battle.
+       * @param pObject The object that should be inserted.
+       * @param bChangePosition If true the position is moved until no other solid object occupies it.
+       */
+      void addObject(std::shared_ptr<CSWObject> pObject, bool bChangePosition = true);
+
       bool isBattleRunning() const;
 
+      /**
+       * Returns true if a snapshot of the running battle can be taken. Weapons in flight, pending events and the 
+       * commands of the objects are not part of a snapshot, so none of them must exist.
+       */
+      bool isSnapshotPossible();
+
+      /**
+       * Takes a snapshot of the running battle that can be written to a file and restored later.
+       * @return The snapshot or null if no battle is running or isSnapshotPossible() is false.
+       */
+      std::shared_ptr<CSWWorldSnapshot> takeSnapshot();
+
+      /**
+       * Sets up the world and battle of the snapshot again and continues them from the stored state. Objects of the
+       * snapshot that could not be set up again are logged and skipped.
+       * @return False if the world or the battle of the snapshot could not be set up.
+       */
+      bool restoreSnapshot(std::shared_ptr<const CSWWorldSnapshot> pSnapshot, 
+                           ARSTD::Time::Mode timeMode = ARSTD::Time::AUTOMATIC);
+
       bool hasChanged(bool bResetModification = true);
 
-      void draw();
+      /**
+       * Returns the last published snapshot of the information shown in the gui and requests a new one. While a 
+       * battle is running the snapshot is taken by the simulation after its next step, so calling this never waits
+       * for the simulation or the python interpreter. Otherwise it is taken immediately.
+       */
+      std::shared_ptr<const CSWInformationSnapshot> getInformation();
+
+      /**
+       * Enables publishing render frames, see publishRenderFrame(). Disabled by default since they are only needed if
+       * the world is drawn.
+       */
+      void setRenderFramesEnabled(bool bEnabled);
+
+      /**
+       * Publishes the current state of the world as render frame for the scene views. Called by the simulation thread 
+       * after each step and after tasks that changed the world. Objects removed from the world before are destroyed 
+       * when no render frame the gui can fetch refers to them anymore.
+       */
+      void publishRenderFrame();
+
+      /**
+       * Returns the most recently published render frame. It is valid until the next call, so only the gui thread may
+       * fetch frames.
+       */
+      const CSWRenderFrame& fetchRenderFrame();
 
       void recalculate();
 
       void store();
+
+      /**
+       * Sets the directory the battle records are written to. Default is "records" relative to the 
+       * working directory.
+       */
+      void setRecordPath(const std::string& strPath);
+      const std::string& getRecordPath() const;
+
+      /**
+       * Sets the directory the predefined worlds are read from. Default is "Worlds" relative to the 
+       * working directory.
+       */
+      void setWorldPath(const std::string& strPath);
+      const std::string& getWorldPath() const;
       
       std::shared_ptr<CSWSettings> getSettings();
       std::shared_ptr<CSWWorldGuard> getWorldGuard();
+      /**
+       * Returns the name of the current world setup, the base name of its definition file (e.g. "default1"). 
+       * Battle statistics are grouped by it.
+       */
+      const std::string& getWorldName() const;
+      std::shared_ptr<const CSWWorldDefinition> getWorldDefinition() const;
+
       std::shared_ptr<CSWBattleStatistics> getBattleStatistics();
       std::shared_ptr<CSWExplosionVisualizer> getExplosionVisualizer();
       std::shared_ptr<CSWSoundVisualizer> getSoundVisualizer();
 
       const std::vector<boost::tuples::tuple<std::string, double, double> >& getLoad() const;
+
+      /**
+       * Returns the summed up calculation time in seconds of each phase since the battle was started.
+       * The phases are the same as for getLoad().
+       */
+      const std::vector<std::pair<std::string, double> >& getAccumulatedLoad() const;
       
     protected:
       CSWWorld();
 
-      void setupEnvironment1();
-      void setupEnvironment2();
-      void setupEnvironment3();
-      void setupEnvironment4();
-      void setupEnvironment5();
+      void finalizeWorld(bool bClearShapeCache);
+
+      void setupEnvironment();
 
       void attachObject(std::shared_ptr<CSWObject> pObject, bool bChangePosition = true);
 
@@ -104,13 +214,23 @@ namespace CodeSubWars
       void store(boost::iostreams::filtering_ostream& os);
 
       void rebuildReceiverContainer();
+
+      void attachProfilers();
+      void writeProfiles();
+      void logCPUUsage(std::shared_ptr<CSWObject> pObject);
+
+      void publishInformation();
+
+      void releaseObject(std::shared_ptr<CSWObject>& pObject);
+      void destroyReleasedObjects();
+      void destroyObject(std::shared_ptr<CSWObject>& pObject);
     
       template <typename ForwardIterator>
       std::pair<typename std::iterator_traits<ForwardIterator>::value_type, 
                 typename std::iterator_traits<ForwardIterator>::value_type> 
       calcStatistics(ForwardIterator itBegin, ForwardIterator itEnd)
       {
-        typedef std::iterator_traits<ForwardIterator>::value_type ValueType;
+        typedef typename std::iterator_traits<ForwardIterator>::value_type ValueType;
         ValueType mean = ValueType();
         ValueType max = ValueType();
         int nNumElements = 0;
@@ -128,17 +248,19 @@ namespace CodeSubWars
 
       DT_SceneHandle m_hDTScene;
       DT_RespTableHandle m_hDTRespTable;
-      DT_ResponseClass m_DTResponseClass;
+      std::shared_ptr<CSWCollisionFilter> m_pCollisionFilter;
     
-      bool m_bWorldInitialized;
-      bool m_bBattleInitialized;
+      //also read by the gui
+      std::atomic<bool> m_bWorldInitialized;
+      std::atomic<bool> m_bBattleInitialized;
     
-      QMutex m_mtxRecalc;
-      QMutex m_mtxDraw;
+      std::recursive_mutex m_mtxRecalc;
     
       PyThreadState* m_pyMainState;
     
       std::shared_ptr<CSWObject> m_pObjectTree;
+      //finds objects of the tree by name or position without walking it
+      std::shared_ptr<CSWObjectIndex> m_pObjectIndex;
       std::vector<std::shared_ptr<CSWObject> > m_LoadedSubmarines;
       std::shared_ptr<CSWSettings> m_pSettings;
       std::shared_ptr<CSWWorldGuard> m_pWorldGuard;
@@ -147,14 +269,36 @@ namespace CodeSubWars
       std::shared_ptr<CSWSoundVisualizer> m_pSoundVisualizer;
     
       std::vector<boost::tuples::tuple<std::string, double, double> > m_Load;
+      std::vector<std::pair<std::string, double> > m_AccumulatedLoad;
       BattleType m_BattleType;
+      int m_nTeamSize;
+      CSWUtilities::SubmarineFileContainer m_BattleSubmarines;
+      std::string m_strWorldName;
+      std::shared_ptr<const CSWWorldDefinition> m_pWorldDefinition;
+      //state of the random generator before the world was set up, so snapshots can set up the same world again
+      std::string m_strWorldRandomGeneratorState;
     
+      std::string m_strRecordPath;
+      std::string m_strWorldPath;
       boost::iostreams::filtering_ostream m_RecordStream;
       double m_fLastStoredTime;
     
       std::vector<std::shared_ptr<CSWObject> > m_DynamicObjectContainer;
       std::vector<std::shared_ptr<CSWObject> > m_SoundReceiverObjectContainer;
 
+      std::vector<std::pair<std::weak_ptr<PythonContext>, std::shared_ptr<CSWPyProfiler> > > m_Profilers;
+
+      //read by the gui without any lock, so it is only replaced via std::atomic_store
+      std::shared_ptr<const CSWInformationSnapshot> m_pInformation;
+      std::atomic<bool> m_bInformationRequested;
+      //version of the object tree the last information snapshot was taken from
+      unsigned long long m_nInformationTreeVersion;
+
+      bool m_bRenderFramesEnabled;
+      ARSTD::TripleBuffer<CSWRenderFrame> m_RenderFrames;
+      //removed from the world but possibly still referenced by a render frame
+      std::vector<std::shared_ptr<CSWObject> > m_ReleasedObjects;
+
       boost::circular_buffer<double> m_CalculateTimes;
       boost::circular_buffer<double> m_TransformCalculateTimes;
       boost::circular_buffer<double> m_RecalcTimes;
@@ -0,0 +1,301 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#include "CorePrecompiledHeader.h"
+#include "CSWWorldDefinition.h"
+#include "CSWWorld.h"
+#include "CSWLog.h"
+#include "CSWUtilities.h"
+
+#include "CSWCamera.h"
+#include "Border.h"
+#include "Wall.h"
+#include "Rock.h"
+#include "ActiveRock.h"
+#include "BlackHole.h"
+#include "Magnet.h"
+#include "WeaponSupply.h"
+
+
+namespace CodeSubWars
+{
+
+  namespace
+  {
+    //file name -> content of the file and the definition parsed from it
+    typedef std::map<std::string, std::pair<std::string, CSWWorldDefinition::PtrType> > DefinitionCache;
+
+
+    std::mutex& getDefinitionCacheMutex()
+    {
+      static std::mutex mtx;
+      return mtx;
+    }
+
+
+    DefinitionCache& getDefinitionCache()
+    {
+      static DefinitionCache cache;
+      return cache;
+    }
+
+
+    Vector3D parseVector(const std::string& strValue)
+    {
+      std::istringstream is(strValue);
+      Vector3D vec;
+      is >> vec.x >> vec.y >> vec.z;
+      if (is.fail())
+        throw std::runtime_error("invalid vector \"" + strValue + "\"");
+      return vec;
+    }
+
+
+    Size3D parseSize(const std::string& strValue)
+    {
+      Vector3D vec = parseVector(strValue);
+      if (vec.x <= 0 || vec.y <= 0 || vec.z <= 0)
+        throw std::runtime_error("invalid size \"" + strValue + "\"");
+      return Size3D(vec.x, vec.y, vec.z);
+    }
+
+
+    int getRandomInteger(double fMin, double fMax)
+    {
+      return CSWUtilities::getRandomInteger(static_cast<int>(floor(fMin)), static_cast<int>(floor(fMax)));
+    }
+  }
+
+
+  CSWWorldDefinition::PtrType CSWWorldDefinition::load(const std::string& strFileName)
+  {
+    std::ifstream is(strFileName.c_str());
+    if (!is.is_open())
+    {
+      CSWLog::getInstance()->log("could not open world definition " + strFileName);
+      return PtrType();
+    }
+    std::stringstream ssContent;
+    ssContent << is.rdbuf();
+    std::string strContent = ssContent.str();
+
+    std::lock_guard<std::mutex> lck(getDefinitionCacheMutex());
+    DefinitionCache::const_iterator itCache = getDefinitionCache().find(strFileName);
+    if (itCache != getDefinitionCache().end() && itCache->second.first == strContent)
+      return itCache->second.second;
+
+    std::shared_ptr<CSWWorldDefinition> pDefinition(new CSWWorldDefinition());
+    pDefinition->m_strFileName = strFileName;
+    try
+    {
+      boost::property_tree::ptree tree;
+      std::istringstream isContent(strContent);
+      read_xml(isContent, tree);
+
+      const boost::property_tree::ptree& world = tree.get_child("world");
+      pDefinition->m_strName = world.get("<xmlattr>.name", ARSTD::FileSystem::getBaseName(strFileName));
+
+      const boost::property_tree::ptree noAttributes;
+      boost::property_tree::ptree::const_iterator it = world.begin();
+      for (; it != world.end(); ++it)
+      {
+        const boost::property_tree::ptree& attributes = it->second.get_child("<xmlattr>", noAttributes);
+        if (it->first == "borders")
+        {
+          pDefinition->m_bBorders = true;
+        }
+        else if (it->first == "spawn")
+        {
+          pDefinition->m_fSingleSpawnExtent = attributes.get("single", pDefinition->m_fSingleSpawnExtent);
+          pDefinition->m_fTeamSpawnExtent = attributes.get("team", pDefinition->m_fTeamSpawnExtent);
+        }
+        else if (it->first == "object" || it->first == "random")
+        {
+          ObjectDefinition object;
+          object.strType = attributes.get<std::string>("type");
+          if (!isKnownType(object.strType))
+            throw std::runtime_error("unknown object type " + object.strType);
+          object.strName = attributes.get<std::string>("name");
+          object.nCount = 0;
+          object.size = Size3D(1, 1, 1);
+          object.minSize = object.size;
+          object.maxSize = object.size;
+          object.bRandomOrientation = false;
+
+          if (it->first == "object")
+          {
+            object.matBaseTObject = Matrix44D(parseVector(attributes.get("xaxis", "1 0 0")),
+                                              parseVector(attributes.get("yaxis", "0 1 0")),
+                                              parseVector(attributes.get("zaxis", "0 0 1")),
+                                              parseVector(attributes.get("position", "0 0 0")));
+            if (object.strType != "Camera")
+              object.size = parseSize(attributes.get<std::string>("size"));
+          }
+          else
+          {
+            object.nCount = attributes.get<int>("count");
+            if (object.nCount < 1)
+              throw std::runtime_error("invalid count of " + object.strName);
+            object.vecMinPosition = parseVector(attributes.get<std::string>("min"));
+            object.vecMaxPosition = parseVector(attributes.get<std::string>("max"));
+            object.minSize = parseSize(attributes.get<std::string>("minsize"));
+            object.maxSize = parseSize(attributes.get<std::string>("maxsize"));
+            object.bRandomOrientation = attributes.get("orientation", "") == "random";
+            if (object.vecMinPosition.x > object.vecMaxPosition.x ||
+                object.vecMinPosition.y > object.vecMaxPosition.y ||
+                object.vecMinPosition.z > object.vecMaxPosition.z ||
+                object.minSize.getWidth() > object.maxSize.getWidth() ||
+                object.minSize.getHeight() > object.maxSize.getHeight() ||
+                object.minSize.getDepth() > object.maxSize.getDepth())
+              throw std::runtime_error("invalid range of " + object.strName);
+          }
+          pDefinition->m_Objects.push_back(object);
+        }
+        else if (it->first != "<xmlattr>" && it->first != "<xmlcomment>")
+        {
+          throw std::runtime_error("unknown element " + it->first);
+        }
+      }
+    }
+    catch (std::exception& e)
+    {
+      CSWLog::getInstance()->log("invalid world definition " + strFileName + ": " + e.what());
+      return PtrType();
+    }
+
+    getDefinitionCache()[strFileName] = std::make_pair(strContent, pDefinition);
+    return pDefinition;
+  }
+
+
+  CSWWorldDefinition::~CSWWorldDefinition()
+  {
+  }
+
+
+  void CSWWorldDefinition::createObjects(std::vector<CSWObject::PtrType>& fixedObjects,
+                                         std::vector<CSWObject::PtrType>& randomObjects) const
+  {
+    if (m_bBorders)
+      createBorders(fixedObjects);
+
+    ObjectDefinitionContainer::const_iterator it = m_Objects.begin();
+    for (; it != m_Objects.end(); ++it)
+    {
+      if (!it->nCount)
+      {
+        fixedObjects.push_back(createObject(*it, it->strName, it->matBaseTObject, it->size));
+        continue;
+      }
+
+      for (int i = 0; i < it->nCount; ++i)
+      {
+        Matrix44D mat;
+        if (it->bRandomOrientation)
+          mat = CSWUtilities::getRandomOrientation();
+        int x = getRandomInteger(it->vecMinPosition.x, it->vecMaxPosition.x);
+        int y = getRandomInteger(it->vecMinPosition.y, it->vecMaxPosition.y);
+        int z = getRandomInteger(it->vecMinPosition.z, it->vecMaxPosition.z);
+        mat.getTranslation() = Vector3D(x, y, z);
+        int nWidth = getRandomInteger(it->minSize.getWidth(), it->maxSize.getWidth());
+        int nHeight = getRandomInteger(it->minSize.getHeight(), it->maxSize.getHeight());
+        int nDepth = getRandomInteger(it->minSize.getDepth(), it->maxSize.getDepth());
+        randomObjects.push_back(createObject(*it, it->strName + ARSTD::Utilities::toString(i), mat, Size3D(nWidth, nHeight, nDepth)));
+      }
+    }
+  }
+
+
+  const std::string& CSWWorldDefinition::getFileName() const
+  {
+    return m_strFileName;
+  }
+
+
+  const std::string& CSWWorldDefinition::getName() const
+  {
+    return m_strName;
+  }
+
+
+  const CSWWorldDefinition::ObjectDefinitionContainer& CSWWorldDefinition::getObjects() const
+  {
+    return m_Objects;
+  }
+
+
+  double CSWWorldDefinition::getSingleSpawnExtent() const
+  {
+    return m_fSingleSpawnExtent;
+  }
+
+
+  double CSWWorldDefinition::getTeamSpawnExtent() const
+  {
+    return m_fTeamSpawnExtent;
+  }
+
+
+  CSWWorldDefinition::CSWWorldDefinition()
+  : m_bBorders(false),
+    m_fSingleSpawnExtent(1500),
+    m_fTeamSpawnExtent(2500)
+  {
+  }
+
+
+  bool CSWWorldDefinition::isKnownType(const std::string& strType)
+  {
+    return strType == "Border" || strType == "Wall" || strType == "Rock" || strType == "ActiveRock" ||
+           strType == "BlackHole" || strType == "Magnet" || strType == "WeaponSupply" || strType == "Camera";
+  }
+
+
+  CSWObject::PtrType CSWWorldDefinition::createObject(const ObjectDefinition& object, const std::string& strName,
+                                                      const Matrix44D& matBaseTObject, const Size3D& size) const
+  {
+    if (object.strType == "Border")
+      return Border::create(strName, matBaseTObject, size);
+    if (object.strType == "Wall")
+      return Wall::create(strName, matBaseTObject, size);
+    if (object.strType == "Rock")
+      return Rock::create(strName, matBaseTObject, size);
+    if (object.strType == "ActiveRock")
+      return ActiveRock::create(strName, matBaseTObject, size);
+    if (object.strType == "BlackHole")
+      return BlackHole::create(strName, matBaseTObject, size);
+    if (object.strType == "Magnet")
+      return Magnet::create(strName, matBaseTObject, size);
+    if (object.strType == "WeaponSupply")
+      return WeaponSupply::create(strName, matBaseTObject, size);
+
+    assert(object.strType == "Camera");
+    return CSWCamera::create(strName, matBaseTObject);
+  }
+
+
+  void CSWWorldDefinition::createBorders(std::vector<CSWObject::PtrType>& objects) const
+  {
+    //the borders enclose the cube the world guard keeps the objects in
+    const Size3D& cube = CSWWorld::CUBE_SIZE;
+    const double fThickness = CSWWorld::CUBE_THICKNESS;
+    const double fMargin = CSWWorld::CUBE_MARGIN;
+
+    objects.push_back(Border::create("envBorder1", Matrix44D(Vector3D(0, 0, cube.getDepth()/2 - fThickness/2)),
+                                     Size3D(cube.getWidth() - 2*fThickness - 2*fMargin, cube.getHeight(), fThickness)));
+    objects.push_back(Border::create("envBorder2", Matrix44D(Vector3D(0, 0, -cube.getDepth()/2 + fThickness/2)),
+                                     Size3D(cube.getWidth() - 2*fThickness - 2*fMargin, cube.getHeight(), fThickness)));
+
+    objects.push_back(Border::create("envBorder3", Matrix44D(Vector3D(cube.getWidth()/2 - fThickness/2, 0, 0)),
+                                     Size3D(fThickness, cube.getHeight(), cube.getDepth())));
+    objects.push_back(Border::create("envBorder4", Matrix44D(Vector3D(-cube.getWidth()/2 + fThickness/2, 0, 0)),
+                                     Size3D(fThickness, cube.getHeight(), cube.getDepth())));
+
+    objects.push_back(Border::create("envBorder5", Matrix44D(Vector3D(0, cube.getHeight()/2 - fThickness/2, 0)),
+                                     Size3D(cube.getWidth() - 2*fThickness - 2*fMargin, fThickness, cube.getDepth() - 2*fThickness - 2*fMargin)));
+    objects.push_back(Border::create("envBorder6", Matrix44D(Vector3D(0, -cube.getHeight()/2 + fThickness/2, 0)),
+                                     Size3D(cube.getWidth() - 2*fThickness - 2*fMargin, fThickness, cube.getDepth() - 2*fThickness - 2*fMargin)));
+  }
+
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#pragma once
+
+
+namespace CodeSubWars
+{
+
+  class CSWObject;
+
+  /**
+   * Describes the environment of a world: the static geometry, supplies and force emitters and the regions the
+   * submarines are spawned in. Definitions are read from xml files like
+   * @code
+   * <world name="Rocks">
+   *   <borders/>
+   *   <object type="Camera" name="envMainCamera" position="0 2300 0" xaxis="1 0 0" yaxis="0 0 1" zaxis="0 -1 0"/>
+   *   <object type="WeaponSupply" name="envWeaponSupply" position="0 0 0" size="100 100 100"/>
+   *   <random type="Rock" name="envRock" count="20" min="-750 -750 -750" max="749 749 749"
+   *           minsize="50 50 50" maxsize="149 149 149" orientation="random"/>
+   *   <spawn single="1500" team="2500"/>
+   * </world>
+   * @endcode
+   * The types are Border, Wall, Rock, ActiveRock, BlackHole, Magnet, WeaponSupply and Camera. Random objects are
+   * placed in whole meters with the random generator of the simulation when the world is set up. Names of objects
+   * must start with "env" to stay in the world between battles.
+   */
+  class CSWWorldDefinition
+  {
+    public:
+      typedef std::shared_ptr<const CSWWorldDefinition> PtrType;
+
+      struct ObjectDefinition
+      {
+        std::string strType;
+        std::string strName;
+        //number of randomly placed objects, 0 for an object at a fixed position
+        int nCount;
+        Matrix44D matBaseTObject;
+        Size3D size;
+        //region and size range of random objects
+        Vector3D vecMinPosition;
+        Vector3D vecMaxPosition;
+        Size3D minSize;
+        Size3D maxSize;
+        bool bRandomOrientation;
+      };
+
+      typedef std::vector<ObjectDefinition> ObjectDefinitionContainer;
+
+      /**
+       * Reads the definition from the given file. Parsed definitions are kept as long as the content of the file
+       * does not change, so setting up the same world again does not parse it again.
+       * @return The definition or null if the file could not be read or is invalid (the reason is logged).
+       */
+      static PtrType load(const std::string& strFileName);
+
+      ~CSWWorldDefinition();
+
+      /**
+       * Creates the objects of the environment. The random objects are placed here, so they should be moved if
+       * their position is occupied, while fixed objects keep the position given in the definition.
+       */
+      void createObjects(std::vector<std::shared_ptr<CSWObject> >& fixedObjects,
+                         std::vector<std::shared_ptr<CSWObject> >& randomObjects) const;
+
+      const std::string& getFileName() const;
+      const std::string& getName() const;
+      const ObjectDefinitionContainer& getObjects() const;
+
+      //edge length of the cube around the center the submarines are spawned in
+      double getSingleSpawnExtent() const;
+      double getTeamSpawnExtent() const;
+
+    protected:
+      CSWWorldDefinition();
+
+      static bool isKnownType(const std::string& strType);
+      std::shared_ptr<CSWObject> createObject(const ObjectDefinition& object, const std::string& strName,
+                                              const Matrix44D& matBaseTObject, const Size3D& size) const;
+      void createBorders(std::vector<std::shared_ptr<CSWObject> >& objects) const;
+
+      std::string m_strFileName;
+      std::string m_strName;
+      bool m_bBorders;
+      ObjectDefinitionContainer m_Objects;
+      double m_fSingleSpawnExtent;
+      double m_fTeamSpawnExtent;
+  };
+
+}
\ No newline at end of file
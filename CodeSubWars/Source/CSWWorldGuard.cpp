@@ -2,7 +2,7 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "CSWWorldGuard.h"
 #include "CSWWorld.h"
 #include "CSWLog.h"
@@ -151,7 +151,7 @@ namespace CodeSubWars
 
   void CSWWorldGuard::addErroneousObject(const std::string& strName, ErrorType type)
   {
-    CSWObject::PtrType pObject = std::dynamic_pointer_cast<CSWObject>(ARSTD::Element::findElement(CSWWorld::getInstance()->getObjectTree(), strName));
+    CSWObject::PtrType pObject = CSWWorld::getInstance()->getObject(strName);
     if (pObject)
       addErroneousObject(pObject, type);
   }
@@ -0,0 +1,296 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#include "CorePrecompiledHeader.h"
+#include "CSWWorldSnapshot.h"
+
+#include "CSWObject.h"
+#include "CSWEngine.h"
+
+#include "CSWIDamageable.h"
+#include "CSWIDynamic.h"
+#include "CSWIPythonable.h"
+
+
+namespace CodeSubWars
+{
+
+  namespace
+  {
+    //strings longer than this are treated as corrupted file
+    const ARSTD::uint32 MAX_STRING_SIZE = 256*1024*1024;
+
+
+    template <typename Type>
+    void writeValue(std::ostream& os, const Type& value)
+    {
+      os.write(reinterpret_cast<const char*>(&value), sizeof(Type));
+    }
+
+
+    void writeString(std::ostream& os, const std::string& str)
+    {
+      ARSTD::uint32 nSize = static_cast<ARSTD::uint32>(str.size());
+      writeValue(os, nSize);
+      os.write(str.data(), nSize);
+    }
+
+
+    template <typename Type>
+    bool readValue(std::istream& is, Type& value)
+    {
+      is.read(reinterpret_cast<char*>(&value), sizeof(Type));
+      return is.good();
+    }
+
+
+    bool readString(std::istream& is, std::string& str)
+    {
+      ARSTD::uint32 nSize = 0;
+      if (!readValue(is, nSize) || nSize > MAX_STRING_SIZE)
+        return false;
+      str.resize(nSize);
+      if (nSize)
+        is.read(&str[0], nSize);
+      return is.good();
+    }
+  }
+
+
+  const ARSTD::uint32 CSWWorldSnapshot::VERSION = 3;
+
+
+  CSWWorldSnapshot::PtrType CSWWorldSnapshot::create(CSWObject::PtrType pObjectTree)
+  {
+    PtrType pSnapshot(new CSWWorldSnapshot());
+    if (pObjectTree)
+    {
+      CSWObject::ChildRange range = pObjectTree->getChildRange();
+      for (CSWObject::ChildIterator it = range.first; it != range.second; ++it)
+      {
+        if (CSWObject::PtrType pChild = std::dynamic_pointer_cast<CSWObject>(*it))
+          pSnapshot->collectObjects(pChild, "");
+      }
+    }
+    return pSnapshot;
+  }
+
+
+  CSWWorldSnapshot::PtrType CSWWorldSnapshot::read(const std::string& strFileName)
+  {
+    std::ifstream is(strFileName.c_str(), std::ios::in | std::ios::binary);
+    char pMagic[6];
+    is.read(pMagic, 6);
+    ARSTD::uint32 nVersion = 0;
+    if (!is.good() || std::string(pMagic, 6) != "CSW.WS" || !readValue(is, nVersion) || nVersion != VERSION)
+      return PtrType();
+
+    PtrType pSnapshot(new CSWWorldSnapshot());
+    ARSTD::uint32 nNumSubmarines = 0;
+    bool bResult = readValue(is, pSnapshot->fTime) &&
+                   readString(is, pSnapshot->strWorld) &&
+                   readValue(is, pSnapshot->nBattleType) &&
+                   readValue(is, pSnapshot->nTeamSize) &&
+                   readString(is, pSnapshot->strWorldRandomGeneratorState) &&
+                   readString(is, pSnapshot->strRandomGeneratorState) &&
+                   readString(is, pSnapshot->strBattleStatisticsState) &&
+                   readValue(is, nNumSubmarines);
+    for (ARSTD::uint32 nSubmarine = 0; bResult && nSubmarine < nNumSubmarines; ++nSubmarine)
+    {
+      std::string strName;
+      std::string strFileName;
+      bResult = readString(is, strName) && readString(is, strFileName);
+      pSnapshot->submarines[strName] = strFileName;
+    }
+
+    ARSTD::uint32 nNumObjects = 0;
+    bResult = bResult && readValue(is, nNumObjects);
+    for (ARSTD::uint32 nObject = 0; bResult && nObject < nNumObjects; ++nObject)
+    {
+      ObjectState state;
+      bResult = readString(is, state.strPath) &&
+                readValue(is, state.matBaseTObject) &&
+                readValue(is, state.bDynamic) &&
+                readValue(is, state.vecWorldTVelocity) &&
+                readValue(is, state.vecWorldTAngularMomentum) &&
+                readValue(is, state.bDamageable) &&
+                readValue(is, state.fHealth) &&
+                readValue(is, state.bEngine) &&
+                readValue(is, state.fIntensity) &&
+                readString(is, state.strPickledState);
+      pSnapshot->objects.push_back(state);
+    }
+    if (!bResult)
+      return PtrType();
+
+    return pSnapshot;
+  }
+
+
+  CSWWorldSnapshot::~CSWWorldSnapshot()
+  {
+  }
+
+
+  bool CSWWorldSnapshot::write(const std::string& strFileName) const
+  {
+    std::ofstream os(strFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!os.is_open())
+      return false;
+
+    os.write("CSW.WS", 6);
+    writeValue(os, VERSION);
+    writeValue(os, fTime);
+    writeString(os, strWorld);
+    writeValue(os, nBattleType);
+    writeValue(os, nTeamSize);
+    writeString(os, strWorldRandomGeneratorState);
+    writeString(os, strRandomGeneratorState);
+    writeString(os, strBattleStatisticsState);
+
+    writeValue(os, static_cast<ARSTD::uint32>(submarines.size()));
+    CSWUtilities::SubmarineFileContainer::const_iterator itSubmarine = submarines.begin();
+    for (; itSubmarine != submarines.end(); ++itSubmarine)
+    {
+      writeString(os, itSubmarine->first);
+      writeString(os, itSubmarine->second);
+    }
+
+    writeValue(os, static_cast<ARSTD::uint32>(objects.size()));
+    ObjectStateContainer::const_iterator it = objects.begin();
+    for (; it != objects.end(); ++it)
+    {
+      writeString(os, it->strPath);
+      writeValue(os, it->matBaseTObject);
+      writeValue(os, it->bDynamic);
+      writeValue(os, it->vecWorldTVelocity);
+      writeValue(os, it->vecWorldTAngularMomentum);
+      writeValue(os, it->bDamageable);
+      writeValue(os, it->fHealth);
+      writeValue(os, it->bEngine);
+      writeValue(os, it->fIntensity);
+      writeString(os, it->strPickledState);
+    }
+
+    os.flush();
+    return os.good();
+  }
+
+
+  std::vector<std::string> CSWWorldSnapshot::restore(CSWObject::PtrType pObjectTree) const
+  {
+    std::vector<std::string> missingObjects;
+    if (!pObjectTree)
+      return missingObjects;
+
+    //the current objects by path
+    std::map<std::string, CSWObject::PtrType> currentObjects;
+    std::vector<std::pair<std::string, CSWObject::PtrType> > stack;
+    stack.push_back(std::make_pair(std::string(), pObjectTree));
+    while (!stack.empty())
+    {
+      std::pair<std::string, CSWObject::PtrType> current = stack.back();
+      stack.pop_back();
+      CSWObject::ChildRange range = current.second->getChildRange();
+      for (CSWObject::ChildIterator it = range.first; it != range.second; ++it)
+      {
+        if (CSWObject::PtrType pChild = std::dynamic_pointer_cast<CSWObject>(*it))
+        {
+          std::string strPath = current.first.empty() ? pChild->getName() : current.first + "/" + pChild->getName();
+          currentObjects.insert(std::make_pair(strPath, pChild));
+          stack.push_back(std::make_pair(strPath, pChild));
+        }
+      }
+    }
+
+    std::vector<std::pair<CSWIPythonable::PtrType, std::string> > pickledStates;
+    ObjectStateContainer::const_iterator itState = objects.begin();
+    for (; itState != objects.end(); ++itState)
+    {
+      std::map<std::string, CSWObject::PtrType>::iterator itObject = currentObjects.find(itState->strPath);
+      if (itObject == currentObjects.end())
+      {
+        missingObjects.push_back(itState->strPath);
+        continue;
+      }
+      CSWObject::PtrType pObject = itObject->second;
+
+      pObject->setTransform(itState->matBaseTObject);
+      //dynamic objects are always on the top level, so their transform is given in world coordinate system
+      CSWIDynamic::PtrType pDynamic = std::dynamic_pointer_cast<CSWIDynamic>(pObject);
+      if (itState->bDynamic && pDynamic)
+      {
+        pDynamic->setNewVelocity(itState->vecWorldTVelocity, itState->vecWorldTAngularMomentum);
+        pDynamic->setNewTransform(itState->matBaseTObject);
+      }
+
+      CSWIDamageable::PtrType pDamageable = std::dynamic_pointer_cast<CSWIDamageable>(pObject);
+      if (itState->bDamageable && pDamageable)
+      {
+        double fDifference = itState->fHealth - pDamageable->getHealth();
+        if (fDifference > 0)
+          pDamageable->addHealth(fDifference);
+        else if (fDifference < 0)
+          pDamageable->addDamage(-fDifference);
+      }
+
+      CSWEngine::PtrType pEngine = std::dynamic_pointer_cast<CSWEngine>(pObject);
+      if (itState->bEngine && pEngine)
+        pEngine->setIntensity(itState->fIntensity);
+
+      CSWIPythonable::PtrType pPythonable = std::dynamic_pointer_cast<CSWIPythonable>(pObject);
+      if (!itState->strPickledState.empty() && pPythonable)
+        pickledStates.push_back(std::make_pair(pPythonable, itState->strPickledState));
+    }
+
+    //bots restore their own state after all objects have been restored, so they see the restored world
+    std::vector<std::pair<CSWIPythonable::PtrType, std::string> >::iterator itPickled = pickledStates.begin();
+    for (; itPickled != pickledStates.end(); ++itPickled)
+      itPickled->first->setPickledState(itPickled->second);
+
+    return missingObjects;
+  }
+
+
+  CSWWorldSnapshot::CSWWorldSnapshot()
+  : fTime(0),
+    nBattleType(0),
+    nTeamSize(1)
+  {
+  }
+
+
+  void CSWWorldSnapshot::collectObjects(CSWObject::PtrType pObject, const std::string& strParentPath)
+  {
+    ObjectState state;
+    state.strPath = strParentPath.empty() ? pObject->getName() : strParentPath + "/" + pObject->getName();
+    state.matBaseTObject = pObject->getTransform();
+
+    CSWIDynamic::PtrType pDynamic = std::dynamic_pointer_cast<CSWIDynamic>(pObject);
+    state.bDynamic = pDynamic != NULL;
+    state.vecWorldTVelocity = pDynamic ? pDynamic->getVelocity() : Vector3D(0, 0, 0);
+    state.vecWorldTAngularMomentum = pDynamic ? pDynamic->getAngularMomentum() : Vector3D(0, 0, 0);
+
+    CSWIDamageable::PtrType pDamageable = std::dynamic_pointer_cast<CSWIDamageable>(pObject);
+    state.bDamageable = pDamageable != NULL;
+    state.fHealth = pDamageable ? pDamageable->getHealth() : 0;
+
+    CSWEngine::PtrType pEngine = std::dynamic_pointer_cast<CSWEngine>(pObject);
+    state.bEngine = pEngine != NULL;
+    state.fIntensity = pEngine ? pEngine->getIntensity() : 0;
+
+    if (CSWIPythonable::PtrType pPythonable = std::dynamic_pointer_cast<CSWIPythonable>(pObject))
+      state.strPickledState = pPythonable->getPickledState();
+
+    objects.push_back(state);
+
+    CSWObject::ChildRange range = pObject->getChildRange();
+    for (CSWObject::ChildIterator it = range.first; it != range.second; ++it)
+    {
+      if (CSWObject::PtrType pChild = std::dynamic_pointer_cast<CSWObject>(*it))
+        collectObjects(pChild, state.strPath);
+    }
+  }
+
+}
\ No newline at end of file
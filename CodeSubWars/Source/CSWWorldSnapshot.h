@@ -0,0 +1,95 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+#pragma once
+
+#include "CSWUtilities.h"
+
+
+namespace CodeSubWars
+{
+
+  class CSWObject;
+
+  /**
+   * Copy of the simulation state of a running battle that can be written to a file and restored later. Restoring
+   * sets up the same world and battle again and applies the stored state to the objects of the same names, so
+   * several independent simulations can be continued from one snapshot (e.g. one process per snapshot file).
+   * The accounts of the battle statistics are stored as well. Weapons in flight, pending events and commands are
+   * not stored, so CSWWorld only takes snapshots while there are none. Not stored is the content of weapon 
+   * batteries either. Bots store their own state by implementing getSnapshotState() and setSnapshotState().
+   */
+  class CSWWorldSnapshot
+  {
+    public:
+      typedef std::shared_ptr<CSWWorldSnapshot> PtrType;
+
+      struct ObjectState
+      {
+        std::string strPath;              //names from the top level object down to the object separated by '/'
+        Matrix44D matBaseTObject;
+
+        //CSWIDynamic
+        bool bDynamic;
+        Vector3D vecWorldTVelocity;
+        Vector3D vecWorldTAngularMomentum;
+
+        //CSWIDamageable
+        bool bDamageable;
+        double fHealth;
+
+        //CSWEngine
+        bool bEngine;
+        double fIntensity;
+
+        //CSWIPythonable, empty if the object does not store a state
+        std::string strPickledState;
+      };
+
+      typedef std::vector<ObjectState> ObjectStateContainer;
+
+      /**
+       * Collects the state of all objects of the given tree. The header (time, world, battle, random generator) must
+       * be set by the caller.
+       */
+      static PtrType create(std::shared_ptr<CSWObject> pObjectTree);
+
+      /**
+       * @return The snapshot stored in the given file or null if it could not be read.
+       */
+      static PtrType read(const std::string& strFileName);
+
+      ~CSWWorldSnapshot();
+
+      bool write(const std::string& strFileName) const;
+
+      /**
+       * Applies the stored states to the objects of the given tree with the same path.
+       * @return The paths of the stored objects that do not exist in the tree.
+       */
+      std::vector<std::string> restore(std::shared_ptr<CSWObject> pObjectTree) const;
+
+      double fTime;
+      std::string strWorld;             //definition file of the world
+      int nBattleType;
+      int nTeamSize;
+      CSWUtilities::SubmarineFileContainer submarines;
+      //state of the random generator when the world was set up and when the snapshot was taken
+      std::string strWorldRandomGeneratorState;
+      std::string strRandomGeneratorState;
+      //see CSWBattleStatistics::getState()
+      std::string strBattleStatisticsState;
+
+      //all objects in preorder
+      ObjectStateContainer objects;
+
+    protected:
+      static const ARSTD::uint32 VERSION;
+
+      CSWWorldSnapshot();
+
+      void collectObjects(std::shared_ptr<CSWObject> pObject, const std::string& strParentPath);
+  };
+
+}
\ No newline at end of file
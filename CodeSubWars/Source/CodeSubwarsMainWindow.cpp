@@ -17,6 +17,7 @@
 #include "ReplayDialog.h"
 #include "NewBattleDialog.h"
 #include "CSWUtilities.h"
+#include "CSWSimulationThread.h"
 
 
 namespace CodeSubWars
@@ -27,6 +28,9 @@ namespace CodeSubWars
   {
     checkRequirements();
 
+    CSWWorld::getInstance()->setRecordPath((qApp->applicationDirPath() + "/records").toStdString());
+    CSWWorld::getInstance()->setWorldPath((qApp->applicationDirPath() + "/worlds").toStdString());
+
     setWindowTitle(QString("CodeSubWars ") + Constants::getVersion().getAsString().c_str());
     setEnabled(TRUE);
 
@@ -39,6 +43,10 @@ namespace CodeSubWars
     setupGUI();
     setupConnections();
 
+    //the scene views draw the frames published by the simulation thread
+    CSWWorld::getInstance()->setRenderFramesEnabled(true);
+    CSWSimulationThread::getInstance()->start();
+
     newWorldDefault1();
   
     showNormal();
@@ -47,16 +55,16 @@ namespace CodeSubWars
 
   CodeSubwarsMainWindow::~CodeSubwarsMainWindow()
   {
-    CSWWorld::getInstance()->finalizeWorld();
-    CSWLog::getInstance()->setLogOutput(NULL);
+    CSWSimulationThread::getInstance()->invoke([]() { CSWWorld::getInstance()->finalizeWorld(); });
+    CSWSimulationThread::getInstance()->stop();
+    CSWLog::getInstance()->resetLogOutput();
   }
 
 
   void CodeSubwarsMainWindow::closeEvent(QCloseEvent* pEvent)
   {
-    CSWWorld::getInstance()->finalizeWorld();
+    CSWSimulationThread::getInstance()->invoke([]() { CSWWorld::getInstance()->finalizeWorld(); });
     m_UpdateTimer.stop();
-    m_RecalcWorldTimer.stop();
     QMainWindow::closeEvent(pEvent);
   }
 
@@ -68,12 +76,6 @@ namespace CodeSubWars
   }
 
 
-  void CodeSubwarsMainWindow::recalcWorld()
-  {
-    CSWWorld::getInstance()->recalculate();
-  }
-
-
   void CodeSubwarsMainWindow::updateTimeLabel()
   {
     double fSecs = ARSTD::Time::getTime();
@@ -90,71 +92,52 @@ namespace CodeSubWars
 
   void CodeSubwarsMainWindow::newWorldDefault1()
   {
-    m_pTimeSlider->setValue(4);
-    m_UpdateTimer.start(40);
-
-    CSWWorld::getInstance()->newWorld(CSWWorld::DEFAULT_1);
-  
-    m_pMainSceneView->setCamera("envMainCamera");
-    m_pDetailLowerInformationView->enforceCompleteRebuild(true);
+    newWorld(CSWWorld::DEFAULT_1);
   }
 
 
   void CodeSubwarsMainWindow::newWorldDefault2()
   {
-    m_pTimeSlider->setValue(4);
-    m_UpdateTimer.start(40);
-
-    CSWWorld::getInstance()->newWorld(CSWWorld::DEFAULT_2);
-  
-    m_pMainSceneView->setCamera("envMainCamera");
-    m_pDetailLowerInformationView->enforceCompleteRebuild(true);
+    newWorld(CSWWorld::DEFAULT_2);
   }
 
 
   void CodeSubwarsMainWindow::newWorldDefault3()
   {
-    m_pTimeSlider->setValue(4);
-    m_UpdateTimer.start(40);
-
-    CSWWorld::getInstance()->newWorld(CSWWorld::DEFAULT_3);
-  
-    m_pMainSceneView->setCamera("envMainCamera");
-    m_pDetailLowerInformationView->enforceCompleteRebuild(true);
+    newWorld(CSWWorld::DEFAULT_3);
   }
 
 
   void CodeSubwarsMainWindow::newWorldDefault4()
   {
-    m_pTimeSlider->setValue(4);
-    m_UpdateTimer.start(40);
-
-    CSWWorld::getInstance()->newWorld(CSWWorld::DEFAULT_4);
-  
-    m_pMainSceneView->setCamera("envMainCamera");
-    m_pDetailLowerInformationView->enforceCompleteRebuild(true);
+    newWorld(CSWWorld::DEFAULT_4);
   }
 
 
   void CodeSubwarsMainWindow::newWorldDefault5()
   {
-    m_pTimeSlider->setValue(4);
-    m_UpdateTimer.start(40);
-
-    CSWWorld::getInstance()->newWorld(CSWWorld::DEFAULT_5);
-  
-    m_pMainSceneView->setCamera("envMainCamera");
-    m_pDetailLowerInformationView->enforceCompleteRebuild(true);
+    newWorld(CSWWorld::DEFAULT_5);
   }
 
 
   void CodeSubwarsMainWindow::newWorldLoad()
   {
+    QString strFileName = QFileDialog::getOpenFileName(this,
+                                                       "Choose a world definition file to open",
+                                                       qApp->applicationDirPath() + "/worlds",
+                                                       "CSW World Definitions (*.xml)");
+    if (strFileName.isEmpty())
+      return;
+
     m_pTimeSlider->setValue(4);
     m_UpdateTimer.start(40);
 
-    CSWWorld::getInstance()->newWorld(CSWWorld::LOAD_WORLD);
-  
+    std::string strWorldFileName = strFileName.toStdString();
+    CSWSimulationThread::getInstance()->invoke([strWorldFileName]()
+    {
+      CSWWorld::getInstance()->newWorld(strWorldFileName);
+    });
+
     m_pMainSceneView->setCamera("envMainCamera");
     m_pDetailLowerInformationView->enforceCompleteRebuild(true);
   }
@@ -167,12 +150,15 @@ namespace CodeSubWars
       return;
 
     m_pTimeSlider->setValue(4);
-    m_RecalcWorldTimer.start(10);
     m_UpdateTimer.start(40);
  
-    CSWWorld::getInstance()->newBattle(dlg.getSubmarines(), 
-                                       static_cast<CSWWorld::BattleType>(dlg.getBattleMode()),
-                                       dlg.getTeamSize());
+    CSWUtilities::SubmarineFileContainer submarines = dlg.getSubmarines();
+    CSWWorld::BattleType battleType = static_cast<CSWWorld::BattleType>(dlg.getBattleMode());
+    int nTeamSize = dlg.getTeamSize();
+    CSWSimulationThread::getInstance()->invoke([&]()
+    {
+      CSWWorld::getInstance()->newBattle(submarines, battleType, nTeamSize);
+    });
   
     m_pMainSceneView->setCamera("envMainCamera");
     m_pDetailLowerInformationView->enforceCompleteRebuild(true);
@@ -181,10 +167,9 @@ namespace CodeSubWars
 
   void CodeSubwarsMainWindow::stopBattle()
   {
-    m_RecalcWorldTimer.stop();
     m_UpdateTimer.stop();
 
-    CSWWorld::getInstance()->finalizeBattle();
+    CSWSimulationThread::getInstance()->invoke([]() { CSWWorld::getInstance()->finalizeBattle(); });
 
     m_pMainSceneView->setCamera("envMainCamera");
     m_pTimeSlider->setValue(4);
@@ -235,10 +220,17 @@ namespace CodeSubWars
     OptionDialog dlg(this);
     if (dlg.exec() == QDialog::Accepted)
     {
-      CSWWorld::getInstance()->getSettings()->setCollidableProperties(dlg.getCollidableProperties());
-      CSWWorld::getInstance()->getSettings()->setDamageableProperties(dlg.getDamageableProperties());
-      CSWWorld::getInstance()->getSettings()->setDynamicProperties(dlg.getDynamicProperties());
-      CSWWorld::getInstance()->getSettings()->setVariousProperties(dlg.getVariousProperties());
+      int nCollidableProperties = dlg.getCollidableProperties();
+      int nDamageableProperties = dlg.getDamageableProperties();
+      int nDynamicProperties = dlg.getDynamicProperties();
+      int nVariousProperties = dlg.getVariousProperties();
+      CSWSimulationThread::getInstance()->invoke([=]()
+      {
+        CSWWorld::getInstance()->getSettings()->setCollidableProperties(nCollidableProperties);
+        CSWWorld::getInstance()->getSettings()->setDamageableProperties(nDamageableProperties);
+        CSWWorld::getInstance()->getSettings()->setDynamicProperties(nDynamicProperties);
+        CSWWorld::getInstance()->getSettings()->setVariousProperties(nVariousProperties);
+      });
     }
   }
 
@@ -257,7 +249,7 @@ namespace CodeSubWars
 
   void CodeSubwarsMainWindow::website()
   {
-    ShellExecuteA(NULL, NULL, (LPCSTR)Constants::WEBSITE.toStdString().c_str(), NULL, NULL, SW_SHOWNORMAL);
+    ShellExecuteA(NULL, NULL, (LPCSTR)Constants::WEBSITE.c_str(), NULL, NULL, SW_SHOWNORMAL);
   }
 
 
@@ -272,7 +264,7 @@ namespace CodeSubWars
     QPixmap screenshot = QPixmap::grabWindow(this->winId());
     QString strPath = qApp->applicationDirPath() + "/Screenshots";
     QDir().mkdir(strPath);
-    screenshot.save(strPath + "/" + CSWUtilities::getUniqueFilename(strPath) + ".png", "PNG");
+    screenshot.save(strPath + "/" + CSWUtilities::getUniqueFilename(strPath.toStdString()).c_str() + ".png", "PNG");
   }
 
 
@@ -282,6 +274,21 @@ namespace CodeSubWars
   }
 
 
+  void CodeSubwarsMainWindow::newWorld(int nType)
+  {
+    m_pTimeSlider->setValue(4);
+    m_UpdateTimer.start(40);
+
+    CSWSimulationThread::getInstance()->invoke([nType]()
+    {
+      CSWWorld::getInstance()->newWorld(static_cast<CSWWorld::WorldType>(nType));
+    });
+  
+    m_pMainSceneView->setCamera("envMainCamera");
+    m_pDetailLowerInformationView->enforceCompleteRebuild(true);
+  }
+
+
   void CodeSubwarsMainWindow::setupMenu()
   {
     QMenu* pBattleMenu = menuBar()->addMenu(tr("&Battle"));
@@ -296,6 +303,8 @@ namespace CodeSubWars
       connect(pWorldMenu->addAction("Default &3 (Weapon supply)"), SIGNAL(triggered()), this, SLOT(newWorldDefault3()));
       connect(pWorldMenu->addAction("Default &4 (Black hole)"), SIGNAL(triggered()), this, SLOT(newWorldDefault4()));
       connect(pWorldMenu->addAction("Default &5 (Active Rocks)"), SIGNAL(triggered()), this, SLOT(newWorldDefault5()));
+      pWorldMenu->addSeparator();
+      connect(pWorldMenu->addAction("&Load..."), SIGNAL(triggered()), this, SLOT(newWorldLoad()));
 
     QMenu* pOptionsMenu = menuBar()->addMenu(tr("&Options"));
       connect(pOptionsMenu->addAction("&Preferences"), SIGNAL(triggered()), this, SLOT(preferences()));
@@ -347,7 +356,13 @@ namespace CodeSubWars
       pLogView->setWordWrapMode(QTextOption::NoWrap);
       pLogView->setReadOnly(true);
       pLogView->setFont(f);
-      CSWLog::getInstance()->setLogOutput(pLogView);
+      CSWWorld::getInstance()->getExplosionVisualizer()->setEnabled(true);
+      CSWWorld::getInstance()->getSoundVisualizer()->setEnabled(true);
+      //lines are also logged by the simulation thread, the widget must only be changed by the gui thread
+      CSWLog::getInstance()->setLogOutput([pLogView](const std::string& str) 
+      { 
+        QMetaObject::invokeMethod(pLogView, "append", Qt::QueuedConnection, Q_ARG(QString, QString(str.c_str())));
+      });
       pVerticalSplitter->addWidget(pLogView);
     
 
@@ -397,7 +412,6 @@ namespace CodeSubWars
     addAction(pMakeScreenshot);
 
     connect(&m_UpdateTimer, SIGNAL(timeout()), this, SIGNAL(redraw()));
-    connect(&m_RecalcWorldTimer, SIGNAL(timeout()), this, SLOT(recalcWorld()));
 
     connect(this, SIGNAL(redraw()), m_pMainSceneView, SLOT(update()));
     connect(this, SIGNAL(redraw()), m_pDetailUpperSceneView, SLOT(update()));
@@ -27,7 +27,6 @@ namespace CodeSubWars
     protected slots:
       virtual void closeEvent(QCloseEvent*);
       void setTimeRatio(int);
-      void recalcWorld();
       void updateTimeLabel();
 
       void newWorldDefault1();
@@ -52,6 +51,7 @@ namespace CodeSubWars
 
     protected:
       void checkRequirements();
+      void newWorld(int nType);
   
       void setupMenu();
       void setupGUI();
@@ -67,7 +67,6 @@ namespace CodeSubWars
       QSlider* m_pTimeSlider;
 
       QTimer m_UpdateTimer;
-      QTimer m_RecalcWorldTimer;
   };
 
 }
\ No newline at end of file
@@ -1,7 +1,7 @@
 // Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
 // Released under the MIT license. (see license.txt)
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "BuildDetails.h"
 #include "Constants.h"
 
@@ -10,9 +10,9 @@ namespace CodeSubWars
 
   const double Constants::CRITICAL_CONSUMING_TIME = 0.006;
 
-  const QString Constants::WEBSITE = "www.codesubwars.org";
-  const QString Constants::AUTHOR = "Andreas Rose";
-  const QString Constants::EMAIL = "andreas@rose.st";
+  const std::string Constants::WEBSITE = "www.codesubwars.org";
+  const std::string Constants::AUTHOR = "Andreas Rose";
+  const std::string Constants::EMAIL = "andreas@rose.st";
 
   const Version& Constants::getVersion()
   {
@@ -12,9 +12,9 @@ namespace CodeSubWars
     public:
       static const double CRITICAL_CONSUMING_TIME;
 
-      static const QString WEBSITE;
-      static const QString AUTHOR;
-      static const QString EMAIL;
+      static const std::string WEBSITE;
+      static const std::string AUTHOR;
+      static const std::string EMAIL;
 
       static const Version& getVersion();
   };
@@ -2,8 +2,9 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "GreenMine.h"
+#include "CSWObjectPool.h"
 
 
 namespace CodeSubWars
@@ -11,7 +12,7 @@ namespace CodeSubWars
 
   GreenMine::PtrType GreenMine::create(const std::string& strName, const Matrix44D& matBaseTObject, double fLength)
   {
-    return PtrType(new GreenMine(strName, matBaseTObject, fLength));
+    return CSWObjectPool::create<GreenMine>([&](void* pBlock) { return new (pBlock) GreenMine(strName, matBaseTObject, fLength); });
   }
 
 
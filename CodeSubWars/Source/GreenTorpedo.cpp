@@ -2,8 +2,9 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "GreenTorpedo.h"
+#include "CSWObjectPool.h"
 #include "CSWEngine.h"
 
 
@@ -12,7 +13,7 @@ namespace CodeSubWars
 
   GreenTorpedo::PtrType GreenTorpedo::create(const std::string& strName, const Matrix44D& matBaseTObject, double fLength)
   {
-    return PtrType(new GreenTorpedo(strName, matBaseTObject, fLength));
+    return CSWObjectPool::create<GreenTorpedo>([&](void* pBlock) { return new (pBlock) GreenTorpedo(strName, matBaseTObject, fLength); });
   }
 
 
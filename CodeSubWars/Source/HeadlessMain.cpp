@@ -0,0 +1,46 @@
+// Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+// Released under the MIT license. (see license.txt)
+
+
+//entry point of the headless runner (see CMakeLists.txt). it only knows the modes which need no gui: the benchmark and
+//the silent battles. the gui, the replay dialogs and the render mode are in main.cpp.
+
+#include "CorePrecompiledHeader.h"
+#include "CSWSilentApplication.h"
+#include "CSWBenchmarkApplication.h"
+#include "CSWLog.h"
+#include "CSWPythonModules.h"
+
+using namespace CodeSubWars;
+
+int main(int argc, char** argv)
+{
+  ARSTD::FileSystem::createDirectory("log");
+  int nResult = 0;
+  try
+  {
+    CSWPythonModules::registerModules();
+
+    if (argc > 1 && std::find(argv + 1, argv + argc, std::string("-benchmark")) != argv + argc)
+    {
+      CSWBenchmarkApplication app(argc, argv);
+      nResult = app.run();
+    }
+    else
+    {
+      CSWSilentApplication app(argc, argv);
+      app.run();
+    }
+  }
+  catch (std::exception& e)
+  {
+    CSWLog::getInstance()->log(std::string("exception caught: ") + e.what());
+    nResult = 2;
+  }
+  catch (...)
+  {
+    CSWLog::getInstance()->log("unknown exception caught");
+    nResult = 2;
+  }
+  return nResult;
+}
\ No newline at end of file
@@ -4,10 +4,21 @@
 
 #include "PrecompiledHeader.h"
 #include "CSWBRImporter.h"
+#include "CSWUtilities.h"
 
 namespace CodeSubWars
 {
 
+  namespace
+  {
+    bool timeSliceLess(const std::pair<double, CSWBRImporter::TimeSliceData>& lhs, 
+                       const std::pair<double, CSWBRImporter::TimeSliceData>& rhs)
+    {
+      return lhs.first < rhs.first;
+    }
+  }
+
+
   double CSWBRImporter::m_fProgress = 0;
 
   bool CSWBRImporter::loadREC(const QString& strFileName, TimeSliceDataContainer& dataContainer)
@@ -62,6 +73,70 @@ namespace CodeSubWars
   }
 
 
+  bool CSWBRImporter::interpolate(const TimeSliceDataContainer& dataContainer, double fTime, TimeSliceData& result)
+  {
+    TimeSliceDataContainer::const_iterator itFound = lower_bound(dataContainer.begin(), 
+                                                                 dataContainer.end(),
+                                                                 std::make_pair(fTime, TimeSliceData()),
+                                                                 timeSliceLess);
+    if (itFound == dataContainer.end()) return false;
+    if (itFound == dataContainer.begin())
+    {
+      result = itFound->second;
+      return true;
+    }
+  
+    TimeSliceDataContainer::const_iterator itFoundPrior = boost::prior(itFound);
+  
+    //linear interpolate
+    double fInterpolateFactor = (fTime - itFoundPrior->first)/(itFound->first - itFoundPrior->first);
+
+    const TimeSliceData& firstObjectData = itFoundPrior->second;
+    const TimeSliceData& secondObjectData = itFound->second;
+
+    std::set<std::string> objectNames;
+    TimeSliceData::const_iterator itFirstData = firstObjectData.begin();
+    for (; itFirstData != firstObjectData.end(); ++itFirstData)
+    {
+      objectNames.insert(itFirstData->first);
+    }
+
+    TimeSliceData::const_iterator itSecondData = secondObjectData.begin();
+    for (; itSecondData != secondObjectData.end(); ++itSecondData)
+    {
+      objectNames.insert(itSecondData->first);
+    }
+
+  
+    ObjectData objData;
+    result.clear();
+    std::set<std::string>::const_iterator itName = objectNames.begin();
+    for (; itName != objectNames.end(); ++itName)
+    {
+      TimeSliceData::const_iterator itFoundObject1 = firstObjectData.find(*itName);
+      TimeSliceData::const_iterator itFoundObject2 = secondObjectData.find(*itName);
+      if (itFoundObject1 != firstObjectData.end() &&
+          itFoundObject2 != secondObjectData.end())
+      {
+        objData = itFoundObject1->second;
+        objData.matWorldTObject = ARSTD::Matrix44D::slerp(itFoundObject1->second.matWorldTObject, 
+                                                          itFoundObject2->second.matWorldTObject, 
+                                                          fInterpolateFactor);
+        objData.color = CSWUtilities::interpolateComponentsLinear(itFoundObject1->second.color, 
+                                                                  itFoundObject2->second.color, 
+                                                                  fInterpolateFactor);
+      
+        result[*itName] = objData;
+      }
+      else if (itFoundObject1 != firstObjectData.end())
+      {
+        result[*itName] = itFoundObject1->second;
+      }
+    }
+    return true;
+  }
+
+
   bool CSWBRImporter::loadREC_v0_2_0__v0_4_6(boost::iostreams::filtering_istream& is, TimeSliceDataContainer& dataContainer)
   {
     if (!is.is_complete())
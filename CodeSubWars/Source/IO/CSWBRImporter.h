@@ -24,6 +24,13 @@ namespace CodeSubWars
       static bool loadREC(const QString& strFileName, TimeSliceDataContainer& dataContainer);
     
       static double getProgress();
+
+      /**
+       * Determines the state of all objects at the given time by interpolating the transforms and colors of the two
+       * surrounding time slices. Objects that do not exist in the later slice keep their state of the earlier one.
+       * @return Returns false if the time is behind the last time slice, the result is not changed then.
+       */
+      static bool interpolate(const TimeSliceDataContainer& dataContainer, double fTime, TimeSliceData& result);
     
     protected:
       ~CSWBRImporter() {}
@@ -7,10 +7,10 @@
 
 #include "CSWSettings.h"
 #include "CSWWorld.h"
+#include "CSWSimulationThread.h"
 #include "CSWObject.h"
-#include "CSWCamera.h"
 #include "InformationView.h"
-#include "PythonContext.h"
+#include "CSWInformationSnapshot.h"
 
 #include "CSWGyroCompass.h"
 
@@ -30,10 +30,18 @@
 #include "CSWISoundReceiver.h"
 
 #include "CSWEquipment.h"
-#include "CSWWeapon.h"
-#include "CSWWeaponSupply.h"
+#include "CSWActiveSonar.h"
+#include "CSWPassiveSonar.h"
+#include "CSWEngine.h"
+#include "CSWMap.h"
+#include "CSWWeaponBattery.h"
 
 #include "CSWIEquipmentVisualizer.h"
+#include "CSWActiveSonarVisualizer.h"
+#include "CSWPassiveSonarVisualizer.h"
+#include "CSWEngineVisualizer.h"
+#include "CSWMapVisualizer.h"
+#include "CSWWeaponBatteryVisualizer.h"
 
 
 namespace CodeSubWars
@@ -41,7 +49,8 @@ namespace CodeSubWars
 
   InformationView::InformationView(QWidget* parent)
   : QWidget(parent),
-    m_nOldChildNumber(0)
+    m_nObjectTreeVersion(-1),
+    m_nLastMessageSequence(-1)
   {
     QHBoxLayout* pLayout = new QHBoxLayout(this);
     pLayout->setSpacing(2);
@@ -83,7 +92,11 @@ namespace CodeSubWars
     if (!isVisible())
       return;
 
-    if (CSWWorld::getInstance()->hasChanged())
+    m_pInformation = CSWWorld::getInstance()->getInformation();
+    if (!m_pInformation)
+      return;
+
+    if (m_pInformation->nObjectTreeVersion != m_nObjectTreeVersion)
     {
       enforceCompleteRebuild(false);
     }
@@ -113,6 +126,7 @@ namespace CodeSubWars
       m_pObjectTree->scrollToItem(items.front());
     }
 
+    m_pInformation = CSWWorld::getInstance()->getInformation();
     ensureDetailContentIsAvailable(pObject);
     updateDetailContent();
   }
@@ -120,18 +134,16 @@ namespace CodeSubWars
 
   void InformationView::enforceCompleteRebuild(bool bIgnoreDifferentChildNumber)
   {
-    int nCurrentChildNumber = CSWWorld::getInstance()->getObjectTree()->getTotalChildNumber();
-    nCurrentChildNumber -= CSWWorld::getInstance()->getObjectTree()->getChildNumber<CSWCamera>();
-    if (!(CSWWorld::getInstance()->getSettings()->getVariousProperties() & CSWSettings::DISPLAY_WEAPONS_IN_OBJECT_TREE))
-    {
-      nCurrentChildNumber -= CSWWorld::getInstance()->getObjectTree()->getChildNumber<CSWWeapon>();
-    }
+    if (!m_pInformation)
+      m_pInformation = CSWWorld::getInstance()->getInformation();
+    if (!m_pInformation)
+      return;
 
-    if (bIgnoreDifferentChildNumber || m_nOldChildNumber != nCurrentChildNumber)
+    if (bIgnoreDifferentChildNumber || m_nObjectTreeVersion != m_pInformation->nObjectTreeVersion)
     {
+      int nCurrentChildNumber = buildTree(m_pObjectTree, *m_pInformation->pObjects);
       m_pObjectTree->setHeaderLabel("Objects (" + QString::number(nCurrentChildNumber) + ")");
-      buildTree(m_pObjectTree, CSWWorld::getInstance()->getObjectTree());
-      m_nOldChildNumber = nCurrentChildNumber;
+      m_nObjectTreeVersion = m_pInformation->nObjectTreeVersion;
     }
   }
 
@@ -142,14 +154,24 @@ namespace CodeSubWars
     if (selectedItems.empty())
       return;
 
-    QString strObjectName = selectedItems.front()->text(0);
-  
-    CSWObject::PtrType pObject = std::dynamic_pointer_cast<CSWObject>(CSWObject::findElement(CSWWorld::getInstance()->getObjectTree(), strObjectName.toStdString()));
+    if (!m_pInformation)
+      return;
+
+    std::string strObjectName = selectedItems.front()->text(0).toStdString();
+    CSWObject::PtrType pObject;
+    CSWInformationSnapshot::ObjectContainer::const_iterator itObject = m_pInformation->pObjects->begin();
+    for (; itObject != m_pInformation->pObjects->end() && !pObject; ++itObject)
+    {
+      if (itObject->strName == strObjectName)
+        pObject = itObject->pObject.lock();
+    }
     if (!pObject || pObject == CSWWorld::getInstance()->getSettings()->getSelectedObject())
       return;
 
-    CSWWorld::getInstance()->getSettings()->setSelectedObject(pObject);
+    //the parents of the object are determined by the simulation thread
+    CSWSimulationThread::getInstance()->invoke([pObject]() { CSWWorld::getInstance()->getSettings()->setSelectedObject(pObject); });
 
+    m_pInformation = CSWWorld::getInstance()->getInformation();
     ensureDetailContentIsAvailable(pObject);
     updateDetailContent();
 
@@ -160,95 +182,77 @@ namespace CodeSubWars
   void InformationView::updateDetailContent()
   {
     CSWObject::PtrType pObject = CSWWorld::getInstance()->getSettings()->getSelectedObject();
-    if (!pObject)
+    if (!pObject || !m_pInformation)
       return;
 
-    //PyThreadState* state = NULL;
-    PythonContext::PtrType pyContext = PythonContext::createEmpty();
-    if (CSWIPythonable::PtrType pPythonObject = std::dynamic_pointer_cast<CSWIPythonable>(pObject))
-    {
-      //state = pPythonObject->getThreadState();
-      //PyEval_AcquireThread(state);
-      pyContext = pPythonObject->getPythonContext();
-    }
-    auto lck = pyContext->makeCurrent();
+    //the snapshot of a newly selected object follows after the next simulation step
+    const CSWInformationSnapshot& info = *m_pInformation;
+    if (info.pSelectedObject.owner_before(pObject) || pObject.owner_before(info.pSelectedObject))
+      return;
 
-    m_CurrentField.pObjectNameLabel->setText(QString("Name: ") + pObject->getName().c_str());
+    m_CurrentField.pObjectNameLabel->setText(QString("Name: ") + info.strName.c_str());
     m_CurrentField.pObjectPositionLabel->setText(QString("Position [m]: ") + 
-                                                 QString::number(pObject->getWorldTransform().getTranslation().x, 'f', 2) + ", " +
-                                                 QString::number(pObject->getWorldTransform().getTranslation().y, 'f', 2) + ", " +
-                                                 QString::number(pObject->getWorldTransform().getTranslation().z, 'f', 2));
+                                                 QString::number(info.matWorldTransform.getTranslation().x, 'f', 2) + ", " +
+                                                 QString::number(info.matWorldTransform.getTranslation().y, 'f', 2) + ", " +
+                                                 QString::number(info.matWorldTransform.getTranslation().z, 'f', 2));
 
-    Vector3D angles = CSWUtilities::determineAngles(pObject->getWorldTransform());
+    Vector3D angles = CSWUtilities::determineAngles(info.matWorldTransform);
     m_CurrentField.pObjectOrientationLabel->setText(QString("Inclination (x) [degree]: ") + QString::number(angles.x, 'f', 2) + "\n" +
                                                     QString("Direction (y) [degree]: ") + QString::number(angles.y, 'f', 2) + "\n" +
                                                     QString("AxialInclination (z) [degree]: ") + QString::number(angles.z, 'f', 2));
   
-    if (CSWICollideable::PtrType pObj = std::dynamic_pointer_cast<CSWICollideable>(pObject))
-    {
-    }    
-    if (CSWICommandable::PtrType pObj = std::dynamic_pointer_cast<CSWICommandable>(pObject))
+    if (info.nProperties & CSWInformationSnapshot::COMMANDABLE)
     {
       if (m_CurrentField.pCurrentCommandLabel->parentWidget()->isVisible())
       {
-        if (pObj->getCommandProcessor()->getCurrentCommandProgress() >= 0)
+        if (info.fCurrentCommandProgress >= 0)
         {
-          m_CurrentField.pCurrentCommandLabel->setText(QString("Stackdepth: ") + QString::number(pObj->getCommandProcessor()->getCurrentStackDepth()) +
-                                                      QString("\nHistory (executed): ") + QString::number(pObj->getCommandProcessor()->getNumExecutedCommands()) +
+          m_CurrentField.pCurrentCommandLabel->setText(QString("Stackdepth: ") + QString::number(info.nStackDepth) +
+                                                      QString("\nHistory (executed): ") + QString::number(info.nNumExecutedCommands) +
                                                       QString("\nCurrent (") + 
-                                                      QString::number(pObj->getCommandProcessor()->getCurrentCommandProgress()*100, 'f', 1) + "%)");
+                                                      QString::number(info.fCurrentCommandProgress*100, 'f', 1) + "%)");
           auto verticalValue = m_CurrentField.pCurrentCommandTextEdit->verticalScrollBar()->value();
           auto horizontalValue = m_CurrentField.pCurrentCommandTextEdit->horizontalScrollBar()->value();
-          m_CurrentField.pCurrentCommandTextEdit->setText(QString(pObj->getCommandProcessor()->getCurrentCommandName().c_str()) + 
+          m_CurrentField.pCurrentCommandTextEdit->setText(QString(info.strCurrentCommandName.c_str()) + 
                                                           "\nDetailed Description: \n" +
-                                                          pObj->getCommandProcessor()->getCurrentCommandDetails().c_str());
+                                                          info.strCurrentCommandDetails.c_str());
           m_CurrentField.pCurrentCommandTextEdit->verticalScrollBar()->setValue(verticalValue);
           m_CurrentField.pCurrentCommandTextEdit->horizontalScrollBar()->setValue(horizontalValue);
         }
         else
         {
-          m_CurrentField.pCurrentCommandLabel->setText(QString("Stackdepth: ") + QString::number(pObj->getCommandProcessor()->getCurrentStackDepth()) +
-                                                      QString("\nHistory (executed): ") + QString::number(pObj->getCommandProcessor()->getNumExecutedCommands()) +
+          m_CurrentField.pCurrentCommandLabel->setText(QString("Stackdepth: ") + QString::number(info.nStackDepth) +
+                                                      QString("\nHistory (executed): ") + QString::number(info.nNumExecutedCommands) +
                                                       "\nCurrent (n.a.)");
           m_CurrentField.pCurrentCommandTextEdit->setText("");
         }
 
-        m_CurrentField.pNumWaitingCommandsLabel->setText(QString("Waiting (") + QString::number(pObj->getCommandProcessor()->getNumWaitingCommands()) + "): ");
+        m_CurrentField.pNumWaitingCommandsLabel->setText(QString("Waiting (") + QString::number(info.waitingCommandNames.size()) + "): ");
       
         std::stringstream ss;
-        int nCnt = 1;
-        ARSTD::CommandProcessor::CommandConstRange range = pObj->getCommandProcessor()->getWaitingCommands();
-        for (ARSTD::CommandProcessor::CommandConstIterator itCommand = range.first; itCommand != range.second; ++itCommand, ++nCnt)
+        for (size_t i = 0; i < info.waitingCommandNames.size(); ++i)
         {
-          ss << nCnt << "." << (*itCommand)->getName() << "\n";
+          ss << i + 1 << "." << info.waitingCommandNames[i] << "\n";
         }
         m_CurrentField.pWaitingCommandsTextEdit->setText(QString(ss.str().c_str()));
       }
     }    
-    if (CSWIDamageable::PtrType pObj = std::dynamic_pointer_cast<CSWIDamageable>(pObject))
+    if (info.nProperties & CSWInformationSnapshot::DAMAGEABLE)
     {
       if (m_CurrentField.pCurrentHealthStateLabel->parentWidget()->isVisible())
       {
-        m_CurrentField.pCurrentHealthValueLabel->setText(QString("Health [%]: ") + QString::number(pObj->getHealth()*100, 'f', 1)); 
-        QString strState = "Unknown";
-        if (pObj->isAlive())
-          strState = "Alive";
-    //    else if (pObj->isDisabled()) strState = "Disabled";
-        else if (pObj->isZombie())
-          strState = "Zombie";
-        else if (pObj->isDead())
-          strState = "Dead";
-        m_CurrentField.pCurrentHealthStateLabel->setText(QString("Health state: ") + strState); 
+        m_CurrentField.pCurrentHealthValueLabel->setText(QString("Health [%]: ") + QString::number(info.fHealth*100, 'f', 1)); 
+        m_CurrentField.pCurrentHealthStateLabel->setText(QString("Health state: ") + info.strHealthState.c_str()); 
       }
     }    
-    if (CSWIDynamic::PtrType pObj = std::dynamic_pointer_cast<CSWIDynamic>(pObject))
+    if (info.nProperties & CSWInformationSnapshot::DYNAMIC)
     {
       if (m_CurrentField.pMassLabel->parentWidget()->isVisible())
       {
-        m_CurrentField.pMassLabel->setText(QString("Total Mass [kt]: ") + QString::number(pObj->getTotalMass()/1e+6, 'g', 3));
+        m_CurrentField.pMassLabel->setText(QString("Total Mass [kt]: ") + QString::number(info.fTotalMass/1e+6, 'g', 3));
 
-        Matrix33D matObjectTWorld = pObject->getInvertWorldTransform().getRotationAsMatrix33();
-        Vector3D vecWorldTVelocity = pObj->getVelocity();
+        Matrix33D matObjectTWorld = Matrix44D::inverse(info.matWorldTransform).getRotationAsMatrix33();
+        const Vector3D& vecWorldTVelocity = info.vecVelocity;
         Vector3D vecObjectTVelocity = matObjectTWorld*vecWorldTVelocity;
         m_CurrentField.pLocalVelocityLabel->setText(QString("Velocity (local) [m/s]: ") + 
                                                     QString::number(vecObjectTVelocity.x, 'f', 2) + ", " +
@@ -262,7 +266,7 @@ namespace CodeSubWars
                                                     QString::number(vecWorldTVelocity.z, 'f', 2) + "   (" +
                                                     QString::number(vecWorldTVelocity.getLength(), 'f', 2) + ")");
 
-        Vector3D vecWorldTAcceleration = pObj->getAcceleration();
+        const Vector3D& vecWorldTAcceleration = info.vecAcceleration;
         Vector3D vecObjectTAcceleration = matObjectTWorld*vecWorldTAcceleration;
         m_CurrentField.pLocalAccelerationLabel->setText(QString("Acceleration (local) [m/s^2]: ") + 
                                                         QString::number(vecObjectTAcceleration.x, 'f', 2) + ", " +
@@ -276,7 +280,7 @@ namespace CodeSubWars
                                                         QString::number(vecWorldTAcceleration.z, 'f', 2) + "   (" +
                                                         QString::number(vecWorldTAcceleration.getLength(), 'f', 2) + ")");
 
-        Vector3D vecWorldTAngularVelocity = pObj->getAngularVelocity();
+        const Vector3D& vecWorldTAngularVelocity = info.vecAngularVelocity;
         Vector3D vecObjectTAngularVelocity = matObjectTWorld*vecWorldTAngularVelocity;
         m_CurrentField.pLocalAngularVelocityLabel->setText(QString("AngularVelocity (local) [degree/s]: ") + 
                                                           QString::number(180/ARSTD::PI*vecObjectTAngularVelocity.x, 'f', 2) + ", " +
@@ -290,7 +294,7 @@ namespace CodeSubWars
                                                           QString::number(180/ARSTD::PI*vecWorldTAngularVelocity.z, 'f', 2) + "   (" +
                                                           QString::number(180/ARSTD::PI*vecWorldTAngularVelocity.getLength(), 'f', 2) +")");
 
-        Vector3D vecWorldTAngularAcceleration = pObj->getAngularAcceleration();
+        const Vector3D& vecWorldTAngularAcceleration = info.vecAngularAcceleration;
         Vector3D vecObjectTAngularAcceleration = matObjectTWorld*vecWorldTAngularAcceleration;
         m_CurrentField.pLocalAngularAccelerationLabel->setText(QString("AngularAcceleration (local) [degree/s^2]: ") + 
                                                               QString::number(180/ARSTD::PI*vecObjectTAngularAcceleration.x, 'f', 2) + ", " +
@@ -305,81 +309,70 @@ namespace CodeSubWars
                                                               QString::number(180/ARSTD::PI*vecWorldTAngularAcceleration.getLength(), 'f', 2) +")");
       }
     }    
-    if (CSWIEventDealable::PtrType pObj = std::dynamic_pointer_cast<CSWIEventDealable>(pObject))
+    if (info.nProperties & CSWInformationSnapshot::EVENTDEALABLE)
     {
       if (m_CurrentField.pInformationEventLabel->parentWidget()->isVisible())
       {
-        m_CurrentField.pInformationEventLabel->setText(pObj->getCurrentInformation().c_str());
-        m_CurrentField.pMessageEventTextEdit->insertPlainText(pObj->getCurrentMessage().c_str());
+        m_CurrentField.pInformationEventLabel->setText(info.strEventInformation.c_str());
+        CSWInformationSnapshot::MessageContainer::const_iterator itMessage = info.eventMessages.begin();
+        for (; itMessage != info.eventMessages.end(); ++itMessage)
+        {
+          if (itMessage->first > m_nLastMessageSequence)
+            m_CurrentField.pMessageEventTextEdit->insertPlainText(itMessage->second.c_str());
+        }
       }
     }    
-    if (CSWEquipment::PtrType pObj = std::dynamic_pointer_cast<CSWEquipment>(pObject))
+    if (!info.eventMessages.empty())
+      m_nLastMessageSequence = std::max(m_nLastMessageSequence, info.eventMessages.back().first);
+    if (info.nProperties & CSWInformationSnapshot::EQUIPMENT)
     {
       if (m_CurrentField.pEquipmentInformationWidget->parentWidget()->isVisible()) 
       {
         if (CSWIEquipmentVisualizer* pV = dynamic_cast<CSWIEquipmentVisualizer*>(m_CurrentField.pEquipmentInformationWidget))
         {
-          pV->updateContent();
+          pV->updateContent(m_pInformation);
         }
-  //      m_CurrentField.pEquipmentInformationWidget->repaint();
       }
     }    
-    if (CSWIForceEmitter::PtrType pObj = std::dynamic_pointer_cast<CSWIForceEmitter>(pObject))
-    {
-    }    
-    if (CSWIImpulsEmitter::PtrType pObj = std::dynamic_pointer_cast<CSWIImpulsEmitter>(pObject))
-    {
-    }    
-    if (CSWIPythonable::PtrType pObj = std::dynamic_pointer_cast<CSWIPythonable>(pObject))
-    {
-    }  
-    if (CSWIResourceProvider::PtrType pObj = std::dynamic_pointer_cast<CSWIResourceProvider>(pObject))
+    if (info.nProperties & CSWInformationSnapshot::RESOURCE_PROVIDER)
     {
       if (m_CurrentField.pConnectedObjectsLabel->parentWidget()->isVisible())
       {
-        m_CurrentField.pConnectedObjectsLabel->setText(pObj->getCurrentInfo().c_str());
+        m_CurrentField.pConnectedObjectsLabel->setText(info.strResourceInformation.c_str());
       }
     }    
-    if (CSWIRechargeable::PtrType pObj = std::dynamic_pointer_cast<CSWIRechargeable>(pObject))
+    if (info.nProperties & CSWInformationSnapshot::RECHARGEABLE)
     {
       if (m_CurrentField.pRechargeInformationLabel->parentWidget()->isVisible())
       {
-        m_CurrentField.pRechargeInformationLabel->setText(QString("Accepted resources: ") + CSWWeaponSupply::translate(pObj->getAcceptedResourceIDs()).c_str() + "\n" +
-                                                          QString("Currently recharging resources: ") + CSWWeaponSupply::translate(pObj->getRechargingIDs()).c_str() + "\n" +
-                                                          QString("Fill level [%]: ") + QString::number(pObj->getFillLevel()*100, 'f', 1));
+        m_CurrentField.pRechargeInformationLabel->setText(QString("Accepted resources: ") + info.strAcceptedResources.c_str() + "\n" +
+                                                          QString("Currently recharging resources: ") + info.strRechargingResources.c_str() + "\n" +
+                                                          QString("Fill level [%]: ") + QString::number(info.fFillLevel*100, 'f', 1));
       }
     }    
-    if (CSWISolid::PtrType pObj = std::dynamic_pointer_cast<CSWISolid>(pObject))
+    if (info.nProperties & CSWInformationSnapshot::SOLID)
     {
       if (m_CurrentField.pSizeLabel->parentWidget()->isVisible())
       {
         m_CurrentField.pSizeLabel->setText("Size (HxWxD) [m]: " + 
-                                          QString::number(pObj->getSurfaceBoundingBox().getWidth(), 'f', 2) + ", " +
-                                          QString::number(pObj->getSurfaceBoundingBox().getHeight(), 'f', 2) + ", " +
-                                          QString::number(pObj->getSurfaceBoundingBox().getDepth(), 'f', 2));
+                                          QString::number(info.size.getWidth(), 'f', 2) + ", " +
+                                          QString::number(info.size.getHeight(), 'f', 2) + ", " +
+                                          QString::number(info.size.getDepth(), 'f', 2));
       }
     }    
-    if (CSWISoundEmitter::PtrType pObj = std::dynamic_pointer_cast<CSWISoundEmitter>(pObject))
-    {
-    }    
-    if (CSWISoundReceiver::PtrType pObj = std::dynamic_pointer_cast<CSWISoundReceiver>(pObject))
+    if (info.nProperties & CSWInformationSnapshot::SOUND_RECEIVER)
     {
       if (m_CurrentField.pSoundsLabel->parentWidget()->isVisible())
       {
         std::stringstream ss;
         ss.precision(2);
         ss.setf(std::ios::fixed);
-        ss << "Angle [degree]: " << pObj->getAngleOfBeam()
-          << "\nDirection: " << pObj->getDirection()
-          << "\nLevel [dB]: " << pObj->getLevel();
+        ss << "Angle [degree]: " << info.fAngleOfBeam
+          << "\nDirection: " << info.vecSoundDirection
+          << "\nLevel [dB]: " << info.fSoundLevel;
         m_CurrentField.pSoundsLabel->setText(ss.str().c_str());
       }  
     }    
-    if (CSWIUpdateable::PtrType pObj = std::dynamic_pointer_cast<CSWIUpdateable>(pObject))
-    {
-    }      
-
-    //if (state) PyEval_ReleaseThread(state);    
   }
 
 
@@ -537,7 +530,7 @@ namespace CodeSubWars
     {
       QList<QWidget*> widgets;
 
-      infoField.pEquipmentInformationWidget = pObj->getInformationWidget(NULL);
+      infoField.pEquipmentInformationWidget = createEquipmentVisualizer(pObj);
       if (!infoField.pEquipmentInformationWidget)
         infoField.pEquipmentInformationWidget = new QLabel("n.a.");
       widgets.push_back(infoField.pEquipmentInformationWidget);
@@ -654,7 +647,25 @@ namespace CodeSubWars
   }
 
 
-  void InformationView::buildTree(QTreeWidget* pParent, CSWObject::PtrType pRootObject)
+  QWidget* InformationView::createEquipmentVisualizer(CSWObject::PtrType pObject)
+  {
+    //the equipment itself knows nothing about widgets. the visualizers are created here and live as long as 
+    //the detail content of the object. they only show the information snapshot, the object just selects the kind.
+    if (std::dynamic_pointer_cast<CSWActiveSonar>(pObject))
+      return new CSWActiveSonarVisualizer(NULL);
+    if (std::dynamic_pointer_cast<CSWPassiveSonar>(pObject))
+      return new CSWPassiveSonarVisualizer(NULL);
+    if (std::dynamic_pointer_cast<CSWEngine>(pObject))
+      return new CSWEngineVisualizer(NULL);
+    if (std::dynamic_pointer_cast<CSWMap>(pObject))
+      return new CSWMapVisualizer(NULL);
+    if (std::dynamic_pointer_cast<CSWWeaponBattery>(pObject))
+      return new CSWWeaponBatteryVisualizer(NULL);
+    return NULL;
+  }
+
+
+  int InformationView::buildTree(QTreeWidget* pParent, const CSWInformationSnapshot::ObjectContainer& objects)
   {
     std::map<QString, std::pair<bool, bool> > properties; //opened, selected
   
@@ -674,80 +685,42 @@ namespace CodeSubWars
 
     pParent->clear();
 
-    CSWObject::ChildRange range = pRootObject->getChildRange();
-    for (CSWObject::ChildIterator it = range.first; it != range.second; ++it)
+    //objects are given in preorder, so the item of the parent is always created before its children
+    bool bDisplayWeapons = (CSWWorld::getInstance()->getSettings()->getVariousProperties() & CSWSettings::DISPLAY_WEAPONS_IN_OBJECT_TREE) != 0;
+    std::vector<QTreeWidgetItem*> items(objects.size(), NULL);
+    int nNumItems = 0;
+    for (size_t i = 0; i < objects.size(); ++i)
     {
-      CSWObject::PtrType pChild = std::dynamic_pointer_cast<CSWObject>(*it);
-      if (pChild)
-        buildChilds(pParent, pChild, properties);
-    }  
+      const CSWInformationSnapshot::ObjectEntry& entry = objects[i];
+      if (!bDisplayWeapons && entry.bWeapon)
+        continue;
+      if (entry.nParent >= 0 && !items[entry.nParent])
+        continue;
 
-    pParent->sortItems(0, Qt::AscendingOrder);
+      QTreeWidgetItem* pItem = entry.nParent >= 0 ? new QTreeWidgetItem(items[entry.nParent]) : new QTreeWidgetItem(pParent);
+      pItem->setText(0, entry.strName.c_str());
   
-    QList<QTreeWidgetItem*> items = pParent->findItems(strSelectedItem, Qt::MatchExactly, 0);  
-    if (!items.empty()) 
-    {
-      items.front()->setSelected(true);
-      pParent->scrollToItem(items.front());
+      std::map<QString, std::pair<bool, bool> >::const_iterator itFound = properties.find(entry.strName.c_str());
+      if (itFound != properties.end()) 
+      {
+        pItem->setExpanded(itFound->second.first);
+      }
+      items[i] = pItem;
+      ++nNumItems;
     }
 
-    pParent->setUpdatesEnabled(true);
-  }
-
-
-  void InformationView::buildChilds(QTreeWidget* pParent, CSWObject::PtrType pObject, const std::map<QString, std::pair<bool, bool> >& properties)
-  {
-    if (std::dynamic_pointer_cast<CSWCamera>(pObject))
-      return;
-    if (!(CSWWorld::getInstance()->getSettings()->getVariousProperties() & CSWSettings::DISPLAY_WEAPONS_IN_OBJECT_TREE) &&
-        std::dynamic_pointer_cast<CSWWeapon>(pObject))
-      return;
-  
-    QTreeWidgetItem* pItem = new QTreeWidgetItem(pParent);
-    pItem->setText(0, pObject->getName().c_str());
+    pParent->sortItems(0, Qt::AscendingOrder);
   
-    std::map<QString, std::pair<bool, bool> >::const_iterator itFound = properties.find(pObject->getName().c_str());
-    if (itFound != properties.end()) 
+    QList<QTreeWidgetItem*> foundItems = pParent->findItems(strSelectedItem, Qt::MatchExactly, 0);  
+    if (!foundItems.empty()) 
     {
-      pItem->setExpanded(itFound->second.first);
-  //    pItem->setSelected(itFound->second.second);
+      foundItems.front()->setSelected(true);
+      pParent->scrollToItem(foundItems.front());
     }
-  
-    CSWObject::ChildRange range = pObject->getChildRange();
-    for (CSWObject::ChildIterator it = range.first; it != range.second; ++it)
-    {
-      CSWObject::PtrType pChild = std::dynamic_pointer_cast<CSWObject>(*it);
-      if (pChild)
-        buildChilds(pItem, pChild, properties);
-    }  
-  }
 
+    pParent->setUpdatesEnabled(true);
 
-  void InformationView::buildChilds(QTreeWidgetItem* pParent, CSWObject::PtrType pObject, const std::map<QString, std::pair<bool, bool> >& properties)
-  {
-    if (std::dynamic_pointer_cast<CSWCamera>(pObject))
-      return;
-    if (!(CSWWorld::getInstance()->getSettings()->getVariousProperties() & CSWSettings::DISPLAY_WEAPONS_IN_OBJECT_TREE) &&
-        std::dynamic_pointer_cast<CSWWeapon>(pObject))
-      return;
-  
-    QTreeWidgetItem* pItem = new QTreeWidgetItem(pParent);
-    pItem->setText(0, pObject->getName().c_str());
-  
-    std::map<QString, std::pair<bool, bool> >::const_iterator itFound = properties.find(pObject->getName().c_str());
-    if (itFound != properties.end()) 
-    {
-      pItem->setExpanded(itFound->second.first);
-  //    pItem->setSelected(itFound->second.second);
-    }
-  
-    CSWObject::ChildRange range = pObject->getChildRange();
-    for (CSWObject::ChildIterator it = range.first; it != range.second; ++it)
-    {
-      CSWObject::PtrType pChild = std::dynamic_pointer_cast<CSWObject>(*it);
-      if (pChild)
-        buildChilds(pItem, pChild, properties);
-    }  
+    return nNumItems;
   }
 
 }
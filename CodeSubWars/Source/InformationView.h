@@ -6,6 +6,7 @@
 //#include "WorldTreeModel.h"
 
 #include "CSWObject.h"
+#include "CSWInformationSnapshot.h"
 
 namespace CodeSubWars
 {
@@ -90,19 +91,22 @@ namespace CodeSubWars
       void ensureDetailContentIsAvailable(std::shared_ptr<CSWObject> pObject);
       void setupDetailContent(std::shared_ptr<CSWObject> pObject, InformationField& infoField, QWidget* pParent);
       QWidget* createTab(QList<QWidget*>& widgets, bool bScrollable);
+      QWidget* createEquipmentVisualizer(std::shared_ptr<CSWObject> pObject);
       void updateDetailContent();
 
-      void buildTree(QTreeWidget* pParent, std::shared_ptr<CSWObject> pRootObject);
-      void buildChilds(QTreeWidget* pParent, std::shared_ptr<CSWObject> pObject, const std::map<QString, std::pair<bool, bool> >& properties);
-      void buildChilds(QTreeWidgetItem* pItem, std::shared_ptr<CSWObject> pObject, const std::map<QString, std::pair<bool, bool> >& properties);
+      int buildTree(QTreeWidget* pParent, const CSWInformationSnapshot::ObjectContainer& objects);
 
       QTreeWidget* m_pObjectTree;
       QStackedWidget* m_pDetailStackedWidget;
 
       std::map<std::weak_ptr<CSWObject>, InformationField, ObjectLess> m_ObjectToDetailWidgetMap; 
 
-      int m_nOldChildNumber;
       InformationField m_CurrentField;
+
+      //last snapshot taken from the world, the gui never reads the simulated objects directly
+      std::shared_ptr<const CSWInformationSnapshot> m_pInformation;
+      long long m_nObjectTreeVersion;
+      long long m_nLastMessageSequence;
   };
 
 }
\ No newline at end of file
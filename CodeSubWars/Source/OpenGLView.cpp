@@ -12,8 +12,23 @@
 namespace CodeSubWars
 {
 
+  namespace
+  {
+    //views without an explicit share widget share their objects (buffers of meshes, shaders) with a hidden widget that
+    //lives as long as the application, so uploaded meshes are valid in all views
+    const QGLWidget* getShareWidget(const QGLWidget* pShareWidget)
+    {
+      if (pShareWidget)
+        return pShareWidget;
+
+      static QGLWidget* pCommonShareWidget = new QGLWidget();
+      return pCommonShareWidget;
+    }
+  }
+
+
   OpenGLView::OpenGLView(QWidget* parent, const QGLWidget* pShareWidget, Qt::WindowFlags f)
-  : QGLWidget(parent, pShareWidget, f),
+  : QGLWidget(parent, getShareWidget(pShareWidget), f),
     m_bLeftPressed(false),
     m_bMidPressed(false),
     m_bRightPressed(false),
@@ -190,8 +205,7 @@ namespace CodeSubWars
 
   void OpenGLView::wheelEvent(QWheelEvent* pEvent)
   {
-    CSWCamera::PtrType pCam = m_pCamera.lock();
-    if (!pCam)
+    if (m_pCamera.expired())
     {
       pEvent->ignore();
       QGLWidget::wheelEvent(pEvent);
@@ -199,7 +213,11 @@ namespace CodeSubWars
     }
 
     pEvent->accept();
-    pCam->getTransform().getTranslation() += pCam->getTransform().getZAxis()*static_cast<double>(pEvent->delta())*getWheelStepSize();
+    double fDistance = static_cast<double>(pEvent->delta())*getWheelStepSize();
+    transformCamera([fDistance](CSWCamera::PtrType pCam)
+    {
+      pCam->getTransform().getTranslation() += pCam->getTransform().getZAxis()*fDistance;
+    });
 
     QGLWidget::wheelEvent(pEvent);
   }
@@ -207,49 +225,70 @@ namespace CodeSubWars
 
   void OpenGLView::timerEvent(QTimerEvent* pTimerEvent)
   {   
-    CSWCamera::PtrType pCam = m_pCamera.lock();
-    if (!pCam || (m_fDeltaX == 0 && m_fDeltaY == 0))
+    if (m_pCamera.expired() || (m_fDeltaX == 0 && m_fDeltaY == 0))
       return;
 
+    double fDeltaX = m_fDeltaX;
+    double fDeltaY = m_fDeltaY;
+    bool bLeftPressed = m_bLeftPressed;
+    bool bMidPressed = m_bMidPressed;
+    bool bRightPressed = m_bRightPressed;
+    transformCamera([=](CSWCamera::PtrType pCam)
+    {
+      moveCamera(pCam, fDeltaX, fDeltaY, bLeftPressed, bMidPressed, bRightPressed);
+    });
+  }
+
+
+  void OpenGLView::transformCamera(const CameraTransformation& transformation)
+  {
+    if (CSWCamera::PtrType pCam = m_pCamera.lock())
+      transformation(pCam);
+  }
+
+
+  void OpenGLView::moveCamera(CSWCamera::PtrType pCam, double fDeltaX, double fDeltaY,
+                              bool bLeftPressed, bool bMidPressed, bool bRightPressed)
+  {
     Matrix44D mat(true);
     Matrix44D matPatientTCam = pCam->getTransform();
   
     // translation in view direction
-    if (m_bMidPressed)
+    if (bMidPressed)
     {
-  //    pCam->moveAlongViewDir(m_fDeltaX);
-      matPatientTCam.getTranslation() -= matPatientTCam.getZAxis()*m_fDeltaY;
+  //    pCam->moveAlongViewDir(fDeltaX);
+      matPatientTCam.getTranslation() -= matPatientTCam.getZAxis()*fDeltaY;
     }  
-    else if (m_bRightPressed) // rotation
+    else if (bRightPressed) // rotation
     {
       Vector3D vecRotationCenter = pCam->getRotationCenter();
       matPatientTCam.getTranslation() -= vecRotationCenter;
 
       Vector3D vecRotationAxis(matPatientTCam.getYAxis());
       vecRotationAxis.normalize();
-      mat.setRotation(vecRotationAxis, -m_fDeltaX*PI/180);
+      mat.setRotation(vecRotationAxis, -fDeltaX*PI/180);
       matPatientTCam = mat*matPatientTCam;
     
       vecRotationAxis = matPatientTCam.getXAxis();
       vecRotationAxis.normalize();
-      mat.setRotation(vecRotationAxis, m_fDeltaY*PI/180);    
+      mat.setRotation(vecRotationAxis, fDeltaY*PI/180);    
       matPatientTCam = mat*matPatientTCam;
     
       matPatientTCam.getTranslation() += vecRotationCenter;
     }    
-    else if (m_bLeftPressed)
+    else if (bLeftPressed)
     {
-  //    pCam->moveAlongUpDir(m_fDeltaX);
-  //    pCam->moveAlongRightDir(m_fDeltaY);
+  //    pCam->moveAlongUpDir(fDeltaX);
+  //    pCam->moveAlongRightDir(fDeltaY);
       // x axis translation
       Vector3D xAxis = matPatientTCam.getXAxis();
-      xAxis *= m_fDeltaX;
+      xAxis *= fDeltaX;
       // add xAxis to translation 
       mat.getTranslation() += xAxis;
     
       // y axis translation
       Vector3D yAxis = matPatientTCam.getYAxis();
-      yAxis *= m_fDeltaY;
+      yAxis *= fDeltaY;
 		  //set translation 
       mat.getTranslation() += yAxis;
     
@@ -261,14 +300,20 @@ namespace CodeSubWars
 
 
   void OpenGLView::setupCameraAndLight(CSWCamera::PtrType pCamera)
+  {
+    setupCameraAndLight(pCamera->getWorldTransform(), pCamera->getFieldOfView());
+  }
+
+
+  void OpenGLView::setupCameraAndLight(const Matrix44D& matWorldTCamera, double fFieldOfView)
   {
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
-    gluPerspective(pCamera->getFieldOfView(), static_cast<GLdouble>(width())/static_cast<GLdouble>(height()), 1, 20000);
+    gluPerspective(fFieldOfView, static_cast<GLdouble>(width())/static_cast<GLdouble>(height()), 1, 20000);
 
-    Vector3D vecPos(pCamera->getEyePosition());
-    Vector3D vecDir(pCamera->getDirection());       
-    Vector3D vecUp(pCamera->getUpDirection());
+    Vector3D vecPos(matWorldTCamera.getTranslation());
+    Vector3D vecDir(matWorldTCamera.getZAxis());       
+    Vector3D vecUp(matWorldTCamera.getYAxis());
   
     gluLookAt(vecPos.x, vecPos.y, vecPos.z, 
               vecPos.x + vecDir.x, vecPos.y + vecDir.y, vecPos.z + vecDir.z, 
@@ -291,6 +336,12 @@ namespace CodeSubWars
     if (!pCam)
       return;
 
+    drawWorldTripod(pCam->calcRootTObject());
+  }
+
+
+  void OpenGLView::drawWorldTripod(const Matrix44D& matWorldTCamera) const
+  {
     glMatrixMode(GL_PROJECTION);
     glPushMatrix();
       glLoadIdentity();
@@ -301,8 +352,7 @@ namespace CodeSubWars
       glPushMatrix();
         glLoadIdentity();
 
-        pCam->setWorldTransform(pCam->calcRootTObject());
-        Matrix44D matCameraTWorld(pCam->getInvertWorldTransform());
+        Matrix44D matCameraTWorld(Matrix44D::inverse(matWorldTCamera));
         matCameraTWorld.getTranslation() = Vector3D(0.1*fHToW, 0.9*fHToW, 0);
 
         //not the best way :( ... but it works
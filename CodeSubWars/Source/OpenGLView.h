@@ -44,8 +44,21 @@ namespace CodeSubWars
 
       virtual void timerEvent(QTimerEvent*);
 
+      typedef std::function<void(std::shared_ptr<CSWCamera>)> CameraTransformation;
+
+      /**
+       * Applies a transformation triggered by the mouse to the current camera. The default applies it immediately,
+       * views of the running simulation have to hand it over to the simulation thread.
+       */
+      virtual void transformCamera(const CameraTransformation& transformation);
+
+      static void moveCamera(std::shared_ptr<CSWCamera> pCam, double fDeltaX, double fDeltaY,
+                             bool bLeftPressed, bool bMidPressed, bool bRightPressed);
+
       void setupCameraAndLight(std::shared_ptr<CSWCamera> pCamera);
+      void setupCameraAndLight(const Matrix44D& matWorldTCamera, double fFieldOfView);
       void drawWorldTripod() const;
+      void drawWorldTripod(const Matrix44D& matWorldTCamera) const;
       void draw2D();
 
       std::pair<bool, Vector3D> getWorldPos(double fX, double fY, double fZ);
@@ -113,6 +113,8 @@ namespace CodeSubWars
                                               CSWSettings::DISPLAY_WEAPONS_IN_OBJECT_TREE, "display weapon objects in object list"));
         pVBoxLayout->addWidget(createCheckBox(m_pVariousButtonGroup, m_VariousMap, m_nVariousProperties, 
                                               CSWSettings::AUTOMATIC_BATTLE_STOP, "automatically stop battle if one submarine/team leftover"));
+        pVBoxLayout->addWidget(createCheckBox(m_pVariousButtonGroup, m_VariousMap, m_nVariousProperties, 
+                                              CSWSettings::PROFILE_SUBMARINES, "profile python code of submarines (written to log at battle end)"));
 
         pContent->setLayout(pVBoxLayout);
         pSV->setWidget(pContent);
@@ -2,8 +2,9 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "RedTorpedo.h"
+#include "CSWObjectPool.h"
 #include "CSWEngine.h"
 
 
@@ -12,7 +13,7 @@ namespace CodeSubWars
 
   RedTorpedo::PtrType RedTorpedo::create(const std::string& strName, const Matrix44D& matBaseTObject, double fLength)
   {
-    return PtrType(new RedTorpedo(strName, matBaseTObject, fLength));
+    return CSWObjectPool::create<RedTorpedo>([&](void* pBlock) { return new (pBlock) RedTorpedo(strName, matBaseTObject, fLength); });
   }
 
 
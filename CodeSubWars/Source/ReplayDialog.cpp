@@ -6,19 +6,11 @@
 #include "Constants.h"
 #include "ReplayDialog.h"
 #include "ReplayView.h"
-#include "CSWUtilities.h"
 
 
 namespace CodeSubWars
 {
 
-  bool timeSliceLess(const std::pair<double, CSWBRImporter::TimeSliceData>& lhs, 
-                     const std::pair<double, CSWBRImporter::TimeSliceData>& rhs)
-  {
-    return lhs.first < rhs.first;
-  }
-
-
   ReplayDialog::ReplayDialog(QString strFileName, QWidget* pParent)
   : QDialog(pParent, Qt::WindowTitleHint | Qt::CustomizeWindowHint | Qt::WindowMinMaxButtonsHint)
   {
@@ -249,64 +241,7 @@ namespace CodeSubWars
     m_pTimeSlider->blockSignals(false);
 
     //load regarding data to current time
-    CSWBRImporter::TimeSliceDataContainer::const_iterator itFound = lower_bound(m_TimeSliceDataContainer.begin(), 
-                                                                                m_TimeSliceDataContainer.end(),
-                                                                                std::make_pair(fCurrentTime, CSWBRImporter::TimeSliceData()),
-                                                                                timeSliceLess);
-    if (itFound == m_TimeSliceDataContainer.end()) return;
-    if (itFound == m_TimeSliceDataContainer.begin())
-    {
-      m_CurrentTimeSliceData = itFound->second;
-      return;
-    }
-  
-    CSWBRImporter::TimeSliceDataContainer::const_iterator itFoundPrior = boost::prior(itFound);
-  
-    //linear interpolate
-    double fInterpolateFactor = (fCurrentTime - itFoundPrior->first)/(itFound->first - itFoundPrior->first);
-
-    const CSWBRImporter::TimeSliceData& firstObjectData = itFoundPrior->second;
-    const CSWBRImporter::TimeSliceData& secondObjectData = itFound->second;
-
-    std::set<std::string> objectNames;
-    CSWBRImporter::TimeSliceData::const_iterator itFirstData = firstObjectData.begin();
-    for (; itFirstData != firstObjectData.end(); ++itFirstData)
-    {
-      objectNames.insert(itFirstData->first);
-    }
-
-    CSWBRImporter::TimeSliceData::const_iterator itSecondData = secondObjectData.begin();
-    for (; itSecondData != secondObjectData.end(); ++itSecondData)
-    {
-      objectNames.insert(itSecondData->first);
-    }
-
-  
-    CSWBRImporter::ObjectData objData;
-    m_CurrentTimeSliceData.clear();
-    std::set<std::string>::const_iterator itName = objectNames.begin();
-    for (; itName != objectNames.end(); ++itName)
-    {
-      CSWBRImporter::TimeSliceData::const_iterator itFoundObject1 = firstObjectData.find(*itName);
-      CSWBRImporter::TimeSliceData::const_iterator itFoundObject2 = secondObjectData.find(*itName);
-      if (itFoundObject1 != firstObjectData.end() &&
-          itFoundObject2 != secondObjectData.end())
-      {
-        objData = itFoundObject1->second;
-        objData.matWorldTObject = ARSTD::Matrix44D::slerp(itFoundObject1->second.matWorldTObject, 
-                                                          itFoundObject2->second.matWorldTObject, 
-                                                          fInterpolateFactor);
-        objData.color = CSWUtilities::interpolateComponentsLinear(itFoundObject1->second.color, 
-                                                                  itFoundObject2->second.color, 
-                                                                  fInterpolateFactor);
-      
-        m_CurrentTimeSliceData[*itName] = objData;
-      }
-      else if (itFoundObject1 != firstObjectData.end())
-      {
-        m_CurrentTimeSliceData[*itName] = itFoundObject1->second;
-      }
-    }
+    CSWBRImporter::interpolate(m_TimeSliceDataContainer, fCurrentTime, m_CurrentTimeSliceData);
   }
 
 }
@@ -10,6 +10,7 @@ namespace CodeSubWars
 {
 
   class CSWCamera;
+  class CSWReplayRenderer;
   class ReplayDialog;
 
   class ReplayView : public OpenGLView
@@ -22,6 +23,7 @@ namespace CodeSubWars
     protected:
       std::shared_ptr<CSWCamera> m_pMainCamera;
       ReplayDialog* m_pReplayDialog;
+      std::shared_ptr<CSWReplayRenderer> m_pRenderer;
   };
 
 }
\ No newline at end of file
@@ -12,6 +12,8 @@
 #include "CSWDetermineIntersectionWithObjects.h"
 #include "CSWBorder.h"
 #include "CSWTrigger.h"
+#include "CSWSimulationThread.h"
+#include "CSWSceneRenderer.h"
 
 
 namespace CodeSubWars
@@ -20,7 +22,8 @@ namespace CodeSubWars
   SceneView::SceneView(QWidget* parent, bool bAbsolutCameraSelection,
                        const QGLWidget* pShareWidget, Qt::WindowFlags f)
   : OpenGLView(parent, pShareWidget, f),
-    m_bAbsolutCameraSelection(bAbsolutCameraSelection)
+    m_bAbsolutCameraSelection(bAbsolutCameraSelection),
+    m_pRenderer(CSWSceneRenderer::create())
   {
   }
 
@@ -31,6 +34,13 @@ namespace CodeSubWars
 
 
   void SceneView::rebuild()
+  {
+    //the camera is looked up in and attached to the world, which only the simulation thread may do
+    CSWSimulationThread::getInstance()->invoke([this]() { rebuildCamera(); });
+  }
+
+
+  void SceneView::rebuildCamera()
   {
     if (m_bAbsolutCameraSelection)
     {
@@ -78,19 +88,24 @@ namespace CodeSubWars
 
   void SceneView::draw()
   {
+    //the frame holds everything that is drawn, so the simulation may change the objects meanwhile
+    const CSWRenderFrame& frame = CSWWorld::getInstance()->fetchRenderFrame();
+
+    //the camera is not contained until the simulation published a frame after it was attached
     CSWCamera::PtrType pCam = m_pCamera.lock();
-    if (!pCam)
+    const CSWRenderFrame::Entry* pCameraEntry = pCam ? frame.find(pCam.get()) : NULL;
+    if (!pCameraEntry)
       return;
 
     glPushAttrib(GL_ALL_ATTRIB_BITS);
     
-      setupCameraAndLight(pCam);
+      setupCameraAndLight(pCameraEntry->matWorldTransform, pCameraEntry->fFieldOfView);
 
       //draw the world
-      CSWWorld::getInstance()->draw();
+      m_pRenderer->draw(frame);
 
       //draw world coord tripod in lower left corner
-      drawWorldTripod();
+      drawWorldTripod(pCameraEntry->matWorldTransform);
     
     glPopAttrib();
   }
@@ -102,28 +117,50 @@ namespace CodeSubWars
 
     // calculate the volume position where the mouse was pressed
     std::pair<bool, Ray3D> resultRay = getWorldPickRay(ev->x(), ev->y());
-    if (resultRay.first)
+    if (!resultRay.first)
+      return;
+
+    //the collision scene is changed by the simulation thread
+    bool bSelectionChanged = false;
+    Ray3D ray = resultRay.second;
+    CSWSimulationThread::getInstance()->invoke([&]() { bSelectionChanged = selectObject(ray); });
+    if (bSelectionChanged)
+      emit selectionChanged();
+  }
+
+
+  void SceneView::transformCamera(const CameraTransformation& transformation)
+  {
+    std::weak_ptr<CSWCamera> pCamera = m_pCamera;
+    CSWSimulationThread::getInstance()->post([pCamera, transformation]()
     {
-      //handle mouse pressing
-      float fIntersection = 0;
-      Vector3F vecNormal;
-      void* pCastResult = DT_RayCast(CSWWorld::getInstance()->getScene(), NULL,
-                                     static_cast<Vector3F>(resultRay.second.getPos()).pData,
-                                     static_cast<Vector3F>(resultRay.second.getPos() + resultRay.second.getDir()*100000.0).pData,
-                                     1.0, &fIntersection, vecNormal.pData);    
-      CSWObject* pObj = reinterpret_cast<CSWObject*>(pCastResult);
-      if (!pObj)
-        return;
+      if (CSWCamera::PtrType pCam = pCamera.lock())
+        transformation(pCam);
+    });
+  }
+
+
+  bool SceneView::selectObject(const Ray3D& ray)
+  {
+    //handle mouse pressing
+    float fIntersection = 0;
+    Vector3F vecNormal;
+    void* pCastResult = DT_RayCast(CSWWorld::getInstance()->getScene(), NULL,
+                                   static_cast<Vector3F>(ray.getPos()).pData,
+                                   static_cast<Vector3F>(ray.getPos() + ray.getDir()*100000.0).pData,
+                                   1.0, &fIntersection, vecNormal.pData);    
+    CSWObject* pObj = reinterpret_cast<CSWObject*>(pCastResult);
+    if (!pObj)
+      return false;
     
-      CSWObject::PtrType pObject = pObj->getSharedThis();
-       if (!std::dynamic_pointer_cast<CSWBorder>(pObject) && //the world border should not be selectable by clicking on it
-           !std::dynamic_pointer_cast<CSWTrigger>(pObject) && //the trigger objects should not be selectable by clicking on it
-           pObject != CSWWorld::getInstance()->getSettings()->getSelectedObject())
-      {
-        CSWWorld::getInstance()->getSettings()->setSelectedObject(pObject);
-        emit selectionChanged();
-      }    
-    }
+    CSWObject::PtrType pObject = pObj->getSharedThis();
+    if (std::dynamic_pointer_cast<CSWBorder>(pObject) || //the world border should not be selectable by clicking on it
+        std::dynamic_pointer_cast<CSWTrigger>(pObject) || //the trigger objects should not be selectable by clicking on it
+        pObject == CSWWorld::getInstance()->getSettings()->getSelectedObject())
+      return false;
+
+    CSWWorld::getInstance()->getSettings()->setSelectedObject(pObject);
+    return true;
   }
 
 }
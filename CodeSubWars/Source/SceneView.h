@@ -11,6 +11,7 @@ namespace CodeSubWars
 {
 
   class CSWObject;
+  class CSWSceneRenderer;
 
   class SceneView : public OpenGLView
   {
@@ -36,9 +37,16 @@ namespace CodeSubWars
     protected:
       virtual void mousePressEvent(QMouseEvent*);
 
+      virtual void transformCamera(const CameraTransformation& transformation);
+
+      //attaches the camera to the selected object, must run on the simulation thread (see rebuild())
+      void rebuildCamera();
+      bool selectObject(const Ray3D& ray);
+
       bool m_bAbsolutCameraSelection;
       std::string m_strObjectPostfix;
       std::weak_ptr<CSWObject> m_pLastSelectedObject;
+      std::shared_ptr<CSWSceneRenderer> m_pRenderer;
   };
 
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "CSWSettings.h"
 #include "CSWWorld.h"
 #include "CSWObject.h"
+#include "CSWInformationSnapshot.h"
 #include "SystemView.h"
 
 
@@ -42,10 +43,12 @@ namespace CodeSubWars
 
   void SystemView::updateContent()
   {
-    const std::vector<boost::tuples::tuple<std::string, double, double> >& load = CSWWorld::getInstance()->getLoad();
-    if (load.empty())
+    CSWInformationSnapshot::PtrType pInformation = CSWWorld::getInstance()->getInformation();
+    if (!pInformation || pInformation->load.empty())
       return;
 
+    const std::vector<boost::tuples::tuple<std::string, double, double> >& load = pInformation->load;
+
     std::stringstream ss;
     ss.precision(1);
     ss.setf(std::ios::fixed | std::ios::right);
@@ -2,8 +2,9 @@
 // Released under the MIT license. (see license.txt)
 
 
-#include "PrecompiledHeader.h"
+#include "CorePrecompiledHeader.h"
 #include "YellowMine.h"
+#include "CSWObjectPool.h"
 
 
 namespace CodeSubWars
@@ -11,7 +12,7 @@ namespace CodeSubWars
 
   YellowMine::PtrType YellowMine::create(const std::string& strName, const Matrix44D& matBaseTObject, double fLength)
   {
-    return PtrType(new YellowMine(strName, matBaseTObject, fLength));
+    return CSWObjectPool::create<YellowMine>([&](void* pBlock) { return new (pBlock) YellowMine(strName, matBaseTObject, fLength); });
   }
 
 
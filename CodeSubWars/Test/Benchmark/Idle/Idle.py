@@ -0,0 +1,26 @@
+# Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+# Released under the MIT license. (see license.txt)
+
+#benchmark submarine
+#does nothing. only the simulation of the submarine itself causes load.
+
+from CodeSubWars_Math import *
+from CodeSubWars_Utilities import *
+
+from CodeSubWars_Common import *
+
+from CodeSubWars_Equipment import *
+from CodeSubWars_Actuators import *
+from CodeSubWars_Sensors import *
+from CodeSubWars_Events import *
+from CodeSubWars_Weapons import *
+from CodeSubWars_Commands import *
+from CodeSubWars_Submarine import *
+
+
+
+class Idle(CSWPySubmarine):
+    def __init__(self): CSWPySubmarine.__init__(self, self.__class__.__name__, 110)
+    def initialize(self): pass
+    def update(self): pass
+    def processEvent(self, event): return 1
@@ -0,0 +1,31 @@
+# Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+# Released under the MIT license. (see license.txt)
+
+#benchmark submarine
+#empties all weapon batteries as fast as possible while moving slowly forward.
+
+from CodeSubWars_Math import *
+from CodeSubWars_Utilities import *
+
+from CodeSubWars_Common import *
+
+from CodeSubWars_Equipment import *
+from CodeSubWars_Actuators import *
+from CodeSubWars_Sensors import *
+from CodeSubWars_Events import *
+from CodeSubWars_Weapons import *
+from CodeSubWars_Commands import *
+from CodeSubWars_Submarine import *
+
+
+
+class TorpedoSwarm(CSWPySubmarine):
+    def __init__(self): CSWPySubmarine.__init__(self, self.__class__.__name__, 110)
+    def update(self): pass
+    def processEvent(self, event): return 1
+
+    def initialize(self):
+        self.getCommandProcessor().execute(CSWCommands.setMainEngineIntensity(self, 0.1))
+        self.getCommandProcessor().execute(CSWCommands.fireSalvo(self.getFrontLeftWeaponBattery(), 44, 1.1))
+        self.getCommandProcessor().execute(CSWCommands.fireSalvo(self.getFrontRightWeaponBattery(), 22, 1.1))
+        self.getCommandProcessor().execute(CSWCommands.fireSalvo(self.getBackWeaponBattery(), 22, 1.1))
@@ -0,0 +1,126 @@
+# Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+# Released under the MIT license. (see license.txt)
+
+#test submarine
+#test sensor active sonar. compares the echoes of multi beam scans with the scan ray of the sonar turned to the same
+#directions, they must detect the same objects, the thin border of MultiBeam.xml at the same distance.
+#both submarines of this directory must be the only ones in a single battle in world MultiBeam.xml, e.g.
+#  CodeSubWars -silent -world=Test/Sensor/ActiveSonar/MultiBeam/MultiBeam.xml -timestep=0.1
+
+from CodeSubWars_Math import *
+from CodeSubWars_Utilities import *
+
+from CodeSubWars_Common import *
+
+from CodeSubWars_Equipment import *
+from CodeSubWars_Actuators import *
+from CodeSubWars_Sensors import *
+from CodeSubWars_Events import *
+from CodeSubWars_Weapons import *
+from CodeSubWars_Commands import *
+from CodeSubWars_Submarine import *
+
+import sys
+sys.path.append('./pylib/Commands')
+from Commands import *
+
+
+#the scanner looks from here toward the thin border in front of the plane z = 400
+BORDER_THICKNESS = 1
+SCANNER_POSITION = Vector3(0, 0, -150)
+#the target waits at this position (see Target.py), about 30 degree beside the forward direction of the scanner
+TARGET_POSITION = Vector3(-170, 0, 150)
+#the beams of the fan
+FAN_ANGLE = 80
+NUMBER_BEAMS = 81
+#time the scan ray needs to follow a new scan direction
+SETTLE_TIME = 0.5
+
+
+
+class Scanner(CSWPySubmarine):
+    def __init__(self): CSWPySubmarine.__init__(self, self.__class__.__name__, 110)
+    def update(self): pass
+    def processEvent(self, event): return 1
+
+    def initialize(self):
+        self.getCommandProcessor().execute(MoveCommand(self, SCANNER_POSITION))
+        self.getCommandProcessor().execute(CSWCommands.disableAllEngines(self))
+        self.getCommandProcessor().execute(CSWCommands.setOrientationAbsoluteTowardDirection(self, Vector3(0, 0, 1), 0.5, 0.3))
+
+        #test
+        self.getCommandProcessor().execute(CompareBeams(self))
+
+
+
+#turns the scan ray beam by beam to the directions of the fan and compares it with the same beam of a multi beam scan
+class CompareBeams(CSWPyCommand):
+    def __init__(self, param):
+        if isinstance(param, self.__class__): 
+            CSWPyCommand.__init__(self, param)
+            self.submarine = param.submarine
+        else: 
+            CSWPyCommand.__init__(self)
+            self.submarine = param
+
+    def cleanup(self): pass
+    def getName(self): return self.__class__.__name__
+
+    def initialize(self):
+        sonar = self.submarine.getControlCenter().getActiveSonar()
+        sonar.setEnableAutomaticRotation(0)
+        sonar.setScanDirectionMode(ScanDirectionMode.LOCAL_DIRECTION)
+        self.directions = CSWActiveSonar.createFanDirections(FAN_ANGLE, NUMBER_BEAMS)
+        self.beam = 0
+        self.submarineBeams = 0
+        self.borderBeams = 0
+        sonar.setScanDirection(self.directions[self.beam])
+        self.time = CSWTime.getTime()
+
+    def step(self):
+        sonar = self.submarine.getControlCenter().getActiveSonar()
+        #the scan ray follows a turn of the submarine one step later than the beams
+        if self.submarine.getControlCenter().getMovingPropertiesSensor().getAngularVelocity().getLength() > 0.001:
+            self.time = CSWTime.getTime()
+            return
+        if CSWTime.getTime() < self.time + SETTLE_TIME or not sonar.isScanReady():
+            return
+
+        #the scan ray turns only close to the scan direction, the beam is sent exactly where it points
+        directions = CSWActiveSonar.createFanDirections(FAN_ANGLE, NUMBER_BEAMS)
+        direction = sonar.getDirection()
+        directions[self.beam] = self.submarine.makeLocalDirection(direction)
+        echo = sonar.scan(directions)[self.beam]
+        assert(direction.x*echo.vecWorldTDirection.x + direction.y*echo.vecWorldTDirection.y + direction.z*echo.vecWorldTDirection.z > 0.999999)
+
+        assert(echo.bTargetDetected == sonar.hasTargetDetected())
+        assert(echo.bTargetBorder == sonar.isTargetBorder())
+        assert(echo.bTargetSubmarine == sonar.isTargetSubmarine())
+        assert(echo.bTargetDynamic == sonar.isTargetDynamic())
+        assert(echo.bTargetWeapon == sonar.isTargetWeapon())
+        if echo.bTargetBorder:
+            #the beam returns where it enters the border, the scan ray a point within the border
+            assert(echo.fDistance - 0.01 < sonar.getDistance())
+            assert(sonar.getDistance() < echo.fDistance + BORDER_THICKNESS/abs(echo.vecWorldTDirection.z) + 0.01)
+            self.borderBeams += 1
+        elif echo.bTargetDetected:
+            #objects are reported by their center
+            position = sonar.getTargetPosition()
+            assert(abs(echo.vecTargetPosition.x - position.x) < 0.5)
+            assert(abs(echo.vecTargetPosition.y - position.y) < 0.5)
+            assert(abs(echo.vecTargetPosition.z - position.z) < 0.5)
+            assert(abs(echo.fDistance - sonar.getDistance()) < 0.5)
+            if echo.bTargetSubmarine:
+                self.submarineBeams += 1
+
+        self.beam += 1
+        if self.beam < len(self.directions):
+            sonar.setScanDirection(self.directions[self.beam])
+            self.time = CSWTime.getTime()
+            return
+
+        #the fan covers the target and the border beside it
+        assert(self.submarineBeams > 0)
+        assert(self.borderBeams > self.submarineBeams)
+        self.setProgress(1)
+        self.finished()
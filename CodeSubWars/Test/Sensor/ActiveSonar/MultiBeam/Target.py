@@ -0,0 +1,36 @@
+# Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+# Released under the MIT license. (see license.txt)
+
+#test submarine
+#target of the submarine Scanner (see Scanner.py). waits at TARGET_POSITION.
+
+from CodeSubWars_Math import *
+from CodeSubWars_Utilities import *
+
+from CodeSubWars_Common import *
+
+from CodeSubWars_Equipment import *
+from CodeSubWars_Actuators import *
+from CodeSubWars_Sensors import *
+from CodeSubWars_Events import *
+from CodeSubWars_Weapons import *
+from CodeSubWars_Commands import *
+from CodeSubWars_Submarine import *
+
+import sys
+sys.path.append('./pylib/Commands')
+from Commands import *
+
+
+TARGET_POSITION = Vector3(-170, 0, 150)
+
+
+
+class Target(CSWPySubmarine):
+    def __init__(self): CSWPySubmarine.__init__(self, self.__class__.__name__, 110)
+    def update(self): pass
+    def processEvent(self, event): return 1
+
+    def initialize(self):
+        self.getCommandProcessor().execute(MoveCommand(self, TARGET_POSITION))
+        self.getCommandProcessor().execute(CSWCommands.disableAllEngines(self))
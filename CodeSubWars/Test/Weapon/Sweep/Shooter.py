@@ -0,0 +1,192 @@
+# Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+# Released under the MIT license. (see license.txt)
+
+#test submarine
+#test the sweep of fast weapons. fires a torpedo at the thin wall of Sweep.xml and one at the submarine Target.
+#both submarines of this directory must be the only ones in a single battle in world Sweep.xml, e.g.
+#  CodeSubWars -silent -world=Test/Weapon/Sweep/Sweep.xml -timestep=0.1
+
+from CodeSubWars_Math import *
+from CodeSubWars_Utilities import *
+
+from CodeSubWars_Common import *
+
+from CodeSubWars_Equipment import *
+from CodeSubWars_Actuators import *
+from CodeSubWars_Sensors import *
+from CodeSubWars_Events import *
+from CodeSubWars_Weapons import *
+from CodeSubWars_Commands import *
+from CodeSubWars_Submarine import *
+
+
+#the thin wall lies in this plane
+WALL_Z = 300
+#length of the submarines, the gps measures the center
+SUBMARINE_LENGTH = 110
+#distance of the bow to the wall when firing at it, the explosion on the wall must still damage the shooter
+WALL_DISTANCE = 30
+#the target waits near this position (see Target.py)
+TARGET_POSITION = Vector3(0, 0, -200)
+
+
+
+class Shooter(CSWPySubmarine):
+    def __init__(self): CSWPySubmarine.__init__(self, self.__class__.__name__, SUBMARINE_LENGTH)
+    def update(self): pass
+
+    def processEvent(self, event):
+        if isinstance(event.getMessage(), CSWExplosionDetectedMessage):
+            self.explosionPoints.append(event.getMessage().getPoint())
+        return 1
+
+    def initialize(self):
+        self.explosionPoints = []
+
+        #test
+        self.getCommandProcessor().execute(CSWCommands.setOrientationAbsoluteTowardDirection(self, Vector3(0, 0, 1), 0.5, 0.3))
+        self.getCommandProcessor().execute(ApproachWall(self))
+        self.getCommandProcessor().execute(CSWCommands.setOrientationAbsoluteTowardDirection(self, Vector3(0, 0, 1), 0.5, 0.3))
+        self.getCommandProcessor().execute(FireAtWall(self, self.getFrontLeftWeaponBattery()))
+        self.getCommandProcessor().execute(CSWCommands.setOrientationAbsoluteTowardPosition(self, TARGET_POSITION, 0.1, 0.3))
+        self.getCommandProcessor().execute(FindTarget(self, self.getFrontLeftWeaponBattery()))
+
+
+
+#moves straight toward the wall until it is about WALL_DISTANCE away and waits until the submarine stands still
+class ApproachWall(CSWPyCommand):
+    def __init__(self, param):
+        if isinstance(param, self.__class__): 
+            CSWPyCommand.__init__(self, param)
+            self.submarine = param.submarine
+        else: 
+            CSWPyCommand.__init__(self)
+            self.submarine = param
+
+    def getName(self): return self.__class__.__name__
+
+    def initialize(self):
+        self.submarine.getMainEngine().setIntensity(0.5)
+        self.approaching = 1
+
+    def step(self):
+        if self.approaching:
+            #the submarine drifts about 5m after the engine is stopped
+            if self.submarine.getControlCenter().getGPS().getPosition().z > WALL_Z - SUBMARINE_LENGTH/2 - WALL_DISTANCE - 5:
+                self.submarine.getMainEngine().setIntensity(0)
+                self.approaching = 0
+        elif self.submarine.getControlCenter().getMovingPropertiesSensor().getVelocity().getLength() < 0.1:
+            self.setProgress(1)
+            self.finished()
+
+    def cleanup(self):
+        self.submarine.getMainEngine().setIntensity(0)
+
+
+
+#a torpedo that passes the wall explodes far behind it, it must explode within the wall and damage the shooter
+class FireAtWall(CSWPyCommand):
+    def __init__(self, param, battery = None):
+        if isinstance(param, self.__class__): 
+            CSWPyCommand.__init__(self, param)
+            self.submarine = param.submarine
+            self.battery = param.battery
+        else: 
+            CSWPyCommand.__init__(self)
+            self.submarine = param
+            self.battery = battery
+
+    def cleanup(self): pass
+    def getName(self): return self.__class__.__name__
+
+    def initialize(self):
+        distance = WALL_Z - SUBMARINE_LENGTH/2 - self.submarine.getControlCenter().getGPS().getPosition().z
+        assert(distance > 0 and distance < WALL_DISTANCE*1.5)
+        self.health = self.submarine.getHealth()
+
+        weapon = self.battery.getNext()
+        assert(weapon != None)
+        assert(weapon.arm(0.5))
+        assert(self.battery.release(weapon))
+        self.time = CSWTime.getTime()
+
+    def step(self):
+        if CSWTime.getTime() > self.time + 20:
+            assert(len(self.submarine.explosionPoints) == 1)
+            #the torpedo is put back to the hit slightly penetrating the wall
+            assert(abs(self.submarine.explosionPoints[0].z - WALL_Z) < 5)
+            assert(self.submarine.getHealth() < self.health)
+            assert(self.submarine.getHealth() > self.health - 0.1)
+
+            self.setProgress(1)
+            self.finished()
+
+
+
+#finds the target with a multi beam scan of the active sonar, then turns exactly toward it and fires
+class FindTarget(CSWPyCommand):
+    def __init__(self, param, battery = None):
+        if isinstance(param, self.__class__): 
+            CSWPyCommand.__init__(self, param)
+            self.submarine = param.submarine
+            self.battery = param.battery
+        else: 
+            CSWPyCommand.__init__(self)
+            self.submarine = param
+            self.battery = battery
+
+    def cleanup(self): pass
+    def getName(self): return self.__class__.__name__
+
+    def initialize(self):
+        self.time = CSWTime.getTime()
+
+    def step(self):
+        assert(CSWTime.getTime() < self.time + 60)
+        sonar = self.submarine.getControlCenter().getActiveSonar()
+        if not sonar.isScanReady():
+            return
+        #the target stops somewhere near TARGET_POSITION, the shooter already looks toward it
+        for echo in sonar.scan(CSWActiveSonar.createConeDirections(60, 1000)):
+            if echo.bTargetSubmarine:
+                self.submarine.getCommandProcessor().execute(CSWCommands.setOrientationAbsoluteTowardPosition(self.submarine, echo.vecTargetPosition, 0.02, 0.02))
+                self.submarine.getCommandProcessor().execute(FireAtTarget(self.submarine, self.battery))
+                self.setProgress(1)
+                self.finished()
+                return
+
+
+
+#fires at the target, the target itself checks where it was hit (see Target.py)
+class FireAtTarget(CSWPyCommand):
+    def __init__(self, param, battery = None):
+        if isinstance(param, self.__class__): 
+            CSWPyCommand.__init__(self, param)
+            self.submarine = param.submarine
+            self.battery = param.battery
+        else: 
+            CSWPyCommand.__init__(self)
+            self.submarine = param
+            self.battery = battery
+
+    def cleanup(self): pass
+    def getName(self): return self.__class__.__name__
+
+    def initialize(self):
+        self.health = self.submarine.getHealth()
+        self.numberExplosions = len(self.submarine.explosionPoints)
+
+        weapon = self.battery.getNext()
+        assert(weapon != None)
+        assert(weapon.arm(0.5))
+        assert(self.battery.release(weapon))
+        self.time = CSWTime.getTime()
+
+    def step(self):
+        if CSWTime.getTime() > self.time + 30:
+            #far from the shooter
+            assert(len(self.submarine.explosionPoints) == self.numberExplosions)
+            assert(self.submarine.getHealth() == self.health)
+
+            self.setProgress(1)
+            self.finished()
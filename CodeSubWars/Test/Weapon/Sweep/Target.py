@@ -0,0 +1,82 @@
+# Copyright (c) 2005-2022 Andreas Rose. All rights reserved.
+# Released under the MIT license. (see license.txt)
+
+#test submarine
+#target of the submarine Shooter (see Shooter.py). waits near TARGET_POSITION until it is hit by the torpedo.
+
+from CodeSubWars_Math import *
+from CodeSubWars_Utilities import *
+
+from CodeSubWars_Common import *
+
+from CodeSubWars_Equipment import *
+from CodeSubWars_Actuators import *
+from CodeSubWars_Sensors import *
+from CodeSubWars_Events import *
+from CodeSubWars_Weapons import *
+from CodeSubWars_Commands import *
+from CodeSubWars_Submarine import *
+
+import sys
+sys.path.append('./pylib/Commands')
+from Commands import *
+
+
+TARGET_POSITION = Vector3(0, 0, -200)
+#length of the submarines, the hull lies within a fifth of it around the axis
+SUBMARINE_LENGTH = 110
+
+
+
+class Target(CSWPySubmarine):
+    def __init__(self): CSWPySubmarine.__init__(self, self.__class__.__name__, SUBMARINE_LENGTH)
+    def update(self): pass
+
+    def processEvent(self, event):
+        if isinstance(event.getMessage(), CSWExplosionDetectedMessage):
+            self.explosionPoints.append(event.getMessage().getPoint())
+        return 1
+
+    def initialize(self):
+        self.explosionPoints = []
+
+        self.getCommandProcessor().execute(MoveCommand(self, TARGET_POSITION))
+        self.getCommandProcessor().execute(CSWCommands.disableAllEngines(self))
+
+        #test
+        self.getCommandProcessor().execute(WaitForHit(self))
+
+
+
+class WaitForHit(CSWPyCommand):
+    def __init__(self, param):
+        if isinstance(param, self.__class__): 
+            CSWPyCommand.__init__(self, param)
+            self.submarine = param.submarine
+        else: 
+            CSWPyCommand.__init__(self)
+            self.submarine = param
+
+    def cleanup(self): pass
+    def getName(self): return self.__class__.__name__
+
+    def initialize(self):
+        #the explosion on the thin wall is far away
+        assert(len(self.submarine.explosionPoints) == 0)
+        self.health = self.submarine.getHealth()
+        self.time = CSWTime.getTime()
+
+    def step(self):
+        assert(CSWTime.getTime() < self.time + 1000)
+        if len(self.submarine.explosionPoints) == 0:
+            return
+
+        #a torpedo that passes the target explodes behind it, it must explode at the hull
+        assert(len(self.submarine.explosionPoints) == 1)
+        localPosition = self.submarine.makeLocalPosition(self.submarine.explosionPoints[0])
+        assert(abs(localPosition.z) < SUBMARINE_LENGTH/2 + 5)
+        assert(localPosition.x*localPosition.x + localPosition.y*localPosition.y < (SUBMARINE_LENGTH/5)*(SUBMARINE_LENGTH/5))
+        assert(self.submarine.getHealth() < self.health)
+
+        self.setProgress(1)
+        self.finished()
@@ -7,7 +7,7 @@ import subprocess
 file = open("Source/BuildDetails2.cpp", "w")
 
 file.write("//warning: this is an automatically generated file!\n")
-file.write("#include \"PrecompiledHeader.h\"\n")
+file.write("#include \"CorePrecompiledHeader.h\"\n")
 file.write("#include \"BuildDetails.h\"\n")
 file.write("\n")
 file.write("namespace CodeSubWars\n")
@@ -41,6 +41,7 @@ except:
 if originalContent == newContent:
   os.remove("Source/BuildDetails2.cpp")
 else:
-  os.remove("Source/BuildDetails.cpp")
+  if os.path.exists("Source/BuildDetails.cpp"):
+    os.remove("Source/BuildDetails.cpp")
   os.rename("Source/BuildDetails2.cpp", "Source/BuildDetails.cpp")
   print("BuildDetails updated")
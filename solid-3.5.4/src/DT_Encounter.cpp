@@ -26,14 +26,93 @@
 #include "DT_Object.h"
 #include "GEN_MinMax.h"
 
+// Relative motion up to which a contact found before is moved along with the objects
+// instead of being computed again.
+static const MT_Scalar CONTACT_TRANSLATION_TOLERANCE = MT_Scalar(1.0e-3);
+static const MT_Scalar CONTACT_ROTATION_TOLERANCE = MT_Scalar(1.0e-4);
+
+static bool equalPose(const MT_Transform& a, const MT_Transform& b, 
+					  MT_Scalar translation_tolerance, MT_Scalar rotation_tolerance)
+{
+	if (a.getOrigin().distance2(b.getOrigin()) > translation_tolerance * translation_tolerance)
+	{
+		return false;
+	}
+
+	for (int i = 0; i != 3; ++i)
+	{
+		for (int j = 0; j != 3; ++j)
+		{
+			if (GEN_max(a.getBasis()[i][j] - b.getBasis()[i][j], b.getBasis()[i][j] - a.getBasis()[i][j]) > rotation_tolerance)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+bool DT_Encounter::findContact(DT_ResponseType type, bool& hit, MT_Point3& p1, MT_Point3& p2) const
+{
+	if (m_contact_type != type)
+	{
+		return false;
+	}
+
+	const MT_Transform& a2w = m_obj_ptr1->getTransform();
+	const MT_Transform& b2w = m_obj_ptr2->getTransform();
+	MT_Transform rel_xform = a2w.inverseTimes(b2w);
+
+	// objects that did not touch are only skipped if they did not move relative to each other at all, 
+	// a small motion could already bring them in contact
+	if (m_contact_hit ? 
+		!equalPose(rel_xform, m_contact_rel_xform, CONTACT_TRANSLATION_TOLERANCE, CONTACT_ROTATION_TOLERANCE) :
+		!equalPose(rel_xform, m_contact_rel_xform, MT_Scalar(0.0), MT_Scalar(0.0)))
+	{
+		return false;
+	}
+
+	hit = m_contact_hit;
+	if (hit && type != DT_SIMPLE_RESPONSE)
+	{
+		p1 = a2w(m_contact_local_p1);
+		p2 = b2w(m_contact_local_p2);
+	}
+	return true;
+}
+
+void DT_Encounter::storeContact(DT_ResponseType type, bool hit, const MT_Point3& p1, const MT_Point3& p2) const
+{
+	const MT_Transform& a2w = m_obj_ptr1->getTransform();
+	const MT_Transform& b2w = m_obj_ptr2->getTransform();
+
+	m_contact_type = type;
+	m_contact_hit = hit;
+	m_contact_rel_xform = a2w.inverseTimes(b2w);
+	if (hit && type != DT_SIMPLE_RESPONSE)
+	{
+		m_contact_local_p1 = a2w.inverse()(p1);
+		m_contact_local_p2 = b2w.inverse()(p2);
+	}
+}
+
 DT_Bool DT_Encounter::exactTest(const DT_RespTable *respTable, int& count) const 
 {
 	const DT_ResponseList& responseList = respTable->find(m_obj_ptr1, m_obj_ptr2);
 
    switch (responseList.getType()) 
    {
-   case DT_SIMPLE_RESPONSE: 
-	   if (intersect(*m_obj_ptr1, *m_obj_ptr2, m_sep_axis)) 
+   case DT_SIMPLE_RESPONSE: {
+	   MT_Point3  p1, p2;
+	   bool       hit;
+
+	   if (!findContact(DT_SIMPLE_RESPONSE, hit, p1, p2))
+	   {
+		   hit = intersect(*m_obj_ptr1, *m_obj_ptr2, m_sep_axis);
+		   storeContact(DT_SIMPLE_RESPONSE, hit, p1, p2);
+	   }
+
+	   if (hit) 
 	   {
 		   ++count;
 		   return (respTable->getResponseClass(m_obj_ptr1) < respTable->getResponseClass(m_obj_ptr2)) ?
@@ -42,10 +121,18 @@ DT_Bool DT_Encounter::exactTest(const DT_RespTable *respTable, int& count) const
  
 	   }
 	   break;
+   }
    case DT_WITNESSED_RESPONSE: {
 	   MT_Point3  p1, p2;
+	   bool       hit;
+
+	   if (!findContact(DT_WITNESSED_RESPONSE, hit, p1, p2))
+	   {
+		   hit = common_point(*m_obj_ptr1, *m_obj_ptr2, m_sep_axis, p1, p2);
+		   storeContact(DT_WITNESSED_RESPONSE, hit, p1, p2);
+	   }
 	   
-	   if (common_point(*m_obj_ptr1, *m_obj_ptr2, m_sep_axis, p1, p2)) 
+	   if (hit) 
 	   { 
 		   ++count;
            if (respTable->getResponseClass(m_obj_ptr1) < respTable->getResponseClass(m_obj_ptr2))
@@ -71,8 +158,15 @@ DT_Bool DT_Encounter::exactTest(const DT_RespTable *respTable, int& count) const
    }
    case DT_DEPTH_RESPONSE: {
 	   MT_Point3  p1, p2;
+	   bool       hit;
+
+	   if (!findContact(DT_DEPTH_RESPONSE, hit, p1, p2))
+	   {
+		   hit = penetration_depth(*m_obj_ptr1, *m_obj_ptr2, m_sep_axis, p1, p2);
+		   storeContact(DT_DEPTH_RESPONSE, hit, p1, p2);
+	   }
 	   
-	   if (penetration_depth(*m_obj_ptr1, *m_obj_ptr2, m_sep_axis, p1, p2)) 
+	   if (hit) 
 	   { 
 		   ++count;
            if (respTable->getResponseClass(m_obj_ptr1) < respTable->getResponseClass(m_obj_ptr2))
@@ -34,9 +34,14 @@ class DT_RespTable;
 
 class DT_Encounter {
 public:
-    DT_Encounter() {}
+    DT_Encounter() 
+        : m_contact_type(DT_NO_RESPONSE),
+          m_contact_hit(false)
+    {}
     DT_Encounter(DT_Object *obj_ptr1, DT_Object *obj_ptr2) 
-        : m_sep_axis(MT_Scalar(0.0), MT_Scalar(0.0), MT_Scalar(0.0)) 
+        : m_sep_axis(MT_Scalar(0.0), MT_Scalar(0.0), MT_Scalar(0.0)),
+          m_contact_type(DT_NO_RESPONSE),
+          m_contact_hit(false)
     {
 		assert(obj_ptr1 != obj_ptr2);
         if (obj_ptr2->getType() < obj_ptr1->getType() || 
@@ -60,9 +65,22 @@ public:
  	DT_Bool exactTest(const DT_RespTable *respTable, int& count) const;
 
 private:
+	// The result of the last exact test is kept as long as the objects overlap in the broad phase.
+	// It is reused while the pose of the second object relative to the first one stays the same, 
+	// a contact also while it changes only slightly. The contact points are stored in the local 
+	// coordinates of their objects and follow them.
+	bool findContact(DT_ResponseType type, bool& hit, MT_Point3& p1, MT_Point3& p2) const;
+	void storeContact(DT_ResponseType type, bool hit, const MT_Point3& p1, const MT_Point3& p2) const;
+
     DT_Object          *m_obj_ptr1;
     DT_Object          *m_obj_ptr2;
     mutable MT_Vector3  m_sep_axis;
+
+	mutable DT_ResponseType m_contact_type;
+	mutable bool            m_contact_hit;
+	mutable MT_Transform    m_contact_rel_xform;
+	mutable MT_Point3       m_contact_local_p1;
+	mutable MT_Point3       m_contact_local_p2;
 };
 
 inline bool operator<(const DT_Encounter& a, const DT_Encounter& b) 
@@ -108,6 +108,8 @@ public:
         m_xform.getValue(m);
     }
 
+	const MT_Transform& getTransform() const { return m_xform; }
+
 	void setBBox();
 
 	const MT_BBox& getBBox() const { return m_bbox; }	
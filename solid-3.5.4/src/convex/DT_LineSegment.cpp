@@ -36,90 +36,85 @@ MT_Point3 DT_LineSegment::support(const MT_Vector3& v) const
 bool DT_LineSegment::ray_cast(const MT_Point3& source, const MT_Point3& target, const MT_Scalar& margin,
 						 MT_Scalar& param, MT_Vector3& normal) const 
 {
-  //simple and stupid approximation: do ray cast with a bbox instead of correct capsule intersection
-  MT_Vector3 xAxis = (m_source + m_target).normalized();
-  MT_Vector3 yAxis = xAxis.cross(MT_Vector3(xAxis[2], -xAxis[0], xAxis[1])).normalized(); 
-  MT_Vector3 zAxis = xAxis.cross(yAxis);
-  MT_Matrix3x3 matRot(xAxis[0], xAxis[1], xAxis[2],
-                      yAxis[0], yAxis[1], yAxis[2],
-                      zAxis[0], zAxis[1], zAxis[2]);
+	// The segment grown by the margin is a capsule, the union of a cylinder 
+	// around the segment and two spheres at its ends. Since the capsule is 
+	// convex, the ray enters it at the earliest entry into one of these parts.
+	MT_Vector3 d = m_target - m_source;
+	MT_Vector3 m = source - m_source;
+	MT_Vector3 r = target - source;
+	MT_Scalar  dd = d.length2();
+	MT_Scalar  radius2 = margin * margin;
 
-  MT_Vector3 translation = (m_source + m_target);
-  translation *= 0.5;
-                      
-  MT_Transform matLineTBBox(matRot, translation);
-  MT_Transform matBBoxTLine(matLineTBBox.inverse());
-  MT_Point3 pointBBoxTSource = matBBoxTLine*source;
-  MT_Point3 pointBBoxTTarget = matBBoxTLine*target;
+	// A source inside the capsule is a hit at the source.
+	MT_Scalar s0 = dd > MT_Scalar(0.0) ? GEN_clamped(m.dot(d) / dd, MT_Scalar(0.0), MT_Scalar(1.0)) : MT_Scalar(0.0);
+	if ((m - d * s0).length2() <= radius2)
+	{
+		param = MT_Scalar(0.0);
+		normal.setValue(MT_Scalar(0.0), MT_Scalar(0.0), MT_Scalar(0.0));
+		return true;
+	}
+
+	MT_Scalar  r_length2 = r.length2();
+	if (r_length2 <= MT_Scalar(0.0) || margin <= MT_Scalar(0.0))
+	{
+		return false;
+	}
 
-  MT_Vector3 e(margin*2, margin*2, (m_source - m_target).length() + margin*2);
-  
-	T_Outcode source_bits = outcode(pointBBoxTSource, e);
-	T_Outcode target_bits = outcode(pointBBoxTTarget, e);
+	bool hit = false;
+	MT_Scalar lambda_hit = param;
+	MT_Point3 axis_point;
 
-	if ((source_bits & target_bits) == 0x0)
-		// None of the side planes separate the ray from the box.
+	// The cylinder, only the part between the end caps counts.
+	if (dd > MT_Scalar(0.0))
 	{
-		MT_Scalar lambda_enter = MT_Scalar(0.0);
-		MT_Scalar lambda_exit  = param;
-		MT_Vector3 r = pointBBoxTTarget - pointBBoxTSource;
-		T_Outcode normal_bit = 0x0; // Indicates the axis that is returned as normal.
-		T_Outcode bit = 0x01;
-		int i;
-		for (i = 0; i != 3; ++i)
+		MT_Scalar md = m.dot(d);
+		MT_Scalar rd = r.dot(d);
+		MT_Scalar a = dd * r_length2 - rd * rd;
+		if (a > MT_EPSILON * dd * r_length2)
+			// The ray is not parallel to the axis.
 		{
-			if (source_bits & bit)
-				// Point of intersection is entering
-			{
-				MT_Scalar lambda = (-pointBBoxTSource[i] - e[i]) / r[i];
-				if (lambda_enter < lambda)
-				{
-					lambda_enter = lambda;
-					normal_bit = bit;
-				}
-			}
-			else if (target_bits & bit) 
-				// Point of intersection is exiting
-			{
-				MT_Scalar lambda = (-pointBBoxTSource[i] - e[i]) / r[i];
-				GEN_set_min(lambda_exit, lambda);
-			}
-			bit <<=1;
-			if (source_bits & bit)
-				// Point of intersection is entering
+			MT_Scalar b = dd * m.dot(r) - rd * md;
+			MT_Scalar c = dd * (m.length2() - radius2) - md * md;
+			MT_Scalar sigma = b * b - a * c;
+			if (sigma >= MT_Scalar(0.0))
 			{
-				MT_Scalar lambda =  (-pointBBoxTSource[i] + e[i]) / r[i];
-				if (lambda_enter < lambda)
+				MT_Scalar lambda = (-b - MT_sqrt(sigma)) / a;
+				MT_Scalar axial = md + lambda * rd;
+				if (lambda >= MT_Scalar(0.0) && lambda <= lambda_hit && 
+					axial >= MT_Scalar(0.0) && axial <= dd)
 				{
-					lambda_enter = lambda;
-					normal_bit = bit;
+					lambda_hit = lambda;
+					axis_point = m_source + d * (axial / dd);
+					hit = true;
 				}
 			}
-			else if (target_bits & bit) 
-				// Point of intersection is exiting
-			{
-				MT_Scalar lambda =  (-pointBBoxTSource[i] + e[i]) / r[i];
-				GEN_set_min(lambda_exit, lambda);
-			}
-			bit <<=1;
 		}
-		if (lambda_enter <= lambda_exit)
-			// The ray intersects the box
+	}
+
+	// The spheres at both ends.
+	const MT_Point3* ends[2] = { &m_source, &m_target };
+	for (int i = 0; i != 2; ++i)
+	{
+		MT_Vector3 e = source - *ends[i];
+		MT_Scalar  delta = -e.dot(r);
+		MT_Scalar  sigma = delta * delta - r_length2 * (e.length2() - radius2);
+		if (sigma >= MT_Scalar(0.0))
 		{
-			param = lambda_enter;
-			normal.setValue(normal_bit == 0x01 ? -MT_Scalar(1.0) : 
-							normal_bit == 0x02 ?  MT_Scalar(1.0) : 
-							MT_Scalar(0.0),
-							normal_bit == 0x04 ? -MT_Scalar(1.0) : 
-							normal_bit == 0x08 ?  MT_Scalar(1.0) : 
-							MT_Scalar(0.0),
-							normal_bit == 0x10 ? -MT_Scalar(1.0) : 
-							normal_bit == 0x20 ?  MT_Scalar(1.0) : 
-							MT_Scalar(0.0));
-      normal = matLineTBBox.getBasis()*normal;
-			return true;
+			MT_Scalar lambda = (delta - MT_sqrt(sigma)) / r_length2;
+			if (lambda >= MT_Scalar(0.0) && lambda <= lambda_hit)
+			{
+				lambda_hit = lambda;
+				axis_point = *ends[i];
+				hit = true;
+			}
 		}
 	}
 
-	return false;
+	if (hit)
+	{
+		param = lambda_hit;
+		normal = (source + r * lambda_hit - axis_point) / margin;
+		// NB: the hit point is at distance margin from the axis point.
+	}
+	return hit;
 }
@@ -42,18 +42,6 @@ public:
 						  MT_Scalar& param, MT_Vector3& normal) const;
 
 private:
-	typedef unsigned int T_Outcode;
-	
-	T_Outcode outcode(const MT_Point3& p, const MT_Vector3& e) const
-	{
-		return (p[0] < -e[0] ? 0x01 : 0x0) |    
-			     (p[0] >  e[0] ? 0x02 : 0x0) |
-		       (p[1] < -e[1] ? 0x04 : 0x0) |    
-		       (p[1] >  e[1] ? 0x08 : 0x0) |
-			     (p[2] < -e[2] ? 0x10 : 0x0) |    
-			     (p[2] >  e[2] ? 0x20 : 0x0);
-	}
-	
 	MT_Point3 m_source;
 	MT_Point3 m_target;
 	
@@ -133,6 +133,9 @@ public:
 	friend bool link(const Edge& edge0, const Edge& edge1);
 	friend void half_link(const Edge& edge0, const Edge& edge1);
 };
+
+bool link(const Edge& edge0, const Edge& edge1);
+void half_link(const Edge& edge0, const Edge& edge1);
   
 	
 static const int MaxTriangles = 200;